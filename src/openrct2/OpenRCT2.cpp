@@ -24,6 +24,7 @@
 #include "OpenRCT2.h"
 #include "platform/crash.h"
 #include "PlatformEnvironment.h"
+#include "Profiler.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/ScenarioRepository.h"
 #include "title/TitleScreen.h"
@@ -465,6 +466,7 @@ namespace OpenRCT2
         {
             platform_draw();
         }
+        profiler_end_frame();
     }
 
     static void RunVariableFrame()
@@ -504,6 +506,7 @@ namespace OpenRCT2
         sprite_position_tween_all(nudge);
 
         platform_draw();
+        profiler_end_frame();
 
         sprite_position_tween_restore();
     }
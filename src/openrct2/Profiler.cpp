@@ -0,0 +1,230 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <string>
+#include <thread>
+#include "core/Exception.hpp"
+#include "core/FileStream.hpp"
+#include "core/Math.hpp"
+#include "core/Memory.hpp"
+#include "core/Stopwatch.hpp"
+#include "Profiler.h"
+
+static const char * const SectionNames[PROFILER_SECTION_COUNT] =
+{
+    "scenario_update",
+    "climate_update",
+    "map_update_tiles",
+    "map_update_path_wide_flags",
+    "peep_update_all",
+    "vehicle_update_all",
+    "sprite_misc_update_all",
+    "ride_update_all",
+    "park_update",
+    "research_update",
+    "ride_ratings_update_all",
+    "ride_measurements_update",
+    "news_item_update_current",
+    "viewport_paint",
+    "paint_generate_structs",
+    "paint_arrange_structs",
+    "paint_draw_structs",
+};
+
+static Stopwatch       _sectionStopwatches[PROFILER_SECTION_COUNT];
+static uint16          _sectionCalls[PROFILER_SECTION_COUNT];
+static uint64          _sectionTotals[PROFILER_SECTION_COUNT];
+static uint32          _sectionTotalCalls[PROFILER_SECTION_COUNT];
+static profiler_sample _samples[PROFILER_MAX_SAMPLES];
+static uint32          _frameCount;
+
+// Only the thread the game started on is timed, sections entered on worker threads are ignored
+static const std::thread::id _profilerThreadId = std::this_thread::get_id();
+
+static bool IsProfilerThread()
+{
+    return std::this_thread::get_id() == _profilerThreadId;
+}
+
+namespace Profiler
+{
+    ScopedSection::ScopedSection(sint32 section)
+        : _section(section)
+    {
+        profiler_begin(section);
+    }
+
+    ScopedSection::~ScopedSection()
+    {
+        profiler_end(_section);
+    }
+}
+
+extern "C"
+{
+    bool gProfilerEnabled = false;
+
+    void profiler_reset()
+    {
+        for (sint32 i = 0; i < PROFILER_SECTION_COUNT; i++)
+        {
+            _sectionStopwatches[i].Reset();
+        }
+        Memory::Set(_sectionCalls, 0, sizeof(_sectionCalls));
+        Memory::Set(_sectionTotals, 0, sizeof(_sectionTotals));
+        Memory::Set(_sectionTotalCalls, 0, sizeof(_sectionTotalCalls));
+        Memory::Set(_samples, 0, sizeof(_samples));
+        _frameCount = 0;
+    }
+
+    void profiler_begin(sint32 section)
+    {
+        if (IsProfilerThread() && gProfilerEnabled)
+        {
+            _sectionStopwatches[section].Start();
+        }
+    }
+
+    void profiler_end(sint32 section)
+    {
+        if (!IsProfilerThread())
+        {
+            return;
+        }
+
+        Stopwatch * stopwatch = &_sectionStopwatches[section];
+        if (stopwatch->IsRunning())
+        {
+            stopwatch->Stop();
+            _sectionCalls[section]++;
+        }
+    }
+
+    /**
+     * Moves the time accumulated for each section since the last call into the sample history.
+     */
+    void profiler_end_frame()
+    {
+        if (!gProfilerEnabled)
+        {
+            return;
+        }
+
+        profiler_sample * sample = &_samples[_frameCount % PROFILER_MAX_SAMPLES];
+        sample->frame = _frameCount;
+        for (sint32 i = 0; i < PROFILER_SECTION_COUNT; i++)
+        {
+            uint64 elapsed = _sectionStopwatches[i].GetElapsedMicroseconds();
+            sample->time[i] = (uint32)Math::Min<uint64>(elapsed, UINT32_MAX);
+            sample->calls[i] = _sectionCalls[i];
+
+            _sectionTotals[i] += elapsed;
+            _sectionTotalCalls[i] += _sectionCalls[i];
+
+            _sectionStopwatches[i].Reset();
+            _sectionCalls[i] = 0;
+        }
+        _frameCount++;
+    }
+
+    const char * profiler_get_section_name(sint32 section)
+    {
+        if (section < 0 || section >= PROFILER_SECTION_COUNT)
+        {
+            return nullptr;
+        }
+        return SectionNames[section];
+    }
+
+    /**
+     * Gets the total number of microseconds spent in the given section since the profiler was reset.
+     */
+    uint64 profiler_get_section_total(sint32 section)
+    {
+        return _sectionTotals[section];
+    }
+
+    uint32 profiler_get_section_total_calls(sint32 section)
+    {
+        return _sectionTotalCalls[section];
+    }
+
+    uint32 profiler_get_frame_count()
+    {
+        return _frameCount;
+    }
+
+    uint32 profiler_get_sample_count()
+    {
+        return Math::Min<uint32>(_frameCount, PROFILER_MAX_SAMPLES);
+    }
+
+    /**
+     * Gets a sample from the history, where index 0 is the oldest sample still kept.
+     */
+    const profiler_sample * profiler_get_sample(uint32 index)
+    {
+        uint32 count = profiler_get_sample_count();
+        if (index >= count)
+        {
+            return nullptr;
+        }
+        uint32 first = _frameCount - count;
+        return &_samples[(first + index) % PROFILER_MAX_SAMPLES];
+    }
+
+    bool profiler_write_csv(const utf8 * path)
+    {
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_WRITE);
+
+            std::string line = "frame";
+            for (sint32 i = 0; i < PROFILER_SECTION_COUNT; i++)
+            {
+                line += ",";
+                line += SectionNames[i];
+                line += "_us,";
+                line += SectionNames[i];
+                line += "_calls";
+            }
+            line += "\n";
+            fs.Write(line.c_str(), line.size());
+
+            uint32 count = profiler_get_sample_count();
+            for (uint32 i = 0; i < count; i++)
+            {
+                const profiler_sample * sample = profiler_get_sample(i);
+                char buffer[32];
+                snprintf(buffer, sizeof(buffer), "%u", sample->frame);
+                line = buffer;
+                for (sint32 j = 0; j < PROFILER_SECTION_COUNT; j++)
+                {
+                    snprintf(buffer, sizeof(buffer), ",%u,%u", sample->time[j], sample->calls[j]);
+                    line += buffer;
+                }
+                line += "\n";
+                fs.Write(line.c_str(), line.size());
+            }
+            return true;
+        }
+        catch (const Exception &)
+        {
+            log_error("Unable to write profiler samples to '%s'", path);
+            return false;
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include "common.h"
+
+enum PROFILER_SECTION
+{
+    // game_logic_update
+    PROFILER_SECTION_SCENARIO,
+    PROFILER_SECTION_CLIMATE,
+    PROFILER_SECTION_MAP_TILES,
+    PROFILER_SECTION_PATH_WIDE_FLAGS,
+    PROFILER_SECTION_PEEPS,
+    PROFILER_SECTION_VEHICLES,
+    PROFILER_SECTION_MISC_SPRITES,
+    PROFILER_SECTION_RIDES,
+    PROFILER_SECTION_PARK,
+    PROFILER_SECTION_RESEARCH,
+    PROFILER_SECTION_RIDE_RATINGS,
+    PROFILER_SECTION_RIDE_MEASUREMENTS,
+    PROFILER_SECTION_NEWS,
+
+    // Rendering
+    PROFILER_SECTION_VIEWPORT_PAINT,
+    PROFILER_SECTION_PAINT_GENERATE_STRUCTS,
+    PROFILER_SECTION_PAINT_ARRANGE_STRUCTS,
+    PROFILER_SECTION_PAINT_DRAW_STRUCTS,
+
+    PROFILER_SECTION_COUNT,
+
+    PROFILER_SECTION_LOGIC_FIRST = PROFILER_SECTION_SCENARIO,
+    PROFILER_SECTION_LOGIC_LAST = PROFILER_SECTION_NEWS,
+};
+
+// Number of frames kept in the sample history
+#define PROFILER_MAX_SAMPLES 256
+
+/**
+ * Time spent in each section during a single frame.
+ */
+typedef struct profiler_sample
+{
+    uint32 frame;
+    uint32 time[PROFILER_SECTION_COUNT];    // microseconds
+    uint16 calls[PROFILER_SECTION_COUNT];
+} profiler_sample;
+
+#ifdef __cplusplus
+
+namespace Profiler
+{
+    /**
+     * Times the enclosing scope as the given section, if profiling is enabled.
+     */
+    class ScopedSection final
+    {
+    private:
+        sint32 _section;
+
+    public:
+        explicit ScopedSection(sint32 section);
+        ~ScopedSection();
+    };
+}
+
+extern "C"
+{
+#endif
+    extern bool gProfilerEnabled;
+
+    void profiler_reset();
+    void profiler_begin(sint32 section);
+    void profiler_end(sint32 section);
+    void profiler_end_frame();
+
+    const char * profiler_get_section_name(sint32 section);
+    uint64 profiler_get_section_total(sint32 section);
+    uint32 profiler_get_section_total_calls(sint32 section);
+    uint32 profiler_get_frame_count();
+    uint32 profiler_get_sample_count();
+    const profiler_sample * profiler_get_sample(uint32 index);
+
+    bool profiler_write_csv(const utf8 * path);
+#ifdef __cplusplus
+}
+#endif
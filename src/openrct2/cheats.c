@@ -21,9 +21,11 @@
 #include "localisation/date.h"
 #include "management/finance.h"
 #include "network/network.h"
+#include "peep/peep_needs.h"
 #include "world/climate.h"
 #include "world/footpath.h"
 #include "world/scenery.h"
+#include "world/tile_summary.h"
 
 bool gCheatsSandboxMode = false;
 bool gCheatsDisableClearanceChecks = false;
@@ -101,6 +103,7 @@ static void cheat_fix_vandalism()
 
 		it.element->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
 	} while (map_element_iterator_next(&it));
+	tile_summary_invalidate();
 
 	gfx_invalidate_screen();
 }
@@ -293,7 +296,7 @@ static void cheat_set_guest_parameter(sint32 parameter, sint32 value)
 	FOR_ALL_GUESTS(spriteIndex, peep) {
 		switch(parameter) {
 			case GUEST_PARAMETER_HAPPINESS:
-				peep->happiness = value;
+				PEEP_NEED(peep, happiness) = value;
 				// Clear the 'red-faced with anger' status if we're making the guest happy
 				if (value > 0)
 				{
@@ -302,22 +305,22 @@ static void cheat_set_guest_parameter(sint32 parameter, sint32 value)
 				}
 				break;
 			case GUEST_PARAMETER_ENERGY:
-				peep->energy = value;
+				PEEP_NEED(peep, energy) = value;
 				break;
 			case GUEST_PARAMETER_HUNGER:
-				peep->hunger = value;
+				PEEP_NEED(peep, hunger) = value;
 				break;
 			case GUEST_PARAMETER_THIRST:
-				peep->thirst = value;
+				PEEP_NEED(peep, thirst) = value;
 				break;
 			case GUEST_PARAMETER_NAUSEA:
-				peep->nausea = value;
+				PEEP_NEED(peep, nausea) = value;
 				break;
 			case GUEST_PARAMETER_NAUSEA_TOLERANCE:
 				peep->nausea_tolerance = value;
 				break;
 			case GUEST_PARAMETER_BATHROOM:
-				peep->bathroom = value;
+				PEEP_NEED(peep, bathroom) = value;
 				break;
 			case GUEST_PARAMETER_PREFERRED_RIDE_INTENSITY:
 				peep->intensity = (15 << 4) | value;
@@ -415,8 +418,8 @@ static void cheat_set_staff_speed(uint8 value)
 	rct_peep *peep;
 
 	FOR_ALL_STAFF(spriteIndex, peep) {
-		peep->energy = value;
-		peep->energy_growth_rate = value;
+		PEEP_NEED(peep, energy) = value;
+		PEEP_NEED(peep, energy_growth_rate) = value;
 	}
 }
 
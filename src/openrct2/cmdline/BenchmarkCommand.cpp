@@ -0,0 +1,1209 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <vector>
+#include "../common.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../core/Stopwatch.hpp"
+#include "../OpenRCT2.h"
+#include "../Profiler.h"
+#include "CommandLine.hpp"
+
+extern "C"
+{
+    #include "../config.h"
+    #include "../drawing/drawing.h"
+    #include "../game.h"
+    #include "../interface/viewport.h"
+    #include "../paint/paint.h"
+    #include "../rct2.h"
+    #include "../scenario/scenario.h"
+    #include "../peep/peep.h"
+    #include "../ride/ride.h"
+    #include "../world/map.h"
+    #include "../world/park.h"
+    #include "../world/sprite.h"
+}
+
+constexpr sint32 DEFAULT_BENCHMARK_TICKS = 10000;
+constexpr sint32 DEFAULT_MAP_BENCHMARK_OPERATIONS = 1000000;
+constexpr sint32 DEFAULT_SPRITE_BENCHMARK_ITERATIONS = 100;
+constexpr sint32 DEFAULT_PATHFIND_BENCHMARK_ITERATIONS = 10;
+constexpr sint32 MAX_PATHFIND_BENCHMARK_DESTINATIONS = 32;
+constexpr sint32 DEFAULT_PAINT_BENCHMARK_ITERATIONS = 10;
+constexpr sint32 DEFAULT_BLIT_BENCHMARK_ITERATIONS = 5;
+constexpr sint32 BLIT_BENCHMARK_SIZE = 1024;
+
+static bool PopBenchmarkParkPath(CommandLineArgEnumerator * enumerator, utf8 * path, size_t pathSize, uint32 * fileType);
+static bool LoadBenchmarkPark(const utf8 * path, uint32 fileType);
+static void WriteBenchmarkResults(sint32 ticks, uint64 elapsedMilliseconds);
+static void RunMapBenchmarkPhase(const utf8 * name, sint32 operations, sint32 areaSize, sint32 insertChance);
+static void RunSpriteBenchmarkPhase(const utf8 * name, sint32 iterations, uint32 (* scan)(), uint32 (* query)());
+static uint32 CountNearbyGuestsByScan();
+static uint32 CountNearbyGuestsByQuery();
+static uint32 FindNearbyLitterByScan();
+static uint32 FindNearbyLitterByQuery();
+static uint32 CountNearbyVehiclesByScan();
+static uint32 CountNearbyVehiclesByQuery();
+static void RunSpriteOperationBenchmark(const utf8 * name, sint32 iterations, uint32 (* operation)());
+static uint32 MoveGuestsToNeighbouringTiles();
+static uint32 LookUpSpritesForPaint();
+static sint32 GetPathfindBenchmarkDestinations(rct_xyz16 * destinations, sint32 maxDestinations);
+static bool RunPaintBenchmarkView(uint8 rotation, sint32 iterations);
+static paint_struct ArrangePaintStructsReference(paint_session * session, uint8 rotation);
+static bool RunBlitBenchmarkCase(const utf8 * name, uint32 imageType, uint8 zoomLevel, uint8 * palette, sint32 iterations);
+static void DrawBlitBenchmarkImages(rct_drawpixelinfo * dpi, uint32 imageType, uint8 * palette);
+
+exitcode_t CommandLine::HandleCommandBenchmark(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    utf8 path[MAX_PATH];
+    uint32 fileType;
+    if (!PopBenchmarkParkPath(enumerator, path, sizeof(path), &fileType))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    sint32 ticks = DEFAULT_BENCHMARK_TICKS;
+    if (enumerator->TryPopInteger(&ticks) && ticks <= 0)
+    {
+        Console::Error::WriteLine("The number of ticks must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    if (!LoadBenchmarkPark(path, fileType))
+    {
+        Console::Error::WriteLine("Unable to load '%s'.", path);
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("Running %d ticks of '%s'...", ticks, path);
+
+    profiler_reset();
+    gProfilerEnabled = true;
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    for (sint32 i = 0; i < ticks; i++)
+    {
+        game_logic_update();
+        profiler_end_frame();
+    }
+    stopwatch.Stop();
+
+    gProfilerEnabled = false;
+
+    WriteBenchmarkResults(ticks, stopwatch.GetElapsedMilliseconds());
+    openrct2_dispose();
+    return EXITCODE_OK;
+}
+
+static bool PopBenchmarkParkPath(CommandLineArgEnumerator * enumerator, utf8 * path, size_t pathSize, uint32 * fileType)
+{
+    const utf8 * rawPath;
+    if (!enumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a path to a saved game or scenario.");
+        return false;
+    }
+
+    Path::GetAbsolute(path, pathSize, rawPath);
+    *fileType = get_file_extension_type(path);
+    if (*fileType != FILE_EXTENSION_SC6 &&
+        *fileType != FILE_EXTENSION_SV6)
+    {
+        Console::Error::WriteLine("Only .SC6 or .SV6 files can be benchmarked.");
+        return false;
+    }
+    return true;
+}
+
+static bool LoadBenchmarkPark(const utf8 * path, uint32 fileType)
+{
+    if (fileType == FILE_EXTENSION_SC6)
+    {
+        if (!scenario_load(path))
+        {
+            return false;
+        }
+        scenario_begin();
+    }
+    else
+    {
+        if (!game_load_sv6_path(path))
+        {
+            return false;
+        }
+        game_load_init();
+    }
+
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    return true;
+}
+
+static void WriteBenchmarkResults(sint32 ticks, uint64 elapsedMilliseconds)
+{
+    double elapsedSeconds = elapsedMilliseconds / 1000.0;
+    double ticksPerSecond = elapsedSeconds > 0 ? ticks / elapsedSeconds : 0;
+
+    Console::WriteLine("Ran %d ticks in %.3f seconds (%.1f ticks/sec).", ticks, elapsedSeconds, ticksPerSecond);
+    Console::WriteLine();
+    Console::WriteLine("%-28s %12s %12s %7s", "Section", "Total (ms)", "Per tick (us)", "Share");
+
+    uint64 totalSectionTime = 0;
+    for (sint32 i = PROFILER_SECTION_LOGIC_FIRST; i <= PROFILER_SECTION_LOGIC_LAST; i++)
+    {
+        totalSectionTime += profiler_get_section_total(i);
+    }
+
+    for (sint32 i = PROFILER_SECTION_LOGIC_FIRST; i <= PROFILER_SECTION_LOGIC_LAST; i++)
+    {
+        uint64 sectionTime = profiler_get_section_total(i);
+        double totalMs = sectionTime / 1000.0;
+        double perTickUs = (double)sectionTime / ticks;
+        double share = totalSectionTime != 0 ? (sectionTime * 100.0) / totalSectionTime : 0;
+        Console::WriteLine("%-28s %12.3f %12.3f %6.2f%%", profiler_get_section_name(i), totalMs, perTickUs, share);
+    }
+
+    // Printing the final state allows two runs to be compared for determinism
+    Console::WriteLine();
+    Console::WriteLine("Final tick: %u, random state: %08X %08X", gCurrentTicks, gScenarioSrand0, gScenarioSrand1);
+    uint32 listChecksums[NUM_SPRITE_LISTS];
+    sprite_list_checksums(listChecksums);
+    Console::WriteLine("Sprite list checksums: %08X %08X %08X %08X %08X %08X",
+        listChecksums[0], listChecksums[1], listChecksums[2], listChecksums[3], listChecksums[4], listChecksums[5]);
+    const char * spriteChecksum = sprite_checksum();
+    if (spriteChecksum != nullptr)
+    {
+        Console::WriteLine("Sprite checksum: %s", spriteChecksum);
+    }
+}
+
+exitcode_t CommandLine::HandleCommandBenchmarkMap(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    sint32 operations = DEFAULT_MAP_BENCHMARK_OPERATIONS;
+    if (enumerator->TryPopInteger(&operations) && operations <= 0)
+    {
+        Console::Error::WriteLine("The number of operations must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    map_init(256);
+    Console::WriteLine("%-20s %12s %14s %12s %12s", "Phase", "Time (ms)", "Ops/sec", "Elements", "Pool size");
+
+    // Scenery being placed and removed all over the park
+    RunMapBenchmarkPhase("Scattered", operations, 256, 60);
+    // Large structures built up in one area, like a station with stacked track and supports
+    RunMapBenchmarkPhase("Dense build", operations, 16, 90);
+    // Demolishing most of that again
+    RunMapBenchmarkPhase("Demolition", operations, 16, 10);
+    return EXITCODE_OK;
+}
+
+static uint32 NextMapBenchmarkRandom(uint32 * state)
+{
+    // xorshift32, so that runs are repeatable
+    uint32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Inserts or removes an element on a random tile for the given number of operations.
+ * @param areaSize The size of the square at the centre of the map the tiles are picked from.
+ * @param insertChance The percentage of operations that insert rather than remove.
+ */
+static void RunMapBenchmarkPhase(const utf8 * name, sint32 operations, sint32 areaSize, sint32 insertChance)
+{
+    uint32 randomState = 0x2C9277B5;
+    sint32 areaStart = (256 - areaSize) / 2;
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    for (sint32 i = 0; i < operations; i++)
+    {
+        uint32 random = NextMapBenchmarkRandom(&randomState);
+        sint32 x = areaStart + (sint32)(random % areaSize);
+        sint32 y = areaStart + (sint32)((random >> 8) % areaSize);
+        bool insert = (sint32)((random >> 16) % 100) < insertChance;
+
+        if (insert)
+        {
+            sint32 z = 14 + (sint32)((random >> 24) % 200);
+            rct_map_element * mapElement = map_element_insert(x, y, z, 0);
+            if (mapElement != nullptr)
+            {
+                mapElement->type = MAP_ELEMENT_TYPE_SCENERY;
+                mapElement->clearance_height = z + 4;
+            }
+        }
+        else
+        {
+            // Remove the element above the surface, if there is one
+            rct_map_element * mapElement = map_get_first_element_at(x, y);
+            while (!map_element_is_last_for_tile(mapElement))
+            {
+                mapElement++;
+                if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_SURFACE)
+                {
+                    map_element_remove(x, y, mapElement);
+                    break;
+                }
+            }
+        }
+    }
+    stopwatch.Stop();
+
+    uint64 elapsedMilliseconds = stopwatch.GetElapsedMilliseconds();
+    double opsPerSecond = elapsedMilliseconds != 0 ? operations / (elapsedMilliseconds / 1000.0) : 0;
+    Console::WriteLine("%-20s %12llu %14.0f %12zu %12zu", name,
+        (unsigned long long)elapsedMilliseconds, opsPerSecond, map_get_num_elements(MAXIMUM_MAP_SIZE_TECHNICAL), map_get_element_pool_capacity());
+}
+
+exitcode_t CommandLine::HandleCommandBenchmarkSprites(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    utf8 path[MAX_PATH];
+    uint32 fileType;
+    if (!PopBenchmarkParkPath(enumerator, path, sizeof(path), &fileType))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    sint32 iterations = DEFAULT_SPRITE_BENCHMARK_ITERATIONS;
+    if (enumerator->TryPopInteger(&iterations) && iterations <= 0)
+    {
+        Console::Error::WriteLine("The number of iterations must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    if (!LoadBenchmarkPark(path, fileType))
+    {
+        Console::Error::WriteLine("Unable to load '%s'.", path);
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("%-24s %12s %12s %12s", "Search", "Scan (ms)", "Query (ms)", "Found");
+
+    // Entertainers cheering up the guests around them
+    RunSpriteBenchmarkPhase("Guests within 96", iterations, CountNearbyGuestsByScan, CountNearbyGuestsByQuery);
+    // Handymen looking for litter to sweep
+    RunSpriteBenchmarkPhase("Litter within 0x60", iterations, FindNearbyLitterByScan, FindNearbyLitterByQuery);
+    // Vehicles looking for other vehicles to collide with
+    RunSpriteBenchmarkPhase("Vehicles on 3x3 tiles", iterations, CountNearbyVehiclesByScan, CountNearbyVehiclesByQuery);
+
+    Console::WriteLine();
+    Console::WriteLine("%-24s %12s %12s", "Operation", "Time (ms)", "Sprites");
+
+    // Every guest stepping onto the next tile and back, which moves it between the tiles of the spatial index
+    RunSpriteOperationBenchmark("Guest moves", iterations, MoveGuestsToNeighbouringTiles);
+    // The sprites of every tile being gathered to be painted
+    RunSpriteOperationBenchmark("Paint lookups", iterations, LookUpSpritesForPaint);
+
+    openrct2_dispose();
+    return EXITCODE_OK;
+}
+
+/**
+ * Times finding sprites near every guest or vehicle both by the way it was done before the spatial index could be
+ * queried and by querying it. Both must find the same sprites.
+ */
+static void RunSpriteBenchmarkPhase(const utf8 * name, sint32 iterations, uint32 (* scan)(), uint32 (* query)())
+{
+    uint32 scanFound = 0;
+    Stopwatch scanStopwatch;
+    scanStopwatch.Start();
+    for (sint32 i = 0; i < iterations; i++)
+    {
+        scanFound = scan();
+    }
+    scanStopwatch.Stop();
+
+    uint32 queryFound = 0;
+    Stopwatch queryStopwatch;
+    queryStopwatch.Start();
+    for (sint32 i = 0; i < iterations; i++)
+    {
+        queryFound = query();
+    }
+    queryStopwatch.Stop();
+
+    Console::WriteLine("%-24s %12llu %12llu %12u", name,
+        (unsigned long long)scanStopwatch.GetElapsedMilliseconds(),
+        (unsigned long long)queryStopwatch.GetElapsedMilliseconds(),
+        queryFound);
+    if (scanFound != queryFound)
+    {
+        Console::Error::WriteLine("The query found %u sprites but the scan found %u.", queryFound, scanFound);
+    }
+}
+
+exitcode_t CommandLine::HandleCommandBenchmarkPathfind(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    utf8 path[MAX_PATH];
+    uint32 fileType;
+    if (!PopBenchmarkParkPath(enumerator, path, sizeof(path), &fileType))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    sint32 iterations = DEFAULT_PATHFIND_BENCHMARK_ITERATIONS;
+    if (enumerator->TryPopInteger(&iterations) && iterations <= 0)
+    {
+        Console::Error::WriteLine("The number of iterations must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    if (!LoadBenchmarkPark(path, fileType))
+    {
+        Console::Error::WriteLine("Unable to load '%s'.", path);
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    rct_xyz16 destinations[MAX_PATHFIND_BENCHMARK_DESTINATIONS];
+    sint32 numDestinations = GetPathfindBenchmarkDestinations(destinations, MAX_PATHFIND_BENCHMARK_DESTINATIONS);
+    uint8 savedFlowFields = gConfigGeneral.guest_flow_fields;
+    gConfigGeneral.guest_flow_fields = 0;
+
+    // Every walking guest looks for the way to every destination, as if the whole park wanted to go there
+    uint32 searches = 0;
+    uint32 heuristicFound = 0;
+    uint32 flowFound = 0;
+    uint32 agreed = 0;
+    Stopwatch heuristicStopwatch;
+    Stopwatch flowStopwatch;
+    for (sint32 i = 0; i < iterations; i++)
+    {
+        for (sint32 d = 0; d < numDestinations; d++)
+        {
+            uint16 spriteIndex;
+            rct_peep * peep;
+            FOR_ALL_GUESTS(spriteIndex, peep)
+            {
+                if (peep->state != PEEP_STATE_WALKING || peep->x == SPRITE_LOCATION_NULL)
+                {
+                    continue;
+                }
+
+                gPeepPathFindGoalPosition = destinations[d];
+                gPeepPathFindIgnoreForeignQueues = true;
+                gPeepPathFindQueueRideIndex = 255;
+
+                // The search remembers the goal and the junctions it took, which must not leak into the next search
+                rct_peep savedPeep = *peep;
+                heuristicStopwatch.Start();
+                sint32 heuristicDirection = peep_pathfind_choose_direction(peep->next_x, peep->next_y, peep->next_z, peep);
+                heuristicStopwatch.Stop();
+                *peep = savedPeep;
+
+                flowStopwatch.Start();
+                sint32 flowDirection = peep_pathfind_get_flow_direction(peep->next_x, peep->next_y, peep->next_z, peep);
+                flowStopwatch.Stop();
+
+                searches++;
+                if (heuristicDirection != -1) heuristicFound++;
+                if (flowDirection != -1) flowFound++;
+                if (heuristicDirection == flowDirection) agreed++;
+            }
+        }
+    }
+
+    gConfigGeneral.guest_flow_fields = savedFlowFields;
+
+    Console::WriteLine("Destinations:   %d", numDestinations);
+    Console::WriteLine("Searches:       %u", searches);
+    Console::WriteLine("%-16s %12s %12s", "Search", "Time (ms)", "Found");
+    Console::WriteLine("%-16s %12llu %12u", "Heuristic", (unsigned long long)heuristicStopwatch.GetElapsedMilliseconds(), heuristicFound);
+    Console::WriteLine("%-16s %12llu %12u", "Flow fields", (unsigned long long)flowStopwatch.GetElapsedMilliseconds(), flowFound);
+    Console::WriteLine("Same direction: %u", agreed);
+
+    openrct2_dispose();
+    return EXITCODE_OK;
+}
+
+/**
+ * Gathers the park entrances and ride entrances guests walk to, in map units with z in height units.
+ */
+static sint32 GetPathfindBenchmarkDestinations(rct_xyz16 * destinations, sint32 maxDestinations)
+{
+    sint32 numDestinations = 0;
+    for (sint32 i = 0; i < 4 && numDestinations < maxDestinations; i++)
+    {
+        if (gParkEntranceX[i] != MAP_LOCATION_NULL)
+        {
+            destinations[numDestinations++] = { gParkEntranceX[i], gParkEntranceY[i], (sint16)(gParkEntranceZ[i] >> 3) };
+        }
+    }
+
+    sint32 rideIndex;
+    rct_ride * ride;
+    FOR_ALL_RIDES(rideIndex, ride)
+    {
+        for (sint32 station = 0; station < 4 && numDestinations < maxDestinations; station++)
+        {
+            uint16 entrance = ride->entrances[station];
+            if (entrance != 0xFFFF)
+            {
+                destinations[numDestinations++] = { (sint16)((entrance & 0xFF) * 32), (sint16)((entrance >> 8) * 32), ride->station_heights[station] };
+            }
+        }
+    }
+    return numDestinations;
+}
+
+static bool IsWithinBenchmarkRange(const rct_unk_sprite * centre, const rct_unk_sprite * sprite, sint32 range)
+{
+    return sprite->x != SPRITE_LOCATION_NULL &&
+        abs(sprite->x - centre->x) <= range &&
+        abs(sprite->y - centre->y) <= range;
+}
+
+static uint32 CountNearbyGuestsByScan()
+{
+    uint32 found = 0;
+    uint16 spriteIndex, otherSpriteIndex;
+    rct_peep * peep, * guest;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        if (peep->x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        FOR_ALL_GUESTS(otherSpriteIndex, guest)
+        {
+            if (IsWithinBenchmarkRange((rct_unk_sprite *)peep, (rct_unk_sprite *)guest, 96))
+            {
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+static uint32 CountNearbyGuestsByQuery()
+{
+    uint32 found = 0;
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        if (peep->x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        sprite_query query;
+        sprite_query_radius(&query, peep->x, peep->y, 96, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+        rct_sprite * sprite;
+        while ((sprite = sprite_query_next(&query)) != nullptr)
+        {
+            if (sprite->peep.type == PEEP_TYPE_GUEST)
+            {
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+static uint32 FindNearbyLitterByScan()
+{
+    uint32 found = 0;
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_PEEPS(spriteIndex, peep)
+    {
+        if (peep->x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        for (uint16 litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != SPRITE_INDEX_NULL;)
+        {
+            rct_sprite * litter = get_sprite(litterIndex);
+            if (IsWithinBenchmarkRange((rct_unk_sprite *)peep, &litter->unknown, 0x60))
+            {
+                found++;
+            }
+            litterIndex = litter->unknown.next;
+        }
+    }
+    return found;
+}
+
+static uint32 FindNearbyLitterByQuery()
+{
+    uint32 found = 0;
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_PEEPS(spriteIndex, peep)
+    {
+        if (peep->x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        sprite_query query;
+        sprite_query_radius(&query, peep->x, peep->y, 0x60, SPRITE_LIST_MASK(SPRITE_LIST_LITTER));
+        while (sprite_query_next(&query) != nullptr)
+        {
+            found++;
+        }
+    }
+    return found;
+}
+
+static uint32 CountNearbyVehiclesByScan()
+{
+    uint32 found = 0;
+    for (uint16 spriteIndex = 0; spriteIndex < MAX_SPRITES; spriteIndex++)
+    {
+        rct_sprite * vehicle = get_sprite(spriteIndex);
+        if (vehicle->unknown.sprite_identifier != SPRITE_IDENTIFIER_VEHICLE || vehicle->unknown.x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        for (sint32 y = -1; y <= 1; y++)
+        {
+            for (sint32 x = -1; x <= 1; x++)
+            {
+                sint32 tileX = (vehicle->unknown.x >> 5) + x;
+                sint32 tileY = (vehicle->unknown.y >> 5) + y;
+                if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                {
+                    continue;
+                }
+
+                size_t numSprites;
+                const uint16 * tileSprites = sprite_get_tile_sprites(tileX, tileY, &numSprites);
+                for (size_t i = 0; i < numSprites; i++)
+                {
+                    rct_sprite * other = get_sprite(tileSprites[i]);
+                    if (other->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+                    {
+                        found++;
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+static uint32 CountNearbyVehiclesByQuery()
+{
+    uint32 found = 0;
+    for (uint16 spriteIndex = 0; spriteIndex < MAX_SPRITES; spriteIndex++)
+    {
+        rct_sprite * vehicle = get_sprite(spriteIndex);
+        if (vehicle->unknown.sprite_identifier != SPRITE_IDENTIFIER_VEHICLE || vehicle->unknown.x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        for (sint32 y = -1; y <= 1; y++)
+        {
+            for (sint32 x = -1; x <= 1; x++)
+            {
+                sprite_query query;
+                sprite_query_tile(&query, (vehicle->unknown.x >> 5) + x, (vehicle->unknown.y >> 5) + y, VEHICLE_SPRITE_LIST_MASK);
+                rct_sprite * other;
+                while ((other = sprite_query_next(&query)) != nullptr)
+                {
+                    if (other->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+                    {
+                        found++;
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+static void RunSpriteOperationBenchmark(const utf8 * name, sint32 iterations, uint32 (* operation)())
+{
+    uint32 count = 0;
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    for (sint32 i = 0; i < iterations; i++)
+    {
+        count = operation();
+    }
+    stopwatch.Stop();
+
+    Console::WriteLine("%-24s %12llu %12u", name, (unsigned long long)stopwatch.GetElapsedMilliseconds(), count);
+}
+
+static uint32 MoveGuestsToNeighbouringTiles()
+{
+    uint32 moved = 0;
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        if (peep->x == SPRITE_LOCATION_NULL)
+        {
+            continue;
+        }
+
+        sint16 x = peep->x;
+        sint16 y = peep->y;
+        sint16 z = peep->z;
+        sint16 otherX = x < MAXIMUM_MAP_SIZE_BIG - 32 ? x + 32 : x - 32;
+        sprite_move(otherX, y, z, (rct_sprite *)peep);
+        sprite_move(x, y, z, (rct_sprite *)peep);
+        moved++;
+    }
+    return moved;
+}
+
+static uint32 LookUpSpritesForPaint()
+{
+    uint32 found = 0;
+    for (sint32 tileY = 0; tileY < gMapSize; tileY++)
+    {
+        for (sint32 tileX = 0; tileX < gMapSize; tileX++)
+        {
+            size_t numSprites;
+            const uint16 * tileSprites = sprite_get_tile_sprites(tileX, tileY, &numSprites);
+            for (size_t i = numSprites; i > 0; i--)
+            {
+                const rct_sprite * sprite = get_sprite(tileSprites[i - 1]);
+                if (sprite->unknown.sprite_left != SPRITE_LOCATION_NULL)
+                {
+                    found++;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+exitcode_t CommandLine::HandleCommandBenchmarkPaint(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    utf8 path[MAX_PATH];
+    uint32 fileType;
+    if (!PopBenchmarkParkPath(enumerator, path, sizeof(path), &fileType))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    sint32 iterations = DEFAULT_PAINT_BENCHMARK_ITERATIONS;
+    if (enumerator->TryPopInteger(&iterations) && iterations <= 0)
+    {
+        Console::Error::WriteLine("The number of iterations must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    if (!LoadBenchmarkPark(path, fileType))
+    {
+        Console::Error::WriteLine("Unable to load '%s'.", path);
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("%-24s %12s %12s %12s", "View", "Old (ms)", "New (ms)", "Structs");
+
+    bool sameOrder = true;
+    uint8 savedRotation = gCurrentRotation;
+    for (uint8 rotation = 0; rotation < 4; rotation++)
+    {
+        sameOrder &= RunPaintBenchmarkView(rotation, iterations);
+    }
+    gCurrentRotation = savedRotation;
+    reset_all_sprite_quadrant_placements();
+
+    openrct2_dispose();
+    return sameOrder ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+struct RecordedPaintStruct
+{
+    paint_struct * ps;
+    paint_struct * next_quadrant_ps;
+    uint8          var_1B;
+};
+
+/**
+ * Records the paint lists of the whole park in one rotation, column by column as a giant screenshot paints them, and
+ * times ordering each of them the way it was done before paint_arrange_structs was reworked and the current way. Both
+ * must give the same draw order, returns false if they do not.
+ */
+static bool RunPaintBenchmarkView(uint8 rotation, sint32 iterations)
+{
+    gCurrentRotation = rotation;
+    gCurrentViewportFlags = 0;
+    reset_all_sprite_quadrant_placements();
+
+    sint32 centreX = (gMapSize / 2) * 32 + 16;
+    sint32 centreY = (gMapSize / 2) * 32 + 16;
+    sint32 z = map_element_height(centreX, centreY) & 0xFFFF;
+    rct_xy32 centre = { 0, 0 };
+    switch (rotation)
+    {
+    case 0:
+        centre = { centreY - centreX, ((centreX + centreY) / 2) - z };
+        break;
+    case 1:
+        centre = { -centreY - centreX, ((-centreX + centreY) / 2) - z };
+        break;
+    case 2:
+        centre = { -centreY + centreX, ((-centreX - centreY) / 2) - z };
+        break;
+    case 3:
+        centre = { centreY + centreX, ((centreX - centreY) / 2) - z };
+        break;
+    }
+
+    sint32 viewWidth = gMapSize * 32 * 2 + 8;
+    sint32 viewHeight = gMapSize * 32 + 128;
+    sint32 viewX = centre.x - viewWidth / 2;
+    sint32 viewY = centre.y - viewHeight / 2;
+
+    uint64 numStructs = 0;
+    uint32 numMismatches = 0;
+    Stopwatch oldStopwatch;
+    Stopwatch newStopwatch;
+    std::vector<RecordedPaintStruct> recorded;
+    std::vector<paint_struct *> oldOrder;
+    for (sint32 x = floor2(viewX, 32); x < viewX + viewWidth; x += 32)
+    {
+        rct_drawpixelinfo dpi = { 0 };
+        dpi.x = x;
+        dpi.y = viewY;
+        dpi.width = 32;
+        dpi.height = viewHeight;
+
+        paint_session * session = paint_session_get(0);
+        paint_init(session, &dpi);
+        paint_generate_structs(session);
+
+        // Ordering relinks the paint structs, so their links are put back before every run
+        recorded.clear();
+        if (session->quadrant_back_index != UINT32_MAX)
+        {
+            for (uint32 i = session->quadrant_back_index; i <= session->quadrant_front_index; i++)
+            {
+                for (paint_struct * ps = session->quadrants[i]; ps != nullptr; ps = ps->next_quadrant_ps)
+                {
+                    recorded.push_back({ ps, ps->next_quadrant_ps, ps->var_1B });
+                }
+            }
+        }
+        numStructs += recorded.size();
+
+        paint_struct psHead = {};
+        for (sint32 i = 0; i < iterations; i++)
+        {
+            for (const RecordedPaintStruct &entry : recorded)
+            {
+                entry.ps->next_quadrant_ps = entry.next_quadrant_ps;
+                entry.ps->var_1B = entry.var_1B;
+            }
+            oldStopwatch.Start();
+            psHead = ArrangePaintStructsReference(session, rotation);
+            oldStopwatch.Stop();
+        }
+
+        oldOrder.clear();
+        for (paint_struct * ps = psHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            oldOrder.push_back(ps);
+        }
+
+        for (sint32 i = 0; i < iterations; i++)
+        {
+            for (const RecordedPaintStruct &entry : recorded)
+            {
+                entry.ps->next_quadrant_ps = entry.next_quadrant_ps;
+                entry.ps->var_1B = entry.var_1B;
+            }
+            newStopwatch.Start();
+            psHead = paint_arrange_structs(session);
+            newStopwatch.Stop();
+        }
+
+        size_t index = 0;
+        bool sameOrder = true;
+        for (paint_struct * ps = psHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            if (index >= oldOrder.size() || oldOrder[index] != ps)
+            {
+                sameOrder = false;
+                break;
+            }
+            index++;
+        }
+        if (!sameOrder || index != oldOrder.size())
+        {
+            numMismatches++;
+        }
+    }
+
+    utf8 name[32];
+    snprintf(name, sizeof(name), "Rotation %u", rotation);
+    Console::WriteLine("%-24s %12llu %12llu %12llu", name,
+        (unsigned long long)oldStopwatch.GetElapsedMilliseconds(),
+        (unsigned long long)newStopwatch.GetElapsedMilliseconds(),
+        (unsigned long long)numStructs);
+    if (numMismatches != 0)
+    {
+        Console::Error::WriteLine("%u columns were drawn in a different order.", numMismatches);
+    }
+    return numMismatches == 0;
+}
+
+static void ArrangePaintStructsReferenceHelper(paint_struct * ps_next, uint16 ax, uint8 flag, uint8 rotation)
+{
+    paint_struct * ps;
+    paint_struct * ps_temp;
+    do
+    {
+        ps = ps_next;
+        ps_next = ps_next->next_quadrant_ps;
+        if (ps_next == nullptr) return;
+    }
+    while (ax > ps_next->var_18);
+
+    ps_temp = ps;
+    do
+    {
+        ps = ps->next_quadrant_ps;
+        if (ps == nullptr) break;
+
+        if (ps->var_18 > ax + 1)
+        {
+            ps->var_1B = 1 << 7;
+        }
+        else if (ps->var_18 == ax + 1)
+        {
+            ps->var_1B = (1 << 1) | (1 << 0);
+        }
+        else if (ps->var_18 == ax)
+        {
+            ps->var_1B = flag | (1 << 0);
+        }
+    }
+    while (ps->var_18 <= ax + 1);
+    ps = ps_temp;
+
+    while (true)
+    {
+        while (true)
+        {
+            ps_next = ps->next_quadrant_ps;
+            if (ps_next == nullptr) return;
+            if (ps_next->var_1B & (1 << 7)) return;
+            if (ps_next->var_1B & (1 << 0)) break;
+            ps = ps_next;
+        }
+
+        ps_next->var_1B &= ~(1 << 0);
+        ps_temp = ps;
+
+        uint16 bbX = ps_next->bound_box_x;
+        uint16 bbY = ps_next->bound_box_y;
+        uint16 bbZ = ps_next->bound_box_z;
+        uint16 bbXEnd = ps_next->bound_box_x_end;
+        uint16 bbYEnd = ps_next->bound_box_y_end;
+        uint16 bbZEnd = ps_next->bound_box_z_end;
+
+        while (true)
+        {
+            ps = ps_next;
+            ps_next = ps_next->next_quadrant_ps;
+            if (ps_next == nullptr) break;
+            if (ps_next->var_1B & (1 << 7)) break;
+            if (!(ps_next->var_1B & (1 << 1))) continue;
+
+            bool yes = false;
+            switch (rotation)
+            {
+            case 0:
+                yes = bbZEnd >= ps_next->bound_box_z && bbYEnd >= ps_next->bound_box_y && bbXEnd >= ps_next->bound_box_x
+                    && !(bbZ < ps_next->bound_box_z_end && bbY < ps_next->bound_box_y_end && bbX < ps_next->bound_box_x_end);
+                break;
+            case 1:
+                yes = bbZEnd >= ps_next->bound_box_z && bbYEnd >= ps_next->bound_box_y && bbXEnd < ps_next->bound_box_x
+                    && !(bbZ < ps_next->bound_box_z_end && bbY < ps_next->bound_box_y_end && bbX >= ps_next->bound_box_x_end);
+                break;
+            case 2:
+                yes = bbZEnd >= ps_next->bound_box_z && bbYEnd < ps_next->bound_box_y && bbXEnd < ps_next->bound_box_x
+                    && !(bbZ < ps_next->bound_box_z_end && bbY >= ps_next->bound_box_y_end && bbX >= ps_next->bound_box_x_end);
+                break;
+            case 3:
+                yes = bbZEnd >= ps_next->bound_box_z && bbYEnd < ps_next->bound_box_y && bbXEnd >= ps_next->bound_box_x
+                    && !(bbZ < ps_next->bound_box_z_end && bbY >= ps_next->bound_box_y_end && bbX < ps_next->bound_box_x_end);
+                break;
+            }
+
+            if (yes)
+            {
+                ps->next_quadrant_ps = ps_next->next_quadrant_ps;
+                paint_struct * ps_temp2 = ps_temp->next_quadrant_ps;
+                ps_temp->next_quadrant_ps = ps_next;
+                ps_next->next_quadrant_ps = ps_temp2;
+                ps_next = ps;
+            }
+        }
+
+        ps = ps_temp;
+    }
+}
+
+/**
+ * The way paint_arrange_structs ordered paint structs before it was reworked, every quadrant is searched for from the
+ * start of the list and the rotation is checked for every comparison.
+ */
+static paint_struct ArrangePaintStructsReference(paint_session * session, uint8 rotation)
+{
+    paint_struct psHead = { 0 };
+    paint_struct * ps = &psHead;
+    ps->next_quadrant_ps = nullptr;
+    uint32 quadrantIndex = session->quadrant_back_index;
+    if (quadrantIndex != UINT32_MAX)
+    {
+        do
+        {
+            paint_struct * ps_next = session->quadrants[quadrantIndex];
+            if (ps_next != nullptr)
+            {
+                ps->next_quadrant_ps = ps_next;
+                do
+                {
+                    ps = ps_next;
+                    ps_next = ps_next->next_quadrant_ps;
+                }
+                while (ps_next != nullptr);
+            }
+        }
+        while (++quadrantIndex <= session->quadrant_front_index);
+
+        ArrangePaintStructsReferenceHelper(&psHead, session->quadrant_back_index & 0xFFFF, 1 << 1, rotation);
+
+        quadrantIndex = session->quadrant_back_index;
+        while (++quadrantIndex < session->quadrant_front_index)
+        {
+            ArrangePaintStructsReferenceHelper(&psHead, quadrantIndex & 0xFFFF, 0, rotation);
+        }
+    }
+    return psHead;
+}
+
+exitcode_t CommandLine::HandleCommandBenchmarkBlit(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    sint32 iterations = DEFAULT_BLIT_BENCHMARK_ITERATIONS;
+    if (enumerator->TryPopInteger(&iterations) && iterations <= 0)
+    {
+        Console::Error::WriteLine("The number of iterations must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        openrct2_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    // Made up palettes, only the same output of every blitter matters. Glass blends with a table indexed by the sprite
+    // colour in the high byte and the background in the low byte, starting at colour 1.
+    std::vector<uint8> remapPalette(256);
+    std::vector<uint8> glassPalette(256 * 256);
+    for (size_t i = 0; i < remapPalette.size(); i++)
+    {
+        remapPalette[i] = (uint8)(i * 7 + 10);
+    }
+    for (size_t i = 0; i < glassPalette.size(); i++)
+    {
+        glassPalette[i] = (uint8)((i >> 8) + (i & 0xFF) / 2);
+    }
+
+    Console::WriteLine("%-24s %12s %12s %12s", "Image type", "Scalar (ms)", "SSE2 (ms)", "AVX2 (ms)");
+
+    bool sameOutput = true;
+    sint32 savedBlitter = gfx_rle_sprite_get_blitter();
+    for (uint8 zoomLevel = 0; zoomLevel < 4; zoomLevel++)
+    {
+        utf8 name[32];
+        snprintf(name, sizeof(name), "Default, zoom %u", zoomLevel);
+        sameOutput &= RunBlitBenchmarkCase(name, IMAGE_TYPE_DEFAULT, zoomLevel, nullptr, iterations);
+        snprintf(name, sizeof(name), "Remap, zoom %u", zoomLevel);
+        sameOutput &= RunBlitBenchmarkCase(name, IMAGE_TYPE_REMAP, zoomLevel, remapPalette.data(), iterations);
+        snprintf(name, sizeof(name), "Transparent, zoom %u", zoomLevel);
+        sameOutput &= RunBlitBenchmarkCase(name, IMAGE_TYPE_TRANSPARENT, zoomLevel, remapPalette.data(), iterations);
+        snprintf(name, sizeof(name), "Glass, zoom %u", zoomLevel);
+        sameOutput &= RunBlitBenchmarkCase(name, IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT, zoomLevel, glassPalette.data() + 256, iterations);
+    }
+    gfx_rle_sprite_set_blitter(savedBlitter);
+
+    openrct2_dispose();
+    return sameOutput ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+/**
+ * Times drawing every RLE image of g1.dat with each blitter the CPU supports. The blitters must draw the same pixels
+ * as the scalar one.
+ */
+static bool RunBlitBenchmarkCase(const utf8 * name, uint32 imageType, uint8 zoomLevel, uint8 * palette, sint32 iterations)
+{
+    std::vector<uint8> reference;
+    std::vector<uint8> buffer(BLIT_BENCHMARK_SIZE * BLIT_BENCHMARK_SIZE);
+    rct_drawpixelinfo dpi = { 0 };
+    dpi.bits = buffer.data();
+    dpi.width = BLIT_BENCHMARK_SIZE << zoomLevel;
+    dpi.height = BLIT_BENCHMARK_SIZE << zoomLevel;
+    dpi.zoom_level = zoomLevel;
+
+    utf8 times[RLE_BLITTER_COUNT][16];
+    uint32 numMismatches = 0;
+    for (sint32 blitter = RLE_BLITTER_SCALAR; blitter < RLE_BLITTER_COUNT; blitter++)
+    {
+        if (!gfx_rle_sprite_set_blitter(blitter))
+        {
+            String::Set(times[blitter], sizeof(times[blitter]), "-");
+            continue;
+        }
+
+        Stopwatch stopwatch;
+        for (sint32 i = 0; i < iterations; i++)
+        {
+            // Transparent images blend with what is already drawn, so every run starts from the same background
+            for (size_t j = 0; j < buffer.size(); j++)
+            {
+                buffer[j] = (uint8)(j * 13 + (j >> 10));
+            }
+            stopwatch.Start();
+            DrawBlitBenchmarkImages(&dpi, imageType, palette);
+            stopwatch.Stop();
+        }
+        snprintf(times[blitter], sizeof(times[blitter]), "%llu", (unsigned long long)stopwatch.GetElapsedMilliseconds());
+
+        if (blitter == RLE_BLITTER_SCALAR)
+        {
+            reference = buffer;
+        }
+        else if (buffer != reference)
+        {
+            numMismatches++;
+        }
+    }
+
+    Console::WriteLine("%-24s %12s %12s %12s", name, times[RLE_BLITTER_SCALAR], times[RLE_BLITTER_SSE2], times[RLE_BLITTER_AVX2]);
+    if (numMismatches != 0)
+    {
+        Console::Error::WriteLine("%u blitters drew different pixels than the scalar one.", numMismatches);
+    }
+    return numMismatches == 0;
+}
+
+static void DrawBlitBenchmarkImages(rct_drawpixelinfo * dpi, uint32 imageType, uint8 * palette)
+{
+    // Images are spread over a grid, those larger than a cell overlap their neighbours or are clipped at the edges
+    const sint32 cellSize = 128;
+    const sint32 cellsPerRow = BLIT_BENCHMARK_SIZE / cellSize;
+    for (sint32 imageId = 0; imageId < (sint32)g1NumEntries; imageId++)
+    {
+        const rct_g1_element * g1 = gfx_get_g1_element(imageId);
+        if (g1 == nullptr || !(g1->flags & G1_FLAG_RLE_COMPRESSION))
+        {
+            continue;
+        }
+
+        sint32 cell = imageId % (cellsPerRow * cellsPerRow);
+        sint32 x = ((cell % cellsPerRow) * cellSize + cellSize / 2) << dpi->zoom_level;
+        sint32 y = ((cell / cellsPerRow) * cellSize + cellSize / 2) << dpi->zoom_level;
+        gfx_draw_sprite_palette_set_software(dpi, imageType | imageId, x, y, palette, nullptr);
+    }
+}
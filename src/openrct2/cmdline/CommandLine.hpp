@@ -110,4 +110,10 @@ namespace CommandLine
     exitcode_t HandleCommandDefault();
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandBenchmark(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandBenchmarkMap(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandBenchmarkSprites(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandBenchmarkPathfind(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandBenchmarkPaint(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandBenchmarkBlit(CommandLineArgEnumerator * enumerator);
 }
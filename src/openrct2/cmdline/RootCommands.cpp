@@ -125,6 +125,12 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
     DefineCommand("scan-objects", "<path>",             StandardOptions, HandleCommandScanObjects),
+    DefineCommand("benchmark", "<path> [<ticks>]",      StandardOptions, CommandLine::HandleCommandBenchmark),
+    DefineCommand("benchmark-map", "[<operations>]",    StandardOptions, CommandLine::HandleCommandBenchmarkMap),
+    DefineCommand("benchmark-sprites", "<path> [<iterations>]", StandardOptions, CommandLine::HandleCommandBenchmarkSprites),
+    DefineCommand("benchmark-pathfind", "<path> [<iterations>]", StandardOptions, CommandLine::HandleCommandBenchmarkPathfind),
+    DefineCommand("benchmark-paint", "<path> [<iterations>]", StandardOptions, CommandLine::HandleCommandBenchmarkPaint),
+    DefineCommand("benchmark-blit", "[<iterations>]",   StandardOptions, CommandLine::HandleCommandBenchmarkBlit),
 
 #if defined(__WINDOWS__) && !defined(__MINGW32__)
     DefineCommand("register-shell", "", RegisterShellOptions, HandleCommandRegisterShell),
@@ -142,6 +148,12 @@ const CommandLineExample CommandLine::RootExamples[]
     { "./my_park.sv6",                                "open a saved park"                      },
     { "./SnowyPark.sc6",                              "install and open a scenario"            },
     { "./ShuttleLoop.td6",                            "install a track"                        },
+    { "benchmark ./my_park.sv6 10000",                "simulate a park for 10000 ticks"        },
+    { "benchmark-map 1000000",                        "time 1000000 map element edits"         },
+    { "benchmark-sprites ./my_park.sv6 100",          "time 100 rounds of nearby sprite searches" },
+    { "benchmark-pathfind ./my_park.sv6 10",          "time 10 rounds of guest pathfinding"    },
+    { "benchmark-paint ./my_park.sv6 10",             "time 10 rounds of ordering paint structs" },
+    { "benchmark-blit 5",                             "time 5 rounds of drawing the g1.dat sprites" },
 #ifndef DISABLE_HTTP
     { "https://openrct2.website/files/SnowyPark.sv6", "download and open a saved park"         },
 #endif
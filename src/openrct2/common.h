@@ -189,6 +189,13 @@ typedef uint16 rct_string_id;
 #endif
 #define abstract = 0
 
+// Gives every thread its own copy of a global variable
+#ifdef _MSC_VER
+	#define THREAD_LOCAL __declspec(thread)
+#else
+	#define THREAD_LOCAL __thread
+#endif
+
 #if defined(__i386__) || defined(_M_IX86)
 #define PLATFORM_X86
 #else
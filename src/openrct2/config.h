@@ -173,6 +173,10 @@ typedef struct general_configuration {
 	uint8 uncap_fps;
 	uint8 test_unfinished_tracks;
 	uint8 no_test_crashes;
+	uint8 guest_flow_fields;
+	uint8 parallel_vehicle_update;
+	uint8 parallel_paint;
+	uint8 paint_tile_cache;
 	uint8 date_format;
 	uint8 auto_staff_placement;
 	uint8 handymen_mow_default;
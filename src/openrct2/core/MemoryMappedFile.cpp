@@ -0,0 +1,151 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../common.h"
+
+#ifdef __WINDOWS__
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+
+    extern "C" {
+        // Windows needs this for widechar <-> utf8 conversion utils
+        #include "../localisation/language.h"
+    }
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "Memory.hpp"
+#include "MemoryMappedFile.hpp"
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+bool MemoryMappedFile::Contains(const void * ptr) const
+{
+    uintptr_t address = (uintptr_t)ptr;
+    uintptr_t start = (uintptr_t)_data;
+    return _data != nullptr && address >= start && address < start + _length;
+}
+
+#ifdef __WINDOWS__
+
+bool MemoryMappedFile::Open(const std::string &path)
+{
+    Close();
+
+    wchar_t * wPath = utf8_to_widechar(path.c_str());
+    HANDLE hFile = CreateFileW(wPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    Memory::Free(wPath);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0 || (uint64)fileSize.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hMapping == NULL)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    void * data = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    _hFile = hFile;
+    _hMapping = hMapping;
+    _data = data;
+    _length = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+        CloseHandle((HANDLE)_hMapping);
+        CloseHandle((HANDLE)_hFile);
+        _data = nullptr;
+        _hMapping = nullptr;
+        _hFile = nullptr;
+        _length = 0;
+    }
+}
+
+#else
+
+bool MemoryMappedFile::Open(const std::string &path)
+{
+    Close();
+
+    sint32 fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat statInfo;
+    if (fstat(fd, &statInfo) != 0 || statInfo.st_size <= 0 || (uint64)statInfo.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t length = (size_t)statInfo.st_size;
+    void * data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    _fd = fd;
+    _data = data;
+    _length = length;
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (_data != nullptr)
+    {
+        munmap(_data, _length);
+        close(_fd);
+        _data = nullptr;
+        _fd = -1;
+        _length = 0;
+    }
+}
+
+#endif
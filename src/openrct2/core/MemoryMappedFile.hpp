@@ -0,0 +1,58 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <string>
+#include "../common.h"
+
+/**
+ * A read-only view of a whole file mapped into memory.
+ */
+class MemoryMappedFile final
+{
+private:
+    void *  _data = nullptr;
+    size_t  _length = 0;
+#ifdef __WINDOWS__
+    void *  _hFile = nullptr;
+    void *  _hMapping = nullptr;
+#else
+    sint32  _fd = -1;
+#endif
+
+public:
+    MemoryMappedFile() = default;
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile & operator=(const MemoryMappedFile &) = delete;
+    ~MemoryMappedFile();
+
+    bool            IsOpen() const { return _data != nullptr; }
+    const void *    GetData() const { return _data; }
+    size_t          GetLength() const { return _length; }
+
+    /**
+     * Checks whether the given pointer points into the mapped file.
+     */
+    bool Contains(const void * ptr) const;
+
+    /**
+     * Maps the file at the given path, any previously mapped file is closed first.
+     * @returns true if the file was mapped, false if it could not be opened or is empty.
+     */
+    bool Open(const std::string &path);
+    void Close();
+};
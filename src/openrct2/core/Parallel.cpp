@@ -0,0 +1,164 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "Parallel.hpp"
+
+namespace Parallel
+{
+    /**
+     * Threads that wait for work between calls to ForEach, so that a call does not have to start threads.
+     */
+    class WorkerPool final
+    {
+    private:
+        std::vector<std::thread> _threads;
+        std::mutex               _runMutex;
+        std::mutex               _mutex;
+        std::condition_variable  _workAvailable;
+        std::condition_variable  _workDone;
+        bool                     _quit = false;
+
+        // The work of the current call, the first _numThreadsWanted threads take part in it
+        uint64              _serial = 0;
+        uint32              _numThreadsWanted = 0;
+        uint32              _numThreadsBusy = 0;
+        ForCallback         _callback = nullptr;
+        void *              _context = nullptr;
+        size_t              _count = 0;
+        std::atomic<size_t> _nextIndex;
+
+    public:
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _quit = true;
+            }
+            _workAvailable.notify_all();
+            for (auto &thread : _threads)
+            {
+                thread.join();
+            }
+        }
+
+        bool TryRun(size_t count, uint32 numWorkers, ForCallback callback, void * context)
+        {
+            std::unique_lock<std::mutex> runLock(_runMutex, std::try_to_lock);
+            if (!runLock.owns_lock())
+            {
+                return false;
+            }
+
+            uint32 numThreads = numWorkers - 1;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                while (_threads.size() < numThreads)
+                {
+                    uint32 threadIndex = (uint32)_threads.size();
+                    _threads.emplace_back([this, threadIndex]() -> void { ThreadMain(threadIndex); });
+                }
+                _callback = callback;
+                _context = context;
+                _count = count;
+                _nextIndex = 0;
+                _numThreadsWanted = numThreads;
+                _numThreadsBusy = numThreads;
+                _serial++;
+            }
+            _workAvailable.notify_all();
+
+            ProcessItems(0);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workDone.wait(lock, [this]() -> bool { return _numThreadsBusy == 0; });
+            return true;
+        }
+
+    private:
+        void ProcessItems(uint32 worker)
+        {
+            size_t index;
+            while ((index = _nextIndex++) < _count)
+            {
+                _callback(_context, index, worker);
+            }
+        }
+
+        void ThreadMain(uint32 threadIndex)
+        {
+            uint64 lastSerial = 0;
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;)
+            {
+                _workAvailable.wait(lock, [this, threadIndex, lastSerial]() -> bool
+                {
+                    return _quit || (_serial != lastSerial && threadIndex < _numThreadsWanted);
+                });
+                if (_quit)
+                {
+                    return;
+                }
+                lastSerial = _serial;
+
+                lock.unlock();
+                ProcessItems(threadIndex + 1);
+                lock.lock();
+
+                if (--_numThreadsBusy == 0)
+                {
+                    _workDone.notify_one();
+                }
+            }
+        }
+    };
+
+    static WorkerPool _workerPool;
+
+    void ForEach(size_t count, uint32 numWorkers, ForCallback callback, void * context)
+    {
+        if (numWorkers > 1 && count > 1 && _workerPool.TryRun(count, numWorkers, callback, context))
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            callback(context, i, 0);
+        }
+    }
+}
+
+extern "C"
+{
+    #include "parallel.h"
+
+    uint32 parallel_get_num_workers(size_t numItems)
+    {
+        return Parallel::GetNumWorkers(numItems);
+    }
+
+    void parallel_for(size_t count, uint32 numWorkers, parallel_for_func func, void * arg)
+    {
+        Parallel::For(count, numWorkers, [func, arg](size_t index, uint32 worker) -> void
+        {
+            func(index, worker, arg);
+        });
+    }
+}
@@ -0,0 +1,63 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <thread>
+#include "../common.h"
+#include "Math.hpp"
+
+/**
+ * Helpers for spreading independent work items across threads.
+ */
+namespace Parallel
+{
+    /**
+     * Gets the number of threads worth using for the given number of work items.
+     */
+    static uint32 GetNumWorkers(size_t numItems)
+    {
+        uint32 numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0)
+        {
+            numThreads = 1;
+        }
+        return (uint32)Math::Min<size_t>(numThreads, Math::Max<size_t>(numItems, 1));
+    }
+
+    typedef void (* ForCallback)(void * context, size_t index, uint32 worker);
+
+    /**
+     * Calls callback(context, index, worker) for every index in [0, count), see For.
+     */
+    void ForEach(size_t count, uint32 numWorkers, ForCallback callback, void * context);
+
+    /**
+     * Calls func(index, worker) for every index in [0, count) using the given number of workers,
+     * including the calling thread as worker 0. Items are handed out one at a time so that uneven
+     * items balance out. Returns once every item has been processed.
+     * The other workers are threads kept for the lifetime of the process. When they are already busy,
+     * such as for a call from within func, the items are processed on the calling thread alone.
+     */
+    template<typename TFunc>
+    static void For(size_t count, uint32 numWorkers, TFunc func)
+    {
+        ForEach(count, numWorkers, [](void * context, size_t index, uint32 worker) -> void
+        {
+            (*((TFunc *)context))(index, worker);
+        }, &func);
+    }
+}
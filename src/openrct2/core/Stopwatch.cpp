@@ -53,6 +53,20 @@ uint64 Stopwatch::GetElapsedMilliseconds() const
     return (GetElapsedTicks() * 1000) / Frequency;
 }
 
+uint64 Stopwatch::GetElapsedMicroseconds() const
+{
+    if (Frequency == 0)
+    {
+        Frequency = QueryFrequency();
+        if (Frequency == 0)
+        {
+            return 0;
+        }
+    }
+
+    return (GetElapsedTicks() * 1000000) / Frequency;
+}
+
 void Stopwatch::Reset()
 {
     _isRunning = false;
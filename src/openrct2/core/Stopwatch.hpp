@@ -44,6 +44,7 @@ public:
 
     uint64 GetElapsedTicks()        const;
     uint64 GetElapsedMilliseconds() const;
+    uint64 GetElapsedMicroseconds() const;
 
     void Reset();
     void Start();
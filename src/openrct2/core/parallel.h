@@ -0,0 +1,32 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include "../common.h"
+
+////////////////////////////
+// C wrapper for Parallel //
+////////////////////////////
+
+typedef void (*parallel_for_func)(size_t index, uint32 worker, void *arg);
+
+uint32 parallel_get_num_workers(size_t numItems);
+void parallel_for(size_t count, uint32 numWorkers, parallel_for_func func, void *arg);
+
+#endif
@@ -31,6 +31,11 @@ enum DRAWING_ENGINE_FLAGS
      * Whether or not the engine will only draw changed blocks of the screen each frame.
      */
     DEF_DIRTY_OPTIMISATIONS = 1 << 0,
+
+    /**
+     * Whether or not several threads can draw at once, as long as each draws to its own dpi.
+     */
+    DEF_PARALLEL_DRAWING = 1 << 1,
 };
 
 interface IDrawingEngine
@@ -18,6 +18,7 @@
 #include "../interface/window.h"
 #include "../localisation/localisation.h"
 #include "../object.h"
+#include "../paint/paint.h"
 #include "../platform/platform.h"
 #include "../rct2.h"
 #include "../world/water.h"
@@ -47,9 +48,11 @@ rct_drawpixelinfo *unk_140E9A8;
 /**
  * 12 elements from 0xF3 are the peep top colour, 12 elements from 0xCA are peep trouser colour
  *
+ * Written to while drawing remapped sprites, so every thread drawing has its own copy.
+ *
  * rct2: 0x0009ABE0C
  */
-uint8 gPeepPalette[256] = {
+THREAD_LOCAL uint8 gPeepPalette[256] = {
 	0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
 	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
 	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -69,7 +72,7 @@ uint8 gPeepPalette[256] = {
 };
 
 /** rct2: 0x009ABF0C */
-uint8 gOtherPalette[256] = {
+THREAD_LOCAL uint8 gOtherPalette[256] = {
 	0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
 	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
 	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -544,6 +547,7 @@ void load_palette(){
  */
 void gfx_invalidate_screen()
 {
+	paint_cache_invalidate();
 	gfx_set_dirty_blocks(0, 0, gScreenWidth, gScreenHeight);
 }
 
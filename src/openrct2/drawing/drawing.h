@@ -88,6 +88,14 @@ enum {
 	// REMAP_2_PLUS = REMAP 3
 };
 
+// The ways RLE sprites can be drawn, depending on the instruction sets of the CPU
+enum {
+	RLE_BLITTER_SCALAR,
+	RLE_BLITTER_SSE2,
+	RLE_BLITTER_AVX2,
+	RLE_BLITTER_COUNT
+};
+
 enum {
 	INSET_RECT_FLAG_FILL_GREY = (1 << 2), // 0x04
 	INSET_RECT_FLAG_BORDER_NONE = (1 << 3), // 0x08
@@ -257,8 +265,8 @@ extern uint8 gGamePalette[256 * 4];
 extern uint32 gPaletteEffectFrame;
 extern const FILTER_PALETTE_ID GlassPaletteIds[COLOUR_COUNT];
 extern const uint16 palette_to_g1_offset[];
-extern uint8 gPeepPalette[256];
-extern uint8 gOtherPalette[256];
+extern THREAD_LOCAL uint8 gPeepPalette[256];
+extern THREAD_LOCAL uint8 gOtherPalette[256];
 extern uint8 text_palette[];
 extern const translucent_window_palette TranslucentWindowPalettes[COLOUR_COUNT];
 
@@ -270,6 +278,7 @@ extern sint32 gPickupPeepX;
 extern sint32 gPickupPeepY;
 
 extern rct_g1_element *g1Elements;
+extern uint32 g1NumEntries;
 extern rct_gx g2;
 
 extern rct_drawpixelinfo gScreenDPI;
@@ -321,6 +330,9 @@ void gfx_object_free_images(uint32 baseImageId, uint32 count);
 void gfx_object_check_all_images_freed();
 void sub_68371D();
 void FASTCALL gfx_rle_sprite_to_buffer(const uint8* RESTRICT source_bits_pointer, uint8* RESTRICT dest_bits_pointer, const uint8* RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi, sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start, sint32 width);
+void gfx_rle_sprite_init();
+sint32 gfx_rle_sprite_get_blitter();
+bool gfx_rle_sprite_set_blitter(sint32 blitter);
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint32 tertiary_colour);
 void FASTCALL gfx_draw_glpyh(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint8 * palette);
 void FASTCALL gfx_draw_sprite_raw_masked(rct_drawpixelinfo *dpi, sint32 x, sint32 y, sint32 maskImage, sint32 colourImage);
@@ -365,6 +377,8 @@ void ttf_dispose();
 // scrolling text
 void scrolling_text_initialise_bitmaps();
 sint32 scrolling_text_setup(rct_string_id stringId, uint16 scroll, uint16 scrollingMode);
+void scrolling_text_begin_batch();
+bool scrolling_text_batch_overflowed();
 
 void rct2_draw(rct_drawpixelinfo *dpi);
 
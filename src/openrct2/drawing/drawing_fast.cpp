@@ -21,11 +21,284 @@ extern "C"
     #include "drawing.h"
 }
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>
+    #include <immintrin.h>
+    #define OpenRCT2_RLE_SIMD_GNUC
+    #define OpenRCT2_RLE_SIMD
+    #define RLE_TARGET_SSE2 __attribute__((target("sse2")))
+    #define RLE_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #include <immintrin.h>
+    #define OpenRCT2_RLE_SIMD_MSVC
+    #define OpenRCT2_RLE_SIMD
+    #define RLE_TARGET_SSE2
+    #define RLE_TARGET_AVX2
+#endif
+
+// Draws a run of pixels like DrawRLERun, for one image type and zoom level
+typedef void (* RLERunKernel)(const uint8* RESTRICT source_pointer,
+                              uint8* RESTRICT dest_pointer,
+                              const uint8* RESTRICT palette_pointer,
+                              sint32 no_pixels);
+
+// Runs shorter than this are not worth calling a kernel for
+constexpr sint32 RLE_KERNEL_MIN_PIXELS = 16;
+
+static sint32 _rleBlitter = RLE_BLITTER_SCALAR;
+
 // This will have -1 (0xffffffff) for (val <= 0), 0 otherwise, so it can act as a mask
 // This is expected to generate
 //     sar eax, 0x1f (arithmetic shift right by 31)
 #define less_or_equal_zero_mask(val) (((val - 1) >> (sizeof(val) * 8 - 1)))
 
+/**
+ * Draws one run of pixels of an RLE sprite, every 1 << zoom_level'th source pixel to the next destination pixel.
+ */
+template<sint32 image_type, sint32 zoom_level>
+static inline void DrawRLERun(const uint8* RESTRICT source_pointer,
+                              uint8* RESTRICT dest_pointer,
+                              const uint8* RESTRICT palette_pointer,
+                              sint32 no_pixels)
+{
+    sint32 zoom_amount = 1 << zoom_level;
+
+    //If the image type is not a basic one we require to mix the pixels
+    if (image_type & IMAGE_TYPE_REMAP) {//In the .exe these are all unraveled loops
+        for (; no_pixels > 0; no_pixels -= zoom_amount, source_pointer += zoom_amount, dest_pointer++) {
+            uint8 al = *source_pointer;
+            uint8 ah = *dest_pointer;
+            if (image_type & IMAGE_TYPE_TRANSPARENT)
+                al = palette_pointer[(((uint16)al << 8) | ah) - 0x100];
+            else
+                al = palette_pointer[al];
+            *dest_pointer = al;
+        }
+    } else if (image_type & IMAGE_TYPE_TRANSPARENT) {//In the .exe these are all unraveled loops
+        //Doesn't use source pointer ??? mix with background only?
+        //Not Tested
+
+        for (; no_pixels > 0; no_pixels -= zoom_amount, dest_pointer++) {
+            uint8 pixel = *dest_pointer;
+            pixel = palette_pointer[pixel];
+            *dest_pointer = pixel;
+        }
+    } else
+    {
+        if (zoom_amount == 1) {
+            no_pixels &= ~less_or_equal_zero_mask(no_pixels);
+            memcpy(dest_pointer, source_pointer, no_pixels);
+        } else {
+            for (; no_pixels > 0; no_pixels -= zoom_amount, source_pointer += zoom_amount, dest_pointer++) {
+                *dest_pointer = *source_pointer;
+            }
+        }
+    }
+}
+
+#ifdef OpenRCT2_RLE_SIMD
+
+/**
+ * Copies every 1 << zoom_level'th pixel of a run by packing the bytes of 16 byte loads, zoom level 0 runs are copied
+ * with memcpy instead.
+ */
+template<sint32 zoom_level>
+RLE_TARGET_SSE2
+static void DrawRLERunCopySSE2(const uint8* RESTRICT source_pointer,
+                               uint8* RESTRICT dest_pointer,
+                               const uint8* RESTRICT palette_pointer,
+                               sint32 no_pixels)
+{
+    static_assert(zoom_level >= 1 && zoom_level <= 3, "Zoom level 0 runs are copied with memcpy");
+
+    // Only load whole blocks within the run, the source of the last run of a sprite may end at the end of g1.dat
+    const sint32 block_pixels = (zoom_level == 1) ? 32 : 64;
+    while (no_pixels >= block_pixels) {
+        const __m128i * source = (const __m128i *)source_pointer;
+        if (zoom_level == 1) {
+            const __m128i mask = _mm_set1_epi16(0xFF);
+            __m128i a = _mm_and_si128(_mm_loadu_si128(source + 0), mask);
+            __m128i b = _mm_and_si128(_mm_loadu_si128(source + 1), mask);
+            _mm_storeu_si128((__m128i *)dest_pointer, _mm_packus_epi16(a, b));
+            dest_pointer += 16;
+        } else if (zoom_level == 2) {
+            const __m128i mask = _mm_set1_epi32(0xFF);
+            __m128i ab = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128(source + 0), mask), _mm_and_si128(_mm_loadu_si128(source + 1), mask));
+            __m128i cd = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128(source + 2), mask), _mm_and_si128(_mm_loadu_si128(source + 3), mask));
+            _mm_storeu_si128((__m128i *)dest_pointer, _mm_packus_epi16(ab, cd));
+            dest_pointer += 16;
+        } else {
+            // The pixels are in the low byte of every 64 bit lane, which is also the low word of every other 32 bit lane
+            const __m128i mask = _mm_set_epi32(0, 0xFF, 0, 0xFF);
+            __m128i ab = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128(source + 0), mask), _mm_and_si128(_mm_loadu_si128(source + 1), mask));
+            __m128i cd = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128(source + 2), mask), _mm_and_si128(_mm_loadu_si128(source + 3), mask));
+            __m128i abcd = _mm_packs_epi32(ab, cd);
+            _mm_storel_epi64((__m128i *)dest_pointer, _mm_packus_epi16(abcd, abcd));
+            dest_pointer += 8;
+        }
+        source_pointer += block_pixels;
+        no_pixels -= block_pixels;
+    }
+    DrawRLERun<IMAGE_TYPE_DEFAULT, zoom_level>(source_pointer, dest_pointer, palette_pointer, no_pixels);
+}
+
+/**
+ * Loads 8 source pixels, every 1 << zoom_level'th one, into 32 bit lanes. Reads no more than the 8 << zoom_level source
+ * pixels they are drawn from.
+ */
+template<sint32 zoom_level>
+RLE_TARGET_AVX2
+static inline __m256i LoadRLERunSourceAVX2(const uint8* source_pointer)
+{
+    if (zoom_level == 0) {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)source_pointer));
+    } else if (zoom_level == 1) {
+        __m128i pixels = _mm_and_si128(_mm_loadu_si128((const __m128i *)source_pointer), _mm_set1_epi16(0xFF));
+        return _mm256_cvtepu16_epi32(pixels);
+    } else if (zoom_level == 2) {
+        __m256i pixels = _mm256_loadu_si256((const __m256i *)source_pointer);
+        return _mm256_and_si256(pixels, _mm256_set1_epi32(0xFF));
+    } else {
+        // The pixels are in the low dword of every 64 bit lane of two loads, which are moved into one register
+        const __m256i mask = _mm256_set1_epi64x(0xFF);
+        __m256i a = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)source_pointer), mask);
+        __m256i b = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)source_pointer + 1), mask);
+        a = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+        b = _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+        return _mm256_blend_epi32(a, b, 0xF0);
+    }
+}
+
+/**
+ * Looks up 8 palette entries with indices in 32 bit lanes. The dword ending at each entry is gathered so that nothing
+ * past the entry is read, the first three entries are taken from first_entries instead.
+ */
+RLE_TARGET_AVX2
+static inline __m256i LookUpRLEPaletteAVX2(const uint8* palette_pointer, __m256i first_entries, __m256i indices)
+{
+    __m256i gatherMask = _mm256_cmpgt_epi32(indices, _mm256_set1_epi32(2));
+    __m256i entries = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)palette_pointer,
+                                                  _mm256_sub_epi32(indices, _mm256_set1_epi32(3)), gatherMask, 1);
+    __m256i firstEntries = _mm256_permutevar8x32_epi32(first_entries, indices);
+    return _mm256_blendv_epi8(firstEntries, _mm256_srli_epi32(entries, 24), gatherMask);
+}
+
+RLE_TARGET_AVX2
+static inline void StoreRLERunPixelsAVX2(uint8* dest_pointer, __m256i colours)
+{
+    __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(colours), _mm256_extracti128_si256(colours, 1));
+    _mm_storel_epi64((__m128i *)dest_pointer, _mm_packus_epi16(words, words));
+}
+
+/**
+ * Remaps or blends 8 pixels at a time with gathers from the palette.
+ */
+template<sint32 image_type, sint32 zoom_level>
+RLE_TARGET_AVX2
+static void DrawRLERunPaletteAVX2(const uint8* RESTRICT source_pointer,
+                                  uint8* RESTRICT dest_pointer,
+                                  const uint8* RESTRICT palette_pointer,
+                                  sint32 no_pixels)
+{
+    const sint32 block_pixels = 8 << zoom_level;
+    const __m256i first_entries = _mm256_setr_epi32(palette_pointer[0], palette_pointer[1], palette_pointer[2], 0, 0, 0, 0, 0);
+    for (; no_pixels >= block_pixels; no_pixels -= block_pixels, source_pointer += block_pixels, dest_pointer += 8) {
+        __m256i indices;
+        if (image_type & IMAGE_TYPE_REMAP) {
+            indices = LoadRLERunSourceAVX2<zoom_level>(source_pointer);
+            if (image_type & IMAGE_TYPE_TRANSPARENT) {
+                __m256i background = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)dest_pointer));
+                indices = _mm256_sub_epi32(_mm256_or_si256(_mm256_slli_epi32(indices, 8), background), _mm256_set1_epi32(0x100));
+
+                // Pixels of colour 0 blend with the bytes before the palette
+                if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(_mm256_setzero_si256(), indices)) != 0) {
+                    DrawRLERun<image_type, zoom_level>(source_pointer, dest_pointer, palette_pointer, block_pixels);
+                    continue;
+                }
+            }
+        } else {
+            indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)dest_pointer));
+        }
+        StoreRLERunPixelsAVX2(dest_pointer, LookUpRLEPaletteAVX2(palette_pointer, first_entries, indices));
+    }
+    DrawRLERun<image_type, zoom_level>(source_pointer, dest_pointer, palette_pointer, no_pixels);
+}
+
+// The kernels of each blitter, by image type (remap and transparent bits) and zoom level, nullptr where the scalar loop
+// is used. The gathers only beat it where every source pixel is drawn or the background is blended with.
+static const RLERunKernel RLERunKernels[RLE_BLITTER_COUNT][4][4] =
+{
+    // RLE_BLITTER_SCALAR
+    { { nullptr } },
+    // RLE_BLITTER_SSE2, palette lookups need a gather to be vectorised
+    {
+        { nullptr, DrawRLERunCopySSE2<1>, DrawRLERunCopySSE2<2>, DrawRLERunCopySSE2<3> },
+    },
+    // RLE_BLITTER_AVX2
+    {
+        { nullptr, DrawRLERunCopySSE2<1>, DrawRLERunCopySSE2<2>, DrawRLERunCopySSE2<3> },
+        { DrawRLERunPaletteAVX2<IMAGE_TYPE_REMAP, 0>, nullptr, nullptr, nullptr },
+        { DrawRLERunPaletteAVX2<IMAGE_TYPE_TRANSPARENT, 0>, DrawRLERunPaletteAVX2<IMAGE_TYPE_TRANSPARENT, 1>, nullptr, nullptr },
+        { DrawRLERunPaletteAVX2<IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT, 0>, DrawRLERunPaletteAVX2<IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT, 1>, nullptr, nullptr },
+    },
+};
+
+static void GetCpuid(uint32 leaf, uint32 subleaf, uint32 regs[4])
+{
+#if defined(OpenRCT2_RLE_SIMD_GNUC)
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#else
+    __cpuidex((int *)regs, leaf, subleaf);
+#endif
+}
+
+static bool IsRLEBlitterSupported(sint32 blitter)
+{
+    uint32 regs[4];
+    GetCpuid(0, 0, regs);
+    uint32 maxLeaf = regs[0];
+    GetCpuid(1, 0, regs);
+
+    switch (blitter) {
+    case RLE_BLITTER_SCALAR:
+        return true;
+    case RLE_BLITTER_SSE2:
+        // SSE2 is declared as the 26th bit of EDX with CPUID(EAX = 1)
+        return (regs[3] & (1 << 26)) != 0;
+    case RLE_BLITTER_AVX2:
+    {
+        // The OS has to save the AVX registers (OSXSAVE and the XMM and YMM state in XCR0)
+        if (!(regs[2] & (1 << 27)) || maxLeaf < 7) {
+            return false;
+        }
+#if defined(OpenRCT2_RLE_SIMD_GNUC)
+        uint32 xcr0Low, xcr0High;
+        asm volatile ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+#else
+        uint32 xcr0Low = (uint32)_xgetbv(0);
+#endif
+        if ((xcr0Low & 6) != 6) {
+            return false;
+        }
+        // AVX2 is declared as the 5th bit of EBX with CPUID(EAX = 7, ECX = 0)
+        GetCpuid(7, 0, regs);
+        return (regs[1] & (1 << 5)) != 0;
+    }
+    default:
+        return false;
+    }
+}
+
+#else
+
+static bool IsRLEBlitterSupported(sint32 blitter)
+{
+    return blitter == RLE_BLITTER_SCALAR;
+}
+
+#endif // OpenRCT2_RLE_SIMD
+
 template<sint32 image_type, sint32 zoom_level>
 static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
                                       uint8* RESTRICT dest_bits_pointer,
@@ -34,7 +307,8 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
                                       sint32 source_y_start,
                                       sint32 height,
                                       sint32 source_x_start,
-                                      sint32 width)
+                                      sint32 width,
+                                      RLERunKernel run_kernel)
 {
     sint32 zoom_amount = 1 << zoom_level;
     sint32 zoom_mask = 0xFFFFFFFF << zoom_level;
@@ -105,43 +379,17 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
             no_pixels -= pixels_till_end & ~(less_or_equal_zero_mask(pixels_till_end));
 
             //Finally after all those checks, copy the image onto the drawing surface
-            //If the image type is not a basic one we require to mix the pixels
-            if (image_type & IMAGE_TYPE_REMAP) {//In the .exe these are all unraveled loops
-                for (; no_pixels > 0; no_pixels -= zoom_amount, source_pointer += zoom_amount, dest_pointer++) {
-                    uint8 al = *source_pointer;
-                    uint8 ah = *dest_pointer;
-                    if (image_type & IMAGE_TYPE_TRANSPARENT)
-                        al = palette_pointer[(((uint16)al << 8) | ah) - 0x100];
-                    else
-                        al = palette_pointer[al];
-                    *dest_pointer = al;
-                }
-            } else if (image_type & IMAGE_TYPE_TRANSPARENT) {//In the .exe these are all unraveled loops
-                //Doesn't use source pointer ??? mix with background only?
-                //Not Tested
-
-                for (; no_pixels > 0; no_pixels -= zoom_amount, dest_pointer++) {
-                    uint8 pixel = *dest_pointer;
-                    pixel = palette_pointer[pixel];
-                    *dest_pointer = pixel;
-                }
-            } else
-            {
-                if (zoom_amount == 1) {
-                    no_pixels &= ~less_or_equal_zero_mask(no_pixels);
-                    memcpy(dest_pointer, source_pointer, no_pixels);
-                } else {
-                    for (; no_pixels > 0; no_pixels -= zoom_amount, source_pointer += zoom_amount, dest_pointer++) {
-                        *dest_pointer = *source_pointer;
-                    }
-                }
+            if (run_kernel != nullptr && no_pixels >= RLE_KERNEL_MIN_PIXELS) {
+                run_kernel(source_pointer, dest_pointer, palette_pointer, no_pixels);
+            } else {
+                DrawRLERun<image_type, zoom_level>(source_pointer, dest_pointer, palette_pointer, no_pixels);
             }
         }
     }
 }
 
 #define DrawRLESpriteHelper2(image_type, zoom_level) \
-    DrawRLESprite2<image_type, zoom_level>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width)
+    DrawRLESprite2<image_type, zoom_level>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width, run_kernels[zoom_level])
 
 template<sint32 image_type>
 static void FASTCALL DrawRLESprite1(const uint8* source_bits_pointer,
@@ -151,7 +399,8 @@ static void FASTCALL DrawRLESprite1(const uint8* source_bits_pointer,
                                       sint32 source_y_start,
                                       sint32 height,
                                       sint32 source_x_start,
-                                      sint32 width)
+                                      sint32 width,
+                                      const RLERunKernel run_kernels[4])
 {
     sint32 zoom_level = dpi->zoom_level;
     switch (zoom_level) {
@@ -164,7 +413,7 @@ static void FASTCALL DrawRLESprite1(const uint8* source_bits_pointer,
 }
 
 #define DrawRLESpriteHelper1(image_type) \
-    DrawRLESprite1<image_type>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width)
+    DrawRLESprite1<image_type>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width, run_kernels)
 
 extern "C"
 {
@@ -183,6 +432,12 @@ extern "C"
                                              sint32 source_x_start,
                                              sint32 width)
     {
+#ifdef OpenRCT2_RLE_SIMD
+        const RLERunKernel * run_kernels = RLERunKernels[_rleBlitter][((uint32)image_type >> 29) & 3];
+#else
+        static const RLERunKernel run_kernels[4] = { nullptr };
+#endif
+
         if (image_type & IMAGE_TYPE_REMAP)
         {
             if (image_type & IMAGE_TYPE_TRANSPARENT)
@@ -203,4 +458,39 @@ extern "C"
             DrawRLESpriteHelper1(IMAGE_TYPE_DEFAULT);
         }
     }
+
+    /**
+     * Picks the fastest way of drawing RLE sprites the CPU supports.
+     */
+    void gfx_rle_sprite_init()
+    {
+        _rleBlitter = RLE_BLITTER_SCALAR;
+        for (sint32 blitter = RLE_BLITTER_COUNT - 1; blitter > RLE_BLITTER_SCALAR; blitter--)
+        {
+            if (IsRLEBlitterSupported(blitter))
+            {
+                _rleBlitter = blitter;
+                break;
+            }
+        }
+    }
+
+    sint32 gfx_rle_sprite_get_blitter()
+    {
+        return _rleBlitter;
+    }
+
+    /**
+     * Draws RLE sprites with the given blitter from now on, all blitters draw exactly the same pixels.
+     * @return false when the CPU does not support the blitter
+     */
+    bool gfx_rle_sprite_set_blitter(sint32 blitter)
+    {
+        if (blitter < 0 || blitter >= RLE_BLITTER_COUNT || !IsRLEBlitterSupported(blitter))
+        {
+            return false;
+        }
+        _rleBlitter = blitter;
+        return true;
+    }
 }
@@ -162,7 +162,9 @@ class SoftwareDrawingContext final : public IDrawingContext
 {
 private:
     SoftwareDrawingEngine * _engine;
-    rct_drawpixelinfo *     _dpi;
+
+    // Each thread drawing with the context sets its own dpi
+    static THREAD_LOCAL rct_drawpixelinfo * _dpi;
 
 public:
     explicit SoftwareDrawingContext(SoftwareDrawingEngine * engine);
@@ -469,7 +471,7 @@ public:
 
     DRAWING_ENGINE_FLAGS GetFlags() override
     {
-        return DEF_DIRTY_OPTIMISATIONS;
+        return (DRAWING_ENGINE_FLAGS)(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING);
     }
 
     void InvalidateImage(uint32 image) override
@@ -814,6 +816,8 @@ IDrawingEngine * DrawingEngineFactory::CreateSoftwareWithHardwareDisplay()
     return new SoftwareDrawingEngine(true);
 }
 
+THREAD_LOCAL rct_drawpixelinfo * SoftwareDrawingContext::_dpi = nullptr;
+
 SoftwareDrawingContext::SoftwareDrawingContext(SoftwareDrawingEngine * engine)
 {
     _engine = engine;
@@ -18,6 +18,7 @@
 #include "../config.h"
 #include "../interface/colour.h"
 #include "../localisation/localisation.h"
+#include "../paint/paint.h"
 #include "../sprites.h"
 #include "drawing.h"
 
@@ -41,6 +42,11 @@ static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
 static uint8 _characterBitmaps[224 * 8];
 static uint32 _drawSCrollNextIndex = 0;
 
+// Entries used by the batch of viewport columns not drawn yet are only replaced when every entry is
+static uint32 _drawScrollTextBatches[MAX_SCROLLING_TEXT_ENTRIES];
+static uint32 _drawScrollCurrentBatch = 1;
+static bool _drawScrollBatchOverflowed;
+
 void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
 void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
 
@@ -94,15 +100,41 @@ static uint8 *font_sprite_get_codepoint_bitmap(sint32 codepoint)
 }
 
 
+/**
+ * Starts a new batch of viewport columns. The scrolling text of the columns painted from now on is kept until the next
+ * batch, so they can all be drawn after painting them.
+ */
+void scrolling_text_begin_batch()
+{
+	_drawScrollCurrentBatch++;
+	_drawScrollBatchOverflowed = false;
+}
+
+/**
+ * Returns whether the scrolling text of the current batch did not fit, in which case some of its columns would draw
+ * another column's text.
+ */
+bool scrolling_text_batch_overflowed()
+{
+	return _drawScrollBatchOverflowed;
+}
+
 static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint16 scroll, uint16 scrollingMode)
 {
 	uint32 oldestId = 0xFFFFFFFF;
 	sint32 scrollIndex = -1;
+	uint32 oldestBatchId = 0xFFFFFFFF;
+	sint32 oldestBatchIndex = -1;
 	for (sint32 i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++) {
 		rct_draw_scroll_text *scrollText = &_drawScrollTextList[i];
-		if (oldestId >= scrollText->id) {
-			oldestId = scrollText->id;
-			scrollIndex = i;
+		if (_drawScrollTextBatches[i] != _drawScrollCurrentBatch) {
+			if (oldestId >= scrollText->id) {
+				oldestId = scrollText->id;
+				scrollIndex = i;
+			}
+		} else if (oldestBatchId >= scrollText->id) {
+			oldestBatchId = scrollText->id;
+			oldestBatchIndex = i;
 		}
 
 		// If exact match return the matching index
@@ -117,9 +149,16 @@ static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint
 			scrollText->mode == scrollingMode
 		) {
 			scrollText->id = _drawSCrollNextIndex;
+			_drawScrollTextBatches[i] = _drawScrollCurrentBatch;
 			return i + SPR_SCROLLING_TEXT_START;
 		}
 	}
+
+	if (scrollIndex == -1) {
+		_drawScrollBatchOverflowed = true;
+		scrollIndex = oldestBatchIndex;
+	}
+	_drawScrollTextBatches[scrollIndex] = _drawScrollCurrentBatch;
 	return scrollIndex;
 }
 
@@ -1422,6 +1461,9 @@ sint32 scrolling_text_setup(rct_string_id stringId, uint16 scroll, uint16 scroll
 
 	if (dpi->zoom_level != 0) return SPR_SCROLLING_TEXT_DEFAULT;
 
+	// The text scrolls every tick, and the sprite it is drawn to is only valid for this frame
+	paint_cache_disallow();
+
 	_drawSCrollNextIndex++;
 
 	sint32 scrollIndex = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode);
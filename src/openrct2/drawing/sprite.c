@@ -30,6 +30,8 @@ rct_gx g2;
 #else
 	rct_g1_element *g1Elements = RCT2_ADDRESS(RCT2_ADDRESS_G1_ELEMENTS, rct_g1_element);
 #endif
+// The number of g1 elements that have been loaded
+uint32 g1NumEntries = 0;
 
 static const uint32 fadeSprites[] = {
 	SPR_NONE,
@@ -95,6 +97,7 @@ bool gfx_load_g1()
 			// Fix entry data offsets
 			for (uint32 i = 0; i < header.num_entries; i++)
 				g1Elements[i].offset += (uintptr_t)_g1Buffer;
+			g1NumEntries = header.num_entries;
 
 			return true;
 		}
@@ -111,6 +114,7 @@ bool gfx_load_g1()
 void gfx_unload_g1()
 {
 	SafeFree(_g1Buffer);
+	g1NumEntries = 0;
 #ifdef NO_RCT2
 	SafeFree(g1Elements);
 #endif
@@ -35,6 +35,7 @@
 #include "peep/peep.h"
 #include "peep/staff.h"
 #include "platform/platform.h"
+#include "Profiler.h"
 #include "rct1.h"
 #include "ride/ride.h"
 #include "ride/ride_ratings.h"
@@ -380,23 +381,48 @@ void game_logic_update()
 	if (gScreenAge == 0)
 		gScreenAge--;
 
-	sub_68B089();
+	profiler_begin(PROFILER_SECTION_SCENARIO);
 	scenario_update();
+	profiler_end(PROFILER_SECTION_SCENARIO);
+	profiler_begin(PROFILER_SECTION_CLIMATE);
 	climate_update();
+	profiler_end(PROFILER_SECTION_CLIMATE);
+	profiler_begin(PROFILER_SECTION_MAP_TILES);
 	map_update_tiles();
+	profiler_end(PROFILER_SECTION_MAP_TILES);
 	// Temporarily remove provisional paths to prevent peep from interacting with them
 	map_remove_provisional_elements();
+	profiler_begin(PROFILER_SECTION_PATH_WIDE_FLAGS);
 	map_update_path_wide_flags();
+	profiler_end(PROFILER_SECTION_PATH_WIDE_FLAGS);
+	profiler_begin(PROFILER_SECTION_PEEPS);
 	peep_update_all();
+	profiler_end(PROFILER_SECTION_PEEPS);
 	map_restore_provisional_elements();
+	profiler_begin(PROFILER_SECTION_VEHICLES);
 	vehicle_update_all();
+	profiler_end(PROFILER_SECTION_VEHICLES);
+	profiler_begin(PROFILER_SECTION_MISC_SPRITES);
 	sprite_misc_update_all();
+	profiler_end(PROFILER_SECTION_MISC_SPRITES);
+	profiler_begin(PROFILER_SECTION_RIDES);
 	ride_update_all();
+	profiler_end(PROFILER_SECTION_RIDES);
+	profiler_begin(PROFILER_SECTION_PARK);
 	park_update();
+	profiler_end(PROFILER_SECTION_PARK);
+	profiler_begin(PROFILER_SECTION_RESEARCH);
 	research_update();
+	profiler_end(PROFILER_SECTION_RESEARCH);
+	profiler_begin(PROFILER_SECTION_RIDE_RATINGS);
 	ride_ratings_update_all();
+	profiler_end(PROFILER_SECTION_RIDE_RATINGS);
+	profiler_begin(PROFILER_SECTION_RIDE_MEASUREMENTS);
 	ride_measurements_update();
+	profiler_end(PROFILER_SECTION_RIDE_MEASUREMENTS);
+	profiler_begin(PROFILER_SECTION_NEWS);
 	news_item_update_current();
+	profiler_end(PROFILER_SECTION_NEWS);
 	///////////////////////////
 	gInUpdateCode = false;
 	///////////////////////////
@@ -909,6 +935,8 @@ void game_load_init()
 	if (network_get_mode() != NETWORK_MODE_CLIENT)
 	{
 		reset_sprite_spatial_index();
+		// Rather than waiting for each ride's turn to come round again
+		ride_ratings_calculate_all();
 	}
 	reset_all_sprite_quadrant_placements();
 	scenery_set_default_placement_configuration();
@@ -30,6 +30,8 @@
 #include "../object.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../paint/paint.h"
+#include "../peep/peep_needs.h"
 #include "../peep/staff.h"
 #include "../platform/platform.h"
 #include "../rct2.h"
@@ -519,7 +521,7 @@ static sint32 cc_staff(const utf8 **argv, sint32 argc)
 			FOR_ALL_STAFF(i, peep) {
 				char name[128];
 				format_string(name, 128, peep->name_string_idx, &peep->id);
-				console_printf("staff id %03d type: %02u energy %03u name %s", i, peep->staff_type, peep->energy, name);
+				console_printf("staff id %03d type: %02u energy %03u name %s", i, peep->staff_type, PEEP_NEED(peep, energy), name);
 			}
 		} else if (strcmp(argv[0], "set") == 0) {
 			if (argc < 4) {
@@ -544,8 +546,8 @@ static sint32 cc_staff(const utf8 **argv, sint32 argc)
 				if (int_valid[0] && int_valid[1] && ((GET_PEEP(int_val[0])) != NULL)) {
 					rct_peep *peep = GET_PEEP(int_val[0]);
 
-					peep->energy = int_val[1];
-					peep->energy_growth_rate = int_val[1];
+					PEEP_NEED(peep, energy) = int_val[1];
+					PEEP_NEED(peep, energy_growth_rate) = int_val[1];
 				}
 			} else if (strcmp(argv[1], "costume") == 0) {
 				sint32 int_val[2];
@@ -672,6 +674,18 @@ static sint32 cc_get(const utf8 **argv, sint32 argc)
 		else if (strcmp(argv[0], "no_test_crashes") == 0) {
 			console_printf("no_test_crashes %d", gConfigGeneral.no_test_crashes);
 		}
+		else if (strcmp(argv[0], "guest_flow_fields") == 0) {
+			console_printf("guest_flow_fields %d", gConfigGeneral.guest_flow_fields);
+		}
+		else if (strcmp(argv[0], "parallel_vehicle_update") == 0) {
+			console_printf("parallel_vehicle_update %d", gConfigGeneral.parallel_vehicle_update);
+		}
+		else if (strcmp(argv[0], "parallel_paint") == 0) {
+			console_printf("parallel_paint %d", gConfigGeneral.parallel_paint);
+		}
+		else if (strcmp(argv[0], "paint_tile_cache") == 0) {
+			console_printf("paint_tile_cache %d", gConfigGeneral.paint_tile_cache);
+		}
 		else if (strcmp(argv[0], "location") == 0) {
 			rct_window *w = window_get_main();
 			if (w != NULL) {
@@ -873,6 +887,26 @@ static sint32 cc_set(const utf8 **argv, sint32 argc)
 			config_save_default();
 			console_execute_silent("get no_test_crashes");
 		}
+		else if (strcmp(argv[0], "guest_flow_fields") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+			gConfigGeneral.guest_flow_fields = (int_val[0] != 0);
+			config_save_default();
+			console_execute_silent("get guest_flow_fields");
+		}
+		else if (strcmp(argv[0], "parallel_vehicle_update") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+			gConfigGeneral.parallel_vehicle_update = (int_val[0] != 0);
+			config_save_default();
+			console_execute_silent("get parallel_vehicle_update");
+		}
+		else if (strcmp(argv[0], "parallel_paint") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+			gConfigGeneral.parallel_paint = (int_val[0] != 0);
+			config_save_default();
+			console_execute_silent("get parallel_paint");
+		}
+		else if (strcmp(argv[0], "paint_tile_cache") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+			gConfigGeneral.paint_tile_cache = (int_val[0] != 0);
+			config_save_default();
+			console_execute_silent("get paint_tile_cache");
+		}
 		else if (strcmp(argv[0], "location") == 0 && invalidArguments(&invalidArgs, int_valid[0] && int_valid[1])) {
 			rct_window *w = window_get_main();
 			if (w != NULL) {
@@ -1051,6 +1085,19 @@ static sint32 cc_object_count(const utf8 **argv, sint32 argc) {
 	return 0;
 }
 
+static sint32 cc_paint_structs(const utf8 **argv, sint32 argc)
+{
+	if (argc > 0 && strcmp(argv[0], "reset") == 0) {
+		paint_reset_entry_stats();
+	}
+
+	uint32 highWaterMark, numChunks;
+	paint_get_entry_stats(&highWaterMark, &numChunks);
+	console_printf("Most paint structs in a column: %u", highWaterMark);
+	console_printf("Chunks allocated: %u (%u KiB)", numChunks, (uint32)(numChunks * sizeof(paint_entry_chunk) / 1024));
+	return 0;
+}
+
 static sint32 cc_reset_user_strings(const utf8 **argv, sint32 argc)
 {
 	reset_user_strings();
@@ -1127,6 +1174,10 @@ utf8* console_variable_table[] = {
 	"console_small_font",
 	"test_unfinished_tracks",
 	"no_test_crashes",
+	"guest_flow_fields",
+	"parallel_vehicle_update",
+	"parallel_paint",
+	"paint_tile_cache",
 	"location",
 	"window_scale",
 	"window_limit",
@@ -1160,6 +1211,7 @@ console_command console_command_table[] = {
 									"This is a safer method opposed to \"open object_selection\".",
 									"load_object <objectfilenodat>" },
 	{ "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
+	{ "paint_structs", cc_paint_structs, "Shows the most paint structs a viewport column has used and the memory kept for them.", "paint_structs [reset]" },
 	{ "twitch", cc_twitch, "Twitch API" },
 	{ "reset_user_strings", cc_reset_user_strings, "Resets all user-defined strings, to fix incorrectly occurring 'Chosen name in use already' errors.", "reset_user_strings" },
 	{ "fix_banner_count", cc_fix_banner_count, "Fixes incorrectly appearing 'Too many banners' error by marking every banner entry without a map element as null.", "fix_banner_count" },
@@ -15,13 +15,16 @@
 #pragma endregion
 
 #include "../config.h"
+#include "../core/parallel.h"
 #include "../drawing/drawing.h"
+#include "../drawing/NewDrawing.h"
 #include "../game.h"
 #include "../input.h"
 #include "../localisation/localisation.h"
 #include "../paint/paint.h"
 #include "../paint/supports.h"
 #include "../peep/staff.h"
+#include "../Profiler.h"
 #include "../rct2.h"
 #include "../ride/ride_data.h"
 #include "../ride/track_data.h"
@@ -53,7 +56,6 @@ uint8 gSavedViewZoom;
 uint8 gSavedViewRotation;
 
 #ifdef NO_RCT2
-paint_entry *gNextFreePaintStruct;
 uint8 gCurrentRotation;
 uint32 gCurrentViewportFlags = 0;
 #endif
@@ -69,7 +71,13 @@ static sint16 _unk9AC14E;
 static uint16 _unk9AC154;
 static sint16 _unk9ABDAE;
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
+// Columns generated before drawing any of them when columns are drawn in parallel
+#define VIEWPORT_PAINT_MAX_BATCH_COLUMNS 16
+
+static void viewport_generate_column(paint_session * session, const rct_drawpixelinfo * dpi, uint32 viewFlags);
+static void viewport_draw_batch(const rct_drawpixelinfo * columnDpis, size_t numColumns, uint32 viewFlags);
+static void viewport_draw_columns(size_t numColumns, uint32 viewFlags);
+static void viewport_draw_column(size_t index, uint32 worker, void *arg);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
 /**
@@ -703,7 +711,19 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
 	dpi1.pitch = (dpi->width + dpi->pitch) - (width >> viewport->zoom);
 	dpi1.zoom_level = viewport->zoom;
 
+	profiler_begin(PROFILER_SECTION_VIEWPORT_PAINT);
+
+	// The paint setup functions share global state, so columns are always generated on this thread, but the drawing
+	// engine may allow a batch of generated columns to be drawn at once
+	size_t maxBatchColumns = 1;
+	if (gConfigGeneral.parallel_paint && drawing_engine_has_parallel_drawing()) {
+		maxBatchColumns = VIEWPORT_PAINT_MAX_BATCH_COLUMNS;
+	}
+
 	// Splits the area into 32 pixel columns and renders them
+	rct_drawpixelinfo columnDpis[VIEWPORT_PAINT_MAX_BATCH_COLUMNS];
+	size_t numColumns = 0;
+	scrolling_text_begin_batch();
 	for (x = floor2(dpi1.x, 32); x < dpi1.x + dpi1.width; x += 32) {
 		rct_drawpixelinfo dpi2 = dpi1;
 		if (x >= dpi2.x) {
@@ -722,35 +742,105 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
 		}
 		dpi2.width = paintRight - dpi2.x;
 
-		viewport_paint_column(&dpi2, viewFlags);
+		paint_session * session = paint_session_get(numColumns);
+		if (session == NULL) {
+			// There is no session for another column, so the batch is drawn early
+			viewport_draw_batch(columnDpis, numColumns, viewFlags);
+			numColumns = 0;
+			session = paint_session_get(0);
+		}
+
+		columnDpis[numColumns] = dpi2;
+		viewport_generate_column(session, &dpi2, viewFlags);
+		numColumns++;
+		if (numColumns == maxBatchColumns || scrolling_text_batch_overflowed()) {
+			viewport_draw_batch(columnDpis, numColumns, viewFlags);
+			numColumns = 0;
+		}
 	}
+	if (numColumns != 0) {
+		viewport_draw_batch(columnDpis, numColumns, viewFlags);
+	}
+
+	profiler_end(PROFILER_SECTION_VIEWPORT_PAINT);
 }
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+static void viewport_generate_column(paint_session * session, const rct_drawpixelinfo * dpi, uint32 viewFlags)
 {
 	gCurrentViewportFlags = viewFlags;
 
+	paint_init(session, dpi);
 	if (viewFlags & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE)) {
 		uint8 colour = 10;
 		if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES) {
 			colour = 0;
 		}
-		gfx_clear(dpi, colour);
+		gfx_clear(&session->dpi, colour);
+	}
+
+	profiler_begin(PROFILER_SECTION_PAINT_GENERATE_STRUCTS);
+	paint_generate_structs(session);
+	profiler_end(PROFILER_SECTION_PAINT_GENERATE_STRUCTS);
+}
+
+/**
+ * Draws a batch of columns generated into the first sessions and starts the next batch.
+ */
+static void viewport_draw_batch(const rct_drawpixelinfo * columnDpis, size_t numColumns, uint32 viewFlags)
+{
+	if (numColumns > 1 && scrolling_text_batch_overflowed()) {
+		// The scrolling text of the batch did not fit in the cache, so some columns would draw the text of
+		// others. They are generated again and drawn one at a time instead.
+		for (size_t i = 0; i < numColumns; i++) {
+			scrolling_text_begin_batch();
+			viewport_generate_column(paint_session_get(0), &columnDpis[i], viewFlags);
+			viewport_draw_columns(1, viewFlags);
+		}
+	} else {
+		viewport_draw_columns(numColumns, viewFlags);
 	}
-	paint_init(dpi);
-	paint_generate_structs(dpi);
-	paint_struct ps = paint_arrange_structs();
-	paint_draw_structs(dpi, &ps, viewFlags);
+	scrolling_text_begin_batch();
+}
+
+/**
+ * Draws the columns generated into the first sessions, numColumns of them.
+ */
+static void viewport_draw_columns(size_t numColumns, uint32 viewFlags)
+{
+	uint32 numWorkers = 1;
+	if (numColumns > 1) {
+		numWorkers = parallel_get_num_workers(numColumns);
+	}
+	parallel_for(numColumns, numWorkers, viewport_draw_column, &viewFlags);
+
+	// Strings are drawn with the shared font state, the columns do not overlap so they can go after every column
+	for (size_t i = 0; i < numColumns; i++) {
+		paint_session * session = paint_session_get(i);
+		if (session->ps_string_head != NULL) {
+			paint_draw_money_structs(&session->dpi, session->ps_string_head);
+		}
+	}
+}
+
+static void viewport_draw_column(size_t index, uint32 worker, void *arg)
+{
+	uint32 viewFlags = *((uint32 *)arg);
+	paint_session * session = paint_session_get(index);
+
+	// Only the columns drawn on the calling thread are timed
+	profiler_begin(PROFILER_SECTION_PAINT_ARRANGE_STRUCTS);
+	paint_struct ps = paint_arrange_structs(session);
+	profiler_end(PROFILER_SECTION_PAINT_ARRANGE_STRUCTS);
+
+	profiler_begin(PROFILER_SECTION_PAINT_DRAW_STRUCTS);
+	paint_draw_structs(session, &ps, viewFlags);
+	profiler_end(PROFILER_SECTION_PAINT_DRAW_STRUCTS);
 
 	if (gConfigGeneral.render_weather_gloom &&
 		!gTrackDesignSaveMode &&
 		!(viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
 	) {
-		viewport_paint_weather_gloom(dpi);
-	}
-
-	if (gPaintPSStringHead != NULL) {
-		paint_draw_money_structs(dpi, gPaintPSStringHead);
+		viewport_paint_weather_gloom(&session->dpi);
 	}
 }
 
@@ -1379,9 +1469,10 @@ void get_map_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 flags,
 			dpi->zoom_level = _viewportDpi1.zoom_level;
 			dpi->x = _viewportDpi1.x;
 			dpi->width = 1;
-			paint_init(dpi);
-			paint_generate_structs(dpi);
-			paint_struct ps = paint_arrange_structs();
+			paint_session * session = paint_session_get(0);
+			paint_init(session, dpi);
+			paint_generate_structs(session);
+			paint_struct ps = paint_arrange_structs(session);
 			sub_68862C(dpi, &ps);
 		}
 		if (viewport != NULL) *viewport = myviewport;
@@ -31,6 +31,7 @@ typedef enum {
 	WWT_TAB = 8,
 	WWT_FLATBTN = 9,
 	WWT_DROPDOWN_BUTTON = 10,
+	WWT_BUTTON = WWT_DROPDOWN_BUTTON, // A plain text button, drawn the same way
 	WWT_11, // Same as dropdown button but uses .text + 1 while pressed/active
 	WWT_12, // looks like a normal label to me
 	WWT_13,
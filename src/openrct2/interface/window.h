@@ -471,6 +471,7 @@ enum {
 	WC_SERVER_START = 128,
 	WC_CUSTOM_CURRENCY_CONFIG = 129,
 	WC_DEBUG_PAINT = 130,
+	WC_DEBUG_PROFILER = 131,
 
 	// Only used for colour schemes
 	WC_STAFF = 220,
@@ -718,6 +719,7 @@ rct_window *window_mapgen_open();
 rct_window *window_loadsave_open(sint32 type, char *defaultName);
 rct_window *window_changelog_open();
 void window_debug_paint_open();
+void window_debug_profiler_open();
 
 void window_editor_main_open();
 void window_editor_bottom_toolbar_open();
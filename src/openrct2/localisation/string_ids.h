@@ -3651,6 +3651,13 @@ enum {
 	STR_SET_MONEY = 5999,
 	STR_ENTER_NEW_VALUE = 6000,
 
+	STR_DEBUG_PROFILER_ENABLE = 6001,
+	STR_DEBUG_PROFILER_EXPORT_CSV = 6002,
+	STR_DEBUG_DROPDOWN_DEBUG_PROFILER = 6003,
+	STR_DEBUG_PROFILER_SECTION = 6004,
+	STR_DEBUG_PROFILER_AVERAGE_MS = 6005,
+	STR_DEBUG_PROFILER_MAXIMUM_MS = 6006,
+
 	// Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
 	STR_COUNT = 32768
 };
@@ -118,6 +118,7 @@ void marketing_set_guest_campaign(rct_peep *peep, sint32 campaign)
 		peep->voucher_type = VOUCHER_TYPE_RIDE_FREE;
 		peep->voucher_arguments = gMarketingCampaignRideIndex[campaign];
 		peep->guest_heading_to_ride_id = gMarketingCampaignRideIndex[campaign];
+		gGuestGroupsGeneration++;
 		peep->peep_is_lost_countdown = 240;
 		break;
 	case ADVERTISING_CAMPAIGN_PARK_ENTRY_HALF_PRICE:
@@ -133,6 +134,7 @@ void marketing_set_guest_campaign(rct_peep *peep, sint32 campaign)
 		break;
 	case ADVERTISING_CAMPAIGN_RIDE:
 		peep->guest_heading_to_ride_id = gMarketingCampaignRideIndex[campaign];
+		gGuestGroupsGeneration++;
 		peep->peep_is_lost_countdown = 240;
 		break;
 	}
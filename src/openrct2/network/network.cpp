@@ -66,6 +66,7 @@ extern "C" {
 #include "../localisation/localisation.h"
 #include "../management/finance.h"
 #include "../network/http.h"
+#include "../peep/peep.h"
 #include "../scenario/scenario.h"
 #include "../windows/error.h"
 #include "../util/util.h"
@@ -277,6 +278,9 @@ bool Network::BeginServer(uint16 port, const char* address)
 
 	mode = NETWORK_MODE_SERVER;
 
+	// Fixed for the whole session, clients get it along with the map
+	gGuestFlowFieldsNetwork = gConfigGeneral.guest_flow_fields != 0;
+
 	_userManager.Load();
 
 	log_verbose("Begin listening for clients");
@@ -569,14 +573,34 @@ bool Network::CheckSRAND(uint32 tick, uint32 srand0)
 		server_srand0_tick = 0;
 		// Check that the server and client sprite hashes match
 		const bool sprites_mismatch = server_sprite_hash[0] != '\0' && strcmp(sprite_checksum(), server_sprite_hash);
+		const bool sprite_lists_mismatch = server_has_sprite_list_checksums && !CheckSpriteListChecksums(tick);
 		// Check PRNG values and sprite hashes, if exist
-		if ((srand0 != server_srand0) || sprites_mismatch) {
+		if ((srand0 != server_srand0) || sprites_mismatch || sprite_lists_mismatch) {
 			return false;
 		}
 	}
 	return true;
 }
 
+bool Network::CheckSpriteListChecksums(uint32 tick)
+{
+	static const char * const SpriteListNames[NUM_SPRITE_LISTS] = {
+		"null", "train", "peep", "misc", "litter", "unknown"
+	};
+
+	uint32 checksums[NUM_SPRITE_LISTS];
+	sprite_list_checksums(checksums);
+
+	bool match = true;
+	for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++) {
+		if (checksums[i] != server_sprite_list_checksums[i]) {
+			log_warning("Sprite list '%s' diverged from the server at tick %u", SpriteListNames[i], tick);
+			match = false;
+		}
+	}
+	return match;
+}
+
 void Network::KickPlayer(sint32 playerId)
 {
 	for(auto it = client_connection_list.begin(); it != client_connection_list.end(); it++) {
@@ -1041,12 +1065,21 @@ void Network::Server_Send_TICK()
 		checksum_counter = 0;
 		flags |= NETWORK_TICK_FLAG_CHECKSUMS;
 	}
+	// The per-list checksums are cheap, so they are sent every tick
+	flags |= NETWORK_TICK_FLAG_LIST_CHECKSUMS;
 	// Send flags always, so we can understand packet structure on the other end,
 	// and allow for some expansion.
 	*packet << flags;
 	if (flags & NETWORK_TICK_FLAG_CHECKSUMS) {
 		packet->WriteString(sprite_checksum());
 	}
+	if (flags & NETWORK_TICK_FLAG_LIST_CHECKSUMS) {
+		uint32 checksums[NUM_SPRITE_LISTS];
+		sprite_list_checksums(checksums);
+		for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++) {
+			*packet << checksums[i];
+		}
+	}
 	SendPacketToClients(*packet);
 }
 
@@ -1781,6 +1814,14 @@ void Network::Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& p
 				safe_strcpy(server_sprite_hash, text, sizeof(server_sprite_hash));
 			}
 		}
+		server_has_sprite_list_checksums = (flags & NETWORK_TICK_FLAG_LIST_CHECKSUMS) != 0;
+		if (server_has_sprite_list_checksums)
+		{
+			for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
+			{
+				packet >> server_sprite_list_checksums[i];
+			}
+		}
 	}
 }
 
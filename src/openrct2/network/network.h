@@ -54,7 +54,7 @@ extern "C" {
 // This define specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "29"
+#define NETWORK_STREAM_VERSION "35"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 #ifdef __cplusplus
@@ -82,6 +82,7 @@ extern "C" {
 
 enum {
 	NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+	NETWORK_TICK_FLAG_LIST_CHECKSUMS = 1 << 1,
 };
 
 struct ObjectRepositoryItem;
@@ -108,6 +109,7 @@ public:
 	static const char* FormatChat(NetworkPlayer* fromplayer, const char* text);
 	void SendPacketToClients(NetworkPacket& packet, bool front = false);
 	bool CheckSRAND(uint32 tick, uint32 srand0);
+	bool CheckSpriteListChecksums(uint32 tick);
 	void KickPlayer(sint32 playerId);
 	void SetPassword(const char* password);
 	void ShutdownClient();
@@ -202,6 +204,8 @@ private:
 	uint32 server_srand0 = 0;
 	uint32 server_srand0_tick = 0;
 	char server_sprite_hash[EVP_MAX_MD_SIZE + 1];
+	bool server_has_sprite_list_checksums = false;
+	uint32 server_sprite_list_checksums[NUM_SPRITE_LISTS];
 	uint8 player_id = 0;
 	std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
 	std::multiset<GameCommand> game_command_queue;
@@ -31,6 +31,8 @@
 extern "C"
 {
     #include "../object_list.h"
+    #include "../paint/paint.h"
+    #include "../world/tile_summary.h"
 }
 
 class ObjectManager final : public IObjectManager
@@ -360,6 +362,10 @@ private:
                 *legacyChunk = loadedObject->GetLegacyData();
             }
         }
+
+        // Path additions are counted by the objects they refer to
+        tile_summary_invalidate();
+        paint_cache_invalidate();
     }
 
     void UpdateSceneryGroupIndexes()
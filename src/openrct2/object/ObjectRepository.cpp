@@ -26,10 +26,12 @@
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
 #include "../core/Memory.hpp"
-#include "../core/MemoryStream.h"
+#include "../core/MemoryMappedFile.hpp"
+#include "../core/Parallel.hpp"
 #include "../core/Path.hpp"
 #include "../core/Stopwatch.hpp"
 #include "../core/String.hpp"
+#include "../core/Util.hpp"
 #include "../PlatformEnvironment.h"
 #include "../scenario/ScenarioRepository.h"
 #include "Object.h"
@@ -51,22 +53,62 @@ extern "C"
     #include "../util/util.h"
 }
 
-constexpr uint16 OBJECT_REPOSITORY_VERSION = 10;
-
+constexpr uint32 OBJECT_REPOSITORY_MAGIC_NUMBER = 0x5844494F;
+constexpr uint16 OBJECT_REPOSITORY_VERSION = 12;
+
+/*
+ * The object index is a flat file that is mapped into memory rather than read, it consists of:
+ *   ObjectRepositoryHeader
+ *   ObjectRepositoryRecord      [NumItems]
+ *   ObjectRepositoryFileRecord  [NumInvalidFiles]
+ *   rct_object_entry            [NumThemeObjects]
+ *   null terminated strings     [StringPoolSize bytes]
+ * Items loaded from the index point straight at the strings and theme objects in the mapped file.
+ */
 #pragma pack(push, 1)
 struct ObjectRepositoryHeader
 {
+    uint32  MagicNumber;
     uint16  Version;
     uint16  LanguageId;
-    uint32  TotalFiles;
-    uint64  TotalFileSize;
-    uint32  FileDateModifiedChecksum;
-    uint32  PathChecksum;
     uint32  NumItems;
+    uint32  NumInvalidFiles;
+    uint32  NumThemeObjects;
+    uint32  StringPoolSize;
+};
+assert_struct_size(ObjectRepositoryHeader, 24);
+
+struct ObjectRepositoryRecord
+{
+    rct_object_entry    ObjectEntry;
+    uint32              PathOffset;
+    uint32              NameOffset;
+    uint64              FileSize;
+    uint64              FileLastModified;
+    uint8               RideFlags;
+    uint8               RideCategory[2];
+    uint8               RideType[3];
+    uint16              NumThemeObjects;
+    uint32              ThemeObjectsIndex;
+};
+assert_struct_size(ObjectRepositoryRecord, 52);
+
+struct ObjectRepositoryFileRecord
+{
+    uint32  PathOffset;
+    uint64  Size;
+    uint64  LastModified;
 };
-assert_struct_size(ObjectRepositoryHeader, 28);
+assert_struct_size(ObjectRepositoryFileRecord, 20);
 #pragma pack(pop)
 
+struct ObjectFile
+{
+    std::string Path;
+    uint64      Size;
+    uint64      LastModified;
+};
+
 struct ObjectEntryHash
 {
     size_t operator()(const rct_object_entry &entry) const
@@ -96,8 +138,10 @@ class ObjectRepository final : public IObjectRepository
 {
     IPlatformEnvironment *              _env = nullptr;
     std::vector<ObjectRepositoryItem>   _items;
-    QueryDirectoryResult                _queryDirectoryResult = { 0 };
     ObjectEntryMap                      _itemMap;
+    std::vector<ObjectRepositoryItem>   _conflictingItems;
+    std::vector<ObjectFile>             _invalidFiles;
+    MemoryMappedFile                    _index;
     uint16                              _languageId = 0;
     sint32                                 _numConflicts;
 
@@ -115,24 +159,25 @@ public:
     void LoadOrConstruct() override
     {
         ClearItems();
+        _languageId = gCurrentLanguage;
 
-        Query();
-        if (!Load())
-        {
-            _languageId = gCurrentLanguage;
-            Scan();
-            Save();
-        }
+        // Only objects that are new or have changed since the index was saved need to be read
+        std::vector<ObjectRepositoryItem> indexedItems;
+        std::vector<ObjectFile> indexedInvalidFiles;
+        Load(&indexedItems, &indexedInvalidFiles);
+        Scan(&indexedItems, &indexedInvalidFiles);
 
         // SortItems();
     }
 
     void Construct() override
     {
+        ClearItems();
         _languageId = gCurrentLanguage;
-        Query();
-        Scan();
-        Save();
+
+        std::vector<ObjectRepositoryItem> indexedItems;
+        std::vector<ObjectFile> indexedInvalidFiles;
+        Scan(&indexedItems, &indexedInvalidFiles);
     }
 
     size_t GetNumObjects() const override
@@ -233,49 +278,185 @@ private:
         }
         _items.clear();
         _itemMap.clear();
-    }
-
-    void Query()
-    {
-        _queryDirectoryResult = { 0 };
-
-        const std::string &rct2Path = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::OBJECT);
-        const std::string &openrct2Path = _env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT);
-        QueryDirectory(&_queryDirectoryResult, rct2Path);
-        QueryDirectory(&_queryDirectoryResult, openrct2Path);
-    }
 
-    void QueryDirectory(QueryDirectoryResult * result, const std::string &directory)
-    {
-        utf8 pattern[MAX_PATH];
-        String::Set(pattern, sizeof(pattern), directory.c_str());
-        Path::Append(pattern, sizeof(pattern), "*.dat");
-        Path::QueryDirectory(result, pattern);
+        for (ObjectRepositoryItem &item : _conflictingItems)
+        {
+            FreeItem(&item);
+        }
+        _conflictingItems.clear();
+        _invalidFiles.clear();
+        _index.Close();
     }
 
-    void Scan()
+    /**
+     * Adds every object in the object directories to the repository. Objects that are in the given
+     * index with the same size and modification time are taken from the index instead of being
+     * read again, the index is saved again if anything had to be read or was removed.
+     */
+    void Scan(std::vector<ObjectRepositoryItem> * indexedItems, std::vector<ObjectFile> * indexedInvalidFiles)
     {
-        Console::WriteLine("Scanning %lu objects...", _queryDirectoryResult.TotalFiles);
         _numConflicts = 0;
 
         auto stopwatch = Stopwatch();
         stopwatch.Start();
 
-        const std::string &rct2Path = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::OBJECT);
-        const std::string &openrct2Path = _env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT);
-        ScanDirectory(rct2Path);
-        ScanDirectory(openrct2Path);
+        // Enumerate each object directory on its own thread
+        const std::string directories[] =
+        {
+            _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::OBJECT),
+            _env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT),
+        };
+        std::vector<ObjectFile> directoryFiles[Util::CountOf(directories)];
+        Parallel::For(Util::CountOf(directories), Util::CountOf(directories), [&directories, &directoryFiles](size_t index, uint32 worker) -> void
+        {
+            directoryFiles[index] = GetObjectFiles(directories[index]);
+        });
+
+        std::vector<ObjectFile> files;
+        for (const auto &directory : directoryFiles)
+        {
+            files.insert(files.end(), directory.begin(), directory.end());
+        }
+
+        // Reuse the indexed items of unchanged files, each item is kept in the slot of its file so
+        // that the items can be added in enumeration order afterwards
+        std::vector<size_t> indexedItemOrder(indexedItems->size());
+        for (size_t i = 0; i < indexedItemOrder.size(); i++)
+        {
+            indexedItemOrder[i] = i;
+        }
+        std::sort(indexedItemOrder.begin(), indexedItemOrder.end(), [indexedItems](size_t a, size_t b) -> bool
+        {
+            return strcmp((*indexedItems)[a].Path, (*indexedItems)[b].Path) < 0;
+        });
+        std::unordered_map<std::string, size_t> indexedInvalidFileMap;
+        for (size_t i = 0; i < indexedInvalidFiles->size(); i++)
+        {
+            indexedInvalidFileMap[(*indexedInvalidFiles)[i].Path] = i;
+        }
+
+        std::vector<bool> indexedItemUsed(indexedItems->size());
+        std::vector<ObjectRepositoryItem> items(files.size());
+        std::vector<size_t> filesToRead;
+        size_t numIndexedFiles = 0;
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            const ObjectFile &file = files[i];
+
+            // Files that could not be read before are not tried again until they change
+            auto invalidKvp = indexedInvalidFileMap.find(file.Path);
+            if (invalidKvp != indexedInvalidFileMap.end())
+            {
+                const ObjectFile &invalidFile = (*indexedInvalidFiles)[invalidKvp->second];
+                if (invalidFile.Size == file.Size &&
+                    invalidFile.LastModified == file.LastModified)
+                {
+                    _invalidFiles.push_back(file);
+                    numIndexedFiles++;
+                    continue;
+                }
+            }
+
+            auto it = std::lower_bound(indexedItemOrder.begin(), indexedItemOrder.end(), file.Path, [indexedItems](size_t a, const std::string &path) -> bool
+            {
+                return strcmp((*indexedItems)[a].Path, path.c_str()) < 0;
+            });
+            if (it != indexedItemOrder.end() && !indexedItemUsed[*it])
+            {
+                const ObjectRepositoryItem * indexedItem = &(*indexedItems)[*it];
+                if (String::Equals(indexedItem->Path, file.Path.c_str()) &&
+                    indexedItem->FileSize == file.Size &&
+                    indexedItem->FileLastModified == file.LastModified)
+                {
+                    items[i] = *indexedItem;
+                    indexedItemUsed[*it] = true;
+                    numIndexedFiles++;
+                    continue;
+                }
+            }
+            filesToRead.push_back(i);
+        }
+
+        // Anything left in the index is for files that were changed or removed
+        size_t numIndexedEntries = indexedItems->size() + indexedInvalidFiles->size();
+        for (size_t i = 0; i < indexedItems->size(); i++)
+        {
+            if (!indexedItemUsed[i])
+            {
+                FreeItem(&(*indexedItems)[i]);
+            }
+        }
+        indexedItems->clear();
+        indexedInvalidFiles->clear();
+
+        // Decode the new and changed objects across all workers
+        uint32 numWorkers = 0;
+        if (filesToRead.size() != 0)
+        {
+            Console::WriteLine("Scanning %lu objects...", filesToRead.size());
+            numWorkers = Parallel::GetNumWorkers(filesToRead.size());
+        }
+        std::vector<Stopwatch> workerStopwatches(numWorkers);
+        std::vector<uint32> workerNumFiles(numWorkers);
+        Parallel::For(filesToRead.size(), numWorkers, [&files, &filesToRead, &items, &workerStopwatches, &workerNumFiles](size_t index, uint32 worker) -> void
+        {
+            size_t fileIndex = filesToRead[index];
+            workerStopwatches[worker].Start();
+            items[fileIndex] = CreateItemFromFile(files[fileIndex].Path.c_str());
+            items[fileIndex].FileSize = files[fileIndex].Size;
+            items[fileIndex].FileLastModified = files[fileIndex].LastModified;
+            workerStopwatches[worker].Stop();
+            workerNumFiles[worker]++;
+        });
+
+        // Add the items in the same order as a sequential scan so conflicts resolve the same way.
+        // Conflicts and unreadable files are remembered so they are not read again next time, only
+        // conflicts involving a newly read object are reported.
+        std::vector<bool> wasRead(files.size());
+        for (size_t fileIndex : filesToRead)
+        {
+            wasRead[fileIndex] = true;
+        }
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            ObjectRepositoryItem * item = &items[i];
+            if (item->Path == nullptr)
+            {
+                if (wasRead[i])
+                {
+                    _invalidFiles.push_back(files[i]);
+                }
+            }
+            else if (!AddItem(item, wasRead[i]))
+            {
+                _conflictingItems.push_back(*item);
+            }
+        }
 
         stopwatch.Stop();
-        Console::WriteLine("Scanning complete in %.2f seconds.", stopwatch.GetElapsedMilliseconds() / 1000.0f);
+        if (filesToRead.size() != 0)
+        {
+            Console::WriteLine("Scanning complete in %.2f seconds.", stopwatch.GetElapsedMilliseconds() / 1000.0f);
+            for (uint32 i = 0; i < numWorkers; i++)
+            {
+                Console::WriteLine("  Thread %u: %u objects in %.2f seconds.", i, workerNumFiles[i], workerStopwatches[i].GetElapsedMilliseconds() / 1000.0f);
+            }
+        }
         if (_numConflicts > 0)
         {
             Console::WriteLine("%d object conflicts found.", _numConflicts);
         }
+
+        if (filesToRead.size() != 0 || numIndexedFiles != numIndexedEntries)
+        {
+            Save();
+        }
     }
 
-    void ScanDirectory(const std::string &directory)
+    static std::vector<ObjectFile> GetObjectFiles(const std::string &directory)
     {
+        std::vector<ObjectFile> files;
+
         utf8 pattern[MAX_PATH];
         String::Set(pattern, sizeof(pattern), directory.c_str());
         Path::Append(pattern, sizeof(pattern), "*.dat");
@@ -283,97 +464,263 @@ private:
         IFileScanner * scanner = Path::ScanDirectory(pattern, true);
         while (scanner->Next())
         {
-            const utf8 * enumPath = scanner->GetPath();
-            ScanObject(enumPath);
+            const FileInfo * fileInfo = scanner->GetFileInfo();
+            files.push_back({ scanner->GetPath(), fileInfo->Size, fileInfo->LastModified });
         }
         delete scanner;
+        return files;
     }
 
     void ScanObject(const utf8 * path)
     {
+        ObjectRepositoryItem item = CreateItemFromFile(path);
+        if (item.Path != nullptr && !AddItem(&item, true))
+        {
+            FreeItem(&item);
+        }
+    }
+
+    /**
+     * Reads the object at the given path into a repository item, the item's path is null if the
+     * object could not be read. Safe to call from multiple threads at once.
+     */
+    static ObjectRepositoryItem CreateItemFromFile(const utf8 * path)
+    {
+        ObjectRepositoryItem item = { 0 };
         Object * object = ObjectFactory::CreateObjectFromLegacyFile(path);
         if (object != nullptr)
         {
-            ObjectRepositoryItem item = { 0 };
             item.ObjectEntry = *object->GetObjectEntry();
             item.Path = String::Duplicate(path);
             item.Name = String::Duplicate(object->GetName());
             object->SetRepositoryItem(&item);
-            AddItem(&item);
 
             delete object;
         }
+        return item;
     }
 
-    bool Load()
+    /**
+     * Maps the saved index and creates an item for each of its records, nothing is read if the
+     * index was saved by a different version or for a different language.
+     */
+    void Load(std::vector<ObjectRepositoryItem> * items, std::vector<ObjectFile> * invalidFiles)
     {
         const std::string &path = _env->GetFilePath(PATHID::CACHE_OBJECTS);
-        try
+        if (!_index.Open(path))
         {
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            auto header = fs.ReadValue<ObjectRepositoryHeader>();
+            return;
+        }
 
-            if (header.Version == OBJECT_REPOSITORY_VERSION &&
-                header.LanguageId == gCurrentLanguage &&
-                header.TotalFiles == _queryDirectoryResult.TotalFiles &&
-                header.TotalFileSize == _queryDirectoryResult.TotalFileSize &&
-                header.FileDateModifiedChecksum == _queryDirectoryResult.FileDateModifiedChecksum &&
-                header.PathChecksum == _queryDirectoryResult.PathChecksum)
-            {
-                // Header matches, so the index is not out of date
+        const uint8 * data = (const uint8 *)_index.GetData();
+        size_t length = _index.GetLength();
+        if (length < sizeof(ObjectRepositoryHeader))
+        {
+            _index.Close();
+            return;
+        }
 
-                // Buffer the rest of file into memory to speed up item reading
-                size_t dataSize = (size_t)(fs.GetLength() - fs.GetPosition());
-                void * data = fs.ReadArray<uint8>(dataSize);
-                auto ms = MemoryStream(data, dataSize, MEMORY_ACCESS_READ | MEMORY_ACCESS_OWNER);
+        const ObjectRepositoryHeader * header = (const ObjectRepositoryHeader *)data;
+        if (header->MagicNumber != OBJECT_REPOSITORY_MAGIC_NUMBER ||
+            header->Version != OBJECT_REPOSITORY_VERSION ||
+            header->LanguageId != _languageId)
+        {
+            Console::WriteLine("Object repository is out of date.");
+            _index.Close();
+            return;
+        }
 
-                // Read items
-                for (uint32 i = 0; i < header.NumItems; i++)
-                {
-                    ObjectRepositoryItem item = ReadItem(&ms);
-                    AddItem(&item);
-                }
-                return true;
+        uint64 expectedLength = sizeof(ObjectRepositoryHeader) +
+                                (uint64)header->NumItems * sizeof(ObjectRepositoryRecord) +
+                                (uint64)header->NumInvalidFiles * sizeof(ObjectRepositoryFileRecord) +
+                                (uint64)header->NumThemeObjects * sizeof(rct_object_entry) +
+                                header->StringPoolSize;
+        const ObjectRepositoryRecord * records = (const ObjectRepositoryRecord *)(header + 1);
+        const ObjectRepositoryFileRecord * fileRecords = (const ObjectRepositoryFileRecord *)(records + header->NumItems);
+        const rct_object_entry * themeObjects = (const rct_object_entry *)(fileRecords + header->NumInvalidFiles);
+        const utf8 * stringPool = (const utf8 *)(themeObjects + header->NumThemeObjects);
+        if (expectedLength != length ||
+            header->StringPoolSize == 0 ||
+            stringPool[header->StringPoolSize - 1] != '\0')
+        {
+            Console::Error::WriteLine("Object repository index is corrupt.");
+            _index.Close();
+            return;
+        }
+
+        items->reserve(header->NumItems);
+        for (uint32 i = 0; i < header->NumItems; i++)
+        {
+            const ObjectRepositoryRecord * record = &records[i];
+            if (record->PathOffset >= header->StringPoolSize ||
+                record->NameOffset >= header->StringPoolSize ||
+                (uint64)record->ThemeObjectsIndex + record->NumThemeObjects > header->NumThemeObjects)
+            {
+                Console::Error::WriteLine("Object repository index is corrupt.");
+                items->clear();
+                invalidFiles->clear();
+                _index.Close();
+                return;
             }
-            Console::WriteLine("Object repository is out of date.");
-            return false;
+
+            ObjectRepositoryItem item = { 0 };
+            item.ObjectEntry = record->ObjectEntry;
+            item.Path = (utf8 *)&stringPool[record->PathOffset];
+            item.Name = (utf8 *)&stringPool[record->NameOffset];
+            item.FileSize = record->FileSize;
+            item.FileLastModified = record->FileLastModified;
+            switch (item.ObjectEntry.flags & 0x0F) {
+            case OBJECT_TYPE_RIDE:
+                item.RideFlags = record->RideFlags;
+                Memory::Copy(item.RideCategory, record->RideCategory, sizeof(item.RideCategory));
+                Memory::Copy(item.RideType, record->RideType, sizeof(item.RideType));
+                break;
+            case OBJECT_TYPE_SCENERY_SETS:
+                item.NumThemeObjects = record->NumThemeObjects;
+                item.ThemeObjects = (rct_object_entry *)&themeObjects[record->ThemeObjectsIndex];
+                break;
+            }
+            items->push_back(item);
         }
-        catch (const IOException &)
+
+        for (uint32 i = 0; i < header->NumInvalidFiles; i++)
         {
-            return false;
+            const ObjectRepositoryFileRecord * fileRecord = &fileRecords[i];
+            if (fileRecord->PathOffset < header->StringPoolSize)
+            {
+                invalidFiles->push_back({ &stringPool[fileRecord->PathOffset], fileRecord->Size, fileRecord->LastModified });
+            }
         }
     }
 
-    void Save() const
+    void Save()
     {
+        // The index can not be written while it is still mapped
+        DetachFromIndex();
+
+        // Lay out the records and string pool in memory first so the file is written in one go
+        std::vector<ObjectRepositoryRecord> records;
+        std::vector<ObjectRepositoryFileRecord> fileRecords;
+        std::vector<rct_object_entry> themeObjects;
+        std::vector<utf8> stringPool;
+        auto addString = [&stringPool](const utf8 * str) -> uint32
+        {
+            uint32 offset = (uint32)stringPool.size();
+            stringPool.insert(stringPool.end(), str, str + String::SizeOf(str) + 1);
+            return offset;
+        };
+
+        records.reserve(_items.size() + _conflictingItems.size());
+        for (const auto * itemList : { &_items, &_conflictingItems })
+        {
+            for (const ObjectRepositoryItem &item : *itemList)
+            {
+                ObjectRepositoryRecord record = { 0 };
+                record.ObjectEntry = item.ObjectEntry;
+                record.PathOffset = addString(item.Path);
+                record.NameOffset = addString(item.Name);
+                record.FileSize = item.FileSize;
+                record.FileLastModified = item.FileLastModified;
+                switch (item.ObjectEntry.flags & 0x0F) {
+                case OBJECT_TYPE_RIDE:
+                    record.RideFlags = item.RideFlags;
+                    Memory::Copy(record.RideCategory, item.RideCategory, sizeof(record.RideCategory));
+                    Memory::Copy(record.RideType, item.RideType, sizeof(record.RideType));
+                    break;
+                case OBJECT_TYPE_SCENERY_SETS:
+                    record.NumThemeObjects = item.NumThemeObjects;
+                    record.ThemeObjectsIndex = (uint32)themeObjects.size();
+                    themeObjects.insert(themeObjects.end(), item.ThemeObjects, item.ThemeObjects + item.NumThemeObjects);
+                    break;
+                }
+                records.push_back(record);
+            }
+        }
+        for (const ObjectFile &file : _invalidFiles)
+        {
+            ObjectRepositoryFileRecord fileRecord;
+            fileRecord.PathOffset = addString(file.Path.c_str());
+            fileRecord.Size = file.Size;
+            fileRecord.LastModified = file.LastModified;
+            fileRecords.push_back(fileRecord);
+        }
+        if (stringPool.empty())
+        {
+            stringPool.push_back('\0');
+        }
+
+        // Write a new file and move it over the index, so that the index is never truncated while
+        // it may still be mapped, e.g. by another instance of the game
         const std::string &path = _env->GetFilePath(PATHID::CACHE_OBJECTS);
+        const std::string tempPath = path + ".tmp";
         try
         {
-            auto fs = FileStream(path, FILE_MODE_WRITE);
+            auto fs = FileStream(tempPath, FILE_MODE_WRITE);
 
-            // Write header
             ObjectRepositoryHeader header;
+            header.MagicNumber = OBJECT_REPOSITORY_MAGIC_NUMBER;
             header.Version = OBJECT_REPOSITORY_VERSION;
             header.LanguageId = _languageId;
-            header.TotalFiles = _queryDirectoryResult.TotalFiles;
-            header.TotalFileSize = _queryDirectoryResult.TotalFileSize;
-            header.FileDateModifiedChecksum = _queryDirectoryResult.FileDateModifiedChecksum;
-            header.PathChecksum = _queryDirectoryResult.PathChecksum;
-            header.NumItems = (uint32)_items.size();
+            header.NumItems = (uint32)records.size();
+            header.NumInvalidFiles = (uint32)fileRecords.size();
+            header.NumThemeObjects = (uint32)themeObjects.size();
+            header.StringPoolSize = (uint32)stringPool.size();
             fs.WriteValue(header);
-
-            // Write items
-            for (uint32 i = 0; i < header.NumItems; i++)
-            {
-                WriteItem(&fs, _items[i]);
-            }
+            fs.WriteArray(records.data(), records.size());
+            fs.WriteArray(fileRecords.data(), fileRecords.size());
+            fs.WriteArray(themeObjects.data(), themeObjects.size());
+            fs.WriteArray(stringPool.data(), stringPool.size());
         }
         catch (const IOException &)
+        {
+            log_error("Unable to write object repository index to '%s'.", tempPath.c_str());
+            platform_file_delete(tempPath.c_str());
+            return;
+        }
+
+        // Moving onto an existing file fails on some platforms
+        if (!platform_file_move(tempPath.c_str(), path.c_str()) &&
+            !(platform_file_delete(path.c_str()) && platform_file_move(tempPath.c_str(), path.c_str())))
         {
             log_error("Unable to write object repository index to '%s'.", path.c_str());
+            platform_file_delete(tempPath.c_str());
         }
     }
 
+    /**
+     * Gives every item its own copy of the data it references in the mapped index, then unmaps it.
+     */
+    void DetachFromIndex()
+    {
+        if (!_index.IsOpen())
+        {
+            return;
+        }
+
+        for (auto * itemList : { &_items, &_conflictingItems })
+        {
+            for (ObjectRepositoryItem &item : *itemList)
+            {
+                if (_index.Contains(item.Path))
+                {
+                    item.Path = String::Duplicate(item.Path);
+                }
+                if (_index.Contains(item.Name))
+                {
+                    item.Name = String::Duplicate(item.Name);
+                }
+                if ((item.ObjectEntry.flags & 0x0F) == OBJECT_TYPE_SCENERY_SETS &&
+                    _index.Contains(item.ThemeObjects))
+                {
+                    rct_object_entry * themeObjects = Memory::AllocateArray<rct_object_entry>(item.NumThemeObjects);
+                    Memory::CopyArray(themeObjects, item.ThemeObjects, item.NumThemeObjects);
+                    item.ThemeObjects = themeObjects;
+                }
+            }
+        }
+        _index.Close();
+    }
+
     void SortItems()
     {
         std::sort(_items.begin(), _items.end(), [](const ObjectRepositoryItem &a,
@@ -391,7 +738,7 @@ private:
         }
     }
 
-    bool AddItem(ObjectRepositoryItem * item)
+    bool AddItem(ObjectRepositoryItem * item, bool reportConflict)
     {
         const ObjectRepositoryItem * conflict = FindObject(&item->ObjectEntry);
         if (conflict == nullptr)
@@ -402,86 +749,38 @@ private:
             _itemMap[item->ObjectEntry] = index;
             return true;
         }
-        else
+        else if (reportConflict)
         {
             _numConflicts++;
             Console::Error::WriteLine("Object conflict: '%s'", conflict->Path);
             Console::Error::WriteLine("               : '%s'", item->Path);
-            return false;
         }
+        return false;
     }
 
-    static ObjectRepositoryItem ReadItem(IStream * stream)
+    /**
+     * Frees the data owned by the item, data that lives in the mapped index is left alone.
+     */
+    void FreeItem(ObjectRepositoryItem * item) const
     {
-        ObjectRepositoryItem item = { 0 };
-
-        item.ObjectEntry = stream->ReadValue<rct_object_entry>();
-        item.Path = stream->ReadString();
-        item.Name = stream->ReadString();
-
-        switch (item.ObjectEntry.flags & 0x0F) {
-        case OBJECT_TYPE_RIDE:
-            item.RideFlags = stream->ReadValue<uint8>();
-            for (sint32 i = 0; i < 2; i++)
-            {
-                item.RideCategory[i] = stream->ReadValue<uint8>();
-            }
-            for (sint32 i = 0; i < 3; i++)
-            {
-                item.RideType[i] = stream->ReadValue<uint8>();
-            }
-            break;
-        case OBJECT_TYPE_SCENERY_SETS:
-            item.NumThemeObjects = stream->ReadValue<uint16>();
-            item.ThemeObjects = Memory::AllocateArray<rct_object_entry>(item.NumThemeObjects);
-            for (uint16 i = 0; i < item.NumThemeObjects; i++)
-            {
-                item.ThemeObjects[i] = stream->ReadValue<rct_object_entry>();
-            }
-            break;
+        if (!_index.Contains(item->Path))
+        {
+            Memory::Free(item->Path);
         }
-        return item;
-    }
-
-    static void WriteItem(IStream * stream, const ObjectRepositoryItem &item)
-    {
-        stream->WriteValue(item.ObjectEntry);
-        stream->WriteString(item.Path);
-        stream->WriteString(item.Name);
-
-        switch (item.ObjectEntry.flags & 0x0F) {
-        case OBJECT_TYPE_RIDE:
-            stream->WriteValue<uint8>(item.RideFlags);
-            for (sint32 i = 0; i < 2; i++)
-            {
-                stream->WriteValue<uint8>(item.RideCategory[i]);
-            }
-            for (sint32 i = 0; i < 3; i++)
-            {
-                stream->WriteValue<uint8>(item.RideType[i]);
-            }
-            break;
-        case OBJECT_TYPE_SCENERY_SETS:
-            stream->WriteValue<uint16>(item.NumThemeObjects);
-            for (uint16 i = 0; i < item.NumThemeObjects; i++)
-            {
-                stream->WriteValue<rct_object_entry>(item.ThemeObjects[i]);
-            }
-            break;
+        if (!_index.Contains(item->Name))
+        {
+            Memory::Free(item->Name);
         }
-    }
-
-    static void FreeItem(ObjectRepositoryItem * item)
-    {
-        Memory::Free(item->Path);
-        Memory::Free(item->Name);
         item->Path = nullptr;
         item->Name = nullptr;
 
         uint8 objectType = item->ObjectEntry.flags & 0x0F;
         switch (objectType) {
         case OBJECT_TYPE_SCENERY_SETS:
-            Memory::Free(item->ThemeObjects);
+            if (!_index.Contains(item->ThemeObjects))
+            {
+                Memory::Free(item->ThemeObjects);
+            }
             item->ThemeObjects = nullptr;
             break;
         }
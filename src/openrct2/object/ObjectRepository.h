@@ -40,6 +40,8 @@ typedef struct ObjectRepositoryItem
     rct_object_entry   ObjectEntry;
     utf8 *             Path;
     utf8 *             Name;
+    uint64             FileSize;
+    uint64             FileLastModified;
     Object *           LoadedObject;
     union
     {
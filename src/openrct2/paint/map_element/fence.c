@@ -66,26 +66,18 @@ static void fence_paint_door(uint32 imageId,
         paint_struct * ps;
 
         ps = sub_98197C(imageId, (sint8) offset.x, (sint8) offset.y, boundsR1.x, boundsR1.y, (sint8) boundsR1.z, offset.z, boundsR1_.x, boundsR1_.y, boundsR1_.z, get_current_rotation());
-        if (ps != NULL) {
-            ps->tertiary_colour = tertiaryColour;
-        }
+        paint_util_set_tertiary_colour(ps, tertiaryColour);
 
         ps = sub_98197C(imageId + 1, (sint8) offset.x, (sint8) offset.y, boundsR2.x, boundsR2.y, (sint8) boundsR2.z, offset.z, boundsR2_.x, boundsR2_.y, boundsR2_.z, get_current_rotation());
-        if (ps != NULL) {
-            ps->tertiary_colour = tertiaryColour;
-        }
+        paint_util_set_tertiary_colour(ps, tertiaryColour);
     } else {
         paint_struct * ps;
 
         ps = sub_98197C(imageId, (sint8) offset.x, (sint8) offset.y, boundsL1.x, boundsL1.y, (sint8) boundsL1.z, offset.z, boundsL1_.x, boundsL1_.y, boundsL1_.z, get_current_rotation());
-        if (ps != NULL) {
-            ps->tertiary_colour = tertiaryColour;
-        }
+        paint_util_set_tertiary_colour(ps, tertiaryColour);
 
         ps = sub_98199C(imageId + 1, (sint8) offset.x, (sint8) offset.y, boundsL1.x, boundsL1.y, (sint8) boundsL1.z, offset.z, boundsL1_.x, boundsL1_.y, boundsL1_.z, get_current_rotation());
-        if (ps != NULL) {
-            ps->tertiary_colour = tertiaryColour;
-        }
+        paint_util_set_tertiary_colour(ps, tertiaryColour);
     }
 }
 
@@ -119,9 +111,7 @@ static void fence_paint_wall(uint32 frameNum, const rct_scenery_entry * sceneryE
         }
 
         paint_struct * paint = sub_98197C(imageId, (sint8)offset.x, (sint8)offset.y, bounds.x, bounds.y, (sint8)bounds.z, offset.z, boundsOffset.x, boundsOffset.y, boundsOffset.z, get_current_rotation());
-        if (paint != NULL) {
-            paint->tertiary_colour = tertiaryColour;
-        }
+        paint_util_set_tertiary_colour(paint, tertiaryColour);
     }
 }
 /**
@@ -139,6 +129,7 @@ void fence_paint(uint8 direction, sint32 height, rct_map_element * map_element)
 
     if (sceneryEntry->wall.flags2 & WALL_SCENERY_2_FLAG5) {
         frameNum = (gCurrentTicks & 7) * 2;
+        paint_cache_disallow();
     }
 
 
@@ -47,6 +47,7 @@ uint8 gVerticalTunnelHeight;
 
 static void blank_tiles_paint(sint32 x, sint32 y);
 static void sub_68B3FB(sint32 x, sint32 y);
+static rct_map_element * map_element_paint_elements(rct_map_element * map_element, uint8 rotation);
 
 const sint32 SEGMENTS_ALL = SEGMENT_B4 | SEGMENT_B8 | SEGMENT_BC | SEGMENT_C0 | SEGMENT_C4 | SEGMENT_C8 | SEGMENT_CC | SEGMENT_D0 | SEGMENT_D4;
 
@@ -235,6 +236,61 @@ static void sub_68B3FB(sint32 x, sint32 y)
 	gUnk9DE568 = x;
 	gUnk9DE56C = y;
 	gDidPassSurface = false;
+
+	// The support segment heights are painted over the elements every time
+	bool cacheable = !gShowSupportSegmentHeights && g141E9DB == 0;
+	if (cacheable && paint_cache_begin_tile(gPaintMapPosition.x, gPaintMapPosition.y)) {
+		return;
+	}
+
+	map_element = map_element_paint_elements(map_element, rotation);
+
+	if (cacheable) {
+		paint_cache_end_tile();
+	}
+
+	if (map_element == NULL || !gShowSupportSegmentHeights) {
+		return;
+	}
+
+	if (map_element_get_type(map_element - 1) == MAP_ELEMENT_TYPE_SURFACE) {
+		return;
+	}
+
+	static const sint32 segmentPositions[][3] = {
+		{0, 6, 2},
+		{5, 4, 8},
+		{1, 7, 3},
+	};
+
+	for (sint32 sy = 0; sy < 3; sy++) {
+		for (sint32 sx = 0; sx < 3; sx++) {
+			uint16 segmentHeight = gSupportSegments[segmentPositions[sy][sx]].height;
+			sint32 imageColourFlats = 0b101111 << 19 | 0x40000000;
+			if (segmentHeight == 0xFFFF) {
+				segmentHeight = gSupport.height;
+				// white: 0b101101
+				imageColourFlats = 0b111011 << 19 | 0x40000000;
+			}
+
+			sint32 xOffset = sy * 10;
+			sint32 yOffset = -22 + sx * 10;
+			paint_struct * ps = sub_98197C(5504 | imageColourFlats, xOffset, yOffset, 10, 10, 1, segmentHeight, xOffset + 1, yOffset + 16, segmentHeight, get_current_rotation());
+			if (ps != NULL) {
+				ps->flags &= PAINT_STRUCT_FLAG_IS_MASKED;
+				ps->colour_image_id = COLOUR_BORDEAUX_RED;
+			}
+
+		}
+	}
+}
+
+/**
+ * Paints the elements of a tile, starting at its first element.
+ * @return the element after the last element painted, NULL when the elements after a corrupt element were skipped
+ */
+static rct_map_element * map_element_paint_elements(rct_map_element * map_element, uint8 rotation)
+{
 	do {
 		sint32 direction = (map_element->type + rotation) & MAP_ELEMENT_DIRECTION_MASK;
 		sint32 height = map_element->base_height * 8;
@@ -257,6 +313,7 @@ static void sub_68B3FB(sint32 x, sint32 y)
 			scenery_paint(direction, height, map_element);
 			break;
 		case MAP_ELEMENT_TYPE_ENTRANCE:
+			paint_cache_disallow();
 			entrance_paint(direction, height, map_element);
 			break;
 		case MAP_ELEMENT_TYPE_FENCE:
@@ -266,55 +323,23 @@ static void sub_68B3FB(sint32 x, sint32 y)
 			scenery_multiple_paint(direction, height, map_element);
 			break;
 		case MAP_ELEMENT_TYPE_BANNER:
+			paint_cache_disallow();
 			banner_paint(direction, height, map_element);
 			break;
 		// A corrupt element inserted by OpenRCT2 itself, which skips the drawing of the next element only.
 		case MAP_ELEMENT_TYPE_CORRUPT:
 			if (map_element_is_last_for_tile(map_element))
-				return;
+				return NULL;
 			map_element++;
 			break;
 		default:
 			// An undefined map element is most likely a corrupt element inserted by 8 cars' MOM feature to skip drawing of all elements after it.
-			return;
+			return NULL;
 		}
 		gPaintMapPosition = dword_9DE574;
 	} while (!map_element_is_last_for_tile(map_element++));
 
-	if (!gShowSupportSegmentHeights) {
-		return;
-	}
-
-	if (map_element_get_type(map_element - 1) == MAP_ELEMENT_TYPE_SURFACE) {
-		return;
-	}
-
-	static const sint32 segmentPositions[][3] = {
-		{0, 6, 2},
-		{5, 4, 8},
-		{1, 7, 3},
-	};
-
-	for (sint32 sy = 0; sy < 3; sy++) {
-		for (sint32 sx = 0; sx < 3; sx++) {
-			uint16 segmentHeight = gSupportSegments[segmentPositions[sy][sx]].height;
-			sint32 imageColourFlats = 0b101111 << 19 | 0x40000000;
-			if (segmentHeight == 0xFFFF) {
-				segmentHeight = gSupport.height;
-				// white: 0b101101
-				imageColourFlats = 0b111011 << 19 | 0x40000000;
-			}
-
-			sint32 xOffset = sy * 10;
-			sint32 yOffset = -22 + sx * 10;
-			paint_struct * ps = sub_98197C(5504 | imageColourFlats, xOffset, yOffset, 10, 10, 1, segmentHeight, xOffset + 1, yOffset + 16, segmentHeight, get_current_rotation());
-			if (ps != NULL) {
-				ps->flags &= PAINT_STRUCT_FLAG_IS_MASKED;
-				ps->colour_image_id = COLOUR_BORDEAUX_RED;
-			}
-
-		}
-	}
+	return map_element;
 }
 
 void paint_util_push_tunnel_left(uint16 height, uint8 type)
@@ -247,6 +247,7 @@ void scenery_multiple_paint(uint8 direction, uint16 height, rct_map_element *map
 		}
 		// 6B8331:
 		// Draw sign text:
+		paint_cache_disallow();
 		set_format_arg(0, uint32, 0);
 		set_format_arg(4, uint32, 0);
 		sint32 textColour = mapElement->properties.scenerymultiple.colour[1] & 0x1F;
@@ -419,12 +419,7 @@ static void viewport_surface_smoothen_edge(enum edge_t edge, struct tile_descrip
 
 	uint32 image_id = maskImageBase + byte_97B444[self.slope];
 
-	if (paint_attach_to_previous_ps(image_id, 0, 0)) {
-		attached_paint_struct * out = g_aps_F1AD2C;
-		// set content and enable masking
-		out->colour_image_id = dword_97B804[neighbour.terrain] + cl;
-		out->flags |= PAINT_STRUCT_FLAG_IS_MASKED;
-	}
+	paint_attach_masked_to_previous_ps(image_id, dword_97B804[neighbour.terrain] + cl, 0, 0);
 }
 
 /**
@@ -1146,6 +1141,9 @@ void surface_paint(uint8 direction, uint16 height, rct_map_element * mapElement)
 	if (((gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) || gCheatsSandboxMode) &&
 		gCurrentViewportFlags & VIEWPORT_FLAG_LAND_OWNERSHIP
 	) {
+		// Peep spawns are not map elements, so moving them does not invalidate the tile
+		paint_cache_disallow();
+
 		rct_xy16 pos = {gPaintMapPosition.x, gPaintMapPosition.y};
 		for (sint32 i = 0; i < 2; ++i) {
 			rct2_peep_spawn * spawn = &gPeepSpawns[i];
@@ -1169,10 +1167,11 @@ void surface_paint(uint8 direction, uint16 height, rct_map_element * mapElement)
 			paint_attach_to_previous_ps(2625 + byte_97B444[surfaceShape], 0, 0);
 		} else if (mapElement->properties.surface.ownership & OWNERSHIP_AVAILABLE) {
 			rct_xy16 pos = {gPaintMapPosition.x, gPaintMapPosition.y};
-			paint_struct * backup = g_ps_F1AD28;
+			paint_cache_disallow();
+			paint_struct * backup = gPaintSession->last_root_ps;
 			sint32 height2 = (map_element_height(pos.x + 16, pos.y + 16) & 0xFFFF) + 3;
 			sub_98196C(22955, 16, 16, 1, 1, 0, height2, rotation);
-			g_ps_F1AD28 = backup;
+			gPaintSession->last_root_ps = backup;
 		}
 	}
 
@@ -1183,11 +1182,12 @@ void surface_paint(uint8 direction, uint16 height, rct_map_element * mapElement)
 			// TODO: SPR_TERRAIN_SELECTION_DOTTED ???
 			paint_attach_to_previous_ps(2644 + byte_97B444[surfaceShape], 0, 0);
 		} else if (mapElement->properties.surface.ownership & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE) {
-			paint_struct * backup = g_ps_F1AD28;
+			paint_cache_disallow();
+			paint_struct * backup = gPaintSession->last_root_ps;
 			rct_xy16 pos = {gPaintMapPosition.x, gPaintMapPosition.y};
 			sint32 height2 = map_element_height(pos.x + 16, pos.y + 16) & 0xFFFF;
 			sub_98196C(22956, 16, 16, 1, 1, 0, height2 + 3, rotation);
-			g_ps_F1AD28 = backup;
+			gPaintSession->last_root_ps = backup;
 		}
 	}
 
@@ -1251,9 +1251,10 @@ void surface_paint(uint8 direction, uint16 height, rct_map_element * mapElement)
 
 				sint32 image_id = (SPR_TERRAIN_SELECTION_CORNER + byte_97B444[local_surfaceShape]) | 0x21300000;
 
-				paint_struct * backup = g_ps_F1AD28;
+				paint_cache_disallow();
+				paint_struct * backup = gPaintSession->last_root_ps;
 				sub_98196C(image_id, 0, 0, 32, 32, 1, local_height, rotation);
-				g_ps_F1AD28 = backup;
+				gPaintSession->last_root_ps = backup;
 			}
 		}
 	}
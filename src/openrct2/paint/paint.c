@@ -15,10 +15,14 @@
 #pragma endregion
 
 #include "paint.h"
+#include "../cheats.h"
 #include "../drawing/drawing.h"
 #include "../localisation/localisation.h"
 #include "../config.h"
 #include "../interface/viewport.h"
+#include "../peep/staff.h"
+#include "../rct2.h"
+#include "../ride/track_design.h"
 #include "map_element/map_element.h"
 #include "sprite/sprite.h"
 #include "supports.h"
@@ -28,32 +32,116 @@ const uint32 construction_markers[] = {
 	PALETTE_DARKEN_2 << 19 | IMAGE_TYPE_TRANSPARENT, // Translucent
 };
 
-paint_struct * g_ps_F1AD28;
-attached_paint_struct * g_aps_F1AD2C;
+paint_session * gPaintSession;
 
-paint_string_struct * gPaintPSStringHead;
-static paint_string_struct * _paintLastPSString;
+// The first session is not allocated, so there is always a session to paint with
+static paint_session _firstPaintSession;
 
-#define MAX_PAINT_QUADRANTS (512)
+// The sessions after the first, session 1 is at index 0
+static paint_session ** _paintSessions;
+static size_t _paintSessionsCount;
+
+// The most paint entries used by a single paint, and the number of chunks allocated by every session
+static uint32 _paintEntriesHighWaterMark;
+static uint32 _paintEntryChunksCount;
+
+enum {
+	PAINT_CACHE_OP_98196C,
+	PAINT_CACHE_OP_98197C,
+	PAINT_CACHE_OP_98198C,
+	PAINT_CACHE_OP_98199C,
+	PAINT_CACHE_OP_ATTACH_TO_PS,
+	PAINT_CACHE_OP_ATTACH_TO_ATTACH,
+};
+
+enum {
+	// The paint struct added gets the colour as its tertiary colour
+	PAINT_CACHE_OP_FLAG_TERTIARY_COLOUR = (1 << 0),
+	// The image attached is a mask for the colour image
+	PAINT_CACHE_OP_FLAG_MASKED = (1 << 1),
+};
+
+/**
+ * A call to one of the paint setup functions, with the globals they read at the time.
+ */
+typedef struct paint_cache_op {
+	uint32 image_id;
+	uint32 colour;
+	void * drawn_item;
+	rct_xy16 map_position;
+	sint16 origin_x;
+	sint16 origin_y;
+	// The offset of the image, or its position for attached images
+	sint16 x;
+	sint16 y;
+	sint16 z_offset;
+	sint16 bound_box_length_x;
+	sint16 bound_box_length_y;
+	sint16 bound_box_offset_x;
+	sint16 bound_box_offset_y;
+	sint16 bound_box_offset_z;
+	sint8 bound_box_length_z;
+	uint8 type;
+	uint8 flags;
+	uint8 interaction_type;
+	uint8 rotation;
+} paint_cache_op;
+
+/**
+ * The paint globals as they were left after the elements of a tile were painted, followed by the calls made.
+ */
+typedef struct paint_cache_tile_state {
+	support_height support;
+	support_height support_segments[9];
+	rct_map_element * surface_element;
+	void * drawn_item;
+	rct_xy16 map_position;
+	sint16 origin_x;
+	sint16 origin_y;
+	uint16 unk_141E9DC;
+	uint8 interaction_type;
+	uint8 vertical_tunnel_height;
+	uint8 unk_141E9DB;
+	bool did_pass_surface;
+} paint_cache_tile_state;
+
+typedef struct paint_cache_tile {
+	// The tile is out of date unless it was recorded in the current generation
+	uint32 generation;
+	uint32 view_flags;
+	uint8 rotation;
+	uint8 zoom_level;
+	uint16 num_ops;
+	// NULL when the tile was painted in a way the calls do not capture
+	paint_cache_tile_state * state;
+} paint_cache_tile;
+
+static paint_cache_tile _paintCacheTiles[MAX_TILE_MAP_ELEMENT_POINTERS];
+
+// Tiles recorded in an older generation are out of date, starts above the zeroed tiles
+static uint32 _paintCacheGeneration = 1;
+static bool _paintCacheEnabled;
+
+// The tile the paint setup calls are recorded for, NULL when nothing is recorded
+static paint_cache_tile * _paintCacheRecordingTile;
+static bool _paintCacheRecordingDisallowed;
+static paint_cache_op * _paintCacheOps;
+static size_t _paintCacheOpsCount;
+static size_t _paintCacheOpsCapacity;
+
+// What the tiles were recorded with besides the map elements, the whole cache is out of date when any of it changes
+static general_configuration _paintCacheConfig;
+static bool _paintCacheSandboxMode;
+static sint16 _paintCacheMapBaseZ;
 
 #ifdef NO_RCT2
-paint_entry gPaintStructs[4000];
-static uint32 _paintQuadrantBackIndex;
-static uint32 _paintQuadrantFrontIndex;
-static paint_struct *_paintQuadrants[MAX_PAINT_QUADRANTS];
 void *g_currently_drawn_item;
-paint_entry * gEndOfPaintStructArray;
 sint16 gUnk9DE568;
 sint16 gUnk9DE56C;
 paint_struct gUnkF1A4CC;
 uint8 gPaintInteractionType;
 support_height gSupportSegments[9] = { 0 };
 support_height gSupport;
-
-#else
-#define _paintQuadrants (RCT2_ADDRESS(0x00F1A50C, paint_struct*))
-#define _paintQuadrantBackIndex RCT2_GLOBAL(0xF1AD0C, uint32)
-#define _paintQuadrantFrontIndex RCT2_GLOBAL(0xF1AD10, uint32)
 #endif
 
 static const uint8 BoundBoxDebugColours[] = {
@@ -78,47 +166,193 @@ static void paint_attached_ps(rct_drawpixelinfo * dpi, paint_struct * ps, uint32
 static void paint_ps_image_with_bounding_boxes(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static void paint_ps_image(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32 viewFlags);
+static bool paint_attach_to_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y);
+static void paint_cache_update_state();
 
 /**
+ * Gets one of the sessions kept for painting, the same index always gives the same session.
+ * @return the session, NULL if it could not be allocated. Session 0 is always there.
+ */
+paint_session * paint_session_get(size_t index)
+{
+	if (index == 0) {
+		return &_firstPaintSession;
+	}
+
+	if (index > _paintSessionsCount) {
+		paint_session ** sessions = realloc(_paintSessions, index * sizeof(paint_session *));
+		if (sessions == NULL) {
+			return NULL;
+		}
+		_paintSessions = sessions;
+
+		while (_paintSessionsCount < index) {
+			paint_session * session = malloc(sizeof(paint_session));
+			if (session == NULL) {
+				return NULL;
+			}
+			session->first_chunk = NULL;
+			session->current_chunk = NULL;
+			_paintSessions[_paintSessionsCount++] = session;
+		}
+	}
+	return _paintSessions[index - 1];
+}
+
+/**
+ * Gets the number of paint entries used since the session was last initialised.
+ */
+uint32 paint_session_get_num_entries(const paint_session * session)
+{
+	if (session->current_chunk == NULL) {
+		return 0;
+	}
+	uint32 numEntries = (uint32)(session->next_free_paint_struct - session->current_chunk->entries);
+	return session->num_full_chunks * PAINT_ENTRY_CHUNK_SIZE + numEntries;
+}
+
+/**
+ * Gets the most paint entries a single paint (usually a viewport column) has used, and the number of chunks allocated.
+ */
+void paint_get_entry_stats(uint32 * highWaterMark, uint32 * numChunks)
+{
+	_paintEntriesHighWaterMark = max(_paintEntriesHighWaterMark, paint_session_get_num_entries(&_firstPaintSession));
+	for (size_t i = 0; i < _paintSessionsCount; i++) {
+		_paintEntriesHighWaterMark = max(_paintEntriesHighWaterMark, paint_session_get_num_entries(_paintSessions[i]));
+	}
+	*highWaterMark = _paintEntriesHighWaterMark;
+	*numChunks = _paintEntryChunksCount;
+}
+
+void paint_reset_entry_stats()
+{
+	_paintEntriesHighWaterMark = 0;
+}
+
+/**
+ * Gets the entry the next paint struct goes in, moving on to the next chunk when the current one is full. The entry is
+ * only taken once next_free_paint_struct is incremented, so it is the same entry until then.
+ */
+static paint_entry * paint_session_get_free_entry(paint_session * session)
+{
+	if (session->next_free_paint_struct >= session->end_of_paint_struct_array) {
+		paint_entry_chunk * chunk = session->current_chunk;
+		if (chunk == NULL) {
+			// The first chunk could not be allocated
+			return NULL;
+		}
+		if (chunk->next == NULL) {
+			chunk->next = malloc(sizeof(paint_entry_chunk));
+			if (chunk->next == NULL) {
+				return NULL;
+			}
+			chunk->next->next = NULL;
+			_paintEntryChunksCount++;
+		}
+		chunk = chunk->next;
+		session->current_chunk = chunk;
+		session->num_full_chunks++;
+		session->next_free_paint_struct = chunk->entries;
+		session->end_of_paint_struct_array = chunk->entries + PAINT_ENTRY_CHUNK_SIZE;
+	}
+	return session->next_free_paint_struct;
+}
+
+#ifndef NO_RCT2
+/**
+ * Copies the state of the session into the original game's paint globals, for before calling an original paint function.
+ */
+void paint_session_store_rct2(paint_session * session)
+{
+	// The original functions add paint structs without going through the recorded calls
+	paint_cache_disallow();
+
+	// Makes sure there is room in the current chunk, the original functions can not move on to the next one
+	paint_session_get_free_entry(session);
+	RCT2_GLOBAL(0x00EE7888, paint_entry *) = session->next_free_paint_struct;
+	RCT2_GLOBAL(0x00EE7880, paint_entry *) = session->end_of_paint_struct_array;
+	memcpy(RCT2_ADDRESS(0x00F1A50C, paint_struct *), session->quadrants, sizeof(session->quadrants));
+	RCT2_GLOBAL(0x00F1AD0C, uint32) = session->quadrant_back_index;
+	RCT2_GLOBAL(0x00F1AD10, uint32) = session->quadrant_front_index;
+	RCT2_GLOBAL(0x00F1AD28, paint_struct *) = session->last_root_ps;
+	RCT2_GLOBAL(0x00F1AD2C, attached_paint_struct *) = session->last_attached_ps;
+}
+
+/**
+ * Copies the original game's paint globals back into the session, for after calling an original paint function.
+ */
+void paint_session_load_rct2(paint_session * session)
+{
+	session->next_free_paint_struct = RCT2_GLOBAL(0x00EE7888, paint_entry *);
+	memcpy(session->quadrants, RCT2_ADDRESS(0x00F1A50C, paint_struct *), sizeof(session->quadrants));
+	session->quadrant_back_index = RCT2_GLOBAL(0x00F1AD0C, uint32);
+	session->quadrant_front_index = RCT2_GLOBAL(0x00F1AD10, uint32);
+	session->last_root_ps = RCT2_GLOBAL(0x00F1AD28, paint_struct *);
+	session->last_attached_ps = RCT2_GLOBAL(0x00F1AD2C, attached_paint_struct *);
+}
+#endif
+
+/**
+ * Empties the session and makes it the one paint structs are added to, the dpi is copied into the session.
  *
  *  rct2: 0x0068615B
  */
-void paint_init(rct_drawpixelinfo * dpi)
+void paint_init(paint_session * session, const rct_drawpixelinfo * dpi)
 {
-	unk_140E9A8 = dpi;
-	gEndOfPaintStructArray = &gPaintStructs[4000 - 1];
-	gNextFreePaintStruct = gPaintStructs;
-	g_ps_F1AD28 = NULL;
-	g_aps_F1AD2C = NULL;
-	for (sint32 i = 0; i < 512; i++) {
-		_paintQuadrants[i] = NULL;
+	_paintEntriesHighWaterMark = max(_paintEntriesHighWaterMark, paint_session_get_num_entries(session));
+	if (session->first_chunk == NULL) {
+		session->first_chunk = malloc(sizeof(paint_entry_chunk));
+		if (session->first_chunk != NULL) {
+			session->first_chunk->next = NULL;
+			_paintEntryChunksCount++;
+		}
+	}
+
+	gPaintSession = session;
+	session->dpi = *dpi;
+	unk_140E9A8 = &session->dpi;
+	session->current_chunk = session->first_chunk;
+	session->num_full_chunks = 0;
+	if (session->first_chunk != NULL) {
+		session->next_free_paint_struct = session->first_chunk->entries;
+		session->end_of_paint_struct_array = session->first_chunk->entries + PAINT_ENTRY_CHUNK_SIZE;
+	} else {
+		// Like a full chunk that can not grow, nothing is painted
+		session->next_free_paint_struct = NULL;
+		session->end_of_paint_struct_array = NULL;
 	}
-	_paintQuadrantBackIndex = -1;
-	_paintQuadrantFrontIndex = 0;
-	gPaintPSStringHead = NULL;
-	_paintLastPSString = NULL;
+	session->last_root_ps = NULL;
+	session->last_attached_ps = NULL;
+	for (sint32 i = 0; i < MAX_PAINT_QUADRANTS; i++) {
+		session->quadrants[i] = NULL;
+	}
+	session->quadrant_back_index = -1;
+	session->quadrant_front_index = 0;
+	session->ps_string_head = NULL;
+	session->last_ps_string = NULL;
 	gWoodenSupportsPrependTo = NULL;
 }
 
-static void paint_add_ps_to_quadrant(paint_struct * ps, sint32 positionHash)
+static void paint_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
 {
 	uint32 paintQuadrantIndex = clamp(0, positionHash / 32, MAX_PAINT_QUADRANTS - 1);
 
 	ps->var_18 = paintQuadrantIndex;
-	ps->next_quadrant_ps = _paintQuadrants[paintQuadrantIndex];
-	_paintQuadrants[paintQuadrantIndex] = ps;
+	ps->next_quadrant_ps = session->quadrants[paintQuadrantIndex];
+	session->quadrants[paintQuadrantIndex] = ps;
 
-	_paintQuadrantBackIndex = min(_paintQuadrantBackIndex, paintQuadrantIndex);
-	_paintQuadrantFrontIndex = max(_paintQuadrantFrontIndex, paintQuadrantIndex);
+	session->quadrant_back_index = min(session->quadrant_back_index, paintQuadrantIndex);
+	session->quadrant_front_index = max(session->quadrant_front_index, paintQuadrantIndex);
 }
 
 /**
  * Extracted from 0x0098196c, 0x0098197c, 0x0098198c, 0x0098199c
  */
-static paint_struct * sub_9819_c(uint32 image_id, rct_xyz16 offset, rct_xyz16 boundBoxSize, rct_xyz16 boundBoxOffset, uint8 rotation)
+static paint_struct * sub_9819_c(paint_session * session, uint32 image_id, rct_xyz16 offset, rct_xyz16 boundBoxSize, rct_xyz16 boundBoxOffset, uint8 rotation)
 {
-	if (gNextFreePaintStruct >= gEndOfPaintStructArray) return NULL;
-	paint_struct * ps = &gNextFreePaintStruct->basic;
+	paint_entry * entry = paint_session_get_free_entry(session);
+	if (entry == NULL) return NULL;
+	paint_struct * ps = &entry->basic;
 
 	ps->image_id = image_id;
 
@@ -153,7 +387,7 @@ static paint_struct * sub_9819_c(uint32 image_id, rct_xyz16 offset, rct_xyz16 bo
 	sint32 right = left + g1Element->width;
 	sint32 top = bottom + g1Element->height;
 
-	rct_drawpixelinfo * dpi = unk_140E9A8;
+	rct_drawpixelinfo * dpi = &session->dpi;
 
 	if (right <= dpi->x)return NULL;
 	if (top <= dpi->y)return NULL;
@@ -215,7 +449,8 @@ static paint_struct * sub_9819_c(uint32 image_id, rct_xyz16 offset, rct_xyz16 bo
  * @param rotation (ebp)
  * @return (ebp) paint_struct on success (CF == 0), NULL on failure (CF == 1)
  */
-paint_struct * sub_98196C(
+static paint_struct * paint_98196C(
+	paint_session * session,
 	uint32 image_id,
 	sint8 x_offset, sint8 y_offset,
 	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
@@ -225,14 +460,15 @@ paint_struct * sub_98196C(
 	assert((uint16) bound_box_length_x == (sint16) bound_box_length_x);
 	assert((uint16) bound_box_length_y == (sint16) bound_box_length_y);
 
-	g_ps_F1AD28 = 0;
-	g_aps_F1AD2C = NULL;
+	session->last_root_ps = NULL;
+	session->last_attached_ps = NULL;
 
-	if (gNextFreePaintStruct >= gEndOfPaintStructArray) {
+	paint_entry * entry = paint_session_get_free_entry(session);
+	if (entry == NULL) {
 		return NULL;
 	}
 
-	paint_struct *ps = &gNextFreePaintStruct->basic;
+	paint_struct *ps = &entry->basic;
 	ps->image_id = image_id;
 
 	uint32 image_element = image_id & 0x7FFFF;
@@ -300,7 +536,7 @@ paint_struct * sub_98196C(
 	sint16 right = left + g1Element->width;
 	sint16 top = bottom + g1Element->height;
 
-	rct_drawpixelinfo *dpi = unk_140E9A8;
+	rct_drawpixelinfo *dpi = &session->dpi;
 
 	if (right <= dpi->x) return NULL;
 	if (top <= dpi->y) return NULL;
@@ -318,7 +554,7 @@ paint_struct * sub_98196C(
 	ps->map_y = gPaintMapPosition.y;
 	ps->mapElement = g_currently_drawn_item;
 
-	g_ps_F1AD28 = ps;
+	session->last_root_ps = ps;
 
 	sint32 positionHash = 0;
 	switch (rotation) {
@@ -335,9 +571,9 @@ paint_struct * sub_98196C(
 		positionHash = coord_3d.x - coord_3d.y + 0x2000;
 		break;
 	}
-	paint_add_ps_to_quadrant(ps, positionHash);
+	paint_add_ps_to_quadrant(session, ps, positionHash);
 
-	gNextFreePaintStruct++;
+	session->next_free_paint_struct++;
 
 	return ps;
 }
@@ -358,7 +594,8 @@ paint_struct * sub_98196C(
  * @param rotation (ebp)
  * @return (ebp) paint_struct on success (CF == 0), NULL on failure (CF == 1)
  */
-paint_struct * sub_98197C(
+static paint_struct * paint_98197C(
+	paint_session * session,
 	uint32 image_id,
 	sint8 x_offset, sint8 y_offset,
 	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
@@ -366,20 +603,19 @@ paint_struct * sub_98197C(
 	sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z,
 	uint32 rotation
 ) {
-
-	g_ps_F1AD28 = 0;
-	g_aps_F1AD2C = NULL;
+	session->last_root_ps = NULL;
+	session->last_attached_ps = NULL;
 
 	rct_xyz16 offset = {.x = x_offset, .y = y_offset, .z = z_offset};
 	rct_xyz16 boundBoxSize = {.x = bound_box_length_x, .y = bound_box_length_y, .z = bound_box_length_z};
 	rct_xyz16 boundBoxOffset = {.x = bound_box_offset_x, .y = bound_box_offset_y, .z = bound_box_offset_z};
-	paint_struct * ps = sub_9819_c(image_id, offset, boundBoxSize, boundBoxOffset, rotation);
+	paint_struct * ps = sub_9819_c(session, image_id, offset, boundBoxSize, boundBoxOffset, rotation);
 
 	if (ps == NULL) {
 		return NULL;
 	}
 
-	g_ps_F1AD28 = ps;
+	session->last_root_ps = ps;
 
 	rct_xy16 attach = {
 		.x = ps->bound_box_x,
@@ -400,9 +636,9 @@ paint_struct * sub_98197C(
 	}
 
 	sint32 positionHash = attach.x + attach.y;
-	paint_add_ps_to_quadrant(ps, positionHash);
+	paint_add_ps_to_quadrant(session, ps, positionHash);
 
-	gNextFreePaintStruct++;
+	session->next_free_paint_struct++;
 	return ps;
 }
 
@@ -423,7 +659,8 @@ paint_struct * sub_98197C(
  * @param rotation (ebp)
  * @return (ebp) paint_struct on success (CF == 0), NULL on failure (CF == 1)
  */
-paint_struct * sub_98198C(
+static paint_struct * paint_98198C(
+	paint_session * session,
 	uint32 image_id,
 	sint8 x_offset, sint8 y_offset,
 	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
@@ -434,20 +671,20 @@ paint_struct * sub_98198C(
 	assert((uint16) bound_box_length_x == (sint16) bound_box_length_x);
 	assert((uint16) bound_box_length_y == (sint16) bound_box_length_y);
 
-	g_ps_F1AD28 = 0;
-	g_aps_F1AD2C = NULL;
+	session->last_root_ps = NULL;
+	session->last_attached_ps = NULL;
 
 	rct_xyz16 offset = {.x = x_offset, .y = y_offset, .z = z_offset};
 	rct_xyz16 boundBoxSize = {.x = bound_box_length_x, .y = bound_box_length_y, .z = bound_box_length_z};
 	rct_xyz16 boundBoxOffset = {.x = bound_box_offset_x, .y = bound_box_offset_y, .z = bound_box_offset_z};
-	paint_struct * ps = sub_9819_c(image_id, offset, boundBoxSize, boundBoxOffset, rotation);
+	paint_struct * ps = sub_9819_c(session, image_id, offset, boundBoxSize, boundBoxOffset, rotation);
 
 	if (ps == NULL) {
 		return NULL;
 	}
 
-	g_ps_F1AD28 = ps;
-	gNextFreePaintStruct++;
+	session->last_root_ps = ps;
+	session->next_free_paint_struct++;
 	return ps;
 }
 
@@ -468,7 +705,8 @@ paint_struct * sub_98198C(
  * @param rotation (ebp)
  * @return (ebp) paint_struct on success (CF == 0), NULL on failure (CF == 1)
  */
-paint_struct * sub_98199C(
+static paint_struct * paint_98199C(
+	paint_session * session,
 	uint32 image_id,
 	sint8 x_offset, sint8 y_offset,
 	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
@@ -479,8 +717,9 @@ paint_struct * sub_98199C(
 	assert((uint16) bound_box_length_x == (sint16) bound_box_length_x);
 	assert((uint16) bound_box_length_y == (sint16) bound_box_length_y);
 
-	if (g_ps_F1AD28 == NULL) {
-		return sub_98197C(
+	if (session->last_root_ps == NULL) {
+		return paint_98197C(
+			session,
 			image_id,
 			x_offset, y_offset,
 			bound_box_length_x, bound_box_length_y, bound_box_length_z,
@@ -493,17 +732,17 @@ paint_struct * sub_98199C(
 	rct_xyz16 offset = {.x = x_offset, .y = y_offset, .z = z_offset};
 	rct_xyz16 boundBox = {.x = bound_box_length_x, .y = bound_box_length_y, .z = bound_box_length_z};
 	rct_xyz16 boundBoxOffset = {.x = bound_box_offset_x, .y = bound_box_offset_y, .z = bound_box_offset_z};
-	paint_struct * ps = sub_9819_c(image_id, offset, boundBox, boundBoxOffset, rotation);
+	paint_struct * ps = sub_9819_c(session, image_id, offset, boundBox, boundBoxOffset, rotation);
 
 	if (ps == NULL) {
 		return NULL;
 	}
 
-	paint_struct *old_ps = g_ps_F1AD28;
+	paint_struct *old_ps = session->last_root_ps;
 	old_ps->var_20 = ps;
 
-	g_ps_F1AD28 = ps;
-	gNextFreePaintStruct++;
+	session->last_root_ps = ps;
+	session->next_free_paint_struct++;
 	return ps;
 }
 
@@ -515,29 +754,30 @@ paint_struct * sub_98199C(
  * @param y (cx)
  * @return (!CF) success
  */
-bool paint_attach_to_previous_attach(uint32 image_id, uint16 x, uint16 y)
+static bool paint_attach_to_attach(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
-	if (g_aps_F1AD2C == NULL) {
-		return paint_attach_to_previous_ps(image_id, x, y);
+	if (session->last_attached_ps == NULL) {
+		return paint_attach_to_ps(session, image_id, x, y);
 	}
 
-	if (gNextFreePaintStruct >= gEndOfPaintStructArray) {
+	paint_entry * entry = paint_session_get_free_entry(session);
+	if (entry == NULL) {
 		return false;
 	}
-	attached_paint_struct * ps = &gNextFreePaintStruct->attached;
+	attached_paint_struct * ps = &entry->attached;
 	ps->image_id = image_id;
 	ps->x = x;
 	ps->y = y;
 	ps->flags = 0;
 
-	attached_paint_struct * ebx = g_aps_F1AD2C;
+	attached_paint_struct * ebx = session->last_attached_ps;
 
 	ps->next = NULL;
 	ebx->next = ps;
 
-	g_aps_F1AD2C = ps;
+	session->last_attached_ps = ps;
 
-	gNextFreePaintStruct++;
+	session->next_free_paint_struct++;
 
 	return true;
 }
@@ -550,35 +790,400 @@ bool paint_attach_to_previous_attach(uint32 image_id, uint16 x, uint16 y)
  * @param y (cx)
  * @return (!CF) success
  */
-bool paint_attach_to_previous_ps(uint32 image_id, uint16 x, uint16 y)
+static bool paint_attach_to_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
-	if (gNextFreePaintStruct >= gEndOfPaintStructArray) {
+	paint_entry * entry = paint_session_get_free_entry(session);
+	if (entry == NULL) {
 		return false;
 	}
-	attached_paint_struct * ps = &gNextFreePaintStruct->attached;
+	attached_paint_struct * ps = &entry->attached;
 
 	ps->image_id = image_id;
 	ps->x = x;
 	ps->y = y;
 	ps->flags = 0;
 
-	paint_struct * masterPs = g_ps_F1AD28;
+	paint_struct * masterPs = session->last_root_ps;
 	if (masterPs == NULL) {
 		return false;
 	}
 
-	gNextFreePaintStruct++;
+	session->next_free_paint_struct++;
 
 	attached_paint_struct * oldFirstAttached = masterPs->attached_ps;
 	masterPs->attached_ps = ps;
 
 	ps->next = oldFirstAttached;
 
-	g_aps_F1AD2C = ps;
+	session->last_attached_ps = ps;
+
+	return true;
+}
+
+/**
+ * Adds a call to the calls recorded for the tile being painted, unless nothing is recorded.
+ */
+static paint_cache_op * paint_cache_push_op(uint8 type, uint32 image_id)
+{
+	if (_paintCacheRecordingTile == NULL || _paintCacheRecordingDisallowed) {
+		return NULL;
+	}
+
+	if (_paintCacheOpsCount >= _paintCacheOpsCapacity) {
+		size_t newCapacity = max(_paintCacheOpsCapacity * 2, 64);
+		paint_cache_op * newOps = realloc(_paintCacheOps, newCapacity * sizeof(paint_cache_op));
+		if (newOps == NULL) {
+			_paintCacheRecordingDisallowed = true;
+			return NULL;
+		}
+		_paintCacheOps = newOps;
+		_paintCacheOpsCapacity = newCapacity;
+	}
+
+	paint_cache_op * op = &_paintCacheOps[_paintCacheOpsCount++];
+	op->type = type;
+	op->flags = 0;
+	op->image_id = image_id;
+	op->colour = 0;
+	op->drawn_item = g_currently_drawn_item;
+	op->map_position = gPaintMapPosition;
+	op->origin_x = gUnk9DE568;
+	op->origin_y = gUnk9DE56C;
+	op->interaction_type = gPaintInteractionType;
+	return op;
+}
+
+static void paint_cache_push_ps_op(
+	uint8 type,
+	uint32 image_id,
+	sint8 x_offset, sint8 y_offset,
+	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
+	sint16 z_offset,
+	sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z,
+	uint32 rotation
+) {
+	paint_cache_op * op = paint_cache_push_op(type, image_id);
+	if (op == NULL) {
+		return;
+	}
+
+	op->x = x_offset;
+	op->y = y_offset;
+	op->z_offset = z_offset;
+	op->bound_box_length_x = bound_box_length_x;
+	op->bound_box_length_y = bound_box_length_y;
+	op->bound_box_length_z = bound_box_length_z;
+	op->bound_box_offset_x = bound_box_offset_x;
+	op->bound_box_offset_y = bound_box_offset_y;
+	op->bound_box_offset_z = bound_box_offset_z;
+	op->rotation = (uint8)rotation;
+}
+
+static void paint_cache_push_attach_op(uint8 type, uint32 image_id, uint16 x, uint16 y)
+{
+	paint_cache_op * op = paint_cache_push_op(type, image_id);
+	if (op != NULL) {
+		op->x = x;
+		op->y = y;
+	}
+}
+
+paint_struct * sub_98196C(
+	uint32 image_id,
+	sint8 x_offset, sint8 y_offset,
+	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
+	sint16 z_offset,
+	uint32 rotation
+) {
+	paint_cache_push_ps_op(PAINT_CACHE_OP_98196C, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, 0, 0, 0, rotation);
+	return paint_98196C(gPaintSession, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, rotation);
+}
+
+paint_struct * sub_98197C(
+	uint32 image_id,
+	sint8 x_offset, sint8 y_offset,
+	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
+	sint16 z_offset,
+	sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z,
+	uint32 rotation
+) {
+	paint_cache_push_ps_op(PAINT_CACHE_OP_98197C, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, bound_box_offset_x, bound_box_offset_y, bound_box_offset_z, rotation);
+	return paint_98197C(gPaintSession, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, bound_box_offset_x, bound_box_offset_y, bound_box_offset_z, rotation);
+}
+
+paint_struct * sub_98198C(
+	uint32 image_id,
+	sint8 x_offset, sint8 y_offset,
+	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
+	sint16 z_offset,
+	sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z,
+	uint32 rotation
+) {
+	paint_cache_push_ps_op(PAINT_CACHE_OP_98198C, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, bound_box_offset_x, bound_box_offset_y, bound_box_offset_z, rotation);
+	return paint_98198C(gPaintSession, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, bound_box_offset_x, bound_box_offset_y, bound_box_offset_z, rotation);
+}
+
+paint_struct * sub_98199C(
+	uint32 image_id,
+	sint8 x_offset, sint8 y_offset,
+	sint16 bound_box_length_x, sint16 bound_box_length_y, sint8 bound_box_length_z,
+	sint16 z_offset,
+	sint16 bound_box_offset_x, sint16 bound_box_offset_y, sint16 bound_box_offset_z,
+	uint32 rotation
+) {
+	paint_cache_push_ps_op(PAINT_CACHE_OP_98199C, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, bound_box_offset_x, bound_box_offset_y, bound_box_offset_z, rotation);
+	return paint_98199C(gPaintSession, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset, bound_box_offset_x, bound_box_offset_y, bound_box_offset_z, rotation);
+}
+
+bool paint_attach_to_previous_attach(uint32 image_id, uint16 x, uint16 y)
+{
+	paint_cache_push_attach_op(PAINT_CACHE_OP_ATTACH_TO_ATTACH, image_id, x, y);
+	return paint_attach_to_attach(gPaintSession, image_id, x, y);
+}
 
+bool paint_attach_to_previous_ps(uint32 image_id, uint16 x, uint16 y)
+{
+	paint_cache_push_attach_op(PAINT_CACHE_OP_ATTACH_TO_PS, image_id, x, y);
+	return paint_attach_to_ps(gPaintSession, image_id, x, y);
+}
+
+/**
+ * Attaches an image used as the mask of another image to the last paint struct added.
+ */
+bool paint_attach_masked_to_previous_ps(uint32 image_id, uint32 colour_image_id, uint16 x, uint16 y)
+{
+	paint_cache_push_attach_op(PAINT_CACHE_OP_ATTACH_TO_PS, image_id, x, y);
+	if (_paintCacheRecordingTile != NULL && !_paintCacheRecordingDisallowed) {
+		paint_cache_op * op = &_paintCacheOps[_paintCacheOpsCount - 1];
+		op->flags |= PAINT_CACHE_OP_FLAG_MASKED;
+		op->colour = colour_image_id;
+	}
+
+	paint_session * session = gPaintSession;
+	if (!paint_attach_to_ps(session, image_id, x, y)) {
+		return false;
+	}
+
+	attached_paint_struct * ps = session->last_attached_ps;
+	ps->colour_image_id = colour_image_id;
+	ps->flags |= PAINT_STRUCT_FLAG_IS_MASKED;
 	return true;
 }
 
+/**
+ * Sets the tertiary colour of the paint struct just added, ps is NULL when it was not added.
+ */
+void paint_util_set_tertiary_colour(paint_struct * ps, uint32 colour)
+{
+	if (_paintCacheRecordingTile != NULL && !_paintCacheRecordingDisallowed && _paintCacheOpsCount > 0) {
+		paint_cache_op * op = &_paintCacheOps[_paintCacheOpsCount - 1];
+		op->flags |= PAINT_CACHE_OP_FLAG_TERTIARY_COLOUR;
+		op->colour = colour;
+	}
+
+	if (ps != NULL) {
+		ps->tertiary_colour = colour;
+	}
+}
+
+/**
+ * Checks whether the paint setup functions could paint static map elements differently than when the cached tiles
+ * were recorded.
+ */
+static void paint_cache_update_state()
+{
+	_paintCacheEnabled =
+		gConfigGeneral.paint_tile_cache &&
+		!(gScreenFlags & SCREEN_FLAGS_EDITOR) &&
+		!gTrackDesignSaveMode &&
+		gStaffDrawPatrolAreas == 0xFFFF &&
+		!(gMapSelectFlags & (MAP_SELECT_FLAG_ENABLE | MAP_SELECT_FLAG_ENABLE_CONSTRUCT));
+	if (!_paintCacheEnabled) {
+		return;
+	}
+
+	if (memcmp(&_paintCacheConfig, &gConfigGeneral, sizeof(general_configuration)) != 0 ||
+		_paintCacheSandboxMode != gCheatsSandboxMode ||
+		_paintCacheMapBaseZ != gMapBaseZ
+	) {
+		_paintCacheConfig = gConfigGeneral;
+		_paintCacheSandboxMode = gCheatsSandboxMode;
+		_paintCacheMapBaseZ = gMapBaseZ;
+		paint_cache_invalidate();
+	}
+}
+
+/**
+ * Marks every cached tile as out of date.
+ */
+void paint_cache_invalidate()
+{
+	_paintCacheGeneration++;
+}
+
+/**
+ * Marks the cached tile and its neighbours as out of date, as surfaces are painted depending on the tiles around them.
+ * @param x tile x coordinate
+ * @param y tile y coordinate
+ */
+void paint_cache_invalidate_tile(sint32 x, sint32 y)
+{
+	for (sint32 ty = y - 1; ty <= y + 1; ty++) {
+		if (ty < 0 || ty >= MAXIMUM_MAP_SIZE_TECHNICAL) {
+			continue;
+		}
+		for (sint32 tx = x - 1; tx <= x + 1; tx++) {
+			if (tx < 0 || tx >= MAXIMUM_MAP_SIZE_TECHNICAL) {
+				continue;
+			}
+			_paintCacheTiles[tx + ty * MAXIMUM_MAP_SIZE_TECHNICAL].generation = 0;
+		}
+	}
+}
+
+static void paint_cache_replay_op(paint_session * session, const paint_cache_op * op)
+{
+	g_currently_drawn_item = op->drawn_item;
+	gPaintMapPosition = op->map_position;
+	gUnk9DE568 = op->origin_x;
+	gUnk9DE56C = op->origin_y;
+	gPaintInteractionType = op->interaction_type;
+
+	paint_struct * ps = NULL;
+	switch (op->type) {
+	case PAINT_CACHE_OP_98196C:
+		ps = paint_98196C(session, op->image_id, (sint8)op->x, (sint8)op->y, op->bound_box_length_x, op->bound_box_length_y, op->bound_box_length_z, op->z_offset, op->rotation);
+		break;
+	case PAINT_CACHE_OP_98197C:
+		ps = paint_98197C(session, op->image_id, (sint8)op->x, (sint8)op->y, op->bound_box_length_x, op->bound_box_length_y, op->bound_box_length_z, op->z_offset, op->bound_box_offset_x, op->bound_box_offset_y, op->bound_box_offset_z, op->rotation);
+		break;
+	case PAINT_CACHE_OP_98198C:
+		ps = paint_98198C(session, op->image_id, (sint8)op->x, (sint8)op->y, op->bound_box_length_x, op->bound_box_length_y, op->bound_box_length_z, op->z_offset, op->bound_box_offset_x, op->bound_box_offset_y, op->bound_box_offset_z, op->rotation);
+		break;
+	case PAINT_CACHE_OP_98199C:
+		ps = paint_98199C(session, op->image_id, (sint8)op->x, (sint8)op->y, op->bound_box_length_x, op->bound_box_length_y, op->bound_box_length_z, op->z_offset, op->bound_box_offset_x, op->bound_box_offset_y, op->bound_box_offset_z, op->rotation);
+		break;
+	case PAINT_CACHE_OP_ATTACH_TO_PS:
+		if (paint_attach_to_ps(session, op->image_id, op->x, op->y) && (op->flags & PAINT_CACHE_OP_FLAG_MASKED)) {
+			session->last_attached_ps->colour_image_id = op->colour;
+			session->last_attached_ps->flags |= PAINT_STRUCT_FLAG_IS_MASKED;
+		}
+		return;
+	case PAINT_CACHE_OP_ATTACH_TO_ATTACH:
+		paint_attach_to_attach(session, op->image_id, op->x, op->y);
+		return;
+	}
+
+	if (ps != NULL && (op->flags & PAINT_CACHE_OP_FLAG_TERTIARY_COLOUR)) {
+		ps->tertiary_colour = op->colour;
+	}
+}
+
+/**
+ * Paints the elements of a tile from the calls recorded the last time they were painted. Starts recording the calls
+ * when the tile has not been recorded for the current view.
+ * @param x map x coordinate
+ * @param y map y coordinate
+ * @return true when the tile was painted from the cache
+ */
+bool paint_cache_begin_tile(sint32 x, sint32 y)
+{
+	if (!_paintCacheEnabled) {
+		return false;
+	}
+
+	paint_session * session = gPaintSession;
+	paint_cache_tile * tile = &_paintCacheTiles[(x >> 5) + (y >> 5) * MAXIMUM_MAP_SIZE_TECHNICAL];
+	if (tile->generation == _paintCacheGeneration &&
+		tile->rotation == get_current_rotation() &&
+		tile->zoom_level == session->dpi.zoom_level &&
+		tile->view_flags == gCurrentViewportFlags
+	) {
+		paint_cache_tile_state * state = tile->state;
+		if (state == NULL) {
+			return false;
+		}
+
+		const paint_cache_op * ops = (const paint_cache_op *)(state + 1);
+		for (uint16 i = 0; i < tile->num_ops; i++) {
+			paint_cache_replay_op(session, &ops[i]);
+		}
+
+		gSupport = state->support;
+		memcpy(gSupportSegments, state->support_segments, sizeof(state->support_segments));
+		gSurfaceElement = state->surface_element;
+		g_currently_drawn_item = state->drawn_item;
+		gPaintMapPosition = state->map_position;
+		gUnk9DE568 = state->origin_x;
+		gUnk9DE56C = state->origin_y;
+		gUnk141E9DC = state->unk_141E9DC;
+		gPaintInteractionType = state->interaction_type;
+		gVerticalTunnelHeight = state->vertical_tunnel_height;
+		g141E9DB = state->unk_141E9DB;
+		gDidPassSurface = state->did_pass_surface;
+		return true;
+	}
+
+	_paintCacheRecordingTile = tile;
+	_paintCacheRecordingDisallowed = false;
+	_paintCacheOpsCount = 0;
+	return false;
+}
+
+/**
+ * Stores the calls recorded since paint_cache_begin_tile and the paint globals they left behind.
+ */
+void paint_cache_end_tile()
+{
+	paint_cache_tile * tile = _paintCacheRecordingTile;
+	if (tile == NULL) {
+		return;
+	}
+	_paintCacheRecordingTile = NULL;
+
+	SafeFree(tile->state);
+	tile->generation = _paintCacheGeneration;
+	tile->rotation = get_current_rotation();
+	tile->zoom_level = gPaintSession->dpi.zoom_level;
+	tile->view_flags = gCurrentViewportFlags;
+	tile->num_ops = 0;
+
+	if (_paintCacheRecordingDisallowed || _paintCacheOpsCount > UINT16_MAX) {
+		return;
+	}
+
+	paint_cache_tile_state * state = malloc(sizeof(paint_cache_tile_state) + _paintCacheOpsCount * sizeof(paint_cache_op));
+	if (state == NULL) {
+		return;
+	}
+
+	state->support = gSupport;
+	memcpy(state->support_segments, gSupportSegments, sizeof(state->support_segments));
+	state->surface_element = gSurfaceElement;
+	state->drawn_item = g_currently_drawn_item;
+	state->map_position = gPaintMapPosition;
+	state->origin_x = gUnk9DE568;
+	state->origin_y = gUnk9DE56C;
+	state->unk_141E9DC = gUnk141E9DC;
+	state->interaction_type = gPaintInteractionType;
+	state->vertical_tunnel_height = gVerticalTunnelHeight;
+	state->unk_141E9DB = g141E9DB;
+	state->did_pass_surface = gDidPassSurface;
+	memcpy(state + 1, _paintCacheOps, _paintCacheOpsCount * sizeof(paint_cache_op));
+
+	tile->state = state;
+	tile->num_ops = (uint16)_paintCacheOpsCount;
+}
+
+/**
+ * Stops the tile being painted from being cached, for paint setup functions that paint differently over time or
+ * change the paint structs in ways the recorded calls do not capture.
+ */
+void paint_cache_disallow()
+{
+	_paintCacheRecordingDisallowed = true;
+}
+
 /**
  * rct2: 0x00685EBC, 0x00686046, 0x00685FC8, 0x00685F4A, 0x00685ECC
  * @param amount (eax)
@@ -591,10 +1196,14 @@ bool paint_attach_to_previous_ps(uint32 image_id, uint16 x, uint16 y)
  */
 void sub_685EBC(money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation)
 {
-	if (gNextFreePaintStruct >= gEndOfPaintStructArray) {
+	paint_cache_disallow();
+
+	paint_session * session = gPaintSession;
+	paint_entry * entry = paint_session_get_free_entry(session);
+	if (entry == NULL) {
 		return;
 	}
-	paint_string_struct * ps = &gNextFreePaintStruct->string;
+	paint_string_struct * ps = &entry->string;
 
 	ps->string_id = string_id;
 	ps->next = 0;
@@ -610,22 +1219,26 @@ void sub_685EBC(money32 amount, rct_string_id string_id, sint16 y, sint16 z, sin
 	ps->x = coord.x + offset_x;
 	ps->y = coord.y;
 
-	gNextFreePaintStruct++;
+	session->next_free_paint_struct++;
 
-	if (_paintLastPSString == NULL) {
-		gPaintPSStringHead = ps;
+	if (session->last_ps_string == NULL) {
+		session->ps_string_head = ps;
 	} else {
-		_paintLastPSString->next = ps;
+		session->last_ps_string->next = ps;
 	}
-	_paintLastPSString = ps;
+	session->last_ps_string = ps;
 }
 
 /**
  *
  *  rct2: 0x0068B6C2
  */
-void paint_generate_structs(rct_drawpixelinfo * dpi)
+void paint_generate_structs(paint_session * session)
 {
+	rct_drawpixelinfo * dpi = &session->dpi;
+
+	paint_cache_update_state();
+
 	rct_xy16 mapTile = {
 		.x = dpi->x & 0xFFE0,
 		.y = (dpi->y - 16) & 0xFFE0
@@ -729,16 +1342,44 @@ void paint_generate_structs(rct_drawpixelinfo * dpi)
 	}
 }
 
-static void paint_arrange_structs_helper(paint_struct * ps_next, uint16 ax, uint8 flag)
+/**
+ * Checks whether the bounding box of a paint struct is in front of another one, in which case the other paint struct
+ * has to be drawn first. The rotation is always a constant, so each caller gets its own comparison.
+ */
+static inline bool paint_is_in_front_of(const paint_struct * ps, const paint_struct * ps_other, uint8 rotation)
+{
+	switch (rotation) {
+	case 0:
+		return ps->bound_box_z_end >= ps_other->bound_box_z && ps->bound_box_y_end >= ps_other->bound_box_y && ps->bound_box_x_end >= ps_other->bound_box_x
+			&& !(ps->bound_box_z < ps_other->bound_box_z_end && ps->bound_box_y < ps_other->bound_box_y_end && ps->bound_box_x < ps_other->bound_box_x_end);
+	case 1:
+		return ps->bound_box_z_end >= ps_other->bound_box_z && ps->bound_box_y_end >= ps_other->bound_box_y && ps->bound_box_x_end < ps_other->bound_box_x
+			&& !(ps->bound_box_z < ps_other->bound_box_z_end && ps->bound_box_y < ps_other->bound_box_y_end && ps->bound_box_x >= ps_other->bound_box_x_end);
+	case 2:
+		return ps->bound_box_z_end >= ps_other->bound_box_z && ps->bound_box_y_end < ps_other->bound_box_y && ps->bound_box_x_end < ps_other->bound_box_x
+			&& !(ps->bound_box_z < ps_other->bound_box_z_end && ps->bound_box_y >= ps_other->bound_box_y_end && ps->bound_box_x >= ps_other->bound_box_x_end);
+	default:
+		return ps->bound_box_z_end >= ps_other->bound_box_z && ps->bound_box_y_end < ps_other->bound_box_y && ps->bound_box_x_end >= ps_other->bound_box_x
+			&& !(ps->bound_box_z < ps_other->bound_box_z_end && ps->bound_box_y >= ps_other->bound_box_y_end && ps->bound_box_x < ps_other->bound_box_x_end);
+	}
+}
+
+/**
+ * Sorts the paint structs of quadrant ax and ax + 1, starting the search for quadrant ax at ps_next. All paint
+ * structs before the returned one are in earlier quadrants and are never touched again, so the next quadrant can
+ * start from there instead of from the head of the list.
+ */
+static inline paint_struct * paint_arrange_structs_helper_rotation(paint_struct * ps_next, uint16 ax, uint8 flag, uint8 rotation)
 {
 	paint_struct * ps;
 	paint_struct * ps_temp;
 	do {
 		ps = ps_next;
 		ps_next = ps_next->next_quadrant_ps;
-		if (ps_next == NULL) return;
+		if (ps_next == NULL) return ps;
 	} while (ax > ps_next->var_18);
 
+	paint_struct * ps_start = ps;
 	ps_temp = ps;
 	do {
 		ps = ps->next_quadrant_ps;
@@ -756,12 +1397,11 @@ static void paint_arrange_structs_helper(paint_struct * ps_next, uint16 ax, uint
 	} while (ps->var_18 <= ax + 1);
 	ps = ps_temp;
 
-	uint8 rotation = get_current_rotation();
 	while (true) {
 		while (true) {
 			ps_next = ps->next_quadrant_ps;
-			if (ps_next == NULL) return;
-			if (ps_next->var_1B & (1 << 7)) return;
+			if (ps_next == NULL) return ps_start;
+			if (ps_next->var_1B & (1 << 7)) return ps_start;
 			if (ps_next->var_1B & (1 << 0)) break;
 			ps = ps_next;
 		}
@@ -769,25 +1409,7 @@ static void paint_arrange_structs_helper(paint_struct * ps_next, uint16 ax, uint
 		ps_next->var_1B &= ~(1 << 0);
 		ps_temp = ps;
 
-		typedef struct bound_box {
-			uint16 x;
-			uint16 y;
-			uint16 z;
-			uint16 x_end;
-			uint16 y_end;
-			uint16 z_end;
-		} bound_box;
-
-		bound_box initialBBox = {
-			.x = ps_next->bound_box_x,
-			.y = ps_next->bound_box_y,
-			.z = ps_next->bound_box_z,
-			.x_end = ps_next->bound_box_x_end,
-			.y_end = ps_next->bound_box_y_end,
-			.z_end = ps_next->bound_box_z_end
-		};
-
-
+		const paint_struct * ps_initial = ps_next;
 		while (true) {
 			ps = ps_next;
 			ps_next = ps_next->next_quadrant_ps;
@@ -795,31 +1417,7 @@ static void paint_arrange_structs_helper(paint_struct * ps_next, uint16 ax, uint
 			if (ps_next->var_1B & (1 << 7)) break;
 			if (!(ps_next->var_1B & (1 << 1))) continue;
 
-			sint32 yes = 0;
-			switch (rotation) {
-			case 0:
-				if (initialBBox.z_end >= ps_next->bound_box_z && initialBBox.y_end >= ps_next->bound_box_y && initialBBox.x_end >= ps_next->bound_box_x
-					&& !(initialBBox.z < ps_next->bound_box_z_end && initialBBox.y < ps_next->bound_box_y_end && initialBBox.x < ps_next->bound_box_x_end))
-					yes = 1;
-				break;
-			case 1:
-				if (initialBBox.z_end >= ps_next->bound_box_z && initialBBox.y_end >= ps_next->bound_box_y && initialBBox.x_end < ps_next->bound_box_x
-					&& !(initialBBox.z < ps_next->bound_box_z_end && initialBBox.y < ps_next->bound_box_y_end && initialBBox.x >= ps_next->bound_box_x_end))
-					yes = 1;
-				break;
-			case 2:
-				if (initialBBox.z_end >= ps_next->bound_box_z && initialBBox.y_end < ps_next->bound_box_y && initialBBox.x_end < ps_next->bound_box_x
-					&& !(initialBBox.z < ps_next->bound_box_z_end && initialBBox.y >= ps_next->bound_box_y_end && initialBBox.x >= ps_next->bound_box_x_end))
-					yes = 1;
-				break;
-			case 3:
-				if (initialBBox.z_end >= ps_next->bound_box_z && initialBBox.y_end < ps_next->bound_box_y && initialBBox.x_end >= ps_next->bound_box_x
-					&& !(initialBBox.z < ps_next->bound_box_z_end && initialBBox.y >= ps_next->bound_box_y_end && initialBBox.x < ps_next->bound_box_x_end))
-					yes = 1;
-				break;
-			}
-
-			if (yes) {
+			if (paint_is_in_front_of(ps_initial, ps_next, rotation)) {
 				ps->next_quadrant_ps = ps_next->next_quadrant_ps;
 				paint_struct *ps_temp2 = ps_temp->next_quadrant_ps;
 				ps_temp->next_quadrant_ps = ps_next;
@@ -832,19 +1430,29 @@ static void paint_arrange_structs_helper(paint_struct * ps_next, uint16 ax, uint
 	}
 }
 
+static paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 ax, uint8 flag, uint8 rotation)
+{
+	switch (rotation) {
+	case 0: return paint_arrange_structs_helper_rotation(ps_next, ax, flag, 0);
+	case 1: return paint_arrange_structs_helper_rotation(ps_next, ax, flag, 1);
+	case 2: return paint_arrange_structs_helper_rotation(ps_next, ax, flag, 2);
+	default: return paint_arrange_structs_helper_rotation(ps_next, ax, flag, 3);
+	}
+}
+
 /**
  *
  *  rct2: 0x00688217
  */
-paint_struct paint_arrange_structs()
+paint_struct paint_arrange_structs(paint_session * session)
 {
 	paint_struct psHead = { 0 };
 	paint_struct * ps = &psHead;
 	ps->next_quadrant_ps = NULL;
-	uint32 quadrantIndex = _paintQuadrantBackIndex;
+	uint32 quadrantIndex = session->quadrant_back_index;
 	if (quadrantIndex != UINT32_MAX) {
 		do {
-			paint_struct * ps_next = _paintQuadrants[quadrantIndex];
+			paint_struct * ps_next = session->quadrants[quadrantIndex];
 			if (ps_next != NULL) {
 				ps->next_quadrant_ps = ps_next;
 				do {
@@ -852,13 +1460,14 @@ paint_struct paint_arrange_structs()
 					ps_next = ps_next->next_quadrant_ps;
 				} while (ps_next != NULL);
 			}
-		} while (++quadrantIndex <= _paintQuadrantFrontIndex);
+		} while (++quadrantIndex <= session->quadrant_front_index);
 
-		paint_arrange_structs_helper(&psHead, _paintQuadrantBackIndex & 0xFFFF, 1 << 1);
+		uint8 rotation = get_current_rotation();
+		paint_struct * ps_start = paint_arrange_structs_helper(&psHead, session->quadrant_back_index & 0xFFFF, 1 << 1, rotation);
 
-		quadrantIndex = _paintQuadrantBackIndex;
-		while (++quadrantIndex < _paintQuadrantFrontIndex) {
-			paint_arrange_structs_helper(&psHead, quadrantIndex & 0xFFFF, 0);
+		quadrantIndex = session->quadrant_back_index;
+		while (++quadrantIndex < session->quadrant_front_index) {
+			ps_start = paint_arrange_structs_helper(ps_start, quadrantIndex & 0xFFFF, 0, rotation);
 		}
 	}
 	return psHead;
@@ -868,8 +1477,9 @@ paint_struct paint_arrange_structs()
  *
  *  rct2: 0x00688485
  */
-void paint_draw_structs(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags)
+void paint_draw_structs(paint_session * session, paint_struct * ps, uint32 viewFlags)
 {
+	rct_drawpixelinfo * dpi = &session->dpi;
 	paint_struct* previous_ps = ps->next_quadrant_ps;
 	for (ps = ps->next_quadrant_ps; ps;) {
 		sint16 x = ps->x;
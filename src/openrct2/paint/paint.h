@@ -81,9 +81,6 @@ struct paint_struct {
 assert_struct_size(paint_struct, 0x34);
 #endif
 
-extern paint_struct * g_ps_F1AD28;
-extern attached_paint_struct * g_aps_F1AD2C;
-
 typedef struct paint_string_struct paint_string_struct;
 
 /* size 0x1E */
@@ -106,6 +103,42 @@ union paint_entry{
 	paint_string_struct string;
 };
 
+#define PAINT_ENTRY_CHUNK_SIZE (1024)
+#define MAX_PAINT_QUADRANTS (512)
+
+typedef struct paint_entry_chunk paint_entry_chunk;
+
+/**
+ * A block of paint entries, a session takes more chunks as it fills them and keeps them for the next time it paints.
+ */
+struct paint_entry_chunk {
+	paint_entry_chunk * next;
+	paint_entry entries[PAINT_ENTRY_CHUNK_SIZE];
+};
+
+/**
+ * Everything painting a view generates before it is drawn, so that several views can be generated and then drawn
+ * independently of each other.
+ */
+typedef struct paint_session {
+	rct_drawpixelinfo dpi;
+	paint_entry_chunk * first_chunk;
+	paint_entry_chunk * current_chunk;
+	// Number of chunks filled before the current chunk
+	uint32 num_full_chunks;
+	// The free entry in the current chunk and the end of the current chunk
+	paint_entry * next_free_paint_struct;
+	paint_entry * end_of_paint_struct_array;
+	paint_struct * quadrants[MAX_PAINT_QUADRANTS];
+	uint32 quadrant_back_index;
+	uint32 quadrant_front_index;
+	// The last paint struct added to a quadrant, and the last image attached to it (0x00F1AD28, 0x00F1AD2C)
+	paint_struct * last_root_ps;
+	attached_paint_struct * last_attached_ps;
+	paint_string_struct * ps_string_head;
+	paint_string_struct * last_ps_string;
+} paint_session;
+
 typedef struct sprite_bb {
 	uint32 sprite_id;
 	rct_xyz16 offset;
@@ -125,14 +158,10 @@ typedef struct support_height {
 
 #ifdef NO_RCT2
 extern void *g_currently_drawn_item;
-extern paint_entry * gEndOfPaintStructArray;
 extern sint16 gUnk9DE568;
 extern sint16 gUnk9DE56C;
-extern paint_entry gPaintStructs[4000];
 #else
-#define gPaintStructs RCT2_ADDRESS(0x00EE788C, paint_entry)
 #define g_currently_drawn_item	RCT2_GLOBAL(0x009DE578, void*)
-#define gEndOfPaintStructArray	RCT2_GLOBAL(0x00EE7880, paint_entry *)
 #define gUnk9DE568				RCT2_GLOBAL(0x009DE568, sint16)
 #define gUnk9DE56C				RCT2_GLOBAL(0x009DE56C, sint16)
 #endif
@@ -147,7 +176,8 @@ extern support_height gSupportSegments[9];
 extern support_height gSupport;
 #endif
 
-extern paint_string_struct * gPaintPSStringHead;
+// The session the paint setup functions add paint structs to
+extern paint_session * gPaintSession;
 
 /** rct2: 0x00993CC4 */
 extern const uint32 construction_markers[];
@@ -166,12 +196,29 @@ void paint_util_push_tunnel_rotated(uint8 direction, uint16 height, uint8 type);
 
 bool paint_attach_to_previous_attach(uint32 image_id, uint16 x, uint16 y);
 bool paint_attach_to_previous_ps(uint32 image_id, uint16 x, uint16 y);
+bool paint_attach_masked_to_previous_ps(uint32 image_id, uint32 colour_image_id, uint16 x, uint16 y);
+void paint_util_set_tertiary_colour(paint_struct * ps, uint32 colour);
 void sub_685EBC(money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation);
 
-void paint_init(rct_drawpixelinfo * dpi);
-void paint_generate_structs(rct_drawpixelinfo * dpi);
-paint_struct paint_arrange_structs();
-void paint_draw_structs(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags);
+paint_session * paint_session_get(size_t index);
+uint32 paint_session_get_num_entries(const paint_session * session);
+void paint_get_entry_stats(uint32 * highWaterMark, uint32 * numChunks);
+void paint_reset_entry_stats();
+
+void paint_cache_invalidate();
+void paint_cache_invalidate_tile(sint32 x, sint32 y);
+bool paint_cache_begin_tile(sint32 x, sint32 y);
+void paint_cache_end_tile();
+void paint_cache_disallow();
+#ifndef NO_RCT2
+void paint_session_store_rct2(paint_session * session);
+void paint_session_load_rct2(paint_session * session);
+#endif
+
+void paint_init(paint_session * session, const rct_drawpixelinfo * dpi);
+void paint_generate_structs(paint_session * session);
+paint_struct paint_arrange_structs(paint_session * session);
+void paint_draw_structs(paint_session * session, paint_struct * ps, uint32 viewFlags);
 void paint_draw_money_structs(rct_drawpixelinfo * dpi, paint_string_struct * ps);
 
 // TESTING
@@ -31,8 +31,9 @@ void sprite_paint_setup(const uint16 eax, const uint16 ecx) {
 
 	if ((eax & 0xe000) | (ecx & 0xe000)) return;
 
-	uint16 sprite_idx = sprite_get_first_in_quadrant(eax, ecx);
-	if (sprite_idx == SPRITE_INDEX_NULL) return;
+	size_t numSprites;
+	const uint16 *tileSprites = sprite_get_tile_sprites(eax >> 5, ecx >> 5, &numSprites);
+	if (numSprites == 0) return;
 
 	if (gTrackDesignSaveMode) return;
 
@@ -43,8 +44,9 @@ void sprite_paint_setup(const uint16 eax, const uint16 ecx) {
 	if (dpi->zoom_level > 2) return;
 
 
-	for (rct_sprite* spr = get_sprite(sprite_idx); sprite_idx != SPRITE_INDEX_NULL; sprite_idx = spr->unknown.next_in_quadrant) {
-		spr = get_sprite(sprite_idx);
+	// Newest first, the order the sprites were painted in when they were kept in linked lists
+	for (size_t i = numSprites; i > 0; i--) {
+		rct_sprite* spr = get_sprite(tileSprites[i - 1]);
 		dpi = unk_140E9A8;
 
 		if (dpi->y + dpi->height <= spr->unknown.sprite_top) continue;
@@ -467,6 +467,7 @@ bool wooden_a_supports_paint_setup(sint32 supportType, sint32 special, sint32 he
 				sub_98197C(imageId, 0, 0, bBox.length.x, bBox.length.y, bBox.length.z, z, bBox.offset.x, bBox.offset.y, bBox.offset.z + z, rotation);
 				hasSupports = true;
 			} else {
+				paint_cache_disallow();
 				hasSupports = true;
 				paint_struct* ps = sub_98198C(imageId, 0, 0, bBox.length.x, bBox.length.y, bBox.length.z, z, bBox.offset.x, bBox.offset.y, bBox.offset.z + z, rotation);
 				if (ps != NULL) {
@@ -497,7 +498,9 @@ bool wooden_b_supports_paint_setup(sint32 supportType, sint32 special, sint32 he
 #ifndef NO_RCT2
 	if (gUseOriginalRidePaint) {
 		sint32 eax = special, ebx = 0, ecx = 0, edx = height, esi = 0, _edi = supportType, ebp = imageColourFlags;
+		paint_session_store_rct2(gPaintSession);
 		RCT2_CALLFUNC_X(0x00662D5C, &eax, &ebx, &ecx, &edx, &esi, &_edi, &ebp);
+		paint_session_load_rct2(gPaintSession);
 		return eax & 0xFF;
 	}
 #endif
@@ -658,6 +661,7 @@ bool wooden_b_supports_paint_setup(sint32 supportType, sint32 special, sint32 he
 				);
 				_9E32B1 = true;
 			} else {
+				paint_cache_disallow();
 				paint_struct * paintStruct = sub_98198C(
 					imageId | imageColourFlags,
 					0, 0,
@@ -881,7 +885,9 @@ bool metal_b_supports_paint_setup(uint8 supportType, uint8 segment, sint32 speci
 #ifndef NO_RCT2
 	if (gUseOriginalRidePaint) {
 		sint32 eax = special, ebx = segment, ecx = 0, edx = height, esi = 0, _edi = supportType, ebp = imageColourFlags;
+		paint_session_store_rct2(gPaintSession);
 		RCT2_CALLFUNC_X(0x00663584, &eax, &ebx, &ecx, &edx, &esi, &_edi, &ebp);
+		paint_session_load_rct2(gPaintSession);
 		return eax & 0xFF;
 	}
 #endif
@@ -1074,7 +1080,9 @@ bool path_a_supports_paint_setup(sint32 supportType, sint32 special, sint32 heig
 	if (gUseOriginalRidePaint) {
 		RCT2_GLOBAL(0xF3EF6C, rct_footpath_entry *) = pathEntry;
 		sint32 eax = special, ebx = 0, ecx = 0, edx = height, esi = 0, _edi = supportType, ebp = imageColourFlags;
+		paint_session_store_rct2(gPaintSession);
 		RCT2_CALLFUNC_X(0x006A2ECC, &eax, &ebx, &ecx, &edx, &esi, &_edi, &ebp);
+		paint_session_load_rct2(gPaintSession);
 		return eax & 0xFF;
 	}
 #endif
@@ -1215,6 +1223,7 @@ bool path_a_supports_paint_setup(sint32 supportType, sint32 special, sint32 heig
 			);
 			hasSupports = true;
 		} else {
+			paint_cache_disallow();
 			paint_struct * paintStruct = sub_98198C(
 				imageId | imageColourFlags,
 				0, 0,
@@ -1254,7 +1263,9 @@ bool path_b_supports_paint_setup(sint32 segment, sint32 special, sint32 height,
 	if (gUseOriginalRidePaint) {
 		RCT2_GLOBAL(0xF3EF6C, rct_footpath_entry *) = pathEntry;
 		sint32 eax = special, ebx = segment, ecx = 0, edx = height, esi = 0, _edi = 0, ebp = imageColourFlags;
+		paint_session_store_rct2(gPaintSession);
 		RCT2_CALLFUNC_X(0x006A326B, &eax, &ebx, &ecx, &edx, &esi, &_edi, &ebp);
+		paint_session_load_rct2(gPaintSession);
 		return eax & 0xFF;
 	}
 #endif
@@ -36,10 +36,14 @@
 #include "../util/util.h"
 #include "../world/climate.h"
 #include "../world/footpath.h"
+#include "../world/footpath_flow.h"
+#include "../world/footpath_graph.h"
 #include "../world/map.h"
 #include "../world/scenery.h"
 #include "../world/sprite.h"
+#include "../world/tile_summary.h"
 #include "peep.h"
+#include "peep_needs.h"
 #include "staff.h"
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
@@ -59,6 +63,10 @@ uint8 gGuestInitialHunger;
 uint8 gGuestInitialThirst;
 
 uint32 gNextGuestNumber;
+uint32 gGuestGroupsGeneration;
+
+// Whether guests follow flow fields in a network game, taken from the server's config so every player paths the same
+bool gGuestFlowFieldsNetwork;
 
 uint8 gPeepWarningThrottle[16];
 
@@ -89,23 +97,7 @@ static rct_map_element * _peepRideEntranceExitElement;
 static uint32 _peepRideConsideration[8];
 static uint8 _peepPotentialRides[256];
 
-enum {
-	PATH_SEARCH_DEAD_END,
-	PATH_SEARCH_WIDE,
-	PATH_SEARCH_THIN,
-	PATH_SEARCH_JUNCTION,
-	PATH_SEARCH_RIDE_QUEUE,
-	PATH_SEARCH_RIDE_ENTRANCE,
-	PATH_SEARCH_RIDE_EXIT,
-	PATH_SEARCH_PARK_EXIT,
-	PATH_SEARCH_SHOP_ENTRANCE,
-	PATH_SEARCH_LIMIT_REACHED,
-	PATH_SEARCH_LOOP,
-	PATH_SEARCH_OTHER,
-	PATH_SEARCH_FAILED
-};
-
-// Some text descriptions corresponding to the above enum for understandable debug messages
+// Some text descriptions corresponding to the PATH_SEARCH enum for understandable debug messages
 const char *gPathFindSearchText[] = {"DeadEnd", "Wide", "Thin", "Junction", "RideQueue", "RideEntrance", "RideExit", "ParkEntryExit", "ShopEntrance", "LimitReached", "PathLoop", "Other", "Failed"};
 
 
@@ -148,6 +140,7 @@ static bool peep_should_go_to_shop(rct_peep *peep, sint32 rideIndex, bool peepAt
 static bool peep_find_ride_to_look_at(rct_peep *peep, uint8 edge, uint8 *rideToView, uint8 *rideSeatToView);
 static void peep_easter_egg_peep_interactions(rct_peep *peep);
 static sint32 peep_get_height_on_slope(rct_peep *peep, sint32 x, sint32 y);
+static void peep_scan_nearby_rides(sint32 cx, sint32 cy, uint32 *rides);
 static void peep_pick_ride_to_go_on(rct_peep *peep);
 static void peep_head_for_nearest_ride_type(rct_peep *peep, sint32 rideType);
 static void peep_head_for_nearest_ride_with_flags(rct_peep *peep, sint32 rideTypeFlags);
@@ -591,6 +584,10 @@ void peep_update_all()
 	if (gScreenFlags & 0x0E)
 		return;
 
+	if ((gCurrentTicks & 0x7F) == 0) {
+		peep_needs_update_all();
+	}
+
 	spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
 	i = 0;
 	while (spriteIndex != SPRITE_INDEX_NULL) {
@@ -618,64 +615,47 @@ static uint8 peep_assess_surroundings(sint16 center_x, sint16 center_y, sint16 c
 	if ((map_element_height(center_x, center_y) & 0xFFFF) > center_z)
 		return PEEP_THOUGHT_TYPE_NONE;
 
-	uint16 num_scenery = 0;
-	uint16 num_fountains = 0;
 	uint16 nearby_music = 0;
-	uint16 num_rubbish = 0;
 
-	sint16 initial_x = max(center_x - 160, 0);
-	sint16 initial_y = max(center_y - 160, 0);
-	sint16 final_x = min(center_x + 160, 8192);
-	sint16 final_y = min(center_y + 160, 8192);
+	sint32 initial_x = max(center_x - 160, 0) / 32;
+	sint32 initial_y = max(center_y - 160, 0) / 32;
+	sint32 final_x = min(center_x + 160, MAXIMUM_MAP_SIZE_BIG) / 32;
+	sint32 final_y = min(center_y + 160, MAXIMUM_MAP_SIZE_BIG) / 32;
 
-	for (sint16 x = initial_x; x < final_x; x += 32){
-		for (sint16 y = initial_y; y < final_y; y += 32){
-			rct_map_element* mapElement = map_get_first_element_at(x / 32, y / 32);
+	tile_summary_totals totals;
+	tile_summary_sum(initial_x, initial_y, final_x, final_y, &totals);
+	if (totals.missing_path_additions != 0)
+		return PEEP_THOUGHT_TYPE_NONE;
 
-			do{
-				rct_ride* ride;
-				rct_scenery_entry* scenery;
+	uint32 num_scenery = totals.scenery;
+	uint32 num_fountains = totals.fountains;
+	uint32 num_rubbish = totals.broken_path_additions;
 
-				switch (map_element_get_type(mapElement)){
-				case MAP_ELEMENT_TYPE_PATH:
-					if (!footpath_element_has_path_scenery(mapElement))
-						break;
+	// Only the tiles with track need visiting to find rides playing music
+	if (totals.track != 0) {
+		for (sint32 x = initial_x; x < final_x; x++){
+			for (sint32 y = initial_y; y < final_y; y++){
+				if (tile_summary_get(x, y)->track == 0)
+					continue;
 
-					scenery = get_footpath_item_entry(footpath_element_get_path_scenery_index(mapElement));
-					if (scenery == NULL) {
-						return PEEP_THOUGHT_TYPE_NONE;
-					}
-					if (footpath_element_path_scenery_is_ghost(mapElement))
-						break;
+				rct_map_element* mapElement = map_get_first_element_at(x, y);
+				do{
+					if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK)
+						continue;
 
-					if (scenery->path_bit.flags &
-						(PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER |
-						PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW)){
-						num_fountains++;
-						break;
-					}
-					if (mapElement->flags & MAP_ELEMENT_FLAG_BROKEN){
-						num_rubbish++;
-					}
-					break;
-				case MAP_ELEMENT_TYPE_SCENERY_MULTIPLE:
-				case MAP_ELEMENT_TYPE_SCENERY:
-					num_scenery++;
-					break;
-				case MAP_ELEMENT_TYPE_TRACK:
-					ride = get_ride(mapElement->properties.track.ride_index);
+					rct_ride* ride = get_ride(mapElement->properties.track.ride_index);
 					if (ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC &&
 						ride->status != RIDE_STATUS_CLOSED &&
 						!(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED))){
 
 						if (ride->type == RIDE_TYPE_MERRY_GO_ROUND){
 							nearby_music |= 1;
-							break;
+							continue;
 						}
 
 						if (ride->music == MUSIC_STYLE_ORGAN){
 							nearby_music |= 1;
-							break;
+							continue;
 						}
 
 						if (ride->type == RIDE_TYPE_DODGEMS){
@@ -683,22 +663,12 @@ static uint8 peep_assess_surroundings(sint16 center_x, sint16 center_y, sint16 c
 							nearby_music |= 2;
 						}
 					}
-					break;
-				}
-			} while (!map_element_is_last_for_tile(mapElement++));
+				} while (!map_element_is_last_for_tile(mapElement++));
+			}
 		}
 	}
 
-	rct_litter* litter;
-	for (uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next) {
-		litter = &(get_sprite(sprite_idx)->litter);
-
-		sint16 dist_x = abs(litter->x - center_x);
-		sint16 dist_y = abs(litter->y - center_y);
-		if (max(dist_x, dist_y) <= 160) {
-			num_rubbish++;
-		}
-	}
+	num_rubbish += tile_summary_count_litter(center_x, center_y, 160);
 
 	if (num_fountains >= 5 && num_rubbish < 20)
 		return PEEP_THOUGHT_TYPE_FOUNTAINS;
@@ -721,10 +691,10 @@ static uint8 peep_assess_surroundings(sint16 center_x, sint16 center_y, sint16 c
  *  rct2: 0x0068F9A9
  */
 static void peep_update_hunger(rct_peep *peep){
-	if (peep->hunger >= 3){
-		peep->hunger -= 2;
-		peep->energy_growth_rate = min(peep->energy_growth_rate + 2, 255);
-		peep->bathroom = min(peep->bathroom + 1, 255);
+	if (PEEP_NEED(peep, hunger) >= 3){
+		PEEP_NEED(peep, hunger) -= 2;
+		PEEP_NEED(peep, energy_growth_rate) = min(PEEP_NEED(peep, energy_growth_rate) + 2, 255);
+		PEEP_NEED(peep, bathroom) = min(PEEP_NEED(peep, bathroom) + 1, 255);
 	}
 }
 
@@ -760,12 +730,12 @@ static void peep_leave_park(rct_peep* peep){
  */
 static void sub_68F8CD(rct_peep *peep)
 {
-	if (peep->energy_growth_rate >= 33) {
-		peep->energy_growth_rate -= 2;
+	if (PEEP_NEED(peep, energy_growth_rate) >= 33) {
+		PEEP_NEED(peep, energy_growth_rate) -= 2;
 	}
 
-	if (gClimateCurrentTemperature >= 21 && peep->thirst >= 5) {
-		peep->thirst--;
+	if (gClimateCurrentTemperature >= 21 && PEEP_NEED(peep, thirst) >= 5) {
+		PEEP_NEED(peep, thirst)--;
 	}
 
 	if (peep->outside_of_park != 0) {
@@ -777,13 +747,13 @@ static void sub_68F8CD(rct_peep *peep)
 	 * in the park. */
 	if (!(peep->peep_flags & PEEP_FLAGS_LEAVING_PARK)){
 		if (gParkFlags & PARK_FLAGS_NO_MONEY) {
-			if (peep->energy >= 70 && peep->happiness >= 60) {
+			if (PEEP_NEED(peep, energy) >= 70 && PEEP_NEED(peep, happiness) >= 60) {
 				return;
 			}
 		} else {
 			if (
-				peep->energy >= 55 &&
-				peep->happiness >= 45 &&
+				PEEP_NEED(peep, energy) >= 55 &&
+				PEEP_NEED(peep, happiness) >= 45 &&
 				peep->cash_in_pocket >= MONEY(5, 00)
 			) {
 				return;
@@ -992,20 +962,20 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 		}
 
 		if (peep->peep_flags & PEEP_FLAGS_HUNGER){
-			if (peep->hunger >= 15)peep->hunger -= 15;
+			if (PEEP_NEED(peep, hunger) >= 15)PEEP_NEED(peep, hunger) -= 15;
 		}
 
 		if (peep->peep_flags & PEEP_FLAGS_BATHROOM){
-			if (peep->bathroom <= 180)peep->bathroom += 50;
+			if (PEEP_NEED(peep, bathroom) <= 180)PEEP_NEED(peep, bathroom) += 50;
 		}
 
 		if (peep->peep_flags & PEEP_FLAGS_HAPPINESS){
-			peep->happiness_growth_rate = 5;
+			PEEP_NEED(peep, happiness_growth_rate) = 5;
 		}
 
 		if (peep->peep_flags & PEEP_FLAGS_NAUSEA){
-			peep->nausea_growth_rate = 200;
-			if (peep->nausea <= 130)peep->nausea = 130;
+			PEEP_NEED(peep, nausea_growth_rate) = 200;
+			if (PEEP_NEED(peep, nausea) <= 130)PEEP_NEED(peep, nausea) = 130;
 		}
 
 		if (peep->angriness != 0)
@@ -1021,7 +991,7 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 
 					if (thought_type != PEEP_THOUGHT_TYPE_NONE) {
 						peep_insert_new_thought(peep, thought_type, 0xFF);
-						peep->happiness_growth_rate = min(255, peep->happiness_growth_rate + 45);
+						PEEP_NEED(peep, happiness_growth_rate) = min(255, PEEP_NEED(peep, happiness_growth_rate) + 45);
 					}
 				}
 			}
@@ -1037,7 +1007,7 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 			}
 
 			if (peep->time_on_ride > 15){
-				peep->happiness_growth_rate = min(0, peep->happiness_growth_rate - 5);
+				PEEP_NEED(peep, happiness_growth_rate) = min(0, PEEP_NEED(peep, happiness_growth_rate) - 5);
 
 				if (peep->time_on_ride > 22){
 					rct_ride* ride = get_ride(peep->current_ride);
@@ -1064,7 +1034,7 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 				peep_pick_ride_to_go_on(peep);
 
 				if (peep->guest_heading_to_ride_id == 0xFF){
-					peep->happiness_growth_rate = max(peep->happiness_growth_rate - 128, 0);
+					PEEP_NEED(peep, happiness_growth_rate) = max(PEEP_NEED(peep, happiness_growth_rate) - 128, 0);
 					peep_leave_park(peep);
 					peep_update_hunger(peep);
 					goto loc_68F9F3;
@@ -1093,29 +1063,29 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 					possible_thoughts[num_thoughts++] = PEEP_THOUGHT_TYPE_GO_HOME;
 				}
 				else{
-					if (peep->energy <= 70 &&
-						peep->happiness < 128){
+					if (PEEP_NEED(peep, energy) <= 70 &&
+						PEEP_NEED(peep, happiness) < 128){
 						possible_thoughts[num_thoughts++] = PEEP_THOUGHT_TYPE_TIRED;
 					}
 
-					if (peep->hunger <= 10 &&
+					if (PEEP_NEED(peep, hunger) <= 10 &&
 						!peep_has_food(peep)){
 						possible_thoughts[num_thoughts++] = PEEP_THOUGHT_TYPE_HUNGRY;
 					}
 
-					if (peep->thirst <= 25 &&
+					if (PEEP_NEED(peep, thirst) <= 25 &&
 						!peep_has_food(peep)){
 						possible_thoughts[num_thoughts++] = PEEP_THOUGHT_TYPE_THIRSTY;
 					}
 
-					if (peep->bathroom >= 160){
+					if (PEEP_NEED(peep, bathroom) >= 160){
 						possible_thoughts[num_thoughts++] = PEEP_THOUGHT_TYPE_BATHROOM;
 					}
 
 					if (!(gParkFlags & PARK_FLAGS_NO_MONEY) &&
 						peep->cash_in_pocket <= MONEY(9, 00) &&
-						peep->happiness >= 105 &&
-						peep->energy >= 70){
+						PEEP_NEED(peep, happiness) >= 105 &&
+						PEEP_NEED(peep, energy) >= 70){
 						/* The energy check was originally a second check on happiness.
 						 * This was superfluous so should probably check something else.
 						 * Guessed that this should really be checking energy, since
@@ -1154,9 +1124,9 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 			 * remaining times the encompassing conditional is
 			 * executed (which is also every second time, but
 			 * the alternate time to the true branch). */
-			if (peep->nausea >= 140){
+			if (PEEP_NEED(peep, nausea) >= 140){
 				uint8 thought_type = PEEP_THOUGHT_TYPE_SICK;
-				if (peep->nausea >= 200){
+				if (PEEP_NEED(peep, nausea) >= 200){
 					thought_type = PEEP_THOUGHT_TYPE_VERY_SICK;
 					peep_head_for_nearest_ride_type(peep, RIDE_TYPE_FIRST_AID);
 				}
@@ -1174,16 +1144,16 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 			break;
 
 		case PEEP_STATE_SITTING:
-			if (peep->energy_growth_rate <= 135)
-				peep->energy_growth_rate += 5;
+			if (PEEP_NEED(peep, energy_growth_rate) <= 135)
+				PEEP_NEED(peep, energy_growth_rate) += 5;
 
-			if (peep->thirst >= 5){
-				peep->thirst -= 4;
-				peep->bathroom = min(255, peep->bathroom + 3);
+			if (PEEP_NEED(peep, thirst) >= 5){
+				PEEP_NEED(peep, thirst) -= 4;
+				PEEP_NEED(peep, bathroom) = min(255, PEEP_NEED(peep, bathroom) + 3);
 			}
 
-			if (peep->nausea_growth_rate >= 50)
-				peep->nausea_growth_rate -= 6;
+			if (PEEP_NEED(peep, nausea_growth_rate) >= 50)
+				PEEP_NEED(peep, nausea_growth_rate) -= 6;
 
 			// In the original this branched differently
 			// but it would mean setting the peep happiness from
@@ -1219,16 +1189,16 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 					 * slowly happier, up to a certain level. */
 					/* Why don't queue line TV monitors start affecting the peeps
 					 * as soon as they join the queue?? */
-					if (peep->happiness_growth_rate < 90)
-						peep->happiness_growth_rate = 90;
+					if (PEEP_NEED(peep, happiness_growth_rate) < 90)
+						PEEP_NEED(peep, happiness_growth_rate) = 90;
 
-					if (peep->happiness_growth_rate < 165)
-						peep->happiness_growth_rate += 2;
+					if (PEEP_NEED(peep, happiness_growth_rate) < 165)
+						PEEP_NEED(peep, happiness_growth_rate) += 2;
 				}
 				else{
 					/* Without a queue line TV monitor peeps waiting too long
 					 * in a queue get less happy. */
-					peep->happiness_growth_rate = max(peep->happiness_growth_rate - 4, 0);
+					PEEP_NEED(peep, happiness_growth_rate) = max(PEEP_NEED(peep, happiness_growth_rate) - 4, 0);
 				}
 			}
 			peep_update_hunger(peep);
@@ -1244,33 +1214,33 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 
 	loc_68F9F3:
 		// Idle peep happiness tends towards 127 (50%).
-		if (peep->happiness_growth_rate >= 128)
-			peep->happiness_growth_rate--;
+		if (PEEP_NEED(peep, happiness_growth_rate) >= 128)
+			PEEP_NEED(peep, happiness_growth_rate)--;
 		else
-			peep->happiness_growth_rate++;
+			PEEP_NEED(peep, happiness_growth_rate)++;
 
-		peep->nausea_growth_rate = max(peep->nausea_growth_rate - 2, 0);
+		PEEP_NEED(peep, nausea_growth_rate) = max(PEEP_NEED(peep, nausea_growth_rate) - 2, 0);
 
-		if (peep->energy <= 50){
-			peep->energy = max(peep->energy - 2, 0);
+		if (PEEP_NEED(peep, energy) <= 50){
+			PEEP_NEED(peep, energy) = max(PEEP_NEED(peep, energy) - 2, 0);
 		}
 
-		if (peep->hunger < 10){
-			peep->hunger = max(peep->hunger - 1, 0);
+		if (PEEP_NEED(peep, hunger) < 10){
+			PEEP_NEED(peep, hunger) = max(PEEP_NEED(peep, hunger) - 1, 0);
 		}
 
-		if (peep->thirst < 10){
-			peep->thirst = max(peep->thirst - 1, 0);
+		if (PEEP_NEED(peep, thirst) < 10){
+			PEEP_NEED(peep, thirst) = max(PEEP_NEED(peep, thirst) - 1, 0);
 		}
 
-		if (peep->bathroom >= 195){
-			peep->bathroom--;
+		if (PEEP_NEED(peep, bathroom) >= 195){
+			PEEP_NEED(peep, bathroom)--;
 		}
 
 		if (peep->state == PEEP_STATE_WALKING &&
-			peep->nausea_growth_rate >= 128){
+			PEEP_NEED(peep, nausea_growth_rate) >= 128){
 
-			if ((scenario_rand() & 0xFF) <= (uint8)((peep->nausea - 128) / 2)){
+			if ((scenario_rand() & 0xFF) <= (uint8)((PEEP_NEED(peep, nausea) - 128) / 2)){
 				if (peep->action >= PEEP_ACTION_NONE_1){
 					peep->action = PEEP_ACTION_THROW_UP;
 					peep->action_frame = 0;
@@ -1296,12 +1266,12 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 		peep->var_42 = max(peep->var_42 - 3, 0);
 
 		if (peep_has_drink(peep)){
-			peep->thirst = min(peep->thirst + 7, 255);
+			PEEP_NEED(peep, thirst) = min(PEEP_NEED(peep, thirst) + 7, 255);
 		}
 		else{
-			peep->hunger = min(peep->hunger + 7, 255);
-			peep->thirst = max(peep->thirst - 3, 0);
-			peep->bathroom = min(peep->bathroom + 2, 255);
+			PEEP_NEED(peep, hunger) = min(PEEP_NEED(peep, hunger) + 7, 255);
+			PEEP_NEED(peep, thirst) = max(PEEP_NEED(peep, thirst) - 3, 0);
+			PEEP_NEED(peep, bathroom) = min(PEEP_NEED(peep, bathroom) + 2, 255);
 		}
 
 		if (peep->var_42 == 0){
@@ -1336,66 +1306,7 @@ static void sub_68F41A(rct_peep *peep, sint32 index)
 		}
 	}
 
-	uint8 energy = peep->energy;
-	uint8 energy_growth = peep->energy_growth_rate;
-	if (energy >= energy_growth){
-		energy -= 2;
-		if (energy < energy_growth)
-			energy = energy_growth;
-	}
-	else{
-		energy = min(255, energy + 4);
-		if (energy > energy_growth)
-			energy = energy_growth;
-	}
-
-	if (energy < 32)
-		energy = 32;
-
-	/* This suggests 100% energy is 128. */
-	if (energy > 128)
-		energy = 128;
-
-	if (energy != peep->energy){
-		peep->energy = energy;
-		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_2;
-	}
-
-	uint8 happiness = peep->happiness;
-	uint8 happiness_growth = peep->happiness_growth_rate;
-	if (happiness >= happiness_growth){
-		happiness = max(happiness - 4, 0);
-		if (happiness < happiness_growth)
-			happiness = happiness_growth;
-	}
-	else{
-		happiness = min(255, happiness + 4);
-		if (happiness > happiness_growth)
-			happiness = happiness_growth;
-	}
-
-	if (happiness != peep->happiness){
-		peep->happiness = happiness;
-		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_2;
-	}
-
-	uint8 nausea = peep->nausea;
-	uint8 nausea_growth = peep->nausea_growth_rate;
-	if (nausea >= nausea_growth){
-		nausea = max(nausea - 4, 0);
-		if (nausea < nausea_growth)
-			nausea = nausea_growth;
-	}
-	else{
-		nausea = min(255, nausea + 4);
-		if (nausea > nausea_growth)
-			nausea = nausea_growth;
-	}
-
-	if (nausea != peep->nausea){
-		peep->nausea = nausea;
-		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_2;
-	}
+	// Energy, happiness and nausea move towards their growth rates in peep_needs_update_all
 }
 
 /*
@@ -1512,7 +1423,7 @@ static void peep_check_if_lost(rct_peep* peep){
 	}
 	peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_LOST, 0xFF);
 
-	peep->happiness_growth_rate = max(peep->happiness_growth_rate - 30, 0);
+	PEEP_NEED(peep, happiness_growth_rate) = max(PEEP_NEED(peep, happiness_growth_rate) - 30, 0);
 }
 
 /**
@@ -1527,7 +1438,7 @@ static void peep_check_cant_find_ride(rct_peep* peep){
 	// Peeps will think "I can't find ride X" twice before giving up completely.
 	if (peep->peep_is_lost_countdown == 30 || peep->peep_is_lost_countdown == 60) {
 		peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_CANT_FIND, peep->guest_heading_to_ride_id);
-		peep->happiness_growth_rate = max(peep->happiness_growth_rate - 30, 0);
+		PEEP_NEED(peep, happiness_growth_rate) = max(PEEP_NEED(peep, happiness_growth_rate) - 30, 0);
 	}
 
 	peep->peep_is_lost_countdown--;
@@ -1535,6 +1446,7 @@ static void peep_check_cant_find_ride(rct_peep* peep){
 		return;
 
 	peep->guest_heading_to_ride_id = 0xFF;
+	gGuestGroupsGeneration++;
 	rct_window* w = window_find_by_number(WC_PEEP, peep->sprite_index);
 
 	if (w){
@@ -1556,7 +1468,7 @@ static void peep_check_cant_find_exit(rct_peep* peep){
 	// Peeps who can't find the park exit will continue to get less happy until they find it.
 	if (peep->peep_is_lost_countdown == 1) {
 		peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_CANT_FIND_EXIT, 0xFF);
-		peep->happiness_growth_rate = max(peep->happiness_growth_rate - 30, 0);
+		PEEP_NEED(peep, happiness_growth_rate) = max(PEEP_NEED(peep, happiness_growth_rate) - 30, 0);
 	}
 
 	if (--peep->peep_is_lost_countdown == 0)
@@ -1654,13 +1566,13 @@ static sint32 peep_update_action(sint16* x, sint16* y, sint16* xy_distance, rct_
 	}
 
 	// We are throwing up
-	peep->hunger /= 2;
-	peep->nausea_growth_rate /= 2;
+	PEEP_NEED(peep, hunger) /= 2;
+	PEEP_NEED(peep, nausea_growth_rate) /= 2;
 
-	if (peep->nausea < 30)
-		peep->nausea = 0;
+	if (PEEP_NEED(peep, nausea) < 30)
+		PEEP_NEED(peep, nausea) = 0;
 	else
-		peep->nausea -= 30;
+		PEEP_NEED(peep, nausea) -= 30;
 
 	peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_2;
 
@@ -1834,27 +1746,27 @@ void peep_update_sprite_type(rct_peep* peep)
 		return;
 	}
 
-	if (peep->nausea > 170) {
+	if (PEEP_NEED(peep, nausea) > 170) {
 		set_sprite_type(peep, PEEP_SPRITE_TYPE_VERY_NAUSEOUS);
 		return;
 	}
 
-	if (peep->nausea > 140) {
+	if (PEEP_NEED(peep, nausea) > 140) {
 		set_sprite_type(peep, PEEP_SPRITE_TYPE_NAUSEOUS);
 		return;
 	}
 
-	if (peep->energy <= 64 && peep->happiness < 128) {
+	if (PEEP_NEED(peep, energy) <= 64 && PEEP_NEED(peep, happiness) < 128) {
 		set_sprite_type(peep, PEEP_SPRITE_TYPE_HEAD_DOWN);
 		return;
 	}
 
-	if (peep->energy <= 80 && peep->happiness < 128) {
+	if (PEEP_NEED(peep, energy) <= 80 && PEEP_NEED(peep, happiness) < 128) {
 		set_sprite_type(peep, PEEP_SPRITE_TYPE_ARMS_CROSSED);
 		return;
 	}
 
-	if (peep->bathroom > 220) {
+	if (PEEP_NEED(peep, bathroom) > 220) {
 		set_sprite_type(peep, PEEP_SPRITE_TYPE_REQUIRE_BATHROOM);
 		return;
 	}
@@ -1882,6 +1794,7 @@ void peep_window_state_update(rct_peep* peep)
 
 		window_invalidate_by_number(WC_PEEP, peep->sprite_index);
 		window_invalidate_by_class(WC_GUEST_LIST);
+		gGuestGroupsGeneration++;
 	} else {
 		window_invalidate_by_number(WC_PEEP, peep->sprite_index);
 		window_invalidate_by_class(WC_STAFF_LIST);
@@ -1981,7 +1894,7 @@ bool peep_pickup_place(rct_peep* peep, sint32 x, sint32 y, sint32 z, bool apply)
 
 		if (peep->type == PEEP_TYPE_GUEST) {
 			peep->action_sprite_type = 0xFF;
-			peep->happiness_growth_rate = max(peep->happiness_growth_rate - 10, 0);
+			PEEP_NEED(peep, happiness_growth_rate) = max(PEEP_NEED(peep, happiness_growth_rate) - 10, 0);
 			sub_693B58(peep);
 		}
 
@@ -2072,6 +1985,7 @@ void peep_sprite_remove(rct_peep* peep){
 
 	if (peep->type == PEEP_TYPE_GUEST){
 		window_invalidate_by_class(WC_GUEST_LIST);
+		gGuestGroupsGeneration++;
 
 		news_item_disable_news(NEWS_ITEM_PEEP_ON_RIDE, peep->sprite_index);
 	}
@@ -2280,7 +2194,7 @@ static void peep_update_sitting(rct_peep* peep){
 		peep->sub_state++;
 
 		// Sets time to sit on seat
-		peep->time_to_sitdown = (129 - peep->energy) * 16 + 50;
+		peep->time_to_sitdown = (129 - PEEP_NEED(peep, energy)) * 16 + 50;
 	}
 	else if (peep->sub_state == 1){
 		if (peep->action < 0xFE){
@@ -3884,7 +3798,7 @@ static void peep_update_ride_sub_state_17(rct_peep* peep){
 	}
 
 	if (peep->action >= PEEP_ACTION_NONE_1){
-		if (peep->energy > 64 &&
+		if (PEEP_NEED(peep, energy) > 64 &&
 			(scenario_rand() & 0xFFFF) <= 2427){
 
 			peep->action = PEEP_ACTION_JUMP;
@@ -4086,7 +4000,7 @@ static void peep_update_ride_sub_state_20(rct_peep* peep){
 	rct_ride* ride = get_ride(peep->current_ride);
 
 	if (ride->type == RIDE_TYPE_FIRST_AID){
-		if (peep->nausea <= 35){
+		if (PEEP_NEED(peep, nausea) <= 35){
 			peep->sub_state++;
 
 			x = peep->next_x + 16;
@@ -4094,18 +4008,18 @@ static void peep_update_ride_sub_state_20(rct_peep* peep){
 			peep->destination_x = x;
 			peep->destination_y = y;
 			peep->destination_tolerence = 3;
-			peep->happiness_growth_rate = min(peep->happiness_growth_rate + 30, 0xFF);
-			peep->happiness = peep->happiness_growth_rate;
+			PEEP_NEED(peep, happiness_growth_rate) = min(PEEP_NEED(peep, happiness_growth_rate) + 30, 0xFF);
+			PEEP_NEED(peep, happiness) = PEEP_NEED(peep, happiness_growth_rate);
 		}
 		else{
-			peep->nausea--;
-			peep->nausea_growth_rate = peep->nausea;
+			PEEP_NEED(peep, nausea)--;
+			PEEP_NEED(peep, nausea_growth_rate) = PEEP_NEED(peep, nausea);
 		}
 		return;
 	}
 
-	if (peep->bathroom != 0){
-		peep->bathroom--;
+	if (PEEP_NEED(peep, bathroom) != 0){
+		PEEP_NEED(peep, bathroom)--;
 		return;
 	}
 
@@ -4122,8 +4036,8 @@ static void peep_update_ride_sub_state_20(rct_peep* peep){
 	peep->destination_y = y;
 	peep->destination_tolerence = 3;
 
-	peep->happiness_growth_rate = min(peep->happiness_growth_rate + 30, 0xFF);
-	peep->happiness = peep->happiness_growth_rate;
+	PEEP_NEED(peep, happiness_growth_rate) = min(PEEP_NEED(peep, happiness_growth_rate) + 30, 0xFF);
+	PEEP_NEED(peep, happiness) = PEEP_NEED(peep, happiness_growth_rate);
 
 	peep_stop_purchase_thought(peep, ride->type);
 }
@@ -4156,7 +4070,7 @@ static void peep_update_ride_sub_state_21(rct_peep* peep){
 	ride->total_customers++;
 	ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
 
-	ride_update_satisfaction(ride, peep->happiness / 64);
+	ride_update_satisfaction(ride, PEEP_NEED(peep, happiness) / 64);
 }
 
 /**
@@ -4972,7 +4886,7 @@ static void peep_update_queuing(rct_peep* peep){
 	}
 	if (peep->time_in_queue < 4300) return;
 
-	if (peep->happiness <= 65 && (0xFFFF & scenario_rand()) < 2184){
+	if (PEEP_NEED(peep, happiness) <= 65 && (0xFFFF & scenario_rand()) < 2184){
 		//Give up queueing for the ride
 		peep->sprite_direction ^= (1 << 4);
 		invalidate_sprite_2((rct_sprite*)peep);
@@ -5295,7 +5209,7 @@ static void peep_update_watching(rct_peep* peep){
 
 		peep->sub_state++;
 
-		peep->time_to_stand = clamp(0, ((129 - peep->energy) * 16 + 50) / 2, 255);
+		peep->time_to_stand = clamp(0, ((129 - PEEP_NEED(peep, energy)) * 16 + 50) / 2, 255);
 		peep_update_sprite_type(peep);
 	}
 	else if (peep->sub_state == 1){
@@ -5423,14 +5337,13 @@ static sint32 peep_update_walking_find_bench(rct_peep* peep){
 
 	for (; !(edges & (1 << chosen_edge));)chosen_edge = (chosen_edge + 1) & 0x3;
 
-	uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
 	uint8 free_edge = 3;
 
-	for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant){
-		sprite = get_sprite(sprite_id);
-
-		if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_PEEP * 2) continue;
+	sprite_query query;
+	sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
 
+	rct_sprite* sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL){
 		if (sprite->peep.state != PEEP_STATE_SITTING)continue;
 
 		if (peep->z != sprite->peep.z)continue;
@@ -5548,8 +5461,8 @@ static void peep_update_walking_break_scenery(rct_peep* peep){
 		return;
 
 	if (!(peep->peep_flags & PEEP_FLAGS_ANGRY)){
-		if (peep->happiness >= 48) return;
-		if (peep->energy < 85) return;
+		if (PEEP_NEED(peep, happiness) >= 48) return;
+		if (PEEP_NEED(peep, energy) < 85) return;
 		if (peep->state != PEEP_STATE_WALKING) return;
 
 		if ((peep->litter_count & 0xC0) != 0xC0 &&
@@ -5598,6 +5511,7 @@ static void peep_update_walking_break_scenery(rct_peep* peep){
 	}
 
 	map_element->flags |= MAP_ELEMENT_FLAG_BROKEN;
+	tile_summary_invalidate_at(peep->next_x >> 5, peep->next_y >> 5);
 
 	map_invalidate_tile_zoom1(
 		peep->next_x,
@@ -6299,16 +6213,11 @@ static sint32 peep_update_patrolling_find_sweeping(rct_peep* peep){
 	if (!(peep->staff_orders & STAFF_ORDERS_SWEEPING))
 		return 0;
 
-	uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
-
-	for (rct_sprite* sprite = NULL;
-		sprite_id != SPRITE_INDEX_NULL;
-		sprite_id = sprite->unknown.next_in_quadrant){
-
-		sprite = get_sprite(sprite_id);
-
-		if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_LITTER * 2) continue;
+	sprite_query query;
+	sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_LITTER));
 
+	rct_sprite* sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL){
 		uint16 z_diff = abs(peep->z - sprite->litter.z);
 
 		if (z_diff >= 16)continue;
@@ -6543,11 +6452,11 @@ static void peep_update_walking(rct_peep* peep){
 
 	if (peep->peep_flags & PEEP_FLAGS_LEAVING_PARK)return;
 
-	if (peep->nausea > 140)return;
+	if (PEEP_NEED(peep, nausea) > 140)return;
 
-	if (peep->happiness < 120)return;
+	if (PEEP_NEED(peep, happiness) < 120)return;
 
-	if (peep->bathroom > 140)return;
+	if (PEEP_NEED(peep, bathroom) > 140)return;
 
 	uint16 chance = peep_has_food(peep) ? 13107 : 2849;
 
@@ -6587,12 +6496,11 @@ static void peep_update_walking(rct_peep* peep){
 	if (!peep_find_ride_to_look_at(peep, chosen_edge, &ride_to_view, &ride_seat_to_view))
 		return;
 
-	uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
-	for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant){
-		sprite = get_sprite(sprite_id);
-
-		if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_PEEP * 2) continue;
+	sprite_query query;
+	sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
 
+	rct_sprite* sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL){
 		if (sprite->peep.state != PEEP_STATE_WATCHING)continue;
 
 		if (peep->z != sprite->peep.z)continue;
@@ -6663,12 +6571,16 @@ static void peep_update_thoughts(rct_peep* peep){
 				// When thought is older than ~6900 ticks remove it
 				if (++peep->thoughts[i].var_2 >= 28) {
 					peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+					gGuestGroupsGeneration++;
 
 					// Clear top thought, push others up
 					if (i < PEEP_MAX_THOUGHTS - 2) {
 						memmove(&peep->thoughts[i], &peep->thoughts[i + 1], sizeof(rct_peep_thought)*(PEEP_MAX_THOUGHTS - i - 1));
 					}
 					peep->thoughts[PEEP_MAX_THOUGHTS - 1].type = PEEP_THOUGHT_TYPE_NONE;
+				} else if (peep->thoughts[i].var_2 == 6) {
+					// Too old to be grouped in the guest list
+					gGuestGroupsGeneration++;
 				}
 			}
 		}
@@ -6682,6 +6594,7 @@ static void peep_update_thoughts(rct_peep* peep){
 	if (add_fresh && fresh_thought != -1) {
 		peep->thoughts[fresh_thought].var_2 = 1;
 		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+		gGuestGroupsGeneration++;
 	}
 }
 
@@ -6700,7 +6613,7 @@ static void peep_update(rct_peep *peep)
 	}
 
 	// Walking speed logic
-	uint32 stepsToTake = peep->energy;
+	uint32 stepsToTake = PEEP_NEED(peep, energy);
 	if (stepsToTake < 95 && peep->state == PEEP_STATE_QUEUING)
 		stepsToTake = 95;
 	if ((peep->peep_flags & PEEP_FLAGS_SLOW_WALK) && peep->state != PEEP_STATE_QUEUING)
@@ -7185,6 +7098,7 @@ rct_peep *peep_generate(sint32 x, sint32 y, sint32 z)
 	peep->var_C4 = 0;
 	peep->interactionRideIndex = 0xFF;
 	peep->type = PEEP_TYPE_GUEST;
+	peep_needs_set_guest(peep->sprite_index, true);
 	peep->previous_ride = 0xFF;
 	peep->thoughts->type = PEEP_THOUGHT_TYPE_NONE;
 	peep->window_invalidate_flags = 0;
@@ -7216,38 +7130,38 @@ rct_peep *peep_generate(sint32 x, sint32 y, sint32 z)
 	/* Scenario editor limits initial guest happiness to between 37..253.
 	 * To be on the safe side, assume the value could have been hacked
 	 * to any value 0..255. */
-	peep->happiness = gGuestInitialHappiness;
+	PEEP_NEED(peep, happiness) = gGuestInitialHappiness;
 	/* Assume a default initial happiness of 0 is wrong and set
 	 * to 128 (50%) instead. */
 	if (gGuestInitialHappiness == 0)
-		peep->happiness = 128;
+		PEEP_NEED(peep, happiness) = 128;
 	/* Initial value will vary by -15..16 */
 	sint8 happiness_delta = (scenario_rand() & 0x1F) - 15;
 	/* Adjust by the delta, clamping at min=0 and max=255. */
-	peep->happiness = clamp(0, peep->happiness + happiness_delta, 255);
-	peep->happiness_growth_rate = peep->happiness;
-	peep->nausea = 0;
-	peep->nausea_growth_rate = 0;
+	PEEP_NEED(peep, happiness) = clamp(0, PEEP_NEED(peep, happiness) + happiness_delta, 255);
+	PEEP_NEED(peep, happiness_growth_rate) = PEEP_NEED(peep, happiness);
+	PEEP_NEED(peep, nausea) = 0;
+	PEEP_NEED(peep, nausea_growth_rate) = 0;
 
 	/* Scenario editor limits initial guest hunger to between 37..253.
 	 * To be on the safe side, assume the value could have been hacked
 	 * to any value 0..255. */
-	peep->hunger = gGuestInitialHunger;
+	PEEP_NEED(peep, hunger) = gGuestInitialHunger;
 	/* Initial value will vary by -15..16 */
 	sint8 hunger_delta = (scenario_rand() & 0x1F) - 15;
 	/* Adjust by the delta, clamping at min=0 and max=255. */
-	peep->hunger = clamp(0, peep->hunger + hunger_delta, 255);
+	PEEP_NEED(peep, hunger) = clamp(0, PEEP_NEED(peep, hunger) + hunger_delta, 255);
 
 	/* Scenario editor limits initial guest thirst to between 37..253.
 	 * To be on the safe side, assume the value could have been hacked
 	 * to any value 0..255. */
-	peep->thirst = gGuestInitialThirst;
+	PEEP_NEED(peep, thirst) = gGuestInitialThirst;
 	/* Initial value will vary by -15..16 */
 	sint8 thirst_delta = (scenario_rand() & 0x1F) - 15;
 	/* Adjust by the delta, clamping at min=0 and max=255. */
-	peep->thirst = clamp(0, peep->thirst + thirst_delta, 0xFF);
+	PEEP_NEED(peep, thirst) = clamp(0, PEEP_NEED(peep, thirst) + thirst_delta, 0xFF);
 
-	peep->bathroom = 0;
+	PEEP_NEED(peep, bathroom) = 0;
 	peep->var_42 = 0;
 	memset(&peep->rides_been_on, 0, 32);
 
@@ -7305,8 +7219,8 @@ rct_peep *peep_generate(sint32 x, sint32 y, sint32 z)
 	/* It looks like 65 is about 50% energy level, so this initialises
 	 * a peep with approx 50%-100% energy. */
 	uint8 energy = (scenario_rand() & 0x3F) + 65;
-	peep->energy = energy;
-	peep->energy_growth_rate = energy;
+	PEEP_NEED(peep, energy) = energy;
+	PEEP_NEED(peep, energy_growth_rate) = energy;
 
 	if (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES){
 		peep_give_real_name(peep);
@@ -7564,23 +7478,23 @@ static sint32 get_face_sprite_offset(rct_peep *peep){
 	if (peep->angriness > 0) return PEEP_FACE_OFFSET_ANGRY;
 
 	// VERY_VERY_SICK
-	if (peep->nausea > 200) return PEEP_FACE_OFFSET_VERY_VERY_SICK;
+	if (PEEP_NEED(peep, nausea) > 200) return PEEP_FACE_OFFSET_VERY_VERY_SICK;
 
 	// VERY_SICK
-	if (peep->nausea > 170) return PEEP_FACE_OFFSET_VERY_SICK;
+	if (PEEP_NEED(peep, nausea) > 170) return PEEP_FACE_OFFSET_VERY_SICK;
 
 	// SICK
-	if (peep->nausea > 140) return PEEP_FACE_OFFSET_SICK;
+	if (PEEP_NEED(peep, nausea) > 140) return PEEP_FACE_OFFSET_SICK;
 
 	// VERY_TIRED
-	if (peep->energy < 46) return PEEP_FACE_OFFSET_VERY_TIRED;
+	if (PEEP_NEED(peep, energy) < 46) return PEEP_FACE_OFFSET_VERY_TIRED;
 
 	// TIRED
-	if (peep->energy < 70) return PEEP_FACE_OFFSET_TIRED;
+	if (PEEP_NEED(peep, energy) < 70) return PEEP_FACE_OFFSET_TIRED;
 
 	sint32 offset = PEEP_FACE_OFFSET_VERY_VERY_UNHAPPY;
 	//There are 7 different happiness based faces
-	for (sint32 i = 37; peep->happiness >= i; i += 37)
+	for (sint32 i = 37; PEEP_NEED(peep, happiness) >= i; i += 37)
 	{
 		offset++;
 	}
@@ -7753,13 +7667,13 @@ static sint32 peep_has_empty_container(rct_peep* peep){
 static sint32 peep_should_find_bench(rct_peep* peep){
 	if (!(peep->peep_flags & PEEP_FLAGS_LEAVING_PARK)){
 		if (peep_has_food(peep)){
-			if (peep->hunger < 128 || peep->happiness < 128){
+			if (PEEP_NEED(peep, hunger) < 128 || PEEP_NEED(peep, happiness) < 128){
 				if (!(peep->next_var_29 & 0x1C)){
 					return 1;
 				}
 			}
 		}
-		if (peep->nausea <= 170 && peep->energy > 50){
+		if (PEEP_NEED(peep, nausea) <= 170 && PEEP_NEED(peep, energy) > 50){
 			return 0;
 		}
 
@@ -7812,6 +7726,7 @@ void peep_insert_new_thought(rct_peep *peep, uint8 thought_type, uint8 thought_a
 	peep->thoughts[0].var_3 = 0;
 
 	peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+	gGuestGroupsGeneration++;
 }
 
 /**
@@ -8239,7 +8154,7 @@ static sint32 peep_footpath_move_forward(rct_peep* peep, sint16 x, sint16 y, rct
 
 			if ((scenario_rand() & 0xFFFF) <= 10922){
 				peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_VANDALISM, 0xFF);
-				peep->happiness_growth_rate = max(0, peep->happiness_growth_rate - 17);
+				PEEP_NEED(peep, happiness_growth_rate) = max(0, PEEP_NEED(peep, happiness_growth_rate) - 17);
 			}
 			peep->var_EF |= 0xC0;
 		}
@@ -8253,9 +8168,11 @@ static sint32 peep_footpath_move_forward(rct_peep* peep, sint16 x, sint16 y, rct
 	uint16 crowded = 0;
 	uint8 litter_count = 0;
 	uint8 sick_count = 0;
-	uint16 sprite_id = sprite_get_first_in_quadrant(x, y);
-	for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant){
-		sprite = get_sprite(sprite_id);
+	sprite_query query;
+	sprite_query_tile(&query, x >> 5, y >> 5, SPRITE_LIST_MASK_ALL);
+
+	rct_sprite* sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL){
 		if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP){
 			rct_peep* other_peep = (rct_peep*)sprite;
 			if (other_peep->state != PEEP_STATE_WALKING)
@@ -8285,7 +8202,7 @@ static sint32 peep_footpath_move_forward(rct_peep* peep, sint16 x, sint16 y, rct
 		(scenario_rand() & 0xFFFF) <= 21845){
 
 		peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_CROWDED, 0xFF);
-		peep->happiness_growth_rate = max(0, peep->happiness_growth_rate - 14);
+		PEEP_NEED(peep, happiness_growth_rate) = max(0, PEEP_NEED(peep, happiness_growth_rate) - 14);
 	}
 
 	litter_count = min(3, litter_count);
@@ -8309,7 +8226,7 @@ static sint32 peep_footpath_move_forward(rct_peep* peep, sint16 x, sint16 y, rct
 		if (total_sick >= 3 &&
 			(scenario_rand() & 0xFFFF) <= 10922){
 			peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_PATH_DISGUSTING, 0xFF);
-			peep->happiness_growth_rate = max(0, peep->happiness_growth_rate - 17);
+			PEEP_NEED(peep, happiness_growth_rate) = max(0, PEEP_NEED(peep, happiness_growth_rate) - 17);
 			// Reset disgusting time
 			peep->disgusting_count |= 0xC0;
 		}
@@ -8333,7 +8250,7 @@ static sint32 peep_footpath_move_forward(rct_peep* peep, sint16 x, sint16 y, rct
 		if (total_litter >= 3 &&
 			(scenario_rand() & 0xFFFF) <= 10922){
 			peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_BAD_LITTER, 0xFF);
-			peep->happiness_growth_rate = max(0, peep->happiness_growth_rate - 17);
+			PEEP_NEED(peep, happiness_growth_rate) = max(0, PEEP_NEED(peep, happiness_growth_rate) - 17);
 			// Reset litter time
 			peep->litter_count |= 0xC0;
 		}
@@ -8505,8 +8422,10 @@ static sint32 peep_interact_with_shop(rct_peep* peep, sint16 x, sint16 y, rct_ma
 		return 1;
 	}
 	else{
-		if (peep->guest_heading_to_ride_id == rideIndex)
+		if (peep->guest_heading_to_ride_id == rideIndex) {
 			peep->guest_heading_to_ride_id = 0xFF;
+			gGuestGroupsGeneration++;
+		}
 		peep->action_sprite_image_offset = _unk_F1AEF0;
 		peep_decrement_num_riders(peep);
 		peep->current_ride = rideIndex;
@@ -8611,104 +8530,20 @@ static sint32 guest_surface_path_finding(rct_peep* peep){
 	return peep_move_one_tile(randDirection, peep);
 }
 
-static rct_map_element* get_banner_on_path(rct_map_element *path_element)
-{
-	// This is an improved version of original.
-	// That only checked for one fence in the way.
-	if (map_element_is_last_for_tile(path_element))
-		return NULL;
-
-	rct_map_element *bannerElement = path_element + 1;
-	do {
-		// Path on top, so no banners
-		if (map_element_get_type(bannerElement) == MAP_ELEMENT_TYPE_PATH)
-			return NULL;
-		// Found a banner
-		if (map_element_get_type(bannerElement) == MAP_ELEMENT_TYPE_BANNER)
-			return bannerElement;
-		// Last element so there cant be any other banners
-		if (map_element_is_last_for_tile(bannerElement))
-			return NULL;
-
-	} while (bannerElement++);
-
-	return NULL;
-}
-
-static sint32 banner_clear_path_edges(rct_map_element *mapElement, sint32 edges)
-{
-	if (_peepPathFindIsStaff) return edges;
-	rct_map_element *bannerElement = get_banner_on_path(mapElement);
-	if (bannerElement != NULL) {
-		do {
-			edges &= bannerElement->properties.banner.flags;
-		} while ((bannerElement = get_banner_on_path(bannerElement)) != NULL);
-	}
-	return edges;
-}
-
 /**
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
 static sint32 path_get_permitted_edges(rct_map_element *mapElement)
 {
-	return banner_clear_path_edges(mapElement, mapElement->properties.path.edges) & 0x0F;
-}
-
-static bool is_valid_path_z_and_direction(rct_map_element *mapElement, sint32 currentZ, sint32 currentDirection)
-{
-	if (footpath_element_is_sloped(mapElement)) {
-		sint32 slopeDirection = footpath_element_get_slope_direction(mapElement);
-		if (slopeDirection == currentDirection) {
-			if (currentZ != mapElement->base_height) return false;
-		} else {
-			slopeDirection ^= 2;
-			if (slopeDirection != currentDirection) return false;
-			if (currentZ != mapElement->base_height + 2) return false;
-		}
-	} else {
-		if (currentZ != mapElement->base_height) return false;
-	}
-	return true;
+	return footpath_element_get_permitted_edges(mapElement, _peepPathFindIsStaff);
 }
 
 /**
- *
- * Returns:
- *   1 - PATH_SEARCH_WIDE (path with wide flag set)
- *   4 - PATH_SEARCH_RIDE_QUEUE (queue path connected to a ride)
- *   11 - PATH_SEARCH_OTHER (other path than the above)
- *   12 - PATH_SEARCH_FAILED (no path element found)
- *
- *  rct2: 0x00694BAE
- *
- * Returns the type of the next footpath tile a peep can get to from x,y,z /
- * inputMapElement in the given direction.
+ * Gets the connected edges of a footpath graph node that are permitted for the peep that is searching.
  */
-static uint8 footpath_element_next_in_direction(sint16 x, sint16 y, sint16 z, rct_map_element *mapElement, uint8 chosenDirection)
+static sint32 path_node_get_permitted_edges(const footpath_graph_node *node)
 {
-	rct_map_element *nextMapElement;
-
-	if (footpath_element_is_sloped(mapElement)) {
-		if (footpath_element_get_slope_direction(mapElement) == chosenDirection) {
-			z += 2;
-		}
-	}
-
-	x += TileDirectionDelta[chosenDirection].x;
-	y += TileDirectionDelta[chosenDirection].y;
-	nextMapElement = map_get_first_element_at(x / 32, y / 32);
-	do {
-		if (map_element_get_type(nextMapElement) != MAP_ELEMENT_TYPE_PATH) continue;
-		if (!is_valid_path_z_and_direction(nextMapElement, z, chosenDirection)) continue;
-		if (footpath_element_is_wide(nextMapElement)) return PATH_SEARCH_WIDE;
-		// Only queue tiles that are connected to a ride are returned as ride queues.
-		if (footpath_element_is_queue(nextMapElement) && nextMapElement->properties.path.ride_index != 0xFF) return PATH_SEARCH_RIDE_QUEUE;
-
-		return PATH_SEARCH_OTHER;
-	} while (!map_element_is_last_for_tile(nextMapElement++));
-
-	return PATH_SEARCH_FAILED;
+	return _peepPathFindIsStaff ? node->staff_edges : node->edges;
 }
 
 /**
@@ -8776,7 +8611,7 @@ static uint8 footpath_element_dest_in_dir(
 			}
 			break;
 		case MAP_ELEMENT_TYPE_PATH:
-			if (!is_valid_path_z_and_direction(mapElement, z, chosenDirection)) continue;
+			if (!footpath_element_is_valid_z_and_direction(mapElement, z, chosenDirection)) continue;
 			if (footpath_element_is_wide(mapElement)) return PATH_SEARCH_WIDE;
 
 			uint8 edges = path_get_permitted_edges(mapElement);
@@ -8889,41 +8724,11 @@ static uint8 peep_pathfind_get_max_number_junctions(rct_peep* peep){
 }
 
 /**
- * Returns if the path as xzy is a 'thin' junction.
- * A junction is considered 'thin' if it has more than 2 edges
- * leading to non-wide path elements; edges leading to non-path elements
- * (e.g. ride/shop entrances) or ride queues are not counted, since entrances
- * and ride queues coming off a path should not result in the path being
- * considered a junction.
+ * Returns if the footpath graph node is a 'thin' junction for the peep that is searching.
  */
-static bool path_is_thin_junction(rct_map_element *path, sint16 x, sint16 y, uint8 z) {
-	uint8 edges = path_get_permitted_edges(path);
-
-	sint32 test_edge = bitscanforward(edges);
-	if (test_edge == -1) return false;
-
-	bool thin_junction = false;
-	sint32 thin_count = 0;
-	do
-	{
-		sint32 fp_result = footpath_element_next_in_direction(x, y, z, path, test_edge);
-
-		/* Ignore non-paths (e.g. ride entrances, shops), wide paths
-		 * and ride queues (per ignoreQueues) when counting
-		 * neighbouring tiles. */
-		if (fp_result != PATH_SEARCH_FAILED &&
-			fp_result != PATH_SEARCH_WIDE &&
-			fp_result != PATH_SEARCH_RIDE_QUEUE) {
-			thin_count++;
-		}
-
-		if (thin_count > 2) {
-			thin_junction = true;
-			break;
-		}
-		edges &= ~(1 << test_edge);
-	} while ((test_edge = bitscanforward(edges)) != -1);
-	return thin_junction;
+static bool path_node_is_thin_junction(const footpath_graph_node *node) {
+	uint8 flag = _peepPathFindIsStaff ? FOOTPATH_GRAPH_NODE_FLAG_STAFF_THIN_JUNCTION : FOOTPATH_GRAPH_NODE_FLAG_THIN_JUNCTION;
+	return (node->flags & flag) != 0;
 }
 
 /**
@@ -9002,7 +8807,7 @@ static bool path_is_thin_junction(rct_map_element *path, sint16 x, sint16 y, uin
  *
  *  rct2: 0x0069A997
  */
-static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep *peep, rct_map_element *currentMapElement, bool inPatrolArea, uint8 counter, uint16 *endScore, sint32 test_edge, uint8 *endJunctions, rct_xyz8 junctionList[16], uint8 directionList[16], rct_xyz8 *endXYZ, uint8 *endSteps) {
+static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep *peep, const footpath_graph_tile *currentTile, const footpath_graph_node *currentNode, bool inPatrolArea, uint8 counter, uint16 *endScore, sint32 test_edge, uint8 *endJunctions, rct_xyz8 junctionList[16], uint8 directionList[16], rct_xyz8 *endXYZ, uint8 *endSteps) {
 	uint8 searchResult = PATH_SEARCH_FAILED;
 
 	x += TileDirectionDelta[test_edge].x;
@@ -9042,22 +8847,57 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 		}
 	}
 
-	/* Get the next map element of interest in the direction of test_edge. */
+	/* Get the map elements of interest in the direction of test_edge
+	 * from the links of the current path. */
+	sint32 numLinks;
+	const footpath_graph_link *links = footpath_graph_get_links(currentTile, currentNode, test_edge, &numLinks);
+	const footpath_graph_tile *tile = NULL;
+	if (numLinks != 0) {
+		tile = footpath_graph_get_tile(x / 32, y / 32);
+	}
+
+	/* The links only hold while test_edge is the direction the tile was
+	 * entered by. Once a path changes test_edge the rest of the tile is
+	 * checked element by element from after that path. */
+	sint32 linkEdge = test_edge;
+	const footpath_graph_node *node = NULL;
+	rct_map_element *mapElement = NULL;
+	uint8 nodeIndex = 0;
+	footpath_graph_link elementLink;
+
 	bool found = false;
-	rct_map_element *mapElement = map_get_first_element_at(x / 32, y / 32);
-	do {
+	sint32 linkIndex = 0;
+	while (true) {
 		/* Look for all map elements that the peep could walk onto while
 		 * navigating to the goal, including the goal tile. */
+		if (mapElement == NULL && test_edge != linkEdge && !(node->flags & FOOTPATH_GRAPH_NODE_FLAG_LAST_ON_TILE)) {
+			mapElement = map_get_first_element_at(x / 32, y / 32) + node->element_index;
+			nodeIndex = (uint8)(node - tile->nodes) + 1;
+		}
 
-		if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST) continue;
+		const footpath_graph_link *link;
+		if (mapElement == NULL) {
+			if (linkIndex >= numLinks) break;
+			link = &links[linkIndex++];
+		} else {
+			bool linked = false;
+			while (!linked && !map_element_is_last_for_tile(mapElement++)) {
+				bool isPath = map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_PATH;
+				linked = footpath_graph_link_element(mapElement, &z, test_edge, &elementLink);
+				elementLink.node_index = nodeIndex;
+				if (isPath) nodeIndex++;
+			}
+			if (!linked) break;
+			link = &elementLink;
+		}
+		z = link->z;
 
 		uint8 rideIndex = 0xFF;
-		switch (map_element_get_type(mapElement)) {
-		case MAP_ELEMENT_TYPE_TRACK:
-			if (z != mapElement->base_height) continue;
+		switch (link->type) {
+		case FOOTPATH_GRAPH_LINK_TRACK:
 			/* For peeps heading for a shop, the goal is the shop
 			 * tile. */
-			rideIndex = mapElement->properties.track.ride_index;
+			rideIndex = link->ride_index;
 			rct_ride *ride = get_ride(rideIndex);
 			if (ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP)) {
 				found = true;
@@ -9066,57 +8906,37 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 			} else {
 				continue;
 			}
-		case MAP_ELEMENT_TYPE_ENTRANCE:
-			if (z != mapElement->base_height) continue;
-			sint32 direction;
-			searchResult = PATH_SEARCH_OTHER;
-			switch (mapElement->properties.entrance.type) {
-			case ENTRANCE_TYPE_RIDE_ENTRANCE:
-				/* For peeps heading for a ride without a queue, the
-				 * goal is the ride entrance tile.
-				 * For mechanics heading for the ride entrance
-				 * (in the case when the station has no exit),
-				 * the goal is the ride entrance tile. */
-				direction = mapElement->type & MAP_ELEMENT_DIRECTION_MASK;
-				if (direction == test_edge) {
-					/* The rideIndex will be useful for
-					 * adding transport rides later. */
-					rideIndex = mapElement->properties.entrance.ride_index;
-					searchResult = PATH_SEARCH_RIDE_ENTRANCE;
-					found = true;
-					break;
-				}
-				continue; // Ride entrance is not facing the right direction.
-			case ENTRANCE_TYPE_PARK_ENTRANCE:
-				/* For peeps leaving the park, the goal is the park
-				 * entrance/exit tile. */
-				searchResult = PATH_SEARCH_PARK_EXIT;
-				found = true;
-				break;
-			case ENTRANCE_TYPE_RIDE_EXIT:
-				/* For mechanics heading for the ride exit, the
-				 * goal is the ride exit tile. */
-				direction = mapElement->type & MAP_ELEMENT_DIRECTION_MASK;
-				if (direction == test_edge) {
-					searchResult = PATH_SEARCH_RIDE_EXIT;
-					found = true;
-					break;
-				}
-				continue; // Ride exit is not facing the right direction.
-			default: continue;
-			}
+		case FOOTPATH_GRAPH_LINK_RIDE_ENTRANCE:
+			/* For peeps heading for a ride without a queue, the
+			 * goal is the ride entrance tile.
+			 * For mechanics heading for the ride entrance
+			 * (in the case when the station has no exit),
+			 * the goal is the ride entrance tile. */
+			/* The rideIndex will be useful for
+			 * adding transport rides later. */
+			rideIndex = link->ride_index;
+			searchResult = PATH_SEARCH_RIDE_ENTRANCE;
+			found = true;
 			break;
-		case MAP_ELEMENT_TYPE_PATH:
+		case FOOTPATH_GRAPH_LINK_PARK_ENTRANCE:
+			/* For peeps leaving the park, the goal is the park
+			 * entrance/exit tile. */
+			searchResult = PATH_SEARCH_PARK_EXIT;
+			found = true;
+			break;
+		case FOOTPATH_GRAPH_LINK_RIDE_EXIT:
+			/* For mechanics heading for the ride exit, the
+			 * goal is the ride exit tile. */
+			searchResult = PATH_SEARCH_RIDE_EXIT;
+			found = true;
+			break;
+		case FOOTPATH_GRAPH_LINK_PATH:
 			/* For peeps heading for a ride with a queue, the goal is the last
 			 * queue path.
 			 * Otherwise, peeps walk on path tiles to get to the goal. */
+			node = &tile->nodes[link->node_index];
 
-			if (!is_valid_path_z_and_direction(mapElement, z, test_edge)) continue;
-
-			// Path may be sloped, so set z to path base height.
-			z = mapElement->base_height;
-
-			if (footpath_element_is_wide(mapElement)) {
+			if (node->flags & FOOTPATH_GRAPH_NODE_FLAG_WIDE) {
 				searchResult = PATH_SEARCH_WIDE;
 				found = true;
 				break;
@@ -9124,19 +8944,19 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 
 			searchResult = PATH_SEARCH_THIN;
 
-			uint8 numEdges = bitcount(path_get_permitted_edges(mapElement));
+			uint8 numEdges = bitcount(path_node_get_permitted_edges(node));
 
 			if (numEdges < 2) {
 				searchResult = PATH_SEARCH_DEAD_END;
 			} else if (numEdges > 2) {
 				searchResult = PATH_SEARCH_JUNCTION;
 			} else { // numEdges == 2
-				if (footpath_element_is_queue(mapElement) && mapElement->properties.path.ride_index != gPeepPathFindQueueRideIndex) {
-					if (gPeepPathFindIgnoreForeignQueues && (mapElement->properties.path.ride_index != 0xFF)) {
+				if ((node->flags & FOOTPATH_GRAPH_NODE_FLAG_QUEUE) && node->ride_index != gPeepPathFindQueueRideIndex) {
+					if (gPeepPathFindIgnoreForeignQueues && (node->ride_index != 0xFF)) {
 						// Path is a queue we aren't interested in
 						/* The rideIndex will be useful for
 						* adding transport rides later. */
-						rideIndex = mapElement->properties.path.ride_index;
+						rideIndex = node->ride_index;
 						searchResult = PATH_SEARCH_RIDE_QUEUE;
 					}
 				}
@@ -9228,7 +9048,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 			 * be reachable from here.
 			 * If the search result is better than the best so far (in the paramaters),
 			 * then update the parameters with this search before continuing to the next map element. */
-			if (footpath_element_is_wide(currentMapElement) &&
+			if ((currentNode->flags & FOOTPATH_GRAPH_NODE_FLAG_WIDE) &&
 				(new_score < *endScore || (new_score == *endScore && counter < *endSteps ))) {
 				// Update the search results
 				*endScore = new_score;
@@ -9258,7 +9078,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 		/* At this point the map element is a non-wide path.*/
 
 		/* Get all the permitted_edges of the map element. */
-		uint8 edges = path_get_permitted_edges(mapElement);
+		uint8 edges = path_node_get_permitted_edges(node);
 
 		#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 		if (gPathFindDebug) {
@@ -9318,7 +9138,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 		if (searchResult == PATH_SEARCH_JUNCTION) {
 			/* Check if this is a thin junction. And perform additional
 			 * necessary checks. */
-			thin_junction = path_is_thin_junction(mapElement, x, y, z);
+			thin_junction = path_node_is_thin_junction(node);
 
 			if (thin_junction) {
 				/* The current search path is passing through a thin
@@ -9429,8 +9249,8 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 			uint8 savedNumJunctions = _peepPathFindNumJunctions;
 
 			uint8 height = z;
-			if (footpath_element_is_sloped(mapElement) &&
-				footpath_element_get_slope_direction(mapElement) == test_edge) {
+			if ((node->flags & FOOTPATH_GRAPH_NODE_FLAG_SLOPED) &&
+				node->slope_direction == test_edge) {
 				height += 2;
 			}
 			#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -9451,7 +9271,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 				_peepPathFindHistory[_peepPathFindNumJunctions + 1].direction = test_edge;
 			}
 
-			peep_pathfind_heuristic_search(x, y, height, peep, mapElement, nextInPatrolArea, counter, endScore, test_edge, endJunctions, junctionList, directionList, endXYZ, endSteps);
+			peep_pathfind_heuristic_search(x, y, height, peep, tile, node, nextInPatrolArea, counter, endScore, test_edge, endJunctions, junctionList, directionList, endXYZ, endSteps);
 			_peepPathFindNumJunctions = savedNumJunctions;
 
 			#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -9460,8 +9280,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 			}
 			#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 		} while ((test_edge = bitscanforward(edges)) != -1);
-
-	} while (!map_element_is_last_for_tile(mapElement++));
+	}
 
 	if (!found) {
 		/* No map element could be found.
@@ -9482,6 +9301,30 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 	return;
 }
 
+/**
+ * Gets the direction of the shortest way to the current pathfinding goal from the flow field of the goal.
+ * Returns -1 if the goal can not be reached from x,y,z along the paths.
+ */
+sint32 peep_pathfind_get_flow_direction(sint16 x, sint16 y, uint8 z, rct_peep *peep)
+{
+	footpath_flow_key key = {
+		.goal = {
+			.x = (uint8)(gPeepPathFindGoalPosition.x >> 5),
+			.y = (uint8)(gPeepPathFindGoalPosition.y >> 5),
+			.z = (uint8)(gPeepPathFindGoalPosition.z)
+		},
+		.flags = 0,
+		.queue_ride_index = gPeepPathFindQueueRideIndex
+	};
+	if (peep->type == PEEP_TYPE_STAFF) {
+		key.flags |= FOOTPATH_FLOW_FLAG_STAFF;
+	}
+	if (gPeepPathFindIgnoreForeignQueues) {
+		key.flags |= FOOTPATH_FLOW_FLAG_IGNORE_FOREIGN_QUEUES;
+	}
+	return footpath_flow_get_direction(&key, x >> 5, y >> 5, z, NULL);
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -9512,8 +9355,21 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *pee
 	}
 	#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-	// Get the path element at this location
-	rct_map_element *dest_map_element = map_get_first_element_at(x / 32, y / 32);
+	/* Guests heading for the same destination share a flow field
+	 * giving the shortest way there from every path. When the
+	 * destination can not be reached that way, fall back to the
+	 * heuristic search. In network games every player uses the
+	 * server's setting, so all players path the same. */
+	bool useFlowFields = network_get_mode() == NETWORK_MODE_NONE ? gConfigGeneral.guest_flow_fields != 0 : gGuestFlowFieldsNetwork;
+	if (useFlowFields && peep->type == PEEP_TYPE_GUEST) {
+		sint32 flowDirection = peep_pathfind_get_flow_direction(x, y, z, peep);
+		if (flowDirection != -1) {
+			return flowDirection;
+		}
+	}
+
+	// Get the path nodes at this location
+	const footpath_graph_tile *tile = footpath_graph_get_tile(x / 32, y / 32);
 	/* Where there are multiple matching map elements placed with zero
 	 * clearance, save the first one for later use to determine the path
 	 * slope - this maintains the original behaviour (which only processes
@@ -9529,17 +9385,17 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *pee
 	 * EXPECT to experience path finding irregularities due to those paths!
 	 * In particular common edges at different heights will not work
 	 * in a useful way. Simply do not do it! :-) */
-	rct_map_element *first_map_element = NULL;
+	const footpath_graph_node *first_node = NULL;
 
 	bool found = false;
 	uint8 permitted_edges = 0;
 	bool isThin = false;
-	do {
-		if (dest_map_element->base_height != z) continue;
-		if (map_element_get_type(dest_map_element) != MAP_ELEMENT_TYPE_PATH) continue;
+	for (sint32 i = 0; i < tile->num_nodes; i++) {
+		const footpath_graph_node *node = &tile->nodes[i];
+		if (node->z != z) continue;
 		found = true;
-		if (first_map_element == NULL) {
-			first_map_element = dest_map_element;
+		if (first_node == NULL) {
+			first_node = node;
 		}
 
 		/* Check if this path element is a thin junction.
@@ -9548,11 +9404,11 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *pee
 		 * check if the combination is 'thin'!
 		 * The junction is considered 'thin' simply if any of the
 		 * overlaid path elements there is a 'thin junction'. */
-		isThin = isThin || path_is_thin_junction(dest_map_element, x, y, z);
+		isThin = isThin || path_node_is_thin_junction(node);
 
 		// Collect the permitted edges of ALL matching path elements at this location.
-		permitted_edges |= path_get_permitted_edges(dest_map_element);
-	} while (!map_element_is_last_for_tile(dest_map_element++));
+		permitted_edges |= path_node_get_permitted_edges(node);
+	}
 	// Peep is not on a path.
 	if (!found) return -1;
 
@@ -9672,8 +9528,8 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *pee
 			edges &= ~(1 << test_edge);
 			uint8 height = z;
 
-			if (footpath_element_is_sloped(first_map_element) &&
-				footpath_element_get_slope_direction(first_map_element) == test_edge
+			if ((first_node->flags & FOOTPATH_GRAPH_NODE_FLAG_SLOPED) &&
+				first_node->slope_direction == test_edge
 			) {
 				height += 0x2;
 			}
@@ -9731,7 +9587,7 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *pee
 			}
 			#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 
-			peep_pathfind_heuristic_search(x, y, height, peep, first_map_element, inPatrolArea, 0, &score, test_edge, &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+			peep_pathfind_heuristic_search(x, y, height, peep, tile, first_node, inPatrolArea, 0, &score, test_edge, &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
 
 			#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 			if (gPathFindDebug) {
@@ -10548,7 +10404,7 @@ static void peep_on_enter_ride(rct_peep *peep, sint32 rideIndex)
 
 	peep_set_has_ridden(peep, peep->current_ride);
 	peep_update_favourite_ride(peep, ride);
-	peep->happiness_growth_rate = clamp(0, peep->happiness_growth_rate + satisfaction, 255);
+	PEEP_NEED(peep, happiness_growth_rate) = clamp(0, PEEP_NEED(peep, happiness_growth_rate) + satisfaction, 255);
 	peep_update_ride_nausea_growth(peep, ride);
 }
 
@@ -10565,9 +10421,9 @@ static void peep_on_enter_ride(rct_peep *peep, sint32 rideIndex)
 static void peep_update_favourite_ride(rct_peep *peep, rct_ride *ride)
 {
 	peep->peep_flags &= ~PEEP_FLAGS_RIDE_SHOULD_BE_MARKED_AS_FAVOURITE;
-	uint8 peepRideRating = clamp(0, (ride->excitement / 4) + peep->happiness, 255);
+	uint8 peepRideRating = clamp(0, (ride->excitement / 4) + PEEP_NEED(peep, happiness), 255);
 	if (peepRideRating >= peep->favourite_ride_rating) {
-		if (peep->happiness >= 160 && peep->happiness_growth_rate >= 160) {
+		if (PEEP_NEED(peep, happiness) >= 160 && PEEP_NEED(peep, happiness_growth_rate) >= 160) {
 			peep->favourite_ride_rating = peepRideRating;
 			peep->peep_flags |= PEEP_FLAGS_RIDE_SHOULD_BE_MARKED_AS_FAVOURITE;
 		}
@@ -10589,7 +10445,7 @@ static sint16 peep_calculate_ride_value_satisfaction(rct_peep* peep, rct_ride* r
         return -5;
     }
 
-    if ((ride->value + ((ride->value * peep->happiness) / 256)) >= ridePrice) {
+    if ((ride->value + ((ride->value * PEEP_NEED(peep, happiness)) / 256)) >= ridePrice) {
         return -30;
     }
 
@@ -10615,13 +10471,13 @@ static sint16 peep_calculate_ride_intensity_nausea_satisfaction(rct_peep * peep,
 	if (minIntensity <= ride->intensity && maxIntensity >= ride->intensity) {
 		intensitySatisfaction--;
 	}
-	minIntensity -= peep->happiness * 2;
-	maxIntensity += peep->happiness;
+	minIntensity -= PEEP_NEED(peep, happiness) * 2;
+	maxIntensity += PEEP_NEED(peep, happiness);
 	if (minIntensity <= ride->intensity && maxIntensity >= ride->intensity) {
 		intensitySatisfaction--;
 	}
-	minIntensity -= peep->happiness * 2;
-	maxIntensity += peep->happiness;
+	minIntensity -= PEEP_NEED(peep, happiness) * 2;
+	maxIntensity += PEEP_NEED(peep, happiness);
 	if (minIntensity <= ride->intensity && maxIntensity >= ride->intensity) {
 		intensitySatisfaction--;
 	}
@@ -10633,13 +10489,13 @@ static sint16 peep_calculate_ride_intensity_nausea_satisfaction(rct_peep * peep,
 	if (minNausea <= ride->nausea && maxNausea >= ride->nausea) {
 		nauseaSatisfaction--;
 	}
-	minNausea -= peep->happiness * 2;
-	maxNausea += peep->happiness;
+	minNausea -= PEEP_NEED(peep, happiness) * 2;
+	maxNausea += PEEP_NEED(peep, happiness);
 	if (minNausea <= ride->nausea && maxNausea >= ride->nausea) {
 		nauseaSatisfaction--;
 	}
-	minNausea -= peep->happiness * 2;
-	maxNausea += peep->happiness;
+	minNausea -= PEEP_NEED(peep, happiness) * 2;
+	maxNausea += PEEP_NEED(peep, happiness);
 	if (minNausea <= ride->nausea && maxNausea >= ride->nausea) {
 		nauseaSatisfaction--;
 	}
@@ -10718,11 +10574,11 @@ static sint16 peep_calculate_ride_satisfaction(rct_peep *peep, rct_ride *ride)
  */
 static void peep_update_ride_nausea_growth(rct_peep *peep, rct_ride *ride)
 {
-	uint32 nauseaMultiplier = clamp(64, 256 - peep->happiness_growth_rate, 200);
+	uint32 nauseaMultiplier = clamp(64, 256 - PEEP_NEED(peep, happiness_growth_rate), 200);
 	uint32 nauseaGrowthRateChange = (ride->nausea * nauseaMultiplier) / 512;
-	nauseaGrowthRateChange *= max(128, peep->hunger) / 64;
+	nauseaGrowthRateChange *= max(128, PEEP_NEED(peep, hunger)) / 64;
 	nauseaGrowthRateChange >>= (peep->nausea_tolerance & 3);
-	peep->nausea_growth_rate = (uint8)clamp(0, peep->nausea_growth_rate + nauseaGrowthRateChange, 255);
+	PEEP_NEED(peep, nausea_growth_rate) = (uint8)clamp(0, PEEP_NEED(peep, nausea_growth_rate) + nauseaGrowthRateChange, 255);
 }
 
 static bool peep_should_go_on_ride_again(rct_peep *peep, rct_ride *ride)
@@ -10730,11 +10586,11 @@ static bool peep_should_go_on_ride_again(rct_peep *peep, rct_ride *ride)
 	if (!ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_PEEP_WILL_RIDE_AGAIN)) return false;
 	if (!ride_has_ratings(ride)) return false;
 	if (ride->intensity > RIDE_RATING(10,00) && !gCheatsIgnoreRideIntensity) return false;
-	if (peep->happiness < 180) return false;
-	if (peep->energy < 100) return false;
-	if (peep->nausea > 160) return false;
-	if (peep->hunger < 30) return false;
-	if (peep->thirst < 20) return false;
+	if (PEEP_NEED(peep, happiness) < 180) return false;
+	if (PEEP_NEED(peep, energy) < 100) return false;
+	if (PEEP_NEED(peep, nausea) > 160) return false;
+	if (PEEP_NEED(peep, hunger) < 30) return false;
+	if (PEEP_NEED(peep, thirst) < 20) return false;
 	if (peep->balloon_colour > 170) return false;
 
 	uint8 r = (scenario_rand() & 0xFF);
@@ -10749,15 +10605,15 @@ static bool peep_should_go_on_ride_again(rct_peep *peep, rct_ride *ride)
 static bool peep_should_preferred_intensity_increase(rct_peep *peep)
 {
 	if (gParkFlags & PARK_FLAGS_PREF_LESS_INTENSE_RIDES) return false;
-	if (peep->happiness < 200) return false;
+	if (PEEP_NEED(peep, happiness) < 200) return false;
 
 	return (scenario_rand() & 0xFF) >= peep->intensity;
 }
 
 static bool peep_really_liked_ride(rct_peep *peep, rct_ride *ride)
 {
-	if (peep->happiness < 215) return false;
-	if (peep->nausea > 120) return false;
+	if (PEEP_NEED(peep, happiness) < 215) return false;
+	if (PEEP_NEED(peep, nausea) > 120) return false;
 	if (!ride_has_ratings(ride)) return false;
 	if (ride->intensity > RIDE_RATING(10, 00) && !gCheatsIgnoreRideIntensity) return false;
 	return true;
@@ -10777,8 +10633,8 @@ static void peep_on_exit_ride(rct_peep *peep, sint32 rideIndex)
 		// TODO fix this flag name or add another one
 		peep->window_invalidate_flags |= PEEP_INVALIDATE_STAFF_STATS;
 	}
-	peep->happiness = peep->happiness_growth_rate;
-	peep->nausea = peep->nausea_growth_rate;
+	PEEP_NEED(peep, happiness) = PEEP_NEED(peep, happiness_growth_rate);
+	PEEP_NEED(peep, nausea) = PEEP_NEED(peep, nausea_growth_rate);
 	peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_STATS;
 
 	if (peep->peep_flags & PEEP_FLAGS_LEAVING_PARK)
@@ -10786,6 +10642,7 @@ static void peep_on_exit_ride(rct_peep *peep, sint32 rideIndex)
 
 	if (peep_should_go_on_ride_again(peep, ride)) {
 		peep->guest_heading_to_ride_id = rideIndex;
+		gGuestGroupsGeneration++;
 		peep->peep_is_lost_countdown = 200;
 		peep_reset_pathfind_goal(peep);
 
@@ -10867,7 +10724,7 @@ static bool sub_69AF1E(rct_peep *peep, sint32 rideIndex, sint32 shopItem, money3
 		} else if ((food = peep_has_food_extra_flag(peep)) != 0) {
 			peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_HAVENT_FINISHED, bitscanforward(food) + 32);
 			return 0;
-		} else if (peep->nausea >= 145)
+		} else if (PEEP_NEED(peep, nausea) >= 145)
 			return 0;
 	}
 
@@ -10882,12 +10739,12 @@ static bool sub_69AF1E(rct_peep *peep, sint32 rideIndex, sint32 shopItem, money3
 			return 0;
 	}
 
-	if (shop_item_is_food(shopItem) && (peep->hunger > 75)) {
+	if (shop_item_is_food(shopItem) && (PEEP_NEED(peep, hunger) > 75)) {
 		peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_NOT_HUNGRY, 0xFF);
 		return 0;
 	}
 
-	if (shop_item_is_drink(shopItem) && (peep->thirst > 75)) {
+	if (shop_item_is_drink(shopItem) && (PEEP_NEED(peep, thirst) > 75)) {
 		peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_NOT_THIRSTY, 0xFF);
 		return 0;
 	}
@@ -10896,7 +10753,7 @@ static bool sub_69AF1E(rct_peep *peep, sint32 rideIndex, sint32 shopItem, money3
 			goto loc_69B119;
 
 	if ((shopItem != SHOP_ITEM_MAP) && shop_item_is_souvenir(shopItem) && !has_voucher) {
-		if (((scenario_rand() & 0x7F) + 0x73) > peep->happiness)
+		if (((scenario_rand() & 0x7F) + 0x73) > PEEP_NEED(peep, happiness))
 			return 0;
 		else if (peep->no_of_rides < 3)
 			return 0;
@@ -10930,10 +10787,10 @@ loc_69B119:
 			}
 
 			value = -value;
-			if (peep->happiness >= 128)
+			if (PEEP_NEED(peep, happiness) >= 128)
 				value /= 2;
 
-			if (peep->happiness >= 180)
+			if (PEEP_NEED(peep, happiness) >= 180)
 				value /= 2;
 
 			if (value > ((money16)(scenario_rand() & 0x07))) {
@@ -10956,8 +10813,8 @@ loc_69B119:
 			}
 
 			sint32 happinessGrowth = value * 4;
-			peep->happiness_growth_rate = min((peep->happiness_growth_rate + happinessGrowth), 255);
-			peep->happiness = min((peep->happiness + happinessGrowth), 255);
+			PEEP_NEED(peep, happiness_growth_rate) = min((PEEP_NEED(peep, happiness_growth_rate) + happinessGrowth), 255);
+			PEEP_NEED(peep, happiness) = min((PEEP_NEED(peep, happiness) + happinessGrowth), 255);
 		}
 	}
 
@@ -11084,11 +10941,11 @@ static bool peep_should_use_cash_machine(rct_peep *peep, sint32 rideIndex)
 	if (gParkFlags & PARK_FLAGS_NO_MONEY) return false;
 	if (peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) return false;
 	if (peep->cash_in_pocket > MONEY(20,00)) return false;
-	if (115 + (scenario_rand() % 128) > peep->happiness) return false;
-	if (peep->energy < 80) return false;
+	if (115 + (scenario_rand() % 128) > PEEP_NEED(peep, happiness)) return false;
+	if (PEEP_NEED(peep, energy) < 80) return false;
 
 	rct_ride *ride = get_ride(rideIndex);
-	ride_update_satisfaction(ride, peep->happiness >> 6);
+	ride_update_satisfaction(ride, PEEP_NEED(peep, happiness) >> 6);
 	ride->cur_num_customers++;
 	ride->total_customers++;
 	ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
@@ -11128,10 +10985,12 @@ static bool peep_has_valid_xy(rct_peep *peep)
 static void peep_give_passing_peeps_purple_clothes(rct_peep *peep)
 {
 	if (peep_has_valid_xy(peep)) {
-		rct_peep *otherPeep;
-		uint16 spriteIndex = sprite_get_first_in_quadrant(peep->x, peep->y);
-		for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = otherPeep->next_in_quadrant) {
-			otherPeep = GET_PEEP(spriteIndex);
+		sprite_query query;
+		sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+
+		rct_sprite *sprite;
+		while ((sprite = sprite_query_next(&query)) != NULL) {
+			rct_peep *otherPeep = &sprite->peep;
 			if (otherPeep->type == PEEP_TYPE_GUEST) {
 				sint32 zDiff = abs(otherPeep->z - peep->z);
 				if (zDiff <= 32) {
@@ -11147,10 +11006,12 @@ static void peep_give_passing_peeps_purple_clothes(rct_peep *peep)
 static void peep_give_passing_peeps_pizza(rct_peep *peep)
 {
 	if (peep_has_valid_xy(peep)) {
-		rct_peep *otherPeep;
-		uint16 spriteIndex = sprite_get_first_in_quadrant(peep->x, peep->y);
-		for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = otherPeep->next_in_quadrant) {
-			otherPeep = GET_PEEP(spriteIndex);
+		sprite_query query;
+		sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+
+		rct_sprite *sprite;
+		while ((sprite = sprite_query_next(&query)) != NULL) {
+			rct_peep *otherPeep = &sprite->peep;
 			if (otherPeep->type == PEEP_TYPE_GUEST) {
 				sint32 zDiff = abs(otherPeep->z - peep->z);
 				if (zDiff <= 32) {
@@ -11180,10 +11041,12 @@ static void peep_give_passing_peeps_pizza(rct_peep *peep)
 static void peep_make_passing_peeps_sick(rct_peep *peep)
 {
 	if (peep_has_valid_xy(peep)) {
-		rct_peep *otherPeep;
-		uint16 spriteIndex = sprite_get_first_in_quadrant(peep->x, peep->y);
-		for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = otherPeep->next_in_quadrant) {
-			otherPeep = GET_PEEP(spriteIndex);
+		sprite_query query;
+		sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+
+		rct_sprite *sprite;
+		while ((sprite = sprite_query_next(&query)) != NULL) {
+			rct_peep *otherPeep = &sprite->peep;
 			if (otherPeep->type == PEEP_TYPE_GUEST) {
 				sint32 zDiff = abs(otherPeep->z - peep->z);
 				if (zDiff <= 32) {
@@ -11205,10 +11068,12 @@ static void peep_make_passing_peeps_sick(rct_peep *peep)
 static void peep_give_passing_peeps_ice_cream(rct_peep *peep)
 {
 	if (peep_has_valid_xy(peep)) {
-		rct_peep *otherPeep;
-		uint16 spriteIndex = sprite_get_first_in_quadrant(peep->x, peep->y);
-		for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = otherPeep->next_in_quadrant) {
-			otherPeep = GET_PEEP(spriteIndex);
+		sprite_query query;
+		sprite_query_tile(&query, peep->x >> 5, peep->y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+
+		rct_sprite *sprite;
+		while ((sprite = sprite_query_next(&query)) != NULL) {
+			rct_peep *otherPeep = &sprite->peep;
 			if (otherPeep->type == PEEP_TYPE_GUEST) {
 				sint32 zDiff = abs(otherPeep->z - peep->z);
 				if (zDiff <= 32) {
@@ -11574,6 +11439,7 @@ static void peep_reset_ride_heading(rct_peep *peep)
 	rct_window *w;
 
 	peep->guest_heading_to_ride_id = 255;
+	gGuestGroupsGeneration++;
 	w = window_find_by_number(WC_PEEP, peep->sprite_index);
 	if (w != NULL) {
 		window_event_invalidate_call(w);
@@ -11684,11 +11550,11 @@ static bool peep_should_go_on_ride(rct_peep *peep, sint32 rideIndex, sint32 entr
 			}
 
 			// If happy enough, peeps will ignore the fact that a ride has recently crashed.
-			if (ride->last_crash_type != RIDE_CRASH_TYPE_NONE && peep->happiness < 225) {
+			if (ride->last_crash_type != RIDE_CRASH_TYPE_NONE && PEEP_NEED(peep, happiness) < 225) {
 				if (peepAtRide) {
 					peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_NOT_SAFE, rideIndex);
-					if (peep->happiness_growth_rate >= 64) {
-						peep->happiness_growth_rate -= 8;
+					if (PEEP_NEED(peep, happiness_growth_rate) >= 64) {
+						PEEP_NEED(peep, happiness_growth_rate) -= 8;
 					}
 					ride_update_popularity(ride, 0);
 				}
@@ -11712,8 +11578,8 @@ static bool peep_should_go_on_ride(rct_peep *peep, sint32 rideIndex, sint32 entr
 				if (gClimateCurrentRainLevel != 0 && (ride->undercover_portion >> 5) < 3) {
 					if (peepAtRide) {
 						peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_NOT_WHILE_RAINING, rideIndex);
-						if (peep->happiness_growth_rate >= 64) {
-							peep->happiness_growth_rate -= 8;
+						if (PEEP_NEED(peep, happiness_growth_rate) >= 64) {
+							PEEP_NEED(peep, happiness_growth_rate) -= 8;
 						}
 						ride_update_popularity(ride, 0);
 					}
@@ -11725,13 +11591,13 @@ static bool peep_should_go_on_ride(rct_peep *peep, sint32 rideIndex, sint32 entr
 					// Intensity calculations. Even though the max intensity can go up to 15, it's capped
 					// at 10.0 (before happiness calculations). A full happiness bar will increase the max
 					// intensity and decrease the min intensity by about 2.5.
-					ride_rating maxIntensity = min((peep->intensity >> 4) * 100, 1000) + peep->happiness;
-					ride_rating minIntensity = ((peep->intensity & 0x0F) * 100) - peep->happiness;
+					ride_rating maxIntensity = min((peep->intensity >> 4) * 100, 1000) + PEEP_NEED(peep, happiness);
+					ride_rating minIntensity = ((peep->intensity & 0x0F) * 100) - PEEP_NEED(peep, happiness);
 					if (ride->intensity < minIntensity) {
 						if (peepAtRide) {
 							peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_MORE_THRILLING, rideIndex);
-							if (peep->happiness_growth_rate >= 64) {
-								peep->happiness_growth_rate -= 8;
+							if (PEEP_NEED(peep, happiness_growth_rate) >= 64) {
+								PEEP_NEED(peep, happiness_growth_rate) -= 8;
 							}
 							ride_update_popularity(ride, 0);
 						}
@@ -11744,13 +11610,13 @@ static bool peep_should_go_on_ride(rct_peep *peep, sint32 rideIndex, sint32 entr
 					}
 
 					// Nausea calculations.
-					ride_rating maxNausea = NauseaMaximumThresholds[(peep->nausea_tolerance & 3)] + peep->happiness;
+					ride_rating maxNausea = NauseaMaximumThresholds[(peep->nausea_tolerance & 3)] + PEEP_NEED(peep, happiness);
 
 					if (ride->nausea > maxNausea) {
 						if (peepAtRide) {
 							peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_SICKENING, rideIndex);
-							if (peep->happiness_growth_rate >= 64) {
-								peep->happiness_growth_rate -= 8;
+							if (PEEP_NEED(peep, happiness_growth_rate) >= 64) {
+								PEEP_NEED(peep, happiness_growth_rate) -= 8;
 							}
 							ride_update_popularity(ride, 0);
 						}
@@ -11759,7 +11625,7 @@ static bool peep_should_go_on_ride(rct_peep *peep, sint32 rideIndex, sint32 entr
 					}
 
 					// Very nauseous peeps will only go on very gentle rides.
-					if (ride->nausea >= FIXED_2DP(1, 40) && peep->nausea > 160) {
+					if (ride->nausea >= FIXED_2DP(1, 40) && PEEP_NEED(peep, nausea) > 160) {
 						peep_chose_not_to_go_on_ride(peep, rideIndex, peepAtRide, false);
 						return false;
 					}
@@ -11798,8 +11664,8 @@ static bool peep_should_go_on_ride(rct_peep *peep, sint32 rideIndex, sint32 entr
 				if (ridePrice > (money16)(value * 2)) {
 					if (peepAtRide) {
 						peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_BAD_VALUE, rideIndex);
-						if (peep->happiness_growth_rate < 60) {
-							peep->happiness_growth_rate -= 16;
+						if (PEEP_NEED(peep, happiness_growth_rate) < 60) {
+							PEEP_NEED(peep, happiness_growth_rate) -= 16;
 						}
 						ride_update_popularity(ride, 0);
 					}
@@ -11841,8 +11707,8 @@ static void peep_ride_is_too_intense(rct_peep *peep, sint32 rideIndex, bool peep
 
 	if (peepAtRide) {
 		peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_INTENSE, rideIndex);
-		if (peep->happiness_growth_rate >= 64) {
-			peep->happiness_growth_rate -= 8;
+		if (PEEP_NEED(peep, happiness_growth_rate) >= 64) {
+			PEEP_NEED(peep, happiness_growth_rate) -= 8;
 		}
 		ride_update_popularity(ride, 0);
 	}
@@ -11890,18 +11756,18 @@ static bool peep_should_go_to_shop(rct_peep *peep, sint32 rideIndex, bool peepAt
 	}
 
 	if (ride->type == RIDE_TYPE_TOILETS) {
-		if (peep->bathroom < 70) {
+		if (PEEP_NEED(peep, bathroom) < 70) {
 			peep_chose_not_to_go_on_ride(peep, rideIndex, peepAtShop, true);
 			return false;
 		}
 
 		// The amount that peeps are willing to pay to use the Toilets scales with their bathroom stat.
 		// It effectively has a minimum of $0.10 (due to the check above) and a maximum of $0.60.
-		if (ride->price * 40 > peep->bathroom) {
+		if (ride->price * 40 > PEEP_NEED(peep, bathroom)) {
 			if (peepAtShop) {
 				peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_NOT_PAYING, rideIndex);
-				if (peep->happiness_growth_rate >= 60) {
-					peep->happiness_growth_rate -= 16;
+				if (PEEP_NEED(peep, happiness_growth_rate) >= 60) {
+					PEEP_NEED(peep, happiness_growth_rate) -= 16;
 				}
 				ride_update_popularity(ride, 0);
 			}
@@ -11911,7 +11777,7 @@ static bool peep_should_go_to_shop(rct_peep *peep, sint32 rideIndex, bool peepAt
 	}
 
 	if (ride->type == RIDE_TYPE_FIRST_AID) {
-		if (peep->nausea < 128) {
+		if (PEEP_NEED(peep, nausea) < 128) {
 			peep_chose_not_to_go_on_ride(peep, rideIndex, peepAtShop, true);
 			return false;
 		}
@@ -11940,6 +11806,20 @@ static bool peep_should_go_to_shop(rct_peep *peep, sint32 rideIndex, bool peepAt
 	return true;
 }
 
+/**
+ * Marks the rides that have track within 10 tiles of the given tile, the rides a guest standing there can see.
+ */
+static void peep_scan_nearby_rides(sint32 cx, sint32 cy, uint32 *rides)
+{
+	for (sint32 i = 0; i < countof(_peepRideConsideration); i++) {
+		rides[i] = 0;
+	}
+
+	sint32 tileX = cx >> 5;
+	sint32 tileY = cy >> 5;
+	tile_summary_get_rides(tileX - 10, tileY - 10, tileX + 11, tileY + 11, rides);
+}
+
 /**
  *
  *  rct2: 0x00695DD2
@@ -11971,21 +11851,7 @@ static void peep_pick_ride_to_go_on(rct_peep *peep)
 		}
 	} else {
 		// Take nearby rides into consideration
-		sint32 cx = floor2(peep->x, 32);
-		sint32 cy = floor2(peep->y, 32);
-		for (sint32 x = cx - 320; x <= cx + 320; x += 32) {
-			for (sint32 y = cy - 320; y <= cy + 320; y += 32) {
-				if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
-					rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
-					do {
-						if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
-
-						sint32 rideIndex = mapElement->properties.track.ride_index;
-						_peepRideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-					} while (!map_element_is_last_for_tile(mapElement++));
-				}
-			}
-		}
+		peep_scan_nearby_rides(floor2(peep->x, 32), floor2(peep->y, 32), _peepRideConsideration);
 
 		// Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
 		sint32 i;
@@ -12031,6 +11897,7 @@ static void peep_pick_ride_to_go_on(rct_peep *peep)
 
 	// Head to that ride
 	peep->guest_heading_to_ride_id = mostExcitingRideIndex;
+	gGuestGroupsGeneration++;
 	peep->peep_is_lost_countdown = 200;
 	peep_reset_pathfind_goal(peep);
 
@@ -12082,22 +11949,15 @@ static void peep_head_for_nearest_ride_type(rct_peep *peep, sint32 rideType)
 		}
 	} else {
 		// Take nearby rides into consideration
-		sint32 cx = floor2(peep->x, 32);
-		sint32 cy = floor2(peep->y, 32);
-		for (sint32 x = cx - 320; x <= cx + 320; x += 32) {
-			for (sint32 y = cy - 320; y <= cy + 320; y += 32) {
-				if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
-					rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
-					do {
-						if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
-
-						sint32 rideIndex = mapElement->properties.track.ride_index;
-						ride = get_ride(rideIndex);
-						if (ride->type == rideType) {
-							_peepRideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-						}
-					} while (!map_element_is_last_for_tile(mapElement++));
-				}
+		uint32 nearbyRides[countof(_peepRideConsideration)];
+		peep_scan_nearby_rides(floor2(peep->x, 32), floor2(peep->y, 32), nearbyRides);
+		for (sint32 i = 0; i < MAX_RIDES; i++) {
+			if (!(nearbyRides[i >> 5] & (1u << (i & 0x1F))))
+				continue;
+
+			ride = get_ride(i);
+			if (ride->type == rideType) {
+				_peepRideConsideration[i >> 5] |= (1u << (i & 0x1F));
 			}
 		}
 	}
@@ -12137,6 +11997,7 @@ static void peep_head_for_nearest_ride_type(rct_peep *peep, sint32 rideType)
 
 	// Head to that ride
 	peep->guest_heading_to_ride_id = closestRideIndex;
+	gGuestGroupsGeneration++;
 	peep->peep_is_lost_countdown = 200;
 	peep_reset_pathfind_goal(peep);
 
@@ -12189,22 +12050,15 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep *peep, sint32 rideTyp
 		}
 	} else {
 		// Take nearby rides into consideration
-		sint32 cx = floor2(peep->x, 32);
-		sint32 cy = floor2(peep->y, 32);
-		for (sint32 x = cx - 320; x <= cx + 320; x += 32) {
-			for (sint32 y = cy - 320; y <= cy + 320; y += 32) {
-				if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
-					rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
-					do {
-						if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
-
-						sint32 rideIndex = mapElement->properties.track.ride_index;
-						ride = get_ride(rideIndex);
-						if (ride_type_has_flag(ride->type, rideTypeFlags)) {
-							_peepRideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-						}
-					} while (!map_element_is_last_for_tile(mapElement++));
-				}
+		uint32 nearbyRides[countof(_peepRideConsideration)];
+		peep_scan_nearby_rides(floor2(peep->x, 32), floor2(peep->y, 32), nearbyRides);
+		for (sint32 i = 0; i < MAX_RIDES; i++) {
+			if (!(nearbyRides[i >> 5] & (1u << (i & 0x1F))))
+				continue;
+
+			ride = get_ride(i);
+			if (ride_type_has_flag(ride->type, rideTypeFlags)) {
+				_peepRideConsideration[i >> 5] |= (1u << (i & 0x1F));
 			}
 		}
 	}
@@ -12244,6 +12098,7 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep *peep, sint32 rideTyp
 
 	// Head to that ride
 	peep->guest_heading_to_ride_id = closestRideIndex;
+	gGuestGroupsGeneration++;
 	peep->peep_is_lost_countdown = 200;
 	peep_reset_pathfind_goal(peep);
 
@@ -12552,12 +12407,12 @@ money32 set_peep_name(sint32 flags, sint32 state, uint16 sprite_index, uint8* te
 	}
 
 	if (peep_check_easteregg_name(EASTEREGG_PEEP_NAME_MELANIE_WARN, peep)) {
-		peep->happiness = 250;
-		peep->happiness_growth_rate = 250;
-		peep->energy = 127;
-		peep->energy_growth_rate = 127;
-		peep->nausea = 0;
-		peep->nausea_growth_rate = 0;
+		PEEP_NEED(peep, happiness) = 250;
+		PEEP_NEED(peep, happiness_growth_rate) = 250;
+		PEEP_NEED(peep, energy) = 127;
+		PEEP_NEED(peep, energy_growth_rate) = 127;
+		PEEP_NEED(peep, nausea) = 0;
+		PEEP_NEED(peep, nausea_growth_rate) = 0;
 	}
 
 	peep->peep_flags &= ~PEEP_FLAGS_LITTER;
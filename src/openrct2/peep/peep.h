@@ -390,6 +390,23 @@ enum PEEP_RIDE_DECISION {
 	PEEP_RIDE_DECISION_THINKING = 1 << 2
 };
 
+// What the peep pathfinding finds at the end of a path search
+enum {
+	PATH_SEARCH_DEAD_END,
+	PATH_SEARCH_WIDE,
+	PATH_SEARCH_THIN,
+	PATH_SEARCH_JUNCTION,
+	PATH_SEARCH_RIDE_QUEUE,
+	PATH_SEARCH_RIDE_ENTRANCE,
+	PATH_SEARCH_RIDE_EXIT,
+	PATH_SEARCH_PARK_EXIT,
+	PATH_SEARCH_SHOP_ENTRANCE,
+	PATH_SEARCH_LIMIT_REACHED,
+	PATH_SEARCH_LOOP,
+	PATH_SEARCH_OTHER,
+	PATH_SEARCH_FAILED
+};
+
 #pragma pack(push, 1)
 typedef struct rct_peep_thought {
 	uint8 type;		//0
@@ -628,6 +645,9 @@ extern uint8 gGuestInitialHunger;
 extern uint8 gGuestInitialThirst;
 
 extern uint32 gNextGuestNumber;
+// Changed whenever guests may have to be grouped differently in the guest list
+extern uint32 gGuestGroupsGeneration;
+extern bool gGuestFlowFieldsNetwork;
 
 extern uint8 gPeepWarningThrottle[16];
 
@@ -685,6 +705,7 @@ money32 set_peep_name(sint32 flags, sint32 state, uint16 sprite_index, uint8* te
 void game_command_set_guest_name(sint32 *eax, sint32 *ebx, sint32 *ecx, sint32 *edx, sint32 *esi, sint32 *edi, sint32 *ebp);
 
 sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep *peep);
+sint32 peep_pathfind_get_flow_direction(sint16 x, sint16 y, uint8 z, rct_peep *peep);
 void peep_reset_pathfind_goal(rct_peep *peep);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
@@ -0,0 +1,136 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "peep_needs.h"
+
+peep_needs gPeepNeeds;
+
+/**
+ * Clears the needs of every sprite, for when all sprites are cleared.
+ */
+void peep_needs_reset_all()
+{
+	memset(&gPeepNeeds, 0, sizeof(gPeepNeeds));
+}
+
+/**
+ * Clears the needs of a sprite, for when the sprite is created and its rct_peep is cleared.
+ */
+void peep_needs_reset(uint16 spriteIndex)
+{
+	gPeepNeeds.energy[spriteIndex] = 0;
+	gPeepNeeds.energy_growth_rate[spriteIndex] = 0;
+	gPeepNeeds.happiness[spriteIndex] = 0;
+	gPeepNeeds.happiness_growth_rate[spriteIndex] = 0;
+	gPeepNeeds.nausea[spriteIndex] = 0;
+	gPeepNeeds.nausea_growth_rate[spriteIndex] = 0;
+	gPeepNeeds.hunger[spriteIndex] = 0;
+	gPeepNeeds.thirst[spriteIndex] = 0;
+	gPeepNeeds.bathroom[spriteIndex] = 0;
+	gPeepNeeds.guest_mask[spriteIndex] = 0;
+}
+
+void peep_needs_set_guest(uint16 spriteIndex, bool isGuest)
+{
+	gPeepNeeds.guest_mask[spriteIndex] = isGuest ? 0xFF : 0;
+}
+
+/**
+ * Takes the needs of every peep from its rct_peep, after the sprites have been loaded.
+ */
+void peep_needs_load_all()
+{
+	peep_needs_reset_all();
+	for (uint16 i = 0; i < MAX_SPRITES; i++) {
+		rct_sprite *sprite = get_sprite(i);
+		if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_PEEP)
+			continue;
+
+		rct_peep *peep = &sprite->peep;
+		gPeepNeeds.energy[i] = peep->energy;
+		gPeepNeeds.energy_growth_rate[i] = peep->energy_growth_rate;
+		gPeepNeeds.happiness[i] = peep->happiness;
+		gPeepNeeds.happiness_growth_rate[i] = peep->happiness_growth_rate;
+		gPeepNeeds.nausea[i] = peep->nausea;
+		gPeepNeeds.nausea_growth_rate[i] = peep->nausea_growth_rate;
+		gPeepNeeds.hunger[i] = peep->hunger;
+		gPeepNeeds.thirst[i] = peep->thirst;
+		gPeepNeeds.bathroom[i] = peep->bathroom;
+		peep_needs_set_guest(i, peep->type == PEEP_TYPE_GUEST);
+	}
+}
+
+/**
+ * Writes the needs of a peep into an rct_peep, such as the copy of the peep that is saved.
+ */
+void peep_needs_store(uint16 spriteIndex, rct_peep *dst)
+{
+	dst->energy = gPeepNeeds.energy[spriteIndex];
+	dst->energy_growth_rate = gPeepNeeds.energy_growth_rate[spriteIndex];
+	dst->happiness = gPeepNeeds.happiness[spriteIndex];
+	dst->happiness_growth_rate = gPeepNeeds.happiness_growth_rate[spriteIndex];
+	dst->nausea = gPeepNeeds.nausea[spriteIndex];
+	dst->nausea_growth_rate = gPeepNeeds.nausea_growth_rate[spriteIndex];
+	dst->hunger = gPeepNeeds.hunger[spriteIndex];
+	dst->thirst = gPeepNeeds.thirst[spriteIndex];
+	dst->bathroom = gPeepNeeds.bathroom[spriteIndex];
+}
+
+/**
+ * Moves each guest's energy towards its energy growth rate, then keeps it within 32 to 128.
+ * The subtraction wraps as it did when done on rct_peep.
+ */
+static void peep_needs_update_energy(uint8 *energy, const uint8 *target, const uint8 *mask)
+{
+	for (sint32 i = 0; i < MAX_SPRITES; i++) {
+		uint8 value = energy[i];
+		uint8 lowered = (uint8)(value - 2);
+		uint8 raised = value > 251 ? 255 : value + 4;
+		uint8 next = value >= target[i] ?
+			(lowered < target[i] ? target[i] : lowered) :
+			(raised > target[i] ? target[i] : raised);
+		next = next < 32 ? 32 : next;
+		next = next > 128 ? 128 : next;
+		energy[i] = (next & mask[i]) | (value & ~mask[i]);
+	}
+}
+
+/**
+ * Moves each guest's value four points towards its growth rate, without passing it.
+ */
+static void peep_needs_update_towards(uint8 *values, const uint8 *target, const uint8 *mask)
+{
+	for (sint32 i = 0; i < MAX_SPRITES; i++) {
+		uint8 value = values[i];
+		uint8 lowered = value < 4 ? 0 : value - 4;
+		uint8 raised = value > 251 ? 255 : value + 4;
+		uint8 next = value >= target[i] ?
+			(lowered < target[i] ? target[i] : lowered) :
+			(raised > target[i] ? target[i] : raised);
+		values[i] = (next & mask[i]) | (value & ~mask[i]);
+	}
+}
+
+/**
+ * Moves the energy, happiness and nausea of all guests towards their growth rates. Done for every
+ * guest at once over whole arrays, which the compiler can turn into vector instructions.
+ */
+void peep_needs_update_all()
+{
+	peep_needs_update_energy(gPeepNeeds.energy, gPeepNeeds.energy_growth_rate, gPeepNeeds.guest_mask);
+	peep_needs_update_towards(gPeepNeeds.happiness, gPeepNeeds.happiness_growth_rate, gPeepNeeds.guest_mask);
+	peep_needs_update_towards(gPeepNeeds.nausea, gPeepNeeds.nausea_growth_rate, gPeepNeeds.guest_mask);
+}
@@ -0,0 +1,55 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _PEEP_NEEDS_H_
+#define _PEEP_NEEDS_H_
+
+#include "../common.h"
+#include "../world/sprite.h"
+#include "peep.h"
+
+/**
+ * The needs of every peep, indexed by sprite index. They change all the time, so they are kept here
+ * in arrays of their own instead of in rct_peep, which lets them be updated for all guests at once
+ * without pulling each peep into the cache. The copies in rct_peep are only brought up to date when
+ * the sprites are saved or checksummed, and read back when sprites are loaded.
+ */
+typedef struct peep_needs {
+	uint8 energy[MAX_SPRITES];
+	uint8 energy_growth_rate[MAX_SPRITES];
+	uint8 happiness[MAX_SPRITES];
+	uint8 happiness_growth_rate[MAX_SPRITES];
+	uint8 nausea[MAX_SPRITES];
+	uint8 nausea_growth_rate[MAX_SPRITES];
+	uint8 hunger[MAX_SPRITES];
+	uint8 thirst[MAX_SPRITES];
+	uint8 bathroom[MAX_SPRITES];
+	// 0xFF for guests and 0 for anything else, masks the updates that only apply to guests
+	uint8 guest_mask[MAX_SPRITES];
+} peep_needs;
+
+extern peep_needs gPeepNeeds;
+
+#define PEEP_NEED(peep, need) (gPeepNeeds.need[(peep)->sprite_index])
+
+void peep_needs_reset_all();
+void peep_needs_reset(uint16 spriteIndex);
+void peep_needs_set_guest(uint16 spriteIndex, bool isGuest);
+void peep_needs_load_all();
+void peep_needs_store(uint16 spriteIndex, rct_peep *dst);
+void peep_needs_update_all();
+
+#endif
@@ -27,6 +27,7 @@
 #include "../world/sprite.h"
 #include "../world/footpath.h"
 #include "peep.h"
+#include "peep_needs.h"
 #include "staff.h"
 
 uint32 gStaffPatrolAreas[204 * 128];
@@ -292,8 +293,8 @@ static money32 staff_hire_new_staff_member(uint8 staff_type, uint8 flags, sint16
 		newPeep->trousers_colour = colour;
 
 		// Staff energy determines their walking speed
-		newPeep->energy = 0x60;
-		newPeep->energy_growth_rate = 0x60;
+		PEEP_NEED(newPeep, energy) = 0x60;
+		PEEP_NEED(newPeep, energy_growth_rate) = 0x60;
 		newPeep->var_E2 = 0;
 
 		peep_update_name_sort(newPeep);
@@ -677,17 +678,23 @@ void staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y)
 static uint8 staff_handyman_direction_to_nearest_litter(rct_peep* peep){
 	uint16 nearestLitterDist = (uint16)-1;
 	rct_litter* nearestLitter = NULL;
-	rct_litter* litter = NULL;
 
-	for (uint16 litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next){
-		litter = &get_sprite(litterIndex)->litter;
+	// Only litter within 0x60 is picked up, so only the tiles that close need searching
+	sprite_query query;
+	sprite_query_radius(&query, peep->x, peep->y, 0x60, SPRITE_LIST_MASK(SPRITE_LIST_LITTER));
+
+	rct_sprite* sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL){
+		rct_litter* litter = &sprite->litter;
 
 		uint16 distance =
 			abs(litter->x - peep->x) +
 			abs(litter->y - peep->y) +
 			abs(litter->z - peep->z) * 4;
 
-		if (distance < nearestLitterDist){
+		// Ties go to the lowest sprite index so the choice does not depend on the order of the tiles' lists
+		if (distance < nearestLitterDist ||
+			(distance == nearestLitterDist && litter->sprite_index < nearestLitter->sprite_index)){
 			nearestLitterDist = distance;
 			nearestLitter = litter;
 		}
@@ -1256,28 +1263,21 @@ static sint32 staff_path_finding_misc(rct_peep* peep) {
  *  rct2: 0x006C086D
  */
 static void staff_entertainer_update_nearby_peeps(rct_peep* peep) {
-	uint16 spriteIndex;
-	rct_peep* guest;
+	sprite_query query;
+	sprite_query_radius(&query, peep->x, peep->y, 96, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
 
-	FOR_ALL_GUESTS(spriteIndex, guest) {
-		if (guest->x == SPRITE_LOCATION_NULL)
+	rct_sprite* sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL) {
+		rct_peep* guest = &sprite->peep;
+		if (guest->type != PEEP_TYPE_GUEST)
 			continue;
 
 		sint16 z_dist = abs(peep->z - guest->z);
 		if (z_dist > 48)
 			continue;
 
-		sint16 x_dist = abs(peep->x - guest->x);
-		sint16 y_dist = abs(peep->y - guest->y);
-
-		if (x_dist > 96)
-			continue;
-
-		if (y_dist > 96)
-			continue;
-
 		if (peep->state == PEEP_STATE_WALKING) {
-			peep->happiness_growth_rate = min(peep->happiness_growth_rate + 4, 255);
+			PEEP_NEED(peep, happiness_growth_rate) = min(PEEP_NEED(peep, happiness_growth_rate) + 4, 255);
 		}
 		else if (peep->state == PEEP_STATE_QUEUING) {
 			if(peep->time_in_queue > 200) {
@@ -1286,7 +1286,7 @@ static void staff_entertainer_update_nearby_peeps(rct_peep* peep) {
 			else {
 				peep->time_in_queue = 0;
 			}
-			peep->happiness_growth_rate = min(peep->happiness_growth_rate + 3, 255);
+			PEEP_NEED(peep, happiness_growth_rate) = min(PEEP_NEED(peep, happiness_growth_rate) + 3, 255);
 		}
 	}
 }
@@ -773,4 +773,5 @@ uint8 platform_get_currency_value(const char *currCode) {
 void core_init()
 {
 	bitcount_init();
+	gfx_rle_sprite_init();
 }
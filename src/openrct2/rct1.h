@@ -28,6 +28,7 @@
 #include "world/sprite.h"
 
 #define RCT1_MAX_MAP_ELEMENTS   0xC000
+#define RCT1_MAX_MAP_SIZE       128
 #define RCT1_MAX_SPRITES        5000
 
 #pragma pack(push, 1)
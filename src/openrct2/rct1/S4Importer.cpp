@@ -41,16 +41,20 @@ extern "C"
     #include "../management/marketing.h"
     #include "../object.h"
     #include "../object/ObjectManager.h"
+    #include "../paint/paint.h"
     #include "../peep/peep.h"
+    #include "../peep/peep_needs.h"
     #include "../peep/staff.h"
     #include "../rct1.h"
     #include "../util/sawyercoding.h"
     #include "../util/util.h"
     #include "../world/climate.h"
     #include "../world/footpath.h"
+    #include "../world/footpath_graph.h"
     #include "../world/map_animation.h"
     #include "../world/park.h"
     #include "../world/scenery.h"
+    #include "../world/tile_summary.h"
     #include "../ride/ride_data.h"
 }
 
@@ -806,6 +810,7 @@ private:
         ImportPeeps();
         ImportLitter();
         ImportMiscSprites();
+        peep_needs_load_all();
     }
 
     void ImportPeeps()
@@ -1015,9 +1020,6 @@ private:
                 litter->sprite_identifier = srcLitter->sprite_identifier;
                 litter->type = srcLitter->type;
 
-                litter->x = srcLitter->x;
-                litter->y = srcLitter->y;
-                litter->z = srcLitter->z;
                 litter->sprite_direction = srcLitter->sprite_direction;
                 litter->sprite_width = srcLitter->sprite_width;
                 litter->sprite_height_positive = srcLitter->sprite_height_positive;
@@ -1236,7 +1238,6 @@ private:
 
     void ImportMapElements()
     {
-        memcpy(gMapElements, _s4.map_elements, RCT1_MAX_MAP_ELEMENTS * sizeof(rct_map_element));
         ClearExtraTileEntries();
         FixColours();
         FixZ();
@@ -1246,6 +1247,10 @@ private:
         FixTerrain();
         FixEntrancePositions();
         FixMapElementEntryTypes();
+        footpath_graph_invalidate();
+        tile_summary_invalidate();
+        tile_summary_invalidate_rides();
+        paint_cache_invalidate();
     }
 
     void ImportResearch()
@@ -1546,62 +1551,8 @@ private:
 
     void ClearExtraTileEntries()
     {
-        // Reset the map tile pointers
-        for (size_t i = 0; i < 0x10000; i++)
-        {
-            gMapElementTilePointers[i] = (rct_map_element *)-1;
-        }
-
-        // Get the first free map element
-        rct_map_element * nextFreeMapElement = gMapElements;
-        for (size_t i = 0; i < 128 * 128; i++)
-        {
-            do { } while (!map_element_is_last_for_tile(nextFreeMapElement++));
-        }
-
-        rct_map_element * mapElement = gMapElements;
-        rct_map_element * * tilePointer = gMapElementTilePointers;
-
-        // 128 rows of map data from RCT1 map
-        for (sint32 x = 0; x < 128; x++)
-        {
-            // Assign the first half of this row
-            for (sint32 y = 0; y < 128; y++)
-            {
-                *tilePointer++ = mapElement;
-                do { } while (!map_element_is_last_for_tile(mapElement++));
-            }
-
-            // Fill the rest of the row with blank tiles
-            for (sint32 y = 0; y < 128; y++)
-            {
-                nextFreeMapElement->type = MAP_ELEMENT_TYPE_SURFACE;
-                nextFreeMapElement->flags = MAP_ELEMENT_FLAG_LAST_TILE;
-                nextFreeMapElement->base_height = 2;
-                nextFreeMapElement->clearance_height = 0;
-                nextFreeMapElement->properties.surface.slope = 0;
-                nextFreeMapElement->properties.surface.terrain = 0;
-                nextFreeMapElement->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
-                nextFreeMapElement->properties.surface.ownership = 0;
-                *tilePointer++ = nextFreeMapElement++;
-            }
-        }
-
-        // 128 extra rows left to fill with blank tiles
-        for (sint32 y = 0; y < 128 * 256; y++)
-        {
-            nextFreeMapElement->type = MAP_ELEMENT_TYPE_SURFACE;
-            nextFreeMapElement->flags = MAP_ELEMENT_FLAG_LAST_TILE;
-            nextFreeMapElement->base_height = 2;
-            nextFreeMapElement->clearance_height = 0;
-            nextFreeMapElement->properties.surface.slope = 0;
-            nextFreeMapElement->properties.surface.terrain = 0;
-            nextFreeMapElement->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
-            nextFreeMapElement->properties.surface.ownership = 0;
-            *tilePointer++ = nextFreeMapElement++;
-        }
-
-        gNextFreeMapElement = nextFreeMapElement;
+        // The RCT1 map is stored in row order, the rest of the map is filled with blank tiles
+        map_set_elements(_s4.map_elements, RCT1_MAX_MAP_SIZE);
     }
 
     void FixColours()
@@ -1633,9 +1584,11 @@ private:
         //     }
         // }
 
-        rct_map_element * mapElement = gMapElements;
-        while (mapElement < gNextFreeMapElement)
+        map_element_iterator it;
+        map_element_iterator_begin(&it);
+        while (map_element_iterator_next(&it))
         {
+            rct_map_element * mapElement = it.element;
             if (mapElement->base_height != 255)
             {
                 switch (map_element_get_type(mapElement)) {
@@ -1676,30 +1629,32 @@ private:
                     break;
                 }
             }
-            mapElement++;
         }
     }
 
     void FixZ()
     {
-        rct_map_element * mapElement = gMapElements;
-        while (mapElement < gNextFreeMapElement)
+        map_element_iterator it;
+        map_element_iterator_begin(&it);
+        while (map_element_iterator_next(&it))
         {
+            rct_map_element * mapElement = it.element;
             if (mapElement->base_height != 255)
             {
                 mapElement->base_height /= 2;
                 mapElement->clearance_height /= 2;
             }
-            mapElement++;
         }
         gMapBaseZ = 7;
     }
 
     void FixPaths()
     {
-        rct_map_element * mapElement = gMapElements;
-        while (mapElement < gNextFreeMapElement)
+        map_element_iterator it;
+        map_element_iterator_begin(&it);
+        while (map_element_iterator_next(&it))
         {
+            rct_map_element * mapElement = it.element;
             switch (map_element_get_type(mapElement)) {
             case MAP_ELEMENT_TYPE_PATH:
             {
@@ -1748,7 +1703,6 @@ private:
                 }
                 break;
             }
-            mapElement++;
         }
     }
 
@@ -1764,7 +1718,7 @@ private:
                     if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_FENCE)
                     {
                         rct_map_element originalMapElement = *mapElement;
-                        map_element_remove(mapElement);
+                        map_element_remove(x, y, mapElement);
 
                         uint8 var_05 = originalMapElement.properties.fence.item[0];
                         uint16 var_06 = originalMapElement.properties.fence.item[1] |
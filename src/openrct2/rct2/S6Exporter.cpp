@@ -36,6 +36,7 @@ extern "C"
     #include "../management/research.h"
     #include "../object.h"
     #include "../OpenRCT2.h"
+    #include "../peep/peep_needs.h"
     #include "../peep/staff.h"
     #include "../rct2.h"
     #include "../ride/ride.h"
@@ -254,13 +255,27 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = gScenarioSrand0;
     _s6.scenario_srand_1 = gScenarioSrand1;
 
-    memcpy(_s6.map_elements, gMapElements, sizeof(_s6.map_elements));
+    if (gMapSize > RCT2_MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        throw Exception("Map is too large to save.");
+    }
+    if (map_get_num_elements(RCT2_MAXIMUM_MAP_SIZE_TECHNICAL) > MAX_MAP_ELEMENTS)
+    {
+        throw Exception("Too many map elements to save.");
+    }
+    memset(_s6.map_elements, 0, sizeof(_s6.map_elements));
+    map_copy_elements(_s6.map_elements, RCT2_MAXIMUM_MAP_SIZE_TECHNICAL);
 
     _s6.next_free_map_element_pointer_index = gNextFreeMapElementPointerIndex;
     for (sint32 i = 0; i < MAX_SPRITES; i++)
     {
         memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
+        if (_s6.sprites[i].unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+        {
+            peep_needs_store(i, &_s6.sprites[i].peep);
+        }
     }
+    sprite_spatial_index_store(nullptr, _s6.sprites);
 
     for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
     {
@@ -414,7 +429,7 @@ void S6Exporter::Export()
     _s6.ride_ratings_calc_data = gRideRatingsCalcData;
     memcpy(_s6.ride_measurements, gRideMeasurements, sizeof(_s6.ride_measurements));
     _s6.next_guest_index = gNextGuestNumber;
-    _s6.grass_and_scenery_tilepos = gGrassSceneryTileLoopPosition;
+    _s6.grass_and_scenery_tilepos = (uint16)gGrassSceneryTileLoopPosition;
     memcpy(_s6.patrol_areas, gStaffPatrolAreas, sizeof(_s6.patrol_areas));
     memcpy(_s6.staff_modes, gStaffModes, sizeof(_s6.staff_modes));
     // unk_13CA73E
@@ -480,8 +495,9 @@ sint32 scenario_save_network(SDL_RWops * rw, const std::vector<const ObjectRepos
         s6exporter->SaveGame(rw);
         result = true;
     }
-    catch (const Exception &)
+    catch (const Exception & ex)
     {
+        log_error("Unable to save the map for the network: %s", ex.GetMessage());
     }
     delete s6exporter;
 
@@ -491,7 +507,9 @@ sint32 scenario_save_network(SDL_RWops * rw, const std::vector<const ObjectRepos
     }
 
     // Write other data not in normal save files
-    SDL_RWwrite(rw, gSpriteSpatialIndex, 0x10001 * sizeof(uint16), 1);
+    static uint16 spriteSpatialIndex[SPRITE_SPATIAL_INDEX_SIZE];
+    sprite_spatial_index_store(spriteSpatialIndex, nullptr);
+    SDL_RWwrite(rw, spriteSpatialIndex, sizeof(spriteSpatialIndex), 1);
     SDL_WriteLE32(rw, gGamePaused);
     SDL_WriteLE32(rw, _guestGenerationProbability);
     SDL_WriteLE32(rw, _suggestedGuestMaximum);
@@ -514,6 +532,7 @@ sint32 scenario_save_network(SDL_RWops * rw, const std::vector<const ObjectRepos
     SDL_WriteU8(rw, gCheatsFreezeClimate);
     SDL_WriteU8(rw, gCheatsDisablePlantAging);
     SDL_WriteU8(rw, gCheatsAllowArbitraryRideTypeChanges);
+    SDL_WriteU8(rw, gGuestFlowFieldsNetwork);
 
     gfx_invalidate_screen();
     return 1;
@@ -600,7 +619,6 @@ extern "C"
             window_close_construction_windows();
         }
 
-        map_reorganise_elements();
         sprite_clear_all_unused();
 
         viewport_set_saved_view();
@@ -624,8 +642,9 @@ extern "C"
             }
             result = true;
         }
-        catch (const Exception &)
+        catch (const Exception & ex)
         {
+            log_error("Unable to save: %s", ex.GetMessage());
         }
         delete s6exporter;
 
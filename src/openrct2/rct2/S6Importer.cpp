@@ -32,6 +32,7 @@ extern "C"
     #include "../management/news_item.h"
     #include "../management/research.h"
     #include "../OpenRCT2.h"
+    #include "../peep/peep_needs.h"
     #include "../peep/staff.h"
     #include "../rct2.h"
     #include "../ride/ride.h"
@@ -170,13 +171,14 @@ void S6Importer::Import()
     gScenarioSrand0 = _s6.scenario_srand_0;
     gScenarioSrand1 = _s6.scenario_srand_1;
 
-    memcpy(gMapElements, _s6.map_elements, sizeof(_s6.map_elements));
+    map_set_elements(_s6.map_elements, RCT2_MAXIMUM_MAP_SIZE_TECHNICAL);
 
     gNextFreeMapElementPointerIndex = _s6.next_free_map_element_pointer_index;
     for (sint32 i = 0; i < MAX_SPRITES; i++)
     {
         memcpy(get_sprite(i), &_s6.sprites[i], sizeof(rct_sprite));
     }
+    peep_needs_load_all();
 
     for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
     {
@@ -364,7 +366,6 @@ void S6Importer::Import()
     {
         throw ObjectLoadException();
     }
-    map_update_tile_pointers();
     game_convert_strings_to_utf8();
     map_count_remaining_land_rights();
     if (FixIssues)
@@ -555,7 +556,9 @@ extern "C"
         SDL_RWread(rw, &checksum, sizeof(uint32), 1);
 
         // Read other data not in normal save files
-        SDL_RWread(rw, gSpriteSpatialIndex, 0x10001 * sizeof(uint16), 1);
+        static uint16 spriteSpatialIndex[SPRITE_SPATIAL_INDEX_SIZE];
+        SDL_RWread(rw, spriteSpatialIndex, sizeof(spriteSpatialIndex), 1);
+        sprite_spatial_index_load(spriteSpatialIndex);
         gGamePaused = SDL_ReadLE32(rw);
         _guestGenerationProbability = SDL_ReadLE32(rw);
         _suggestedGuestMaximum = SDL_ReadLE32(rw);
@@ -578,6 +581,7 @@ extern "C"
         gCheatsFreezeClimate = SDL_ReadU8(rw) != 0;
         gCheatsDisablePlantAging = SDL_ReadU8(rw) != 0;
         gCheatsAllowArbitraryRideTypeChanges = SDL_ReadU8(rw) != 0;
+        gGuestFlowFieldsNetwork = SDL_ReadU8(rw) != 0;
 
         gLastAutoSaveUpdate = AUTOSAVE_PAUSE;
         return 1;
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "../core/Collections.hpp"
 #include "../core/Console.hpp"
@@ -29,6 +30,7 @@
 
 extern "C"
 {
+    #include "../platform/platform.h"
     #include "../rct2.h"
     #include "track_design.h"
 }
@@ -38,10 +40,6 @@ struct TrackRepositoryHeader
 {
     uint32  MagicNumber;
     uint16  Version;
-    uint32  TotalFiles;
-    uint64  TotalFileSize;
-    uint32  FileDateModifiedChecksum;
-    uint32  PathChecksum;
     uint32  NumItems;
 };
 #pragma pack(pop)
@@ -53,10 +51,12 @@ struct TrackRepositoryItem
     uint8 RideType = 0;
     std::string ObjectEntry;
     uint32 Flags;
+    uint64 FileSize = 0;
+    uint64 FileLastModified = 0;
 };
 
 constexpr uint32 TRACK_REPOSITORY_MAGIC_NUMBER = 0x58444954;
-constexpr uint16 TRACK_REPOSITORY_VERSION = 1;
+constexpr uint16 TRACK_REPOSITORY_VERSION = 2;
 
 enum TRACK_REPO_ITEM_FLAGS
 {
@@ -71,7 +71,6 @@ private:
     IPlatformEnvironment * _env;
 
     std::vector<TrackRepositoryItem> _items;
-    QueryDirectoryResult _directoryQueryResult = { 0 };
 
 public:
     TrackDesignRepository(IPlatformEnvironment * env)
@@ -128,16 +127,19 @@ public:
         std::string rct2Directory = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::TRACK);
         std::string userDirectory = _env->GetDirectoryPath(DIRBASE::USER, DIRID::TRACK);
 
+        // Only tracks that are new or have changed since the index was saved need to be read
+        std::unordered_map<std::string, TrackRepositoryItem> indexedItems;
+        Load(&indexedItems);
+
         _items.clear();
-        _directoryQueryResult = { 0 };
-        Query(rct2Directory);
-        Query(userDirectory);
+        size_t numRead = 0;
+        numRead += Scan(&indexedItems, rct2Directory, TRIF_READ_ONLY);
+        numRead += Scan(&indexedItems, userDirectory);
+        SortItems();
 
-        if (!Load())
+        // Anything left in the index is for tracks that were removed
+        if (numRead != 0 || indexedItems.size() != 0)
         {
-            Scan(rct2Directory, TRIF_READ_ONLY);
-            Scan(userDirectory);
-            SortItems();
             Save();
         }
     }
@@ -201,38 +203,63 @@ public:
     }
 
 private:
-    void Query(const std::string &directory)
-    {
-        std::string pattern = Path::Combine(directory, TD_FILE_PATTERN);
-        Path::QueryDirectory(&_directoryQueryResult, pattern);
-    }
-
-    void Scan(const std::string &directory, uint32 flags = 0)
+    /**
+     * Adds every track in the given directory, tracks in the index with the same size and
+     * modification time are taken from the index instead of being read again.
+     * @returns The number of tracks that were read from file.
+     */
+    size_t Scan(std::unordered_map<std::string, TrackRepositoryItem> * indexedItems, const std::string &directory, uint32 flags = 0)
     {
+        size_t numRead = 0;
         std::string pattern = Path::Combine(directory, TD_FILE_PATTERN);
         IFileScanner * scanner = Path::ScanDirectory(pattern, true);
         while (scanner->Next())
         {
             const utf8 * path = scanner->GetPath();
-            AddTrack(path, flags);
+            const FileInfo * fileInfo = scanner->GetFileInfo();
+
+            auto kvp = indexedItems->find(path);
+            if (kvp != indexedItems->end())
+            {
+                TrackRepositoryItem item = kvp->second;
+                indexedItems->erase(kvp);
+                if (item.FileSize == fileInfo->Size &&
+                    item.FileLastModified == fileInfo->LastModified)
+                {
+                    item.Flags = flags;
+                    _items.push_back(item);
+                    continue;
+                }
+            }
+
+            if (AddTrack(path, flags, fileInfo->Size, fileInfo->LastModified))
+            {
+                numRead++;
+            }
         }
         delete scanner;
+        return numRead;
     }
 
-    void AddTrack(const std::string path, uint32 flags = 0)
+    bool AddTrack(const std::string path, uint32 flags = 0, uint64 fileSize = 0, uint64 fileLastModified = 0)
     {
         rct_track_td6 * td6 = track_design_open(path.c_str());
-        if (td6 != nullptr)
+        if (td6 == nullptr)
         {
-            TrackRepositoryItem item;
-            item.Name = GetNameFromTrackPath(path);
-            item.Path = path;
-            item.RideType = td6->type;
-            item.ObjectEntry = std::string(td6->vehicle_object.name, 8);
-            item.Flags = flags;
-            _items.push_back(item);
-            track_design_dispose(td6);
+            return false;
         }
+
+        TrackRepositoryItem item;
+        item.Name = GetNameFromTrackPath(path);
+        item.Path = path;
+        item.RideType = td6->type;
+        item.ObjectEntry = std::string(td6->vehicle_object.name, 8);
+        item.Flags = flags;
+        item.FileSize = fileSize;
+        item.FileLastModified = fileLastModified;
+        _items.push_back(item);
+        track_design_dispose(td6);
+        return true;
     }
 
     void SortItems()
@@ -248,24 +275,23 @@ private:
             });
     }
 
-    bool Load()
+    void Load(std::unordered_map<std::string, TrackRepositoryItem> * items) const
     {
         std::string path = _env->GetFilePath(PATHID::CACHE_TRACKS);
-        bool result = false;
+        if (!platform_file_exists(path.c_str()))
+        {
+            return;
+        }
+
         try
         {
             auto fs = FileStream(path, FILE_MODE_OPEN);
 
-            // Read header, check if we need to re-scan
+            // Read header, an index from a different version is not used
             auto header = fs.ReadValue<TrackRepositoryHeader>();
             if (header.MagicNumber == TRACK_REPOSITORY_MAGIC_NUMBER &&
-                header.Version == TRACK_REPOSITORY_VERSION &&
-                header.TotalFiles == _directoryQueryResult.TotalFiles &&
-                header.TotalFileSize == _directoryQueryResult.TotalFileSize &&
-                header.FileDateModifiedChecksum == _directoryQueryResult.FileDateModifiedChecksum &&
-                header.PathChecksum == _directoryQueryResult.PathChecksum)
+                header.Version == TRACK_REPOSITORY_VERSION)
             {
-                // Directory is the same, just read the saved items
                 for (uint32 i = 0; i < header.NumItems; i++)
                 {
                     TrackRepositoryItem item;
@@ -274,16 +300,17 @@ private:
                     item.RideType = fs.ReadValue<uint8>();
                     item.ObjectEntry = fs.ReadStdString();
                     item.Flags = fs.ReadValue<uint32>();
-                    _items.push_back(item);
+                    item.FileSize = fs.ReadValue<uint64>();
+                    item.FileLastModified = fs.ReadValue<uint64>();
+                    (*items)[item.Path] = item;
                 }
-                result = true;
             }
         }
         catch (const Exception &)
         {
-            Console::Error::WriteLine("Unable to write object repository index.");
+            Console::Error::WriteLine("Unable to read track repository index.");
+            items->clear();
         }
-        return result;
     }
 
     void Save() const
@@ -297,10 +324,6 @@ private:
             TrackRepositoryHeader header = { 0 };
             header.MagicNumber = TRACK_REPOSITORY_MAGIC_NUMBER;
             header.Version = TRACK_REPOSITORY_VERSION;
-            header.TotalFiles = _directoryQueryResult.TotalFiles;
-            header.TotalFileSize = _directoryQueryResult.TotalFileSize;
-            header.FileDateModifiedChecksum = _directoryQueryResult.FileDateModifiedChecksum;
-            header.PathChecksum = _directoryQueryResult.PathChecksum;
             header.NumItems = (uint32)_items.size();
             fs.WriteValue(header);
 
@@ -312,11 +335,13 @@ private:
                 fs.WriteValue(item.RideType);
                 fs.WriteString(item.ObjectEntry);
                 fs.WriteValue(item.Flags);
+                fs.WriteValue(item.FileSize);
+                fs.WriteValue(item.FileLastModified);
             }
         }
         catch (const Exception &)
         {
-            Console::Error::WriteLine("Unable to write object repository index.");
+            Console::Error::WriteLine("Unable to write track repository index.");
         }
     }
 
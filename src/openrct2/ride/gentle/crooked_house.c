@@ -50,6 +50,8 @@ static void sub_88ABA4(uint8 direction, uint8 x_offset, uint8 y_offset, uint32 s
 
 	rct_ride_entry *ride_type = get_ride_entry(ride->subtype);
 
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK) {
 		if (ride->vehicles[0] != (uint16)-1) {
 			rct_sprite *sprite = get_sprite(ride->vehicles[0]);
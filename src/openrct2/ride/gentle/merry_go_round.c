@@ -44,6 +44,8 @@ static void paint_merry_go_round_structure(uint8 rideIndex, uint8 direction, sin
 
 	uint32 baseImageId = ride_type->vehicles[0].base_image_id;
 
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK
 	    && ride->vehicles[0] != SPRITE_INDEX_NULL) {
 		gPaintInteractionType = VIEWPORT_INTERACTION_ITEM_SPRITE;
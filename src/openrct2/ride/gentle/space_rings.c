@@ -51,6 +51,8 @@ static void paint_space_rings_structure(rct_ride * ride, uint8 direction,  uint3
 
 		uint32 baseImageId = ride_type->vehicles[0].base_image_id;
 
+		paint_cache_disallow();
+
 		if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK
 		    && ride->vehicles[0] != SPRITE_INDEX_NULL) {
 			gPaintInteractionType = VIEWPORT_INTERACTION_ITEM_SPRITE;
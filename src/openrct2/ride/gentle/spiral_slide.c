@@ -101,6 +101,8 @@ static void spiral_slide_paint_tile_front(uint8 rideIndex, uint8 trackSequence,
 		sub_98197C(image_id, 16, 16, 8, 16, 108, height, 8, 0, height + 3, get_current_rotation());
 	}
 
+	paint_cache_disallow();
+
 	rct_drawpixelinfo *dpi = unk_140E9A8;
 	if (dpi->zoom_level == 0 && ride->slide_in_use != 0) {
 		uint8 slide_progress = ride->spiral_slide_progress;
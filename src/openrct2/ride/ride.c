@@ -31,6 +31,7 @@
 #include "../network/network.h"
 #include "../object_list.h"
 #include "../peep/peep.h"
+#include "../peep/peep_needs.h"
 #include "../peep/staff.h"
 #include "../rct1.h"
 #include "../rct2/addresses.h"
@@ -40,6 +41,7 @@
 #include "../world/banner.h"
 #include "../world/climate.h"
 #include "../world/footpath.h"
+#include "../world/footpath_graph.h"
 #include "../world/map.h"
 #include "../world/map_animation.h"
 #include "../world/scenery.h"
@@ -1173,8 +1175,8 @@ static void ride_remove_peeps(sint32 rideIndex)
 			peep->state = PEEP_STATE_FALLING;
 			sub_693BE5(peep, 0);
 
-			peep->happiness = min(peep->happiness, peep->happiness_growth_rate) / 2;
-			peep->happiness_growth_rate = peep->happiness;
+			PEEP_NEED(peep, happiness) = min(PEEP_NEED(peep, happiness), PEEP_NEED(peep, happiness_growth_rate)) / 2;
+			PEEP_NEED(peep, happiness_growth_rate) = PEEP_NEED(peep, happiness);
 			peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_STATS;
 		}
 	}
@@ -5630,6 +5632,7 @@ void game_command_set_ride_name(sint32 *eax, sint32 *ebx, sint32 *ecx, sint32 *e
 		user_string_free(ride->name);
 
 		ride->name = newUserStringId;
+		gGuestGroupsGeneration++;
 
 		gfx_invalidate_screen();
 
@@ -5680,7 +5683,7 @@ sint32 ride_get_refund_price(sint32 ride_id)
 				z,
 				0);
 			if (removePrice == MONEY32_UNDEFINED) {
-				map_element_remove(it.element);
+				map_element_remove(it.x, it.y, it.element);
 			} else {
 				refundPrice += removePrice;
 			}
@@ -6423,6 +6426,7 @@ void game_command_demolish_ride(sint32 *eax, sint32 *ebx, sint32 *ecx, sint32 *e
 					}
 				}
 			}
+			gGuestGroupsGeneration++;
 
 			user_string_free(ride->name);
 			ride->type = RIDE_TYPE_NULL;
@@ -8069,7 +8073,7 @@ void sub_6CB945(sint32 rideIndex)
 				footpath_remove_edges_at(location.x, location.y, mapElement);
 				sub_6A759F();
 				map_invalidate_tile_full(location.x, location.y);
-				map_element_remove(mapElement);
+				map_element_remove(location.x / 32, location.y / 32, mapElement);
 				mapElement--;
 			}
 		} while (!map_element_is_last_for_tile(mapElement++));
@@ -8153,7 +8157,7 @@ static money32 place_ride_entrance_or_exit(sint16 x, sint16 y, sint16 z, uint8 d
 	gCommandPosition.x = x;
 	gCommandPosition.y = y;
 
-	if (!map_check_free_elements_and_reorganise(1)) {
+	if (!map_check_free_elements(1)) {
 		return MONEY32_UNDEFINED;
 	}
 
@@ -8303,6 +8307,7 @@ static money32 place_ride_entrance_or_exit(sint16 x, sint16 y, sint16 z, uint8 d
 			if (flags & GAME_COMMAND_FLAG_GHOST) {
 				mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
 			}
+			footpath_graph_invalidate_element(x / 32, y / 32, mapElement);
 
 			if (is_exit) {
 				ride->exits[station_num] = (x / 32) | (y / 32 << 8);
@@ -8413,7 +8418,7 @@ static money32 remove_ride_entrance_or_exit(sint16 x, sint16 y, uint8 rideIndex,
 
 		uint8 is_exit = mapElement->properties.entrance.type;
 
-		map_element_remove(mapElement);
+		map_element_remove(x / 32, y / 32, mapElement);
 
 		if (is_exit){
 			ride->exits[station_num] = 0xFFFF;
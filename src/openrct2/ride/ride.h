@@ -900,6 +900,7 @@ typedef struct rct_ride_properties {
 extern const rct_ride_properties RideProperties[RIDE_TYPE_COUNT];
 
 #define MAX_RIDES 255
+#define MAX_VEHICLES_PER_RIDE 32
 
 #define MAX_RIDE_MEASUREMENTS 8
 #define RIDE_VALUE_UNDEFINED 0xFFFF
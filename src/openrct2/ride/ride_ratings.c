@@ -79,15 +79,11 @@ static void ride_ratings_calculate(rct_ride *ride);
 static void ride_ratings_calculate_value(rct_ride *ride);
 static void ride_ratings_score_close_proximity(rct_map_element *mapElement);
 
-/**
- *
- *  rct2: 0x006B5A2A
- */
-void ride_ratings_update_all()
-{
-	if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
-		return;
+// Every track piece is visited at most twice, so a walk taking longer than this is going round in circles
+#define RIDE_RATINGS_MAX_STEPS_FOR_RIDE (MAX_MAP_ELEMENTS * 2)
 
+static void ride_ratings_update_state()
+{
 	switch (gRideRatingsCalcData.state) {
 	case RIDE_RATINGS_STATE_FIND_NEXT_RIDE:
 		ride_ratings_update_state_0();
@@ -110,6 +106,56 @@ void ride_ratings_update_all()
 	}
 }
 
+/**
+ *
+ *  rct2: 0x006B5A2A
+ */
+void ride_ratings_update_all()
+{
+	if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
+		return;
+
+	ride_ratings_update_state();
+}
+
+/**
+ * Calculates the ratings of a ride straight away, walking its whole track in one go rather than a piece each tick.
+ * The ride being rated a tick at a time carries on from where it was.
+ */
+void ride_ratings_calculate_now(sint32 rideIndex)
+{
+	rct_ride *ride = get_ride(rideIndex);
+	if (ride->type == RIDE_TYPE_NULL || ride->status == RIDE_STATUS_CLOSED) {
+		return;
+	}
+
+	rct_ride_rating_calc_data savedCalcData = gRideRatingsCalcData;
+	gRideRatingsCalcData.current_ride = rideIndex;
+	gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
+	for (sint32 i = 0; i < RIDE_RATINGS_MAX_STEPS_FOR_RIDE; i++) {
+		ride_ratings_update_state();
+		if (gRideRatingsCalcData.state == RIDE_RATINGS_STATE_FIND_NEXT_RIDE) {
+			break;
+		}
+	}
+	gRideRatingsCalcData = savedCalcData;
+}
+
+/**
+ * Calculates the ratings of every open ride straight away, such as when a park has been loaded.
+ */
+void ride_ratings_calculate_all()
+{
+	if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
+		return;
+
+	sint32 i;
+	rct_ride *ride;
+	FOR_ALL_RIDES(i, ride) {
+		ride_ratings_calculate_now(i);
+	}
+}
+
 /**
  *
  *  rct2: 0x006B5A5C
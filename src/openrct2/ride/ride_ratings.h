@@ -45,5 +45,7 @@ typedef struct rct_ride_rating_calc_data {
 extern rct_ride_rating_calc_data gRideRatingsCalcData;
 
 void ride_ratings_update_all();
+void ride_ratings_calculate_now(sint32 rideIndex);
+void ride_ratings_calculate_all();
 
 #endif
@@ -30,6 +30,8 @@ static void paint_3d_cinema_structure(uint8 rideIndex, uint8 direction, sint8 xO
 	rct_ride * ride = get_ride(rideIndex);
 	rct_ride_entry * ride_type = get_ride_entry(ride->subtype);
 
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK
 	    && ride->vehicles[0] != SPRITE_INDEX_NULL) {
 		gPaintInteractionType = VIEWPORT_INTERACTION_ITEM_SPRITE;
@@ -155,6 +155,8 @@ static void paint_magic_carpet_vehicle(rct_ride *ride, uint8 direction, uint32 s
 /** rct2: 0x00899104 */
 static void paint_magic_carpet_structure(rct_ride *ride, uint8 direction, sint8 axisOffset, uint16 height)
 {
+	paint_cache_disallow();
+
 	rct_vehicle *vehicle = get_first_vehicle(ride);
 
 	uint32 swingImageId = 0;
@@ -43,6 +43,8 @@ static void paint_motionsimulator_vehicle(sint8 offsetX, sint8 offsetY, uint8 di
 	rct_map_element * savedMapElement = g_currently_drawn_item;
 
 	rct_vehicle *vehicle = NULL;
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK) {
 		uint16 spriteIndex = ride->vehicles[0];
 		if (spriteIndex != SPRITE_INDEX_NULL) {
@@ -80,6 +80,8 @@ static void paint_pirate_ship_structure(rct_ride * ride, uint8 direction, sint8
 
 	height += 7;
 
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK
 	    && ride->vehicles[0] != SPRITE_INDEX_NULL) {
 		vehicle = GET_VEHICLE(ride->vehicles[0]);
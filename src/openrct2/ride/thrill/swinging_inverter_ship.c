@@ -70,6 +70,8 @@ static void paint_swinging_inverter_ship_structure(rct_ride * ride, uint8 direct
 	sint8 xOffset = !(direction & 1) ? axisOffset : 0;
 	sint8 yOffset = (direction & 1) ? axisOffset : 0;
 
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK
 	    && ride->vehicles[0] != SPRITE_INDEX_NULL) {
 		vehicle = GET_VEHICLE(ride->vehicles[0]);
@@ -32,6 +32,8 @@ static void paint_twist_structure(rct_ride * ride, uint8 direction, sint8 xOffse
 	height += 7;
 	uint32 baseImageId = rideType->vehicles[0].base_image_id;
 
+	paint_cache_disallow();
+
 	if (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK
 	    && ride->vehicles[0] != SPRITE_INDEX_NULL) {
 		vehicle = GET_VEHICLE(ride->vehicles[0]);
@@ -30,6 +30,7 @@
 #include "../world/park.h"
 #include "../world/scenery.h"
 #include "../world/footpath.h"
+#include "../world/footpath_graph.h"
 #include "../windows/error.h"
 #include "ride.h"
 #include "ride_data.h"
@@ -1018,7 +1019,7 @@ static money32 track_place(sint32 rideIndex, sint32 type, sint32 originX, sint32
 		num_elements++;
 	}
 
-	if (!map_check_free_elements_and_reorganise(num_elements)) {
+	if (!map_check_free_elements(num_elements)) {
 		return MONEY32_UNDEFINED;
 	}
 	const uint16 *trackFlags = (rideTypeFlags & RIDE_TYPE_FLAG_FLAT_RIDE) ?
@@ -1332,6 +1333,7 @@ static money32 track_place(sint32 rideIndex, sint32 type, sint32 originX, sint32
 		if (flags & GAME_COMMAND_FLAG_GHOST){
 			mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
 		}
+		footpath_graph_invalidate_element(x / 32, y / 32, mapElement);
 
 		switch (type) {
 		case TRACK_ELEM_WATERFALL:
@@ -1629,7 +1631,7 @@ static money32 track_remove(uint8 type, uint8 sequence, sint16 originX, sint16 o
 		if (!gCheatsDisableClearanceChecks || !(mapElement->flags & MAP_ELEMENT_FLAG_GHOST)) {
 			footpath_remove_edges_at(x, y, mapElement);
 		}
-		map_element_remove(mapElement);
+		map_element_remove(x / 32, y / 32, mapElement);
 		sub_6CB945(rideIndex);
 		if (!(flags & (1 << 6))){
 			ride_update_max_vehicles(rideIndex);
@@ -1762,7 +1764,7 @@ static money32 set_maze_track(uint16 x, uint8 flags, uint8 direction, uint16 y,
 
 	money32 cost = 0;
 
-	if (!map_check_free_elements_and_reorganise(1)) {
+	if (!map_check_free_elements(1)) {
 		return MONEY32_UNDEFINED;
 	}
 
@@ -1853,6 +1855,7 @@ static money32 set_maze_track(uint16 x, uint8 flags, uint8 direction, uint16 y,
 		if (flags & GAME_COMMAND_FLAG_GHOST) {
 			mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
 		}
+		footpath_graph_invalidate_element(x / 32, y / 32, mapElement);
 
 		map_invalidate_tile_full(flooredX, flooredY);
 
@@ -1876,6 +1879,10 @@ static money32 set_maze_track(uint16 x, uint8 flags, uint8 direction, uint16 y,
 	}
 
 
+	// The tile of mapElement, fill-in mode changes the element on the tile of the previous segment
+	sint32 elementTileX = x / 32;
+	sint32 elementTileY = y / 32;
+
 	if (mode == 0) {
 		// Build mode
 		uint8 segmentOffset = maze_element_get_segment_bit(x, y);
@@ -1913,6 +1920,8 @@ static money32 set_maze_track(uint16 x, uint8 flags, uint8 direction, uint16 y,
 				log_error("No surface found");
 				return MONEY32_UNDEFINED;
 			}
+			elementTileX = previousSegmentX / 32;
+			elementTileY = previousSegmentY / 32;
 
 			uint32 segmentBit = maze_element_get_segment_bit(previousSegmentX, previousSegmentY);
 
@@ -1944,7 +1953,7 @@ static money32 set_maze_track(uint16 x, uint8 flags, uint8 direction, uint16 y,
 	map_invalidate_tile(floor2(x, 32), floor2(y, 32), mapElement->base_height * 8, mapElement->clearance_height * 8);
 
 	if ((mapElement->properties.track.maze_entry & 0x8888) == 0x8888) {
-		map_element_remove(mapElement);
+		map_element_remove(elementTileX, elementTileY, mapElement);
 		sub_6CB945(rideIndex);
 		get_ride(rideIndex)->maze_tiles--;
 	}
@@ -28,6 +28,7 @@
 #include "../util/util.h"
 #include "../windows/error.h"
 #include "../world/footpath.h"
+#include "../world/footpath_graph.h"
 #include "../world/scenery.h"
 #include "ride.h"
 #include "ride_data.h"
@@ -37,9 +38,7 @@
 #include "TrackDesignRepository.h"
 
 typedef struct map_backup {
-	rct_map_element map_elements[MAX_MAP_ELEMENTS];
-	rct_map_element *tile_pointers[256 * 256];
-	rct_map_element *next_free_map_element;
+	rct_map_element *map_elements;
 	uint16 map_size_units;
 	uint16 map_size_units_minus_2;
 	uint16 map_size;
@@ -1531,7 +1530,7 @@ static money32 place_maze_design(uint8 flags, uint8 rideIndex, uint16 mazeEntry,
 	gCommandPosition.x = x + 8;
 	gCommandPosition.y = y + 8;
 	gCommandPosition.z = z;
-	if (!map_check_free_elements_and_reorganise(1)) {
+	if (!map_check_free_elements(1)) {
 		return MONEY32_UNDEFINED;
 	}
 
@@ -1629,6 +1628,7 @@ static money32 place_maze_design(uint8 flags, uint8 rideIndex, uint16 mazeEntry,
 		if (flags & GAME_COMMAND_FLAG_GHOST) {
 			mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
 		}
+		footpath_graph_invalidate_element(fx >> 5, fy >> 5, mapElement);
 
 		map_invalidate_element(fx, fy, mapElement);
 
@@ -1778,17 +1778,12 @@ static map_backup *track_design_preview_backup_map()
 {
 	map_backup *backup = malloc(sizeof(map_backup));
 	if (backup != NULL) {
-		memcpy(
-			backup->map_elements,
-			gMapElements,
-			sizeof(backup->map_elements)
-		);
-		memcpy(
-			backup->tile_pointers,
-			gMapElementTilePointers,
-			sizeof(backup->tile_pointers)
-		);
-		backup->next_free_map_element = gNextFreeMapElement;
+		backup->map_elements = malloc(map_get_num_elements(MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(rct_map_element));
+		if (backup->map_elements == NULL) {
+			free(backup);
+			return NULL;
+		}
+		map_copy_elements(backup->map_elements, MAXIMUM_MAP_SIZE_TECHNICAL);
 		backup->map_size_units = gMapSizeUnits;
 		backup->map_size_units_minus_2 = gMapSizeMinus2;
 		backup->map_size = gMapSize;
@@ -1803,22 +1798,13 @@ static map_backup *track_design_preview_backup_map()
  */
 static void track_design_preview_restore_map(map_backup *backup)
 {
-	memcpy(
-		gMapElements,
-		backup->map_elements,
-		sizeof(backup->map_elements)
-	);
-	memcpy(
-		gMapElementTilePointers,
-		backup->tile_pointers,
-		sizeof(backup->tile_pointers)
-	);
-	gNextFreeMapElement = backup->next_free_map_element;
+	map_set_elements(backup->map_elements, MAXIMUM_MAP_SIZE_TECHNICAL);
 	gMapSizeUnits = backup->map_size_units;
 	gMapSizeMinus2 = backup->map_size_units_minus_2;
 	gMapSize = backup->map_size;
 	gCurrentRotation = backup->current_rotation;
 
+	free(backup->map_elements);
 	free(backup);
 }
 
@@ -1834,8 +1820,9 @@ static void track_design_preview_clear_map()
 	gMapSizeMinus2 = (264 * 32) - 2;
 	gMapSize = 256;
 
+	map_set_elements(NULL, 0);
 	for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
-		rct_map_element* map_element = &gMapElements[i];
+		rct_map_element* map_element = gMapElementTilePointers[i];
 		map_element->type = MAP_ELEMENT_TYPE_SURFACE;
 		map_element->flags = MAP_ELEMENT_FLAG_LAST_TILE;
 		map_element->base_height = 2;
@@ -1845,7 +1832,6 @@ static void track_design_preview_clear_map()
 		map_element->properties.surface.grass_length = 1;
 		map_element->properties.surface.ownership = OWNERSHIP_OWNED;
 	}
-	map_update_tile_pointers();
 }
 
 #pragma endregion
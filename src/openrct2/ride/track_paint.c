@@ -1602,6 +1602,8 @@ void track_paint_util_spinning_tunnel_paint(sint8 thickness, sint16 height, uint
 {
 
 	sint32 frame = gScenarioTicks >> 2 & 3;
+	paint_cache_disallow();
+
 	uint32 colourFlags = gTrackColours[SCHEME_SUPPORTS];
 
 	uint32 colourFlags2 = gTrackColours[SCHEME_TRACK];
@@ -1804,10 +1806,14 @@ void track_paint(uint8 direction, sint32 height, rct_map_element *mapElement)
 		}
 		else {
 #ifndef NO_RCT2
+			// The original code can not be recorded, so it is repainted every frame
+			paint_cache_disallow();
+
 			uint32 *trackDirectionList = (uint32 *)RideTypeTrackPaintFunctionsOld[ride->type][trackType];
 
 			if (trackDirectionList != NULL) {
 				// Have to call from this point as it pushes esi and expects callee to pop it
+				paint_session_store_rct2(gPaintSession);
 				RCT2_CALLPROC_X(
 					0x006C4934,
 					ride->type,
@@ -1818,6 +1824,7 @@ void track_paint(uint8 direction, sint32 height, rct_map_element *mapElement)
 					rideIndex * sizeof(rct_ride),
 					trackSequence
 				);
+				paint_session_load_rct2(gPaintSession);
 			}
 #endif
 		}
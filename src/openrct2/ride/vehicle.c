@@ -17,10 +17,12 @@
 #include "../audio/audio.h"
 #include "../audio/AudioMixer.h"
 #include "../config.h"
+#include "../core/parallel.h"
 #include "../editor.h"
 #include "../game.h"
 #include "../interface/viewport.h"
 #include "../localisation/localisation.h"
+#include "../network/network.h"
 #include "../OpenRCT2.h"
 #include "../rct2/hook.h"
 #include "../scenario/scenario.h"
@@ -74,23 +76,81 @@ static sint32 vehicle_update_scream_sound(rct_vehicle *vehicle);
 
 static void vehicle_kill_all_passengers(rct_vehicle* vehicle);
 static bool vehicle_can_depart_synchronised(rct_vehicle *vehicle);
+static void vehicle_report_stalled(rct_vehicle *vehicle);
+static void steam_particle_create(sint16 x, sint16 y, sint16 z);
 
 #define NO_SCREAM 254
 #define VEHICLE_INVALID_ID -1
 
-rct_vehicle *gCurrentVehicle;
+// The state of the vehicle being updated, one copy for each thread updating rides at the same time
+THREAD_LOCAL rct_vehicle *gCurrentVehicle;
+
+static THREAD_LOCAL uint8 _vehicleBreakdown;
+THREAD_LOCAL uint8 _vehicleStationIndex;
+THREAD_LOCAL uint32 _vehicleMotionTrackFlags;
+THREAD_LOCAL sint32 _vehicleVelocityF64E08;
+THREAD_LOCAL sint32 _vehicleVelocityF64E0C;
+THREAD_LOCAL sint32 _vehicleUnkF64E10;
+THREAD_LOCAL uint8 _vehicleVAngleEndF64E36;
+THREAD_LOCAL uint8 _vehicleBankEndF64E37;
+THREAD_LOCAL uint8 _vehicleF64E2C;
+THREAD_LOCAL rct_vehicle * _vehicleFrontVehicle;
+THREAD_LOCAL rct_xyz16 unk_F64E20;
 
-static uint8 _vehicleBreakdown;
-uint8 _vehicleStationIndex;
-uint32 _vehicleMotionTrackFlags;
-sint32 _vehicleVelocityF64E08;
-sint32 _vehicleVelocityF64E0C;
-sint32 _vehicleUnkF64E10;
-uint8 _vehicleVAngleEndF64E36;
-uint8 _vehicleBankEndF64E37;
-uint8 _vehicleF64E2C;
-rct_vehicle * _vehicleFrontVehicle;
-rct_xyz16 unk_F64E20;
+enum {
+	VEHICLE_EFFECT_SPRITE_MOVE,
+	VEHICLE_EFFECT_INVALIDATE_SPRITE,
+	VEHICLE_EFFECT_INVALIDATE_WINDOW,
+	VEHICLE_EFFECT_INVALIDATE_MAP_ELEMENT,
+	VEHICLE_EFFECT_PLAY_SOUND,
+	VEHICLE_EFFECT_MAP_ANIMATION,
+	VEHICLE_EFFECT_STEAM_PARTICLE,
+	VEHICLE_EFFECT_REPORT_STALLED,
+	VEHICLE_EFFECT_CRASH_SETUP,
+	VEHICLE_EFFECT_COLLISION_SETUP,
+	VEHICLE_EFFECT_UPDATE_SOUND,
+};
+
+/**
+ * Something a vehicle did while its ride was updated alongside other rides that touches state the
+ * other rides share, such as the sprite spatial index, the viewports, sounds or the random generator.
+ * These are applied afterwards one ride at a time.
+ */
+typedef struct vehicle_effect {
+	uint8 type;
+	// Sound or map animation type
+	uint8 id;
+	uint16 sprite_index;
+	sint16 x;
+	sint16 y;
+	sint16 z;
+	// Where a moved sprite was moved from
+	sint16 from_x;
+	sint16 from_y;
+	rct_map_element *map_element;
+} vehicle_effect;
+
+/**
+ * The trains of a ride and the effects they left to apply, for rides that are updated
+ * alongside other rides.
+ */
+typedef struct vehicle_ride_update {
+	bool independent;
+	uint8 num_trains;
+	uint16 trains[MAX_VEHICLES_PER_RIDE];
+	vehicle_effect *effects;
+	size_t num_effects;
+	size_t effects_capacity;
+} vehicle_ride_update;
+
+static vehicle_ride_update _vehicleRideUpdates[MAX_RIDES];
+static uint8 _vehicleIndependentRides[MAX_RIDES];
+
+// The ride whose effects are being collected on this thread, NULL when effects are applied straight away
+static THREAD_LOCAL vehicle_ride_update *_vehicleEffectsRide;
+
+// Fewer rides than this are not worth starting threads for
+#define VEHICLE_UPDATE_MIN_PARALLEL_RIDES 4
 
 const uint8 byte_9A3A14[] = { SOUND_SCREAM_8, SOUND_SCREAM_1 };
 const uint8 byte_9A3A16[] = { SOUND_SCREAM_1, SOUND_SCREAM_6 };
@@ -645,11 +705,102 @@ static const struct { sint8 x, y, z; } SteamParticleOffsets[] = {
 	{  -8,  -4, 17 }
 };
 
+static vehicle_effect *vehicle_push_effect(uint8 type, uint16 spriteIndex)
+{
+	vehicle_ride_update *rideUpdate = _vehicleEffectsRide;
+	if (rideUpdate->num_effects >= rideUpdate->effects_capacity) {
+		size_t newCapacity = max(rideUpdate->effects_capacity * 2, 64);
+		vehicle_effect *newEffects = realloc(rideUpdate->effects, newCapacity * sizeof(vehicle_effect));
+		if (newEffects == NULL) {
+			// Dropping an effect would leave the sprites and the map out of step with the vehicles
+			log_fatal("Unable to allocate memory for vehicle effects.");
+			exit(-1);
+		}
+		rideUpdate->effects = newEffects;
+		rideUpdate->effects_capacity = newCapacity;
+	}
+	vehicle_effect *effect = &rideUpdate->effects[rideUpdate->num_effects++];
+	memset(effect, 0, sizeof(vehicle_effect));
+	effect->type = type;
+	effect->sprite_index = spriteIndex;
+	return effect;
+}
+
 static void vehicle_invalidate(rct_vehicle *vehicle)
 {
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_push_effect(VEHICLE_EFFECT_INVALIDATE_SPRITE, vehicle->sprite_index);
+		return;
+	}
 	invalidate_sprite_2((rct_sprite*)vehicle);
 }
 
+/**
+ * Moves a vehicle like sprite_move. When effects are collected the vehicle gets its new position
+ * straight away but is only moved in the sprite spatial index once the effect is applied.
+ */
+static void vehicle_sprite_move(sint16 x, sint16 y, sint16 z, rct_vehicle *vehicle)
+{
+	if (_vehicleEffectsRide == NULL) {
+		sprite_move(x, y, z, (rct_sprite*)vehicle);
+		return;
+	}
+
+	vehicle_effect *effect = vehicle_push_effect(VEHICLE_EFFECT_SPRITE_MOVE, vehicle->sprite_index);
+	effect->x = x;
+	effect->y = y;
+	effect->z = z;
+	effect->from_x = vehicle->x;
+	effect->from_y = vehicle->y;
+
+	if (x < 0 || y < 0 || x > 0x1FFF || y > 0x1FFF)
+		x = SPRITE_LOCATION_NULL;
+	vehicle->x = x;
+	vehicle->y = y;
+	vehicle->z = z;
+}
+
+static void vehicle_play_sound_at_location(sint32 soundId, sint16 x, sint16 y, sint16 z)
+{
+	if (_vehicleEffectsRide == NULL) {
+		audio_play_sound_at_location(soundId, x, y, z);
+		return;
+	}
+
+	vehicle_effect *effect = vehicle_push_effect(VEHICLE_EFFECT_PLAY_SOUND, SPRITE_INDEX_NULL);
+	effect->id = soundId;
+	effect->x = x;
+	effect->y = y;
+	effect->z = z;
+}
+
+static void vehicle_create_map_animation(sint32 type, sint32 x, sint32 y, sint32 z)
+{
+	if (_vehicleEffectsRide == NULL) {
+		map_animation_create(type, x, y, z);
+		return;
+	}
+
+	vehicle_effect *effect = vehicle_push_effect(VEHICLE_EFFECT_MAP_ANIMATION, SPRITE_INDEX_NULL);
+	effect->id = type;
+	effect->x = x;
+	effect->y = y;
+	effect->z = z;
+}
+
+static void vehicle_invalidate_map_element(sint32 x, sint32 y, rct_map_element *mapElement)
+{
+	if (_vehicleEffectsRide == NULL) {
+		map_invalidate_element(x, y, mapElement);
+		return;
+	}
+
+	vehicle_effect *effect = vehicle_push_effect(VEHICLE_EFFECT_INVALIDATE_MAP_ELEMENT, SPRITE_INDEX_NULL);
+	effect->x = x;
+	effect->y = y;
+	effect->map_element = mapElement;
+}
+
 /**
  *
  *  rct2: 0x006BB9FF
@@ -1035,6 +1186,155 @@ void vehicle_sounds_update()
 	}
 }
 
+/**
+ * Whether updating the train only reads and changes its own ride, cars and track, as long as the
+ * effects it has on shared state are collected instead of applied.
+ */
+static bool vehicle_train_is_independent(rct_vehicle *vehicle)
+{
+	// The cable lift has no ride type and works together with the trains of its ride
+	if (vehicle->ride_subtype == RIDE_TYPE_NULL)
+		return false;
+
+	// Trains at stations load and unload guests and may wait for trains on other rides
+	if (vehicle->status != VEHICLE_STATUS_TRAVELLING)
+		return false;
+
+	if (vehicle->update_flags & VEHICLE_UPDATE_FLAG_TESTING)
+		return false;
+
+	rct_ride *ride = get_ride(vehicle->ride);
+	if (ride->mode == RIDE_MODE_BOAT_HIRE)
+		return false;
+
+	// Every vehicle type of the ride is checked as cars can change type on the track. Mini golf and
+	// go karts draw random numbers as they move and boats look for vehicles of other rides to bump into.
+	rct_ride_entry *rideEntry = get_ride_entry(vehicle->ride_subtype);
+	for (sint32 i = 0; i < countof(rideEntry->vehicles); i++) {
+		rct_ride_entry_vehicle *vehicleEntry = &rideEntry->vehicles[i];
+		if (vehicleEntry->flags_a & VEHICLE_ENTRY_FLAG_A_MINI_GOLF)
+			return false;
+		if (vehicleEntry->flags_b & (VEHICLE_ENTRY_FLAG_B_6 | VEHICLE_ENTRY_FLAG_B_14))
+			return false;
+	}
+	return true;
+}
+
+static void vehicle_update_independent_ride(size_t index, uint32 worker, void *arg)
+{
+	vehicle_ride_update *rideUpdate = &_vehicleRideUpdates[_vehicleIndependentRides[index]];
+
+	_vehicleEffectsRide = rideUpdate;
+	for (sint32 i = 0; i < rideUpdate->num_trains; i++) {
+		vehicle_update(GET_VEHICLE(rideUpdate->trains[i]));
+	}
+	_vehicleEffectsRide = NULL;
+}
+
+static void vehicle_apply_effects(vehicle_ride_update *rideUpdate)
+{
+	for (size_t i = 0; i < rideUpdate->num_effects; i++) {
+		vehicle_effect *effect = &rideUpdate->effects[i];
+		rct_sprite *sprite = effect->sprite_index == SPRITE_INDEX_NULL ? NULL : get_sprite(effect->sprite_index);
+
+		switch (effect->type) {
+		case VEHICLE_EFFECT_SPRITE_MOVE:
+			// Moved from where the sprite was at the time so the spatial index changes as it would have
+			sprite->unknown.x = effect->from_x;
+			sprite->unknown.y = effect->from_y;
+			sprite_move(effect->x, effect->y, effect->z, sprite);
+			break;
+		case VEHICLE_EFFECT_INVALIDATE_SPRITE:
+			invalidate_sprite_2(sprite);
+			break;
+		case VEHICLE_EFFECT_INVALIDATE_WINDOW:
+			vehicle_invalidate_window(&sprite->vehicle);
+			break;
+		case VEHICLE_EFFECT_INVALIDATE_MAP_ELEMENT:
+			map_invalidate_element(effect->x, effect->y, effect->map_element);
+			break;
+		case VEHICLE_EFFECT_PLAY_SOUND:
+			audio_play_sound_at_location(effect->id, effect->x, effect->y, effect->z);
+			break;
+		case VEHICLE_EFFECT_MAP_ANIMATION:
+			map_animation_create(effect->id, effect->x, effect->y, effect->z);
+			break;
+		case VEHICLE_EFFECT_STEAM_PARTICLE:
+			steam_particle_create(effect->x, effect->y, effect->z);
+			break;
+		case VEHICLE_EFFECT_REPORT_STALLED:
+			vehicle_report_stalled(&sprite->vehicle);
+			break;
+		case VEHICLE_EFFECT_CRASH_SETUP:
+			vehicle_update_crash_setup(&sprite->vehicle);
+			break;
+		case VEHICLE_EFFECT_COLLISION_SETUP:
+			vehicle_update_collision_setup(&sprite->vehicle);
+			break;
+		case VEHICLE_EFFECT_UPDATE_SOUND:
+			vehicle_update_sound(&sprite->vehicle);
+			break;
+		}
+	}
+	rideUpdate->num_effects = 0;
+}
+
+/**
+ * Updates the rides whose trains are all out on the track, which have nothing to do with each other,
+ * before any other train. The rides are spread across threads and whatever their trains do that other
+ * rides could see is applied afterwards one ride at a time, in ride order, so the result is the same
+ * for any number of threads. Changes to the track itself, such as closing block sections, only touch
+ * elements of the train's own ride and are still made straight away.
+ * @returns false if there were too few rides to spread over threads, nothing has been updated then.
+ */
+static bool vehicle_update_independent_rides()
+{
+	for (sint32 i = 0; i < MAX_RIDES; i++) {
+		_vehicleRideUpdates[i].independent = true;
+		_vehicleRideUpdates[i].num_trains = 0;
+	}
+
+	uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_TRAIN];
+	while (spriteIndex != SPRITE_INDEX_NULL) {
+		rct_vehicle *vehicle = GET_VEHICLE(spriteIndex);
+		spriteIndex = vehicle->next;
+		if (vehicle->ride >= MAX_RIDES)
+			continue;
+
+		vehicle_ride_update *rideUpdate = &_vehicleRideUpdates[vehicle->ride];
+		if (!rideUpdate->independent)
+			continue;
+
+		if (rideUpdate->num_trains >= MAX_VEHICLES_PER_RIDE || !vehicle_train_is_independent(vehicle)) {
+			rideUpdate->independent = false;
+			continue;
+		}
+		rideUpdate->trains[rideUpdate->num_trains++] = vehicle->sprite_index;
+	}
+
+	size_t numRides = 0;
+	for (sint32 i = 0; i < MAX_RIDES; i++) {
+		vehicle_ride_update *rideUpdate = &_vehicleRideUpdates[i];
+		if (rideUpdate->num_trains == 0) {
+			rideUpdate->independent = false;
+		}
+		if (rideUpdate->independent) {
+			_vehicleIndependentRides[numRides++] = i;
+		}
+	}
+
+	uint32 numWorkers = parallel_get_num_workers(numRides);
+	if (numRides < VEHICLE_UPDATE_MIN_PARALLEL_RIDES || numWorkers <= 1) {
+		return false;
+	}
+	parallel_for(numRides, numWorkers, vehicle_update_independent_ride, NULL);
+
+	for (size_t i = 0; i < numRides; i++) {
+		vehicle_apply_effects(&_vehicleRideUpdates[_vehicleIndependentRides[i]]);
+	}
+	return true;
+}
+
 /**
  *
  *  rct2: 0x006D4204
@@ -1050,12 +1350,22 @@ void vehicle_update_all()
 	if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gS6Info.editor_step != EDITOR_STEP_ROLLERCOASTER_DESIGNER)
 		return;
 
+	// Updating the independent rides first changes the order trains are updated in, so it is only done
+	// when the work is really spread over threads. Network games keep the original order, as the number
+	// of threads and the setting differ between players.
+	bool independentRidesUpdated =
+		gConfigGeneral.parallel_vehicle_update &&
+		network_get_mode() == NETWORK_MODE_NONE &&
+		vehicle_update_independent_rides();
 
 	sprite_index = gSpriteListHead[SPRITE_LIST_TRAIN];
 	while (sprite_index != SPRITE_INDEX_NULL) {
 		vehicle = &(get_sprite(sprite_index)->vehicle);
 		sprite_index = vehicle->next;
 
+		if (independentRidesUpdated && vehicle->ride < MAX_RIDES && _vehicleRideUpdates[vehicle->ride].independent)
+			continue;
+
 		vehicle_update(vehicle);
 	}
 }
@@ -2968,7 +3278,17 @@ static void vehicle_check_if_missing(rct_vehicle* vehicle) {
 		return;
 
 	ride->lifecycle_flags |= RIDE_LIFECYCLE_HAS_STALLED_VEHICLE;
+	vehicle_report_stalled(vehicle);
+}
+
+static void vehicle_report_stalled(rct_vehicle *vehicle)
+{
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_push_effect(VEHICLE_EFFECT_REPORT_STALLED, vehicle->sprite_index);
+		return;
+	}
 
+	rct_ride *ride = get_ride(vehicle->ride);
 	set_format_arg(0, rct_string_id, RideComponentNames[RideNameConvention[ride->type].vehicle].number);
 
 	uint8 vehicleIndex = 0;
@@ -2991,6 +3311,11 @@ static void vehicle_check_if_missing(rct_vehicle* vehicle) {
  *  rct2: 0x006DA059
  */
 static void vehicle_update_collision_setup(rct_vehicle* vehicle) {
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_push_effect(VEHICLE_EFFECT_COLLISION_SETUP, vehicle->sprite_index);
+		return;
+	}
+
 	vehicle->status = VEHICLE_STATUS_CRASHED;
 	vehicle_invalidate_window(vehicle);
 
@@ -3091,6 +3416,11 @@ static const rct_xy16 stru_9A3AC4[] = {
  *  rct2: 0x006D9EFE
  */
 static void vehicle_update_crash_setup(rct_vehicle* vehicle) {
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_push_effect(VEHICLE_EFFECT_CRASH_SETUP, vehicle->sprite_index);
+		return;
+	}
+
 	vehicle->status = VEHICLE_STATUS_CRASHING;
 	vehicle_invalidate_window(vehicle);
 
@@ -4813,6 +5143,12 @@ static void vehicle_update_sound(rct_vehicle *vehicle)
 	uint8 screamId, screamVolume = 255;
 	uint16 soundIdVolume;
 
+	// Screams draw random numbers
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_push_effect(VEHICLE_EFFECT_UPDATE_SOUND, vehicle->sprite_index);
+		return;
+	}
+
 	ride = get_ride(vehicle->ride);
 	rideEntry = get_ride_entry(vehicle->ride_subtype);
 
@@ -5762,10 +6098,12 @@ bool vehicle_update_bumper_car_collision(rct_vehicle *vehicle, sint16 x, sint16
 		location.x += Unk9A37C4[i].x;
 		location.y += Unk9A37C4[i].y;
 
-		uint16 spriteIdx = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-		while (spriteIdx != SPRITE_INDEX_NULL) {
-			rct_vehicle* vehicle2 = GET_VEHICLE(spriteIdx);
-			spriteIdx = vehicle2->next_in_quadrant;
+		sprite_query query;
+		sprite_query_tile(&query, location.x, location.y, VEHICLE_SPRITE_LIST_MASK);
+
+		rct_sprite* sprite;
+		while ((sprite = sprite_query_next(&query)) != NULL) {
+			rct_vehicle* vehicle2 = &sprite->vehicle;
 
 			if (vehicle2 == vehicle)
 				continue;
@@ -6036,13 +6374,13 @@ static void vehicle_update_block_breaks_open_previous_section(rct_vehicle *vehic
 		return;
 	}
 	mapElement->flags &= ~MAP_ELEMENT_FLAG_BLOCK_BRAKE_CLOSED;
-	map_invalidate_element(x, y, mapElement);
+	vehicle_invalidate_map_element(x, y, mapElement);
 
 	sint32 trackType = mapElement->properties.track.type;
 	if (trackType == TRACK_ELEM_BLOCK_BRAKES || trackType == TRACK_ELEM_END_STATION) {
 		rct_ride *ride = get_ride(vehicle->ride);
 		if (ride_is_block_sectioned(ride)) {
-			audio_play_sound_at_location(SOUND_48, x, y, z);
+			vehicle_play_sound_at_location(SOUND_48, x, y, z);
 		}
 	}
 }
@@ -6651,6 +6989,14 @@ static void vehicle_update_spinning_car(rct_vehicle *vehicle)
  */
 static void steam_particle_create(sint16 x, sint16 y, sint16 z)
 {
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_effect *effect = vehicle_push_effect(VEHICLE_EFFECT_STEAM_PARTICLE, SPRITE_INDEX_NULL);
+		effect->x = x;
+		effect->y = y;
+		effect->z = z;
+		return;
+	}
+
 	rct_map_element *mapElement = map_get_surface_element_at(x >> 5, y >> 5);
 	if (mapElement != NULL && z > mapElement->base_height * 8) {
 		rct_steam_particle *steam = (rct_steam_particle*)create_sprite(2);
@@ -6807,7 +7153,7 @@ static void vehicle_play_scenery_door_open_sound(rct_vehicle *vehicle, rct_map_e
 	if (doorSoundType != 0) {
 		sint32 soundId = DoorOpenSoundIds[doorSoundType - 1];
 		if (soundId != 255) {
-			audio_play_sound_at_location(soundId, vehicle->x, vehicle->track_y, vehicle->track_z);
+			vehicle_play_sound_at_location(soundId, vehicle->x, vehicle->track_y, vehicle->track_z);
 		}
 	}
 }
@@ -6823,7 +7169,7 @@ static void vehicle_play_scenery_door_close_sound(rct_vehicle *vehicle, rct_map_
 	if (doorSoundType != 0) {
 		sint32 soundId = DoorCloseSoundIds[doorSoundType - 1];
 		if (soundId != 255) {
-			audio_play_sound_at_location(soundId, vehicle->x, vehicle->track_y, vehicle->track_z);
+			vehicle_play_sound_at_location(soundId, vehicle->x, vehicle->track_y, vehicle->track_z);
 		}
 	}
 }
@@ -6853,7 +7199,7 @@ static void vehicle_update_scenery_door(rct_vehicle *vehicle)
 	if (vehicle->next_vehicle_on_train != SPRITE_INDEX_NULL) {
 		mapElement->properties.fence.item[2] &= 7;
 		mapElement->properties.fence.item[2] |= 8;
-		map_animation_create(MAP_ANIMATION_TYPE_WALL_UNKNOWN, x, y, z);
+		vehicle_create_map_animation(MAP_ANIMATION_TYPE_WALL_UNKNOWN, x, y, z);
 		vehicle_play_scenery_door_open_sound(vehicle, mapElement);
 	} else {
 		mapElement->properties.fence.item[2] &= 7;
@@ -6905,7 +7251,7 @@ static void vehicle_trigger_on_ride_photo(rct_vehicle *vehicle, rct_map_element
 {
 	mapElement->properties.track.sequence &= 0x0F;
 	mapElement->properties.track.sequence |= 0x30;
-	map_animation_create(
+	vehicle_create_map_animation(
 		MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO,
 		vehicle->track_x,
 		vehicle->track_y,
@@ -6936,7 +7282,7 @@ static void sub_6DEDE8(rct_vehicle *vehicle)
 	if (vehicle->next_vehicle_on_train != SPRITE_INDEX_NULL) {
 		mapElement->properties.fence.item[2] &= 7;
 		mapElement->properties.fence.item[2] |= 0x88;
-		map_animation_create(MAP_ANIMATION_TYPE_WALL_UNKNOWN, x, y, z);
+		vehicle_create_map_animation(MAP_ANIMATION_TYPE_WALL_UNKNOWN, x, y, z);
 		vehicle_play_scenery_door_open_sound(vehicle, mapElement);
 	} else {
 		mapElement->properties.fence.item[2] &= 7;
@@ -6951,7 +7297,7 @@ static void vehicle_update_play_water_splash_sound()
 		return;
 	}
 
-	audio_play_sound_at_location(
+	vehicle_play_sound_at_location(
 		SOUND_WATER_SPLASH,
 		unk_F64E20.x,
 		unk_F64E20.y,
@@ -7012,7 +7358,7 @@ static void sub_6DB807(rct_vehicle *vehicle)
 	sint32 x = vehicle->track_x + moveInfo->x;
 	sint32 y = vehicle->track_y + moveInfo->y;
 	sint32 z = vehicle->z;
-	sprite_move(x, y, z, (rct_sprite*)vehicle);
+	vehicle_sprite_move(x, y, z, vehicle);
 }
 
 extern const rct_xy16 duck_move_offset[4];
@@ -7074,9 +7420,13 @@ static bool vehicle_update_motion_collision_detection(
 		location.x += Unk9A37C4[i].x;
 		location.y += Unk9A37C4[i].y;
 
-		collideId = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-		for(; collideId != SPRITE_INDEX_NULL; collideId = collideVehicle->next_in_quadrant){
-			collideVehicle = GET_VEHICLE(collideId);
+		sprite_query query;
+		sprite_query_tile(&query, location.x, location.y, VEHICLE_SPRITE_LIST_MASK);
+
+		rct_sprite* sprite;
+		while ((sprite = sprite_query_next(&query)) != NULL){
+			collideVehicle = &sprite->vehicle;
+			collideId = collideVehicle->sprite_index;
 			if (collideVehicle == vehicle) continue;
 
 			if (collideVehicle->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE) continue;
@@ -7320,10 +7670,10 @@ static bool vehicle_update_track_motion_forwards_get_new_track(rct_vehicle *vehi
 			mapElement->flags |= MAP_ELEMENT_FLAG_BLOCK_BRAKE_CLOSED;
 			if (trackType == TRACK_ELEM_BLOCK_BRAKES || trackType == TRACK_ELEM_END_STATION) {
 				if (!(rideEntry->vehicles[0].flags_b & VEHICLE_ENTRY_FLAG_B_3)) {
-					audio_play_sound_at_location(SOUND_49, vehicle->track_x, vehicle->track_y, vehicle->track_z);
+					vehicle_play_sound_at_location(SOUND_49, vehicle->track_x, vehicle->track_y, vehicle->track_z);
 				}
 			}
-			map_invalidate_element(vehicle->track_x, vehicle->track_z, mapElement);
+			vehicle_invalidate_map_element(vehicle->track_x, vehicle->track_z, mapElement);
 			vehicle_update_block_breaks_open_previous_section(vehicle, mapElement);
 		}
 	}
@@ -7500,7 +7850,7 @@ loc_6DAEB9:
 			else if (!(gCurrentTicks & 0x0F)) {
 				if (_vehicleF64E2C == 0) {
 					_vehicleF64E2C++;
-					audio_play_sound_at_location(SOUND_51, vehicle->x, vehicle->y, vehicle->z);
+					vehicle_play_sound_at_location(SOUND_51, vehicle->x, vehicle->y, vehicle->z);
 				}
 			}
 		}
@@ -8665,7 +9015,7 @@ sint32 vehicle_update_track_motion(rct_vehicle *vehicle, sint32 *outStation)
 		unk_F64E20.x = car->x;
 		unk_F64E20.y = car->y;
 		unk_F64E20.z = car->z;
-		invalidate_sprite_2((rct_sprite*)car);
+		vehicle_invalidate(car);
 
 		while (true) {
 			if (car->remaining_distance < 0) {
@@ -8701,8 +9051,8 @@ sint32 vehicle_update_track_motion(rct_vehicle *vehicle, sint32 *outStation)
 			}
 		}
 		// loc_6DBF20
-		sprite_move(unk_F64E20.x, unk_F64E20.y, unk_F64E20.z, (rct_sprite*)car);
-		invalidate_sprite_2((rct_sprite*)car);
+		vehicle_sprite_move(unk_F64E20.x, unk_F64E20.y, unk_F64E20.z, car);
+		vehicle_invalidate(car);
 
 	loc_6DBF3E:
 		sub_6DBF3E(car);
@@ -8953,6 +9303,11 @@ void vehicle_invalidate_window(rct_vehicle *vehicle)
 	rct_ride *ride;
 	rct_window *w;
 
+	if (_vehicleEffectsRide != NULL) {
+		vehicle_push_effect(VEHICLE_EFFECT_INVALIDATE_WINDOW, vehicle->sprite_index);
+		return;
+	}
+
 	w = window_find_by_number(WC_RIDE, vehicle->ride);
 	if (w == NULL)
 		return;
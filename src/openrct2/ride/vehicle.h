@@ -385,17 +385,17 @@ const rct_vehicle_info *vehicle_get_move_info(sint32 cd, sint32 typeAndDirection
 uint16 vehicle_get_move_info_size(sint32 cd, sint32 typeAndDirection);
 bool vehicle_update_bumper_car_collision(rct_vehicle *vehicle, sint16 x, sint16 y, uint16 *spriteId);
 
-extern rct_vehicle *gCurrentVehicle;
-extern uint8 _vehicleStationIndex;
-extern uint32 _vehicleMotionTrackFlags;
-extern sint32 _vehicleVelocityF64E08;
-extern sint32 _vehicleVelocityF64E0C;
-extern sint32 _vehicleUnkF64E10;
-extern uint8 _vehicleVAngleEndF64E36;
-extern uint8 _vehicleBankEndF64E37;
-extern uint8 _vehicleF64E2C;
-extern rct_vehicle * _vehicleFrontVehicle;
-extern rct_xyz16 unk_F64E20;
+extern THREAD_LOCAL rct_vehicle *gCurrentVehicle;
+extern THREAD_LOCAL uint8 _vehicleStationIndex;
+extern THREAD_LOCAL uint32 _vehicleMotionTrackFlags;
+extern THREAD_LOCAL sint32 _vehicleVelocityF64E08;
+extern THREAD_LOCAL sint32 _vehicleVelocityF64E0C;
+extern THREAD_LOCAL sint32 _vehicleUnkF64E10;
+extern THREAD_LOCAL uint8 _vehicleVAngleEndF64E36;
+extern THREAD_LOCAL uint8 _vehicleBankEndF64E37;
+extern THREAD_LOCAL uint8 _vehicleF64E2C;
+extern THREAD_LOCAL rct_vehicle * _vehicleFrontVehicle;
+extern THREAD_LOCAL rct_xyz16 unk_F64E20;
 
 /** Helper macro until rides are stored in this module. */
 #define GET_VEHICLE(sprite_index) &(get_sprite(sprite_index)->vehicle)
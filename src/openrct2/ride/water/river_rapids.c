@@ -613,6 +613,7 @@ static void paint_river_rapids_track_waterfall(uint8 rideIndex, uint8 trackSeque
 	uint32 imageId;
 
 	uint16 frameNum = (gScenarioTicks / 2) & 7;
+	paint_cache_disallow();
 
 	if (direction & 1) {
 		imageId = (direction == 1 ? SPR_RIVER_RAPIDS_WATERFALL_NW_SE : SPR_RIVER_RAPIDS_WATERFALL_SE_NW) | gTrackColours[SCHEME_TRACK];
@@ -664,6 +665,7 @@ static void paint_river_rapids_track_rapids(uint8 rideIndex, uint8 trackSequence
 	uint32 imageId;
 
 	uint16 frameNum = (gScenarioTicks / 2) & 7;
+	paint_cache_disallow();
 
 	if (direction & 1) {
 		imageId = (SPR_RIVER_RAPIDS_RAPIDS_NW_SE_FRAME_0 + frameNum) | gTrackColours[SCHEME_TRACK];
@@ -705,6 +707,7 @@ static void paint_river_rapids_track_whirlpool(uint8 rideIndex, uint8 trackSeque
 	uint32 imageId;
 
 	uint8 frameNum = (gScenarioTicks / 4) % 16;
+	paint_cache_disallow();
 
 	if (direction & 1) {
 		imageId = (direction == 1 ? SPR_RIVER_RAPIDS_FLAT_NW_SE : SPR_RIVER_RAPIDS_FLAT_SE_NW) | gTrackColours[SCHEME_TRACK];
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "../core/Console.hpp"
 #include "../core/FileScanner.h"
@@ -36,6 +37,29 @@ extern "C"
     #include "scenario.h"
 }
 
+#pragma pack(push, 1)
+struct ScenarioRepositoryHeader
+{
+    uint32  MagicNumber;
+    uint16  Version;
+    uint32  NumItems;
+};
+#pragma pack(pop)
+
+/**
+ * The information read from a scenario file, kept in the index so unchanged files are not read again.
+ */
+struct ScenarioRepositoryFile
+{
+    std::string Path;
+    uint64      Size = 0;
+    uint64      LastModified = 0;
+    rct_s6_info Info;
+};
+
+constexpr uint32 SCENARIO_REPOSITORY_MAGIC_NUMBER = 0x58444953;
+constexpr uint16 SCENARIO_REPOSITORY_VERSION = 1;
+
 static sint32 ScenarioCategoryCompare(sint32 categoryA, sint32 categoryB)
 {
     if (categoryA == categoryB) return 0;
@@ -141,11 +165,23 @@ public:
     {
         _scenarios.clear();
 
+        // Only scenarios that are new or have changed since the index was saved need to be read
+        std::unordered_map<std::string, ScenarioRepositoryFile> indexedFiles;
+        LoadIndex(&indexedFiles);
+
         // Scan RCT2 directory
         std::string rct2dir = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::SCENARIO);
         std::string openrct2dir = _env->GetDirectoryPath(DIRBASE::USER, DIRID::SCENARIO);
-        Scan(rct2dir);
-        Scan(openrct2dir);
+        std::vector<ScenarioRepositoryFile> files;
+        size_t numRead = 0;
+        numRead += Scan(rct2dir, &indexedFiles, &files);
+        numRead += Scan(openrct2dir, &indexedFiles, &files);
+
+        // Anything left in the index is for scenarios that were removed
+        if (numRead != 0 || indexedFiles.size() != 0)
+        {
+            SaveIndex(files);
+        }
 
         Sort();
         LoadScores();
@@ -249,8 +285,17 @@ private:
         return (scenario_index_entry *)repo->GetByPath(path);
     }
 
-    void Scan(const std::string &directory)
+    /**
+     * Adds every scenario in the given directory, scenarios in the index with the same size and
+     * modification time are taken from the index instead of being read again.
+     * @returns The number of scenarios that were read from file.
+     */
+    size_t Scan(const std::string &directory,
+                std::unordered_map<std::string, ScenarioRepositoryFile> * indexedFiles,
+                std::vector<ScenarioRepositoryFile> * files)
     {
+        size_t numRead = 0;
+
         utf8 pattern[MAX_PATH];
         String::Set(pattern, sizeof(pattern), directory.c_str());
         Path::Append(pattern, sizeof(pattern), "*.sc6");
@@ -260,21 +305,40 @@ private:
         {
             auto path = scanner->GetPath();
             auto fileInfo = scanner->GetFileInfo();
-            AddScenario(path, fileInfo->LastModified);
+
+            ScenarioRepositoryFile file;
+            auto kvp = indexedFiles->find(path);
+            if (kvp != indexedFiles->end())
+            {
+                file = kvp->second;
+                indexedFiles->erase(kvp);
+            }
+
+            if (file.Path.empty() ||
+                file.Size != fileInfo->Size ||
+                file.LastModified != fileInfo->LastModified)
+            {
+                rct_s6_header s6Header;
+                if (!scenario_load_basic(path, &s6Header, &file.Info))
+                {
+                    Console::Error::WriteLine("Unable to read scenario: '%s'", path);
+                    continue;
+                }
+                file.Path = path;
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
+                numRead++;
+            }
+
+            files->push_back(file);
+            AddScenario(path, fileInfo->LastModified, &file.Info);
         }
         delete scanner;
+        return numRead;
     }
 
-    void AddScenario(const utf8 * path, uint64 timestamp)
+    void AddScenario(const utf8 * path, uint64 timestamp, rct_s6_info * s6Info)
     {
-        rct_s6_header s6Header;
-        rct_s6_info s6Info;
-        if (!scenario_load_basic(path, &s6Header, &s6Info))
-        {
-            Console::Error::WriteLine("Unable to read scenario: '%s'", path);
-            return;
-        }
-
         const utf8 * filename = Path::GetFileName(path);
         scenario_index_entry * existingEntry = GetByFilename(filename);
         if (existingEntry != nullptr)
@@ -286,7 +350,7 @@ private:
                 conflictPath = existingEntry->path;
 
                 // Overwrite existing entry with this one
-                *existingEntry = CreateNewScenarioEntry(path, timestamp, &s6Info);
+                *existingEntry = CreateNewScenarioEntry(path, timestamp, s6Info);
             }
             else
             {
@@ -297,7 +361,7 @@ private:
         }
         else
         {
-            scenario_index_entry entry = CreateNewScenarioEntry(path, timestamp, &s6Info);
+            scenario_index_entry entry = CreateNewScenarioEntry(path, timestamp, s6Info);
             _scenarios.push_back(entry);
         }
     }
@@ -368,6 +432,68 @@ private:
         }
     }
 
+    void LoadIndex(std::unordered_map<std::string, ScenarioRepositoryFile> * files) const
+    {
+        std::string path = _env->GetFilePath(PATHID::CACHE_SCENARIOS);
+        if (!platform_file_exists(path.c_str()))
+        {
+            return;
+        }
+
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+
+            // Read header, an index from a different version is not used
+            auto header = fs.ReadValue<ScenarioRepositoryHeader>();
+            if (header.MagicNumber == SCENARIO_REPOSITORY_MAGIC_NUMBER &&
+                header.Version == SCENARIO_REPOSITORY_VERSION)
+            {
+                for (uint32 i = 0; i < header.NumItems; i++)
+                {
+                    ScenarioRepositoryFile file;
+                    file.Path = fs.ReadStdString();
+                    file.Size = fs.ReadValue<uint64>();
+                    file.LastModified = fs.ReadValue<uint64>();
+                    file.Info = fs.ReadValue<rct_s6_info>();
+                    (*files)[file.Path] = file;
+                }
+            }
+        }
+        catch (const Exception &)
+        {
+            Console::Error::WriteLine("Unable to read scenario repository index.");
+            files->clear();
+        }
+    }
+
+    void SaveIndex(const std::vector<ScenarioRepositoryFile> &files) const
+    {
+        std::string path = _env->GetFilePath(PATHID::CACHE_SCENARIOS);
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_WRITE);
+
+            ScenarioRepositoryHeader header = { 0 };
+            header.MagicNumber = SCENARIO_REPOSITORY_MAGIC_NUMBER;
+            header.Version = SCENARIO_REPOSITORY_VERSION;
+            header.NumItems = (uint32)files.size();
+            fs.WriteValue(header);
+
+            for (const auto &file : files)
+            {
+                fs.WriteString(file.Path);
+                fs.WriteValue(file.Size);
+                fs.WriteValue(file.LastModified);
+                fs.WriteValue(file.Info);
+            }
+        }
+        catch (const Exception &)
+        {
+            Console::Error::WriteLine("Unable to write scenario repository index.");
+        }
+    }
+
     void LoadScores()
     {
         std::string path = _env->GetFilePath(PATHID::SCORES);
@@ -133,7 +133,6 @@ extern "C"
         window_new_ride_init_vars();
         window_guest_list_init_vars_b();
         window_staff_list_init_vars();
-        map_update_tile_pointers();
         reset_sprite_spatial_index();
         audio_stop_all_music_and_sounds();
         viewport_init_all();
@@ -0,0 +1,182 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../interface/themes.h"
+#include "../interface/widget.h"
+#include "../interface/window.h"
+#include "../localisation/localisation.h"
+#include "../platform/platform.h"
+#include "../Profiler.h"
+#include "../util/util.h"
+
+enum WINDOW_DEBUG_PROFILER_WIDGET_IDX
+{
+	WIDX_BACKGROUND,
+	WIDX_TOGGLE_PROFILER,
+	WIDX_EXPORT_CSV,
+};
+
+// Number of most recent frames the averages and maximums are taken over
+#define AVERAGE_FRAMES	40
+
+#define LINE_HEIGHT		10
+#define WINDOW_WIDTH	(260)
+#define WINDOW_HEIGHT	(8 + 15 + 15 + 4 + (PROFILER_SECTION_COUNT + 1) * LINE_HEIGHT + 8)
+
+static rct_widget window_debug_profiler_widgets[] = {
+	{ WWT_FRAME,			0,	0,	WINDOW_WIDTH - 1,	0,			WINDOW_HEIGHT - 1,	0xFFFFFFFF,						STR_NONE},
+	{ WWT_CHECKBOX,			1,	8,	WINDOW_WIDTH - 8,	8,			8 + 11,				STR_DEBUG_PROFILER_ENABLE,		STR_NONE},
+	{ WWT_BUTTON,			1,	8,	107,				8 + 15,		8 + 15 + 11,		STR_DEBUG_PROFILER_EXPORT_CSV,	STR_NONE},
+	{ WIDGETS_END },
+};
+
+static void window_debug_profiler_mouseup(rct_window * w, sint32 widgetIndex);
+static void window_debug_profiler_update(rct_window * w);
+static void window_debug_profiler_invalidate(rct_window * w);
+static void window_debug_profiler_paint(rct_window * w, rct_drawpixelinfo * dpi);
+
+static rct_window_event_list window_debug_profiler_events = {
+	NULL,
+	window_debug_profiler_mouseup,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	window_debug_profiler_update,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	window_debug_profiler_invalidate,
+	window_debug_profiler_paint,
+	NULL
+};
+
+void window_debug_profiler_open()
+{
+	rct_window * window;
+
+	// Check if window is already open
+	if (window_find_by_class(WC_DEBUG_PROFILER) != NULL)
+		return;
+
+	window = window_create(
+		gScreenWidth - 16 - WINDOW_WIDTH,
+		gScreenHeight - 16 - 33 - WINDOW_HEIGHT,
+		WINDOW_WIDTH,
+		WINDOW_HEIGHT,
+		&window_debug_profiler_events,
+		WC_DEBUG_PROFILER,
+		WF_STICK_TO_FRONT | WF_TRANSPARENT
+	);
+
+	window->widgets = window_debug_profiler_widgets;
+	window->enabled_widgets = (1 << WIDX_TOGGLE_PROFILER) | (1 << WIDX_EXPORT_CSV);
+	window_init_scroll_widgets(window);
+	window_push_others_below(window);
+
+	window->colours[0] = TRANSLUCENT(COLOUR_BLACK);
+	window->colours[1] = COLOUR_GREY;
+}
+
+static void window_debug_profiler_export_csv()
+{
+	utf8 path[MAX_PATH];
+	platform_get_user_directory(path, NULL, sizeof(path));
+	safe_strcat_path(path, "profiler.csv", sizeof(path));
+
+	if (profiler_write_csv(path)) {
+		log_info("Profiler samples written to '%s'", path);
+	}
+}
+
+static void window_debug_profiler_mouseup(rct_window * w, sint32 widgetIndex)
+{
+	switch (widgetIndex) {
+		case WIDX_TOGGLE_PROFILER:
+			gProfilerEnabled = !gProfilerEnabled;
+			if (gProfilerEnabled) {
+				profiler_reset();
+			}
+			window_invalidate(w);
+			break;
+
+		case WIDX_EXPORT_CSV:
+			window_debug_profiler_export_csv();
+			break;
+	}
+}
+
+static void window_debug_profiler_update(rct_window * w)
+{
+	if (gProfilerEnabled) {
+		window_invalidate(w);
+	}
+}
+
+static void window_debug_profiler_invalidate(rct_window * w)
+{
+	widget_set_checkbox_value(w, WIDX_TOGGLE_PROFILER, gProfilerEnabled);
+}
+
+static void window_debug_profiler_paint(rct_window * w, rct_drawpixelinfo * dpi)
+{
+	window_draw_widgets(w, dpi);
+
+	sint32 x = w->x + 8;
+	sint32 y = w->y + window_debug_profiler_widgets[WIDX_EXPORT_CSV].bottom + 4;
+
+	char buffer[64];
+	gfx_draw_string_left(dpi, STR_DEBUG_PROFILER_SECTION, NULL, COLOUR_WHITE, x, y);
+	gfx_draw_string_left(dpi, STR_DEBUG_PROFILER_AVERAGE_MS, NULL, COLOUR_WHITE, x + 150, y);
+	gfx_draw_string_left(dpi, STR_DEBUG_PROFILER_MAXIMUM_MS, NULL, COLOUR_WHITE, x + 200, y);
+	y += LINE_HEIGHT;
+
+	uint32 sampleCount = profiler_get_sample_count();
+	uint32 firstSample = sampleCount > AVERAGE_FRAMES ? sampleCount - AVERAGE_FRAMES : 0;
+	for (sint32 section = 0; section < PROFILER_SECTION_COUNT; section++) {
+		uint64 total = 0;
+		uint32 maximum = 0;
+		for (uint32 i = firstSample; i < sampleCount; i++) {
+			const profiler_sample * sample = profiler_get_sample(i);
+			total += sample->time[section];
+			maximum = max(maximum, sample->time[section]);
+		}
+		uint32 frames = sampleCount - firstSample;
+		double average = frames != 0 ? (total / 1000.0) / frames : 0;
+
+		gfx_draw_string(dpi, (char *)profiler_get_section_name(section), COLOUR_WHITE, x, y);
+		snprintf(buffer, sizeof(buffer), "%.3f", average);
+		gfx_draw_string(dpi, buffer, COLOUR_WHITE, x + 150, y);
+		snprintf(buffer, sizeof(buffer), "%.3f", maximum / 1000.0);
+		gfx_draw_string(dpi, buffer, COLOUR_WHITE, x + 200, y);
+		y += LINE_HEIGHT;
+	}
+}
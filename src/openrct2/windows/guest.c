@@ -20,6 +20,7 @@
 #include "../management/marketing.h"
 #include "../network/network.h"
 #include "../peep/peep.h"
+#include "../peep/peep_needs.h"
 #include "../peep/staff.h"
 #include "../ride/ride.h"
 #include "../ride/ride_data.h"
@@ -1372,7 +1373,7 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	//Happiness
 	gfx_draw_string_left(dpi, STR_GUEST_STAT_HAPPINESS_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
 
-	sint32 happiness = peep->happiness;
+	sint32 happiness = PEEP_NEED(peep, happiness);
 	if (happiness < 10)happiness = 10;
 	sint32 ebp = COLOUR_BRIGHT_GREEN;
 	if (happiness < 50){
@@ -1384,7 +1385,7 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	y += 10;
 	gfx_draw_string_left(dpi, STR_GUEST_STAT_ENERGY_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
 
-	sint32 energy = ((peep->energy - 32) * 85) / 32;
+	sint32 energy = ((PEEP_NEED(peep, energy) - 32) * 85) / 32;
 	ebp = COLOUR_BRIGHT_GREEN;
 	if (energy < 50){
 		ebp |= 0x80000000;
@@ -1396,7 +1397,7 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	y += 10;
 	gfx_draw_string_left(dpi, STR_GUEST_STAT_HUNGER_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
 
-	sint32 hunger = peep->hunger;
+	sint32 hunger = PEEP_NEED(peep, hunger);
 	if (hunger > 190) hunger = 190;
 
 	hunger -= 32;
@@ -1415,7 +1416,7 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	y += 10;
 	gfx_draw_string_left(dpi, STR_GUEST_STAT_THIRST_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
 
-	sint32 thirst = peep->thirst;
+	sint32 thirst = PEEP_NEED(peep, thirst);
 	if (thirst > 190) thirst = 190;
 
 	thirst -= 32;
@@ -1434,7 +1435,7 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	y += 10;
 	gfx_draw_string_left(dpi, STR_GUEST_STAT_NAUSEA_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
 
-	sint32 nausea = peep->nausea - 32;
+	sint32 nausea = PEEP_NEED(peep, nausea) - 32;
 
 	if (nausea  < 0) nausea = 0;
 	nausea *= 36;
@@ -1450,7 +1451,7 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	y += 10;
 	gfx_draw_string_left(dpi, STR_GUEST_STAT_TOILET_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
 
-	sint32 bathroom = peep->bathroom - 32;
+	sint32 bathroom = PEEP_NEED(peep, bathroom) - 32;
 	if (bathroom > 210) bathroom = 210;
 
 	bathroom -= 32;
@@ -153,6 +153,12 @@ static uint32 _window_guest_list_groups_argument_2[240];
 static uint8 _window_guest_list_groups_guest_faces[240 * 58];
 static uint8 _window_guest_list_group_index[240];
 
+// Open addressing table from group arguments to group index, 0xFF marks an empty slot
+#define GROUP_HASH_TABLE_SIZE 512
+static uint8 _window_guest_list_group_hash_table[GROUP_HASH_TABLE_SIZE];
+// The guest groups generation the summarised groups were found at
+static uint32 _window_guest_list_groups_generation;
+
 static sint32 window_guest_list_is_peep_in_filter(rct_peep* peep);
 static void window_guest_list_find_groups();
 
@@ -166,6 +172,7 @@ void window_guest_list_init_vars_a()
 {
 	gNextGuestNumber = 1;
 	_window_guest_list_last_find_groups_tick = 0xFFFFFFFF;
+	_window_guest_list_groups_generation = gGuestGroupsGeneration - 1;
 	_window_guest_list_selected_filter = 0xFF;
 }
 
@@ -178,6 +185,7 @@ void window_guest_list_init_vars_b()
 	_window_guest_list_selected_tab = 0;
 	_window_guest_list_selected_view = 0;
 	_window_guest_list_last_find_groups_tick = 0xFFFFFFFF;
+	_window_guest_list_groups_generation = gGuestGroupsGeneration - 1;
 	_window_guest_list_selected_filter = 0xFF;
 	_window_guest_list_last_find_groups_wait = 0;
 }
@@ -880,18 +888,38 @@ static void get_arguments_from_peep(rct_peep *peep, uint32 *argument_1, uint32*
 	}
 }
 
+/**
+ * Finds the group slot for the given arguments, or the empty slot where it should be inserted.
+ */
+static sint32 window_guest_list_find_group_slot(uint32 argument1, uint32 argument2)
+{
+	uint32 hash = (argument1 * 0x9E3779B1) ^ (argument2 * 0x85EBCA77);
+	sint32 slot = (hash >> 16) & (GROUP_HASH_TABLE_SIZE - 1);
+	for (;;) {
+		uint8 groupIndex = _window_guest_list_group_hash_table[slot];
+		if (groupIndex == 0xFF ||
+			(_window_guest_list_groups_argument_1[groupIndex] == argument1 &&
+			 _window_guest_list_groups_argument_2[groupIndex] == argument2)
+		) {
+			return slot;
+		}
+		slot = (slot + 1) & (GROUP_HASH_TABLE_SIZE - 1);
+	}
+}
+
 /**
  *
  *  rct2: 0x0069B5AE
  */
 static void window_guest_list_find_groups()
 {
-	sint32 spriteIndex, spriteIndex2, groupIndex, faceIndex;
-	rct_peep *peep, *peep2;
+	sint32 spriteIndex, groupIndex, numGroups, i, j;
+	rct_peep *peep;
 
 	uint32 tick256 = floor2(gScenarioTicks, 256);
 	if (_window_guest_list_selected_view == _window_guest_list_last_find_groups_selected_view) {
-		if (_window_guest_list_last_find_groups_wait != 0 ||
+		if (_window_guest_list_groups_generation == gGuestGroupsGeneration ||
+			_window_guest_list_last_find_groups_wait != 0 ||
 			_window_guest_list_last_find_groups_tick == tick256
 		) {
 			return;
@@ -901,100 +929,73 @@ static void window_guest_list_find_groups()
 	_window_guest_list_last_find_groups_tick = tick256;
 	_window_guest_list_last_find_groups_selected_view = _window_guest_list_selected_view;
 	_window_guest_list_last_find_groups_wait = 320;
-	_window_guest_list_num_groups = 0;
+	_window_guest_list_groups_generation = gGuestGroupsGeneration;
 
-	// Set all guests to unassigned
-	FOR_ALL_GUESTS(spriteIndex, peep)
-		if (peep->outside_of_park == 0)
-			peep->flags |= SPRITE_FLAGS_PEEP_VISIBLE;
-
-	// For each guest / group
+	// Groups are created in the order their first guest appears, guests of an existing group are
+	// looked up by their arguments so every guest is only visited once.
+	memset(_window_guest_list_group_hash_table, 0xFF, sizeof(_window_guest_list_group_hash_table));
+	numGroups = 0;
+	bool groupsFull = false;
 	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0 || !(peep->flags & SPRITE_FLAGS_PEEP_VISIBLE))
+		if (peep->outside_of_park != 0)
 			continue;
 
-		// New group, cap at 240 though
-		groupIndex = _window_guest_list_num_groups;
-		if (groupIndex >= 240)
-			break;
-
-		_window_guest_list_num_groups++;
-		_window_guest_list_groups_num_guests[groupIndex] = 1;
-		peep->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-		get_arguments_from_peep( peep, &_window_guest_list_groups_argument_1[groupIndex], &_window_guest_list_groups_argument_2[groupIndex]);
-		memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups_argument_1[groupIndex], 4);
-		memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups_argument_2[groupIndex], 4);
+		uint32 argument1, argument2;
+		get_arguments_from_peep(peep, &argument1, &argument2);
 
-		_window_guest_list_group_index[groupIndex] = groupIndex;
-		faceIndex = groupIndex * 56;
-		_window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-
-		// Find more peeps that belong to same group
-		FOR_ALL_GUESTS(spriteIndex2, peep2) {
-			if (peep2->outside_of_park != 0 || !(peep2->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-				continue;
+		// Guests without an action or thought are not listed
+		if ((argument1 & 0xFFFF) == 0)
+			continue;
 
-			uint32 argument1, argument2;
-			// Get and check if in same group
-			get_arguments_from_peep(peep2, &argument1, &argument2);
-			if (argument1 != _window_guest_list_groups_argument_1[groupIndex] || argument2 != _window_guest_list_groups_argument_2[groupIndex] )
+		sint32 slot = window_guest_list_find_group_slot(argument1, argument2);
+		groupIndex = _window_guest_list_group_hash_table[slot];
+		if (groupIndex == 0xFF) {
+			// New group, cap at 240 though
+			if (groupsFull || numGroups >= 240) {
+				groupsFull = true;
 				continue;
+			}
 
-			// Assign guest
-			_window_guest_list_groups_num_guests[groupIndex]++;
-			peep2->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-			// Add face sprite, cap at 56 though
-			if (_window_guest_list_groups_num_guests[groupIndex] >= 56)
-				continue;
-			_window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep2) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+			groupIndex = numGroups++;
+			_window_guest_list_group_hash_table[slot] = groupIndex;
+			_window_guest_list_groups_num_guests[groupIndex] = 0;
+			_window_guest_list_groups_argument_1[groupIndex] = argument1;
+			_window_guest_list_groups_argument_2[groupIndex] = argument2;
+			_window_guest_list_group_index[groupIndex] = groupIndex;
 		}
 
-		if (_window_guest_list_filter_arguments[0] == 0) {
-			_window_guest_list_num_groups--;
+		// Add face sprite, cap at 56 though
+		uint16 numGuests = _window_guest_list_groups_num_guests[groupIndex]++;
+		if (numGuests < 55)
+			_window_guest_list_groups_guest_faces[groupIndex * 56 + numGuests] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+	}
+
+	// Place the groups in size order, groups of the same size stay in the order they were found
+	for (i = 1; i < numGroups; i++) {
+		uint16 numGuests = _window_guest_list_groups_num_guests[i];
+		if (numGuests <= _window_guest_list_groups_num_guests[i - 1])
 			continue;
-		}
 
-		sint32 curr_num_guests = _window_guest_list_groups_num_guests[groupIndex];
-		sint32 swap_position = 0;
-		//This section places the groups in size order.
-		while (1) {
-			if (swap_position >= groupIndex)
-				goto nextPeep;
-			if (curr_num_guests > _window_guest_list_groups_num_guests[swap_position])
-				break;
-			swap_position++;
+		uint32 argument1 = _window_guest_list_groups_argument_1[i];
+		uint32 argument2 = _window_guest_list_groups_argument_2[i];
+		uint8 index = _window_guest_list_group_index[i];
+		uint8 faces[56];
+		memcpy(faces, &_window_guest_list_groups_guest_faces[i * 56], 56);
+
+		for (j = i; j > 0 && numGuests > _window_guest_list_groups_num_guests[j - 1]; j--) {
+			_window_guest_list_groups_num_guests[j] = _window_guest_list_groups_num_guests[j - 1];
+			_window_guest_list_groups_argument_1[j] = _window_guest_list_groups_argument_1[j - 1];
+			_window_guest_list_groups_argument_2[j] = _window_guest_list_groups_argument_2[j - 1];
+			_window_guest_list_group_index[j] = _window_guest_list_group_index[j - 1];
+			memcpy(&_window_guest_list_groups_guest_faces[j * 56], &_window_guest_list_groups_guest_faces[(j - 1) * 56], 56);
 		}
 
-		sint32 argument_1 = _window_guest_list_groups_argument_1[groupIndex];
-		sint32 argument_2 = _window_guest_list_groups_argument_2[groupIndex];
-		sint32 bl = _window_guest_list_group_index[groupIndex];
-
-		do {
-			sint32 temp = curr_num_guests;
-			curr_num_guests = _window_guest_list_groups_num_guests[swap_position];
-			_window_guest_list_groups_num_guests[swap_position] = temp;
-
-			temp = argument_1;
-			argument_1 = _window_guest_list_groups_argument_1[swap_position];
-			_window_guest_list_groups_argument_1[swap_position] = temp;
-
-			temp = argument_2;
-			argument_2 = _window_guest_list_groups_argument_2[swap_position];
-			_window_guest_list_groups_argument_2[swap_position] = temp;
-
-			uint8 temp_faces[56];
-			memcpy(temp_faces, &(_window_guest_list_groups_guest_faces[groupIndex*56]), 56);
-			memcpy(&(_window_guest_list_groups_guest_faces[groupIndex * 56]), &(_window_guest_list_groups_guest_faces[swap_position * 56]), 56);
-			memcpy(&(_window_guest_list_groups_guest_faces[swap_position * 56]), temp_faces, 56);
-
-			temp = _window_guest_list_group_index[swap_position];
-			_window_guest_list_group_index[swap_position] = bl;
-			bl = temp;
-		} while (++swap_position <= groupIndex);
-
-	nextPeep:
-		;
+		_window_guest_list_groups_num_guests[j] = numGuests;
+		_window_guest_list_groups_argument_1[j] = argument1;
+		_window_guest_list_groups_argument_2[j] = argument2;
+		_window_guest_list_group_index[j] = index;
+		memcpy(&_window_guest_list_groups_guest_faces[j * 56], faces, 56);
 	}
+
+	_window_guest_list_num_groups = numGroups;
 }
@@ -389,10 +389,6 @@ static uint32 window_mapgen_page_hold_down_widgets[] = {
 
 const sint32 window_mapgen_tab_animation_loops[] = { 16, 16, 16 };
 
-#define MINIMUM_MAP_SIZE_TECHNICAL 15
-#define MAXIMUM_MAP_SIZE_TECHNICAL 256
-#define MINIMUM_MAP_SIZE_PRACTICAL MINIMUM_MAP_SIZE_TECHNICAL-2
-#define MAXIMUM_MAP_SIZE_PRACTICAL MAXIMUM_MAP_SIZE_TECHNICAL-2
 #define BASESIZE_MIN 0
 #define BASESIZE_MAX 60
 #define WATERLEVEL_MIN 0
@@ -2312,7 +2312,8 @@ static void sub_6CBCE2(
 	gCurrentViewportFlags = 0;
 	trackDirection &= 3;
 
-	paint_init(unk_140E9A8);
+	paint_session * session = paint_session_get(0);
+	paint_init(session, unk_140E9A8);
 
 	ride = get_ride(rideIndex);
 
@@ -2415,8 +2416,8 @@ static void sub_6CBCE2(
 	gMapSize = preserveMapSize;
 	gMapSizeMaxXY = preserveMapSizeMaxXY;
 
-	paint_struct ps = paint_arrange_structs();
-	paint_draw_structs(unk_140E9A8, &ps, gCurrentViewportFlags);
+	paint_struct ps = paint_arrange_structs(session);
+	paint_draw_structs(session, &ps, gCurrentViewportFlags);
 
 	gCurrentViewportFlags = preserve_current_viewport_flags;
 }
@@ -26,8 +26,10 @@
 #include "../ride/track.h"
 #include "../sprites.h"
 #include "../world/footpath.h"
+#include "../world/footpath_graph.h"
 #include "../world/map.h"
 #include "../world/scenery.h"
+#include "../world/tile_summary.h"
 
 static const rct_string_id terrainTypeStringIds[] = {
 	STR_TILE_INSPECTOR_TERRAIN_GRASS,
@@ -478,6 +480,7 @@ static void window_tile_inspector_surface_toggle_corner(rct_map_element *mapElem
 static void window_tile_inspector_track_block_height_offset(rct_map_element *mapElement, uint8 offset);
 static void window_tile_inspector_track_block_set_lift(rct_map_element *mapElement, bool chain);
 static void window_tile_inspector_quarter_tile_set(rct_map_element *const mapElement, const sint32 index);
+static void window_tile_inspector_invalidate_tile();
 
 static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex);
 static void window_tile_inspector_resize(rct_window *w);
@@ -619,6 +622,18 @@ static void window_tile_inspector_load_tile(rct_window* w)
 	window_invalidate(w);
 }
 
+/**
+ * Marks the inspected tile for redrawing, along with what has been worked out from its elements.
+ * Must be called after editing the tile.
+ */
+static void window_tile_inspector_invalidate_tile()
+{
+	tile_summary_invalidate_at(windowTileInspectorTileX, windowTileInspectorTileY);
+	tile_summary_invalidate_rides_at(windowTileInspectorTileX, windowTileInspectorTileY);
+	footpath_graph_invalidate_tile(windowTileInspectorTileX, windowTileInspectorTileY);
+	map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+}
+
 static void window_tile_inspector_insert_corrupt_element(rct_window *w)
 {
 	// Create new corrupt element
@@ -637,16 +652,16 @@ static void window_tile_inspector_insert_corrupt_element(rct_window *w)
 		window_tile_inspector_swap_elements(i, i + 1);
 	}
 
-	map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+	window_tile_inspector_invalidate_tile();
 }
 
 static void window_tile_inspector_remove_element(sint32 index)
 {
 	assert(index < windowTileInspectorElementCount);
 	rct_map_element *const mapElement = map_get_first_element_at(windowTileInspectorTileX, windowTileInspectorTileY) + index;
-	map_element_remove(mapElement);
+	map_element_remove(windowTileInspectorTileX, windowTileInspectorTileY, mapElement);
 	windowTileInspectorElementCount--;
-	map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+	window_tile_inspector_invalidate_tile();
 }
 
 static void window_tile_inspector_rotate_element(sint32 index)
@@ -684,7 +699,7 @@ static void window_tile_inspector_rotate_element(sint32 index)
 		break;
 	}
 
-	map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+	window_tile_inspector_invalidate_tile();
 }
 
 // Swap element with its parent
@@ -714,7 +729,7 @@ static void window_tile_inspector_swap_elements(sint16 first, sint16 second)
 		firstElement->flags ^= MAP_ELEMENT_FLAG_LAST_TILE;
 		secondElement->flags ^= MAP_ELEMENT_FLAG_LAST_TILE;
 	}
-	map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+	window_tile_inspector_invalidate_tile();
 }
 
 static void window_tile_inspector_sort_elements(rct_window *w)
@@ -860,6 +875,7 @@ static void window_tile_inspector_track_block_height_offset(rct_map_element *map
 
 		z += trackBlock->z;
 
+		footpath_graph_invalidate_tile(x >> 5, y >> 5);
 		map_invalidate_tile_full(x, y);
 
 		bool found = false;
@@ -961,6 +977,7 @@ static void window_tile_inspector_track_block_set_lift(rct_map_element *mapEleme
 
 		z += trackBlock->z;
 
+		footpath_graph_invalidate_tile(x >> 5, y >> 5);
 		map_invalidate_tile_full(x, y);
 
 		bool found = false;
@@ -1017,7 +1034,7 @@ static void window_tile_inspector_quarter_tile_set(rct_map_element *const mapEle
 	mapElement->flags &= 0xF0;
 	mapElement->flags |= 1 << ((index + 6 - get_current_rotation()) & 3);
 
-	map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+	window_tile_inspector_invalidate_tile();
 }
 
 static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
@@ -1079,7 +1096,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		break;
 	case WIDX_BUTTON_PASTE:
 		window_tile_inspector_paste_element(w);
-		map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+		window_tile_inspector_invalidate_tile();
 		widget_invalidate(w, WIDX_LIST);
 		break;
 	case WIDX_BUTTON_MOVE_DOWN:
@@ -1111,29 +1128,29 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_SURFACE_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_PATH_SPINNER_HEIGHT);
 			break;
 		case WIDX_SURFACE_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_PATH_SPINNER_HEIGHT);
 			break;
 		case WIDX_SURFACE_BUTTON_REMOVE_FENCES:
 			mapElement->properties.surface.ownership &= ~0x0F;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			break;
 		case WIDX_SURFACE_BUTTON_RESTORE_FENCES:
 			update_park_fences(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			break;
 		case WIDX_SURFACE_CHECK_CORNER_N:
 		case WIDX_SURFACE_CHECK_CORNER_E:
 		case WIDX_SURFACE_CHECK_CORNER_S:
 		case WIDX_SURFACE_CHECK_CORNER_W:
 			window_tile_inspector_surface_toggle_corner(mapElement, ((widgetIndex - WIDX_SURFACE_CHECK_CORNER_N) + 2 - get_current_rotation()) & 3);
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			window_invalidate(w);
 			break;
 		case WIDX_SURFACE_CHECK_DIAGONAL:
@@ -1148,7 +1165,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 				mapElement->clearance_height = mapElement->base_height;
 			}
 
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, widgetIndex);
 			break;
 		} // switch widgetindex
@@ -1159,13 +1176,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_PATH_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_PATH_SPINNER_HEIGHT);
 			break;
 		case WIDX_PATH_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_PATH_SPINNER_HEIGHT);
 			break;
 		case WIDX_PATH_CHECK_EDGE_E:
@@ -1174,7 +1191,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_PATH_CHECK_EDGE_N:
 			widget_set_checkbox_value(w, widgetIndex, !widget_is_pressed(w, widgetIndex));
 			mapElement->properties.path.edges ^= (1 << (4 + (((widgetIndex - WIDX_PATH_CHECK_EDGE_E) / 2 - get_current_rotation()) & 3))) & 0xF0;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			break;
 		case WIDX_PATH_CHECK_EDGE_NE:
 		case WIDX_PATH_CHECK_EDGE_SE:
@@ -1182,7 +1199,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_PATH_CHECK_EDGE_NW:
 			widget_set_checkbox_value(w, widgetIndex, !widget_is_pressed(w, widgetIndex));
 			mapElement->properties.path.edges ^= (1 << (((widgetIndex - WIDX_PATH_CHECK_EDGE_NE) / 2 - get_current_rotation()) & 3)) & 0x0F;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			break;
 		} // switch widget index
 		break;
@@ -1200,7 +1217,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 			else {
 				mapElement->base_height++;
 				mapElement->clearance_height++;
-				map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+				window_tile_inspector_invalidate_tile();
 			}
 			widget_invalidate(w, WIDX_TRACK_SPINNER_HEIGHT);
 			break;
@@ -1211,7 +1228,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 			else {
 				mapElement->base_height--;
 				mapElement->clearance_height--;
-				map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+				window_tile_inspector_invalidate_tile();
 			}
 			widget_invalidate(w, WIDX_TRACK_SPINNER_HEIGHT);
 			break;
@@ -1222,7 +1239,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 			}
 			else {
 				mapElement->type ^= TRACK_ELEMENT_FLAG_CHAIN_LIFT;
-				map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+				window_tile_inspector_invalidate_tile();
 			}
 			widget_invalidate(w, widgetIndex);
 			break;
@@ -1234,13 +1251,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_SCENERY_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_SCENERY_SPINNER_HEIGHT);
 			break;
 		case WIDX_SCENERY_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_SCENERY_SPINNER_HEIGHT);
 			break;
 		case WIDX_SCENERY_CHECK_QUARTER_N:
@@ -1265,13 +1282,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_ENTRANCE_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_ENTRANCE_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		} // switch widget index
@@ -1282,13 +1299,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_FENCE_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_FENCE_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		} // switch widget index
@@ -1299,13 +1316,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_LARGE_SCENERY_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_LARGE_SCENERY_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		} // switch widget index
@@ -1316,13 +1333,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_BANNER_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_BANNER_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_BANNER_CHECK_BLOCK_NE:
@@ -1330,7 +1347,7 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_BANNER_CHECK_BLOCK_SW:
 		case WIDX_BANNER_CHECK_BLOCK_NW:
 			mapElement->properties.banner.flags ^= 1 << ((widgetIndex - WIDX_BANNER_CHECK_BLOCK_NE - get_current_rotation()) & 3);
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, widgetIndex);
 			break;
 		} // switch widget index
@@ -1341,13 +1358,13 @@ static void window_tile_inspector_mouseup(rct_window *w, sint32 widgetIndex)
 		case WIDX_CORRUPT_SPINNER_HEIGHT_INCREASE:
 			mapElement->base_height++;
 			mapElement->clearance_height++;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_CORRUPT_SPINNER_HEIGHT_DECREASE:
 			mapElement->base_height--;
 			mapElement->clearance_height--;
-			map_invalidate_tile_full(windowTileInspectorTileX << 5, windowTileInspectorTileY << 5);
+			window_tile_inspector_invalidate_tile();
 			widget_invalidate(w, WIDX_FENCE_SPINNER_HEIGHT);
 			break;
 		case WIDX_CORRUPT_BUTTON_CLAMP:
@@ -1444,6 +1461,7 @@ static void window_tile_inspector_dropdown(rct_window *w, sint32 widgetIndex, si
 		case WIDX_FENCE_DROPDOWN_SLOPE_BUTTON:
 			mapElement->type &= ~0xC0;
 			mapElement->type |= dropdownIndex << 6;
+			window_tile_inspector_invalidate_tile();
 			break;
 		}
 		break;
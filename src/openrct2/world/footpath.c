@@ -23,6 +23,8 @@
 #include "../ride/track.h"
 #include "../ride/track_data.h"
 #include "../util/util.h"
+#include "footpath_graph.h"
+#include "tile_summary.h"
 
 void footpath_interrupt_peeps(sint32 x, sint32 y, sint32 z);
 void sub_6A7642(sint32 x, sint32 y, rct_map_element *mapElement);
@@ -175,7 +177,7 @@ static money32 footpath_element_insert(sint32 type, sint32 x, sint32 y, sint32 z
 	rct_map_element *mapElement;
 	sint32 bl, zHigh;
 
-	if (!map_check_free_elements_and_reorganise(1))
+	if (!map_check_free_elements(1))
 		return MONEY32_UNDEFINED;
 
 	if ((flags & GAME_COMMAND_FLAG_APPLY) && !(flags & (GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_GHOST)))
@@ -217,6 +219,7 @@ static money32 footpath_element_insert(sint32 type, sint32 x, sint32 y, sint32 z
 		mapElement->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
 		if (flags & GAME_COMMAND_FLAG_GHOST)
 			mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
+		footpath_graph_invalidate_element(x >> 5, y >> 5, mapElement);
 
 		footpath_queue_chain_reset();
 
@@ -308,6 +311,7 @@ static money32 footpath_element_update(sint32 x, sint32 y, rct_map_element *mapE
 				mapElement->properties.path.addition_status = 255;
 			}
 		}
+		tile_summary_invalidate_at(x >> 5, y >> 5);
 		map_invalidate_tile_full(x, y);
 		return gParkFlags & PARK_FLAGS_NO_MONEY ? 0 : gFootpathPrice;
 	}
@@ -325,6 +329,8 @@ static money32 footpath_element_update(sint32 x, sint32 y, rct_map_element *mapE
 		mapElement->type = (mapElement->type & 0xFE) | (type >> 7);
 		footpath_element_set_path_scenery(mapElement, pathItemType);
 		mapElement->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
+		tile_summary_invalidate_at(x >> 5, y >> 5);
+		footpath_graph_invalidate_tile(x >> 5, y >> 5);
 
 		loc_6A6620(flags, x, y, mapElement);
 	}
@@ -445,7 +451,7 @@ money32 footpath_remove_real(sint32 x, sint32 y, sint32 z, sint32 flags)
 		remove_banners_at_element(x, y, mapElement);
 		footpath_remove_edges_at(x, y, mapElement);
 		map_invalidate_tile_full(x, y);
-		map_element_remove(mapElement);
+		map_element_remove(x / 32, y / 32, mapElement);
 		sub_6A759F();
 	}
 
@@ -555,6 +561,7 @@ static money32 footpath_place_from_track(sint32 type, sint32 x, sint32 y, sint32
 		mapElement->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
 		if (flags & (1 << 6))
 			mapElement->flags |= MAP_ELEMENT_FLAG_GHOST;
+		footpath_graph_invalidate_element(x >> 5, y >> 5, mapElement);
 
 		map_invalidate_tile_full(x, y);
 	}
@@ -798,18 +805,16 @@ void footpath_bridge_get_info_from_pos(sint32 screenX, sint32 screenY, sint32 *x
  */
 void footpath_remove_litter(sint32 x, sint32 y, sint32 z)
 {
-	uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-	while (spriteIndex != SPRITE_INDEX_NULL) {
-		rct_litter *sprite = &get_sprite(spriteIndex)->litter;
-		uint16 nextSpriteIndex = sprite->next_in_quadrant;
-		if (sprite->linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
-			sint32 distanceZ = abs(sprite->z - z);
-			if (distanceZ <= 32) {
-				invalidate_sprite_0((rct_sprite*)sprite);
-				sprite_remove((rct_sprite*)sprite);
-			}
+	sprite_query query;
+	sprite_query_tile(&query, x >> 5, y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_LITTER));
+
+	rct_sprite *sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL) {
+		sint32 distanceZ = abs(sprite->litter.z - z);
+		if (distanceZ <= 32) {
+			invalidate_sprite_0(sprite);
+			sprite_remove(sprite);
 		}
-		spriteIndex = nextSpriteIndex;
 	}
 }
 
@@ -819,24 +824,23 @@ void footpath_remove_litter(sint32 x, sint32 y, sint32 z)
  */
 void footpath_interrupt_peeps(sint32 x, sint32 y, sint32 z)
 {
-	uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-	while (spriteIndex != SPRITE_INDEX_NULL) {
-		rct_peep *peep = &get_sprite(spriteIndex)->peep;
-		uint16 nextSpriteIndex = peep->next_in_quadrant;
-		if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2) {
-			if (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING) {
-				if (peep->z == z) {
-					peep_decrement_num_riders(peep);
-					peep->state = PEEP_STATE_WALKING;
-					peep_window_state_update(peep);
-					peep->destination_x = (peep->x & 0xFFE0) + 16;
-					peep->destination_y = (peep->y & 0xFFE0) + 16;
-					peep->destination_tolerence = 5;
-					sub_693B58(peep);
-				}
+	sprite_query query;
+	sprite_query_tile(&query, x >> 5, y >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+
+	rct_sprite *sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL) {
+		rct_peep *peep = &sprite->peep;
+		if (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING) {
+			if (peep->z == z) {
+				peep_decrement_num_riders(peep);
+				peep->state = PEEP_STATE_WALKING;
+				peep_window_state_update(peep);
+				peep->destination_x = (peep->x & 0xFFE0) + 16;
+				peep->destination_y = (peep->y & 0xFFE0) + 16;
+				peep->destination_tolerence = 5;
+				sub_693B58(peep);
 			}
 		}
-		spriteIndex = nextSpriteIndex;
 	}
 }
 
@@ -1083,7 +1087,11 @@ static bool sub_footpath_disconnect_queue_from_path(sint32 x, sint32 y, rct_map_
 			mapElement->properties.path.edges |= (1 << direction);
 			otherMapElement->properties.path.edges |= (1 << ((direction + 2) & 3));
 		}
-		if (action != 0) map_invalidate_tile_full(x1, y1);
+		if (action != 0) {
+			map_invalidate_tile_full(x1, y1);
+			footpath_graph_invalidate_tile(x >> 5, y >> 5);
+			footpath_graph_invalidate_tile(x1 >> 5, y1 >> 5);
+		}
 		return true;
 	}
 	return false;
@@ -1220,6 +1228,7 @@ static void loc_6A6D7E(
 		} else {
 			footpath_disconnect_queue_from_path(x, y, mapElement, 1 + ((flags >> 6) & 1));
 			mapElement->properties.path.edges |= (1 << (direction ^ 2));
+			footpath_graph_invalidate_tile(x >> 5, y >> 5);
 			if (footpath_element_is_queue(mapElement)) {
 				footpath_queue_chain_push(mapElement->properties.path.ride_index);
 			}
@@ -1235,6 +1244,7 @@ loc_6A6FD2:
 		if (!query) {
 			initialMapElement->properties.path.edges |= (1 << direction);
 			map_invalidate_element(initialX, initialY, initialMapElement);
+			footpath_graph_invalidate_tile(initialX >> 5, initialY >> 5);
 		}
 	}
 }
@@ -1406,6 +1416,7 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
 			mapElement->properties.path.additions |= (entranceIndex & 7) << 4;
 
 			map_invalidate_element(x, y, mapElement);
+			footpath_graph_invalidate_tile(x >> 5, y >> 5);
 
 			if (lastQueuePathElement == NULL) {
 				lastQueuePathElement = mapElement;
@@ -1695,6 +1706,164 @@ uint8 footpath_element_get_type(rct_map_element *mapElement)
 	return mapElement->properties.path.type >> 4;
 }
 
+static rct_map_element* get_banner_on_path(rct_map_element *path_element)
+{
+	// This is an improved version of original.
+	// That only checked for one fence in the way.
+	if (map_element_is_last_for_tile(path_element))
+		return NULL;
+
+	rct_map_element *bannerElement = path_element + 1;
+	do {
+		// Path on top, so no banners
+		if (map_element_get_type(bannerElement) == MAP_ELEMENT_TYPE_PATH)
+			return NULL;
+		// Found a banner
+		if (map_element_get_type(bannerElement) == MAP_ELEMENT_TYPE_BANNER)
+			return bannerElement;
+		// Last element so there cant be any other banners
+		if (map_element_is_last_for_tile(bannerElement))
+			return NULL;
+
+	} while (bannerElement++);
+
+	return NULL;
+}
+
+/**
+ * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
+ * @param ignoreBanners Whether 'no entry' signs are walked through, as staff do.
+ */
+sint32 footpath_element_get_permitted_edges(rct_map_element *mapElement, bool ignoreBanners)
+{
+	sint32 edges = mapElement->properties.path.edges;
+	if (!ignoreBanners) {
+		rct_map_element *bannerElement = get_banner_on_path(mapElement);
+		if (bannerElement != NULL) {
+			do {
+				edges &= bannerElement->properties.banner.flags;
+			} while ((bannerElement = get_banner_on_path(bannerElement)) != NULL);
+		}
+	}
+	return edges & 0x0F;
+}
+
+/**
+ * Returns whether a peep at height currentZ walking in currentDirection can step onto the path.
+ */
+bool footpath_element_is_valid_z_and_direction(rct_map_element *mapElement, sint32 currentZ, sint32 currentDirection)
+{
+	if (footpath_element_is_sloped(mapElement)) {
+		sint32 slopeDirection = footpath_element_get_slope_direction(mapElement);
+		if (slopeDirection == currentDirection) {
+			if (currentZ != mapElement->base_height) return false;
+		} else {
+			slopeDirection ^= 2;
+			if (slopeDirection != currentDirection) return false;
+			if (currentZ != mapElement->base_height + 2) return false;
+		}
+	} else {
+		if (currentZ != mapElement->base_height) return false;
+	}
+	return true;
+}
+
+/**
+ *
+ * Returns:
+ *   1 - PATH_SEARCH_WIDE (path with wide flag set)
+ *   4 - PATH_SEARCH_RIDE_QUEUE (queue path connected to a ride)
+ *   11 - PATH_SEARCH_OTHER (other path than the above)
+ *   12 - PATH_SEARCH_FAILED (no path element found)
+ *
+ *  rct2: 0x00694BAE
+ *
+ * Returns the type of the next footpath tile a peep can get to from x,y,z /
+ * inputMapElement in the given direction.
+ */
+uint8 footpath_element_next_in_direction(sint16 x, sint16 y, sint16 z, rct_map_element *mapElement, uint8 chosenDirection)
+{
+	rct_map_element *nextMapElement;
+
+	if (footpath_element_is_sloped(mapElement)) {
+		if (footpath_element_get_slope_direction(mapElement) == chosenDirection) {
+			z += 2;
+		}
+	}
+
+	x += TileDirectionDelta[chosenDirection].x;
+	y += TileDirectionDelta[chosenDirection].y;
+	nextMapElement = map_get_first_element_at(x / 32, y / 32);
+	do {
+		if (map_element_get_type(nextMapElement) != MAP_ELEMENT_TYPE_PATH) continue;
+		if (!footpath_element_is_valid_z_and_direction(nextMapElement, z, chosenDirection)) continue;
+		if (footpath_element_is_wide(nextMapElement)) return PATH_SEARCH_WIDE;
+		// Only queue tiles that are connected to a ride are returned as ride queues.
+		if (footpath_element_is_queue(nextMapElement) && nextMapElement->properties.path.ride_index != 0xFF) return PATH_SEARCH_RIDE_QUEUE;
+
+		return PATH_SEARCH_OTHER;
+	} while (!map_element_is_last_for_tile(nextMapElement++));
+
+	return PATH_SEARCH_FAILED;
+}
+
+/**
+ * Returns if the path as xzy is a 'thin' junction.
+ * A junction is considered 'thin' if it has more than 2 edges
+ * leading to non-wide path elements; edges leading to non-path elements
+ * (e.g. ride/shop entrances) or ride queues are not counted, since entrances
+ * and ride queues coming off a path should not result in the path being
+ * considered a junction.
+ */
+bool footpath_element_is_thin_junction(rct_map_element *path, sint16 x, sint16 y, uint8 z, bool ignoreBanners)
+{
+	uint8 edges = footpath_element_get_permitted_edges(path, ignoreBanners);
+
+	sint32 test_edge = bitscanforward(edges);
+	if (test_edge == -1) return false;
+
+	bool thin_junction = false;
+	sint32 thin_count = 0;
+	do
+	{
+		sint32 fp_result = footpath_element_next_in_direction(x, y, z, path, test_edge);
+
+		/* Ignore non-paths (e.g. ride entrances, shops), wide paths
+		 * and ride queues (per ignoreQueues) when counting
+		 * neighbouring tiles. */
+		if (fp_result != PATH_SEARCH_FAILED &&
+			fp_result != PATH_SEARCH_WIDE &&
+			fp_result != PATH_SEARCH_RIDE_QUEUE) {
+			thin_count++;
+		}
+
+		if (thin_count > 2) {
+			thin_junction = true;
+			break;
+		}
+		edges &= ~(1 << test_edge);
+	} while ((test_edge = bitscanforward(edges)) != -1);
+	return thin_junction;
+}
+
+/**
+ * Gets a mask of which of the first 32 path elements at the location are wide.
+ */
+static uint32 footpath_get_wide_mask(sint32 x, sint32 y)
+{
+	uint32 wideMask = 0;
+	sint32 index = 0;
+	rct_map_element *mapElement = map_get_first_element_at(x / 32, y / 32);
+	do {
+		if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_PATH)
+			continue;
+		if (footpath_element_is_wide(mapElement) && index < 32)
+			wideMask |= 1u << index;
+		index++;
+	} while (!map_element_is_last_for_tile(mapElement++));
+	return wideMask;
+}
+
 /**
 *
 *  rct2: 0x006A8B12
@@ -1751,6 +1920,7 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
 	if (y > 0x1FDF)
 		return;
 
+	uint32 oldWideMask = footpath_get_wide_mask(x, y);
 	footpath_clear_wide(x, y);
 	/* Rather than clearing the wide flag of the following tiles and
 	 * checking the state of them later, leave them intact and assume
@@ -1924,6 +2094,11 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
 				mapElement->type |= 2;
 		}
 	} while (!map_element_is_last_for_tile(mapElement++));
+
+	// Pathfinding stops at wide paths, so only a change in them affects the footpath graph
+	if (footpath_get_wide_mask(x, y) != oldWideMask) {
+		footpath_graph_invalidate_tile(x >> 5, y >> 5);
+	}
 }
 
 /**
@@ -1943,6 +2118,7 @@ void sub_6A7642(sint32 x, sint32 y, rct_map_element *mapElement)
 				}
 			}
 			mapElement->properties.path.ride_index = 255;
+			footpath_graph_invalidate_tile(x >> 5, y >> 5);
 		}
 		break;
 	case MAP_ELEMENT_TYPE_ENTRANCE:
@@ -1973,6 +2149,7 @@ static void footpath_remove_edges_towards_here(sint32 x, sint32 y, sint32 z, sin
 	d = (((d - 4) + 1) & 3) + 4;
 	mapElement->properties.path.edges &= ~(1 << d);
 	map_invalidate_tile(x, y, mapElement->base_height * 8, mapElement->clearance_height * 8);
+	footpath_graph_invalidate_tile(x >> 5, y >> 5);
 
 	if (isQueue) footpath_disconnect_queue_from_path(x, y, mapElement, -1);
 
@@ -2067,8 +2244,10 @@ void footpath_remove_edges_at(sint32 x, sint32 y, rct_map_element *mapElement)
 			z0, z1, direction, footpath_element_is_queue(mapElement));
 	}
 
-	if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_PATH)
+	if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_PATH) {
 		mapElement->properties.path.edges = 0;
+		footpath_graph_invalidate_tile(x >> 5, y >> 5);
+	}
 }
 
 rct_footpath_entry *get_footpath_entry(sint32 entryIndex)
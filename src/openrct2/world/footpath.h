@@ -97,6 +97,10 @@ void footpath_element_set_path_scenery(rct_map_element *mapElement, uint8 pathSc
 uint8 footpath_element_get_path_scenery_index(rct_map_element *mapElement);
 bool footpath_element_path_scenery_is_ghost(rct_map_element *mapElement);
 void footpath_scenery_set_is_ghost(rct_map_element *mapElement, bool isGhost);
+sint32 footpath_element_get_permitted_edges(rct_map_element *mapElement, bool ignoreBanners);
+bool footpath_element_is_valid_z_and_direction(rct_map_element *mapElement, sint32 currentZ, sint32 currentDirection);
+uint8 footpath_element_next_in_direction(sint16 x, sint16 y, sint16 z, rct_map_element *mapElement, uint8 chosenDirection);
+bool footpath_element_is_thin_junction(rct_map_element *path, sint16 x, sint16 y, uint8 z, bool ignoreBanners);
 void footpath_remove_edges_at(sint32 x, sint32 y, rct_map_element *mapElement);
 sint32 entrance_get_directions(rct_map_element *mapElement);
 
@@ -0,0 +1,389 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "footpath_flow.h"
+#include "footpath_graph.h"
+
+#define FOOTPATH_FLOW_MAX_FIELDS 16
+
+/**
+ * A path node of the whole map that steps onto another node when leaving in the given direction.
+ */
+typedef struct footpath_flow_predecessor {
+	uint32 node;
+	uint8 direction;
+} footpath_flow_predecessor;
+
+/**
+ * The distance to a destination from every path node of the map and the direction to leave each node by.
+ */
+typedef struct footpath_flow_field {
+	footpath_flow_key key;
+	bool valid;
+	uint32 revision;
+	uint32 last_used;
+	uint32 capacity;
+	uint16 *distances;
+	uint8 *directions;
+} footpath_flow_field;
+
+// The footpath graph revision the node numbering was made for
+static uint32 _flowNetworkRevision;
+static bool _flowNetworkValid;
+
+// Nodes of the whole map are numbered tile by tile, so the nodes of a tile follow its first node
+static uint32 _flowTileFirstNode[MAX_TILE_MAP_ELEMENT_POINTERS + 1];
+static uint32 _flowNumNodes;
+static uint32 _flowNodesCapacity;
+static footpath_graph_node *_flowNodes;
+static uint32 *_flowQueue;
+
+// The nodes stepping onto each node, grouped by the node they step onto
+static uint32 *_flowFirstPredecessor;
+static footpath_flow_predecessor *_flowPredecessors;
+static uint32 _flowPredecessorsCapacity;
+
+static footpath_flow_field _flowFields[FOOTPATH_FLOW_MAX_FIELDS];
+static uint32 _flowFieldUseCounter;
+
+static sint32 footpath_flow_get_neighbour_tile(sint32 tileIndex, sint32 direction)
+{
+	sint32 x = (tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL) + TileDirectionDelta[direction].x / 32;
+	sint32 y = (tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL) + TileDirectionDelta[direction].y / 32;
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
+		return -1;
+	}
+	return x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+/**
+ * Goes through the paths every node steps onto, either counting the predecessors of each node or, once
+ * _flowFirstPredecessor holds where the predecessors of each node go, filling them in.
+ */
+static void footpath_flow_visit_predecessors(bool fill)
+{
+	for (sint32 tileIndex = 0; tileIndex < MAX_TILE_MAP_ELEMENT_POINTERS; tileIndex++) {
+		uint32 firstNode = _flowTileFirstNode[tileIndex];
+		uint32 numNodes = _flowTileFirstNode[tileIndex + 1] - firstNode;
+		if (numNodes == 0)
+			continue;
+
+		const footpath_graph_tile *tile = footpath_graph_get_tile(tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL, tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL);
+		for (uint32 i = 0; i < numNodes; i++) {
+			const footpath_graph_node *node = &tile->nodes[i];
+			for (sint32 direction = 0; direction < 4; direction++) {
+				// Staff may leave by every edge guests may, whether guests may is checked when the field is made
+				if (!(node->staff_edges & (1 << direction)))
+					continue;
+
+				sint32 neighbourIndex = footpath_flow_get_neighbour_tile(tileIndex, direction);
+				if (neighbourIndex == -1)
+					continue;
+
+				sint32 numLinks;
+				const footpath_graph_link *links = footpath_graph_get_links(tile, node, direction, &numLinks);
+				for (sint32 j = 0; j < numLinks; j++) {
+					if (links[j].type != FOOTPATH_GRAPH_LINK_PATH)
+						continue;
+
+					uint32 target = _flowTileFirstNode[neighbourIndex] + links[j].node_index;
+					if (fill) {
+						footpath_flow_predecessor *predecessor = &_flowPredecessors[_flowFirstPredecessor[target + 1]++];
+						predecessor->node = firstNode + i;
+						predecessor->direction = direction;
+					} else {
+						_flowFirstPredecessor[target + 2]++;
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Grows the block to hold the given number of items, keeping it as it was when there is not enough memory.
+ */
+static bool footpath_flow_reserve(void **block, size_t count, size_t itemSize)
+{
+	void *newBlock = realloc(*block, count * itemSize);
+	if (newBlock == NULL) {
+		log_error("Unable to allocate memory for the guest flow fields.");
+		return false;
+	}
+	*block = newBlock;
+	return true;
+}
+
+/**
+ * Numbers the path nodes of the whole map and gathers which nodes step onto each other. Returns false when
+ * there is not enough memory.
+ */
+static bool footpath_flow_build_network()
+{
+	uint32 numNodes = 0;
+	for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+		for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+			sint32 tileIndex = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+			_flowTileFirstNode[tileIndex] = numNodes;
+			numNodes += footpath_graph_get_tile(x, y)->num_nodes;
+		}
+	}
+	_flowTileFirstNode[MAX_TILE_MAP_ELEMENT_POINTERS] = numNodes;
+
+	if (_flowNodes == NULL || numNodes > _flowNodesCapacity) {
+		uint32 capacity = max(numNodes, max(_flowNodesCapacity * 2, 256));
+		if (!footpath_flow_reserve((void **)&_flowNodes, capacity, sizeof(footpath_graph_node)) ||
+			!footpath_flow_reserve((void **)&_flowQueue, capacity, sizeof(uint32)) ||
+			!footpath_flow_reserve((void **)&_flowFirstPredecessor, capacity + 2, sizeof(uint32))
+		) {
+			return false;
+		}
+		_flowNodesCapacity = capacity;
+	}
+	_flowNumNodes = numNodes;
+
+	for (sint32 tileIndex = 0; tileIndex < MAX_TILE_MAP_ELEMENT_POINTERS; tileIndex++) {
+		uint32 numTileNodes = _flowTileFirstNode[tileIndex + 1] - _flowTileFirstNode[tileIndex];
+		if (numTileNodes != 0) {
+			const footpath_graph_tile *tile = footpath_graph_get_tile(tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL, tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL);
+			memcpy(&_flowNodes[_flowTileFirstNode[tileIndex]], tile->nodes, numTileNodes * sizeof(footpath_graph_node));
+		}
+	}
+
+	// Count the predecessors of each node two entries ahead, so the running sum leaves where each node's
+	// predecessors start one entry ahead, which the filling moves back into place
+	memset(_flowFirstPredecessor, 0, (numNodes + 2) * sizeof(uint32));
+	footpath_flow_visit_predecessors(false);
+	for (uint32 i = 2; i < numNodes + 2; i++) {
+		_flowFirstPredecessor[i] += _flowFirstPredecessor[i - 1];
+	}
+
+	uint32 numPredecessors = _flowFirstPredecessor[numNodes + 1];
+	if (_flowPredecessors == NULL || numPredecessors > _flowPredecessorsCapacity) {
+		uint32 capacity = max(numPredecessors, max(_flowPredecessorsCapacity * 2, 256));
+		if (!footpath_flow_reserve((void **)&_flowPredecessors, capacity, sizeof(footpath_flow_predecessor))) {
+			return false;
+		}
+		_flowPredecessorsCapacity = capacity;
+	}
+	footpath_flow_visit_predecessors(true);
+
+	_flowNetworkRevision = footpath_graph_get_revision();
+	_flowNetworkValid = true;
+	return true;
+}
+
+/**
+ * Returns whether guests following the field may walk along the node.
+ */
+static bool footpath_flow_node_is_walkable(const footpath_flow_key *key, const footpath_graph_node *node)
+{
+	if (node->flags & FOOTPATH_GRAPH_NODE_FLAG_GHOST)
+		return false;
+
+	if ((key->flags & FOOTPATH_FLOW_FLAG_IGNORE_FOREIGN_QUEUES) &&
+		(node->flags & FOOTPATH_GRAPH_NODE_FLAG_QUEUE) &&
+		node->ride_index != key->queue_ride_index &&
+		node->ride_index != 0xFF) {
+		return false;
+	}
+	return true;
+}
+
+static uint8 footpath_flow_get_node_edges(const footpath_flow_key *key, const footpath_graph_node *node)
+{
+	return (key->flags & FOOTPATH_FLOW_FLAG_STAFF) ? node->staff_edges : node->edges;
+}
+
+/**
+ * Fills in the field with a breadth first search from the destination back along the paths, so every node gets
+ * the fewest steps to the destination. The nodes are visited in a fixed order, so the same map always gives the
+ * same field. Returns false when there is not enough memory.
+ */
+static bool footpath_flow_compute_field(footpath_flow_field *field)
+{
+	const footpath_flow_key *key = &field->key;
+
+	if (field->distances == NULL || _flowNumNodes > field->capacity) {
+		uint32 capacity = max(_flowNumNodes, 256);
+		if (!footpath_flow_reserve((void **)&field->distances, capacity, sizeof(uint16)) ||
+			!footpath_flow_reserve((void **)&field->directions, capacity, sizeof(uint8))
+		) {
+			return false;
+		}
+		field->capacity = capacity;
+	}
+	memset(field->distances, 0xFF, _flowNumNodes * sizeof(uint16));
+	memset(field->directions, 0xFF, _flowNumNodes * sizeof(uint8));
+
+	uint32 queueHead = 0;
+	uint32 queueTail = 0;
+
+	// The paths the destination is reached from, which are those that step onto an element at its height
+	sint32 goalIndex = key->goal.x + key->goal.y * MAXIMUM_MAP_SIZE_TECHNICAL;
+	for (sint32 goalDirection = 0; goalDirection < 4; goalDirection++) {
+		sint32 tileIndex = footpath_flow_get_neighbour_tile(goalIndex, goalDirection);
+		if (tileIndex == -1)
+			continue;
+
+		sint32 direction = goalDirection ^ 2;
+		uint32 firstNode = _flowTileFirstNode[tileIndex];
+		uint32 numNodes = _flowTileFirstNode[tileIndex + 1] - firstNode;
+		if (numNodes == 0)
+			continue;
+
+		const footpath_graph_tile *tile = footpath_graph_get_tile(tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL, tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL);
+		for (uint32 i = 0; i < numNodes; i++) {
+			const footpath_graph_node *node = &tile->nodes[i];
+			if (!footpath_flow_node_is_walkable(key, node))
+				continue;
+			if (!(footpath_flow_get_node_edges(key, node) & (1 << direction)))
+				continue;
+
+			sint32 numLinks;
+			const footpath_graph_link *links = footpath_graph_get_links(tile, node, direction, &numLinks);
+			for (sint32 j = 0; j < numLinks; j++) {
+				if (links[j].z == key->goal.z) {
+					field->distances[firstNode + i] = 1;
+					field->directions[firstNode + i] = direction;
+					_flowQueue[queueTail++] = firstNode + i;
+					break;
+				}
+			}
+		}
+	}
+
+	while (queueHead < queueTail) {
+		uint32 node = _flowQueue[queueHead++];
+		uint16 distance = field->distances[node] + 1;
+		if (distance == FOOTPATH_FLOW_DISTANCE_UNREACHABLE)
+			continue;
+
+		for (uint32 i = _flowFirstPredecessor[node]; i < _flowFirstPredecessor[node + 1]; i++) {
+			const footpath_flow_predecessor *predecessor = &_flowPredecessors[i];
+			uint32 other = predecessor->node;
+			if (field->distances[other] != FOOTPATH_FLOW_DISTANCE_UNREACHABLE)
+				continue;
+
+			const footpath_graph_node *otherNode = &_flowNodes[other];
+			if (!footpath_flow_node_is_walkable(key, otherNode))
+				continue;
+			if (!(footpath_flow_get_node_edges(key, otherNode) & (1 << predecessor->direction)))
+				continue;
+
+			field->distances[other] = distance;
+			field->directions[other] = predecessor->direction;
+			_flowQueue[queueTail++] = other;
+		}
+	}
+
+	field->revision = _flowNetworkRevision;
+	field->valid = true;
+	return true;
+}
+
+static bool footpath_flow_key_equals(const footpath_flow_key *a, const footpath_flow_key *b)
+{
+	return a->goal.x == b->goal.x &&
+		a->goal.y == b->goal.y &&
+		a->goal.z == b->goal.z &&
+		a->flags == b->flags &&
+		a->queue_ride_index == b->queue_ride_index;
+}
+
+/**
+ * Gets the field for the destination, making it if there is none for the current footpath network. Fields that
+ * have not been used for the longest time make room for new ones. Returns NULL when there is not enough memory.
+ */
+static footpath_flow_field *footpath_flow_get_field(const footpath_flow_key *key)
+{
+	if (!_flowNetworkValid || _flowNetworkRevision != footpath_graph_get_revision()) {
+		_flowNetworkValid = false;
+		if (!footpath_flow_build_network()) {
+			return NULL;
+		}
+	}
+
+	footpath_flow_field *field = NULL;
+	for (sint32 i = 0; i < FOOTPATH_FLOW_MAX_FIELDS; i++) {
+		if (_flowFields[i].valid && footpath_flow_key_equals(&_flowFields[i].key, key)) {
+			field = &_flowFields[i];
+			break;
+		}
+	}
+	if (field == NULL) {
+		field = &_flowFields[0];
+		for (sint32 i = 0; i < FOOTPATH_FLOW_MAX_FIELDS; i++) {
+			if (!_flowFields[i].valid) {
+				field = &_flowFields[i];
+				break;
+			}
+			if (_flowFields[i].last_used < field->last_used) {
+				field = &_flowFields[i];
+			}
+		}
+	}
+
+	if (!field->valid || !footpath_flow_key_equals(&field->key, key) || field->revision != _flowNetworkRevision) {
+		field->key = *key;
+		field->valid = false;
+		if (!footpath_flow_compute_field(field)) {
+			return NULL;
+		}
+	}
+	field->last_used = ++_flowFieldUseCounter;
+	return field;
+}
+
+/**
+ * Gets the direction to leave the path at the given tile and height by to reach the destination in the fewest
+ * steps, or -1 if the destination can not be reached from there.
+ * @param x The tile x of the path.
+ * @param y The tile y of the path.
+ * @param outDistance If not NULL, set to the number of steps to the destination.
+ */
+sint32 footpath_flow_get_direction(const footpath_flow_key *key, sint32 x, sint32 y, sint32 z, uint16 *outDistance)
+{
+	if (outDistance != NULL) {
+		*outDistance = FOOTPATH_FLOW_DISTANCE_UNREACHABLE;
+	}
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+		return -1;
+	if (key->goal.x >= MAXIMUM_MAP_SIZE_TECHNICAL || key->goal.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+		return -1;
+
+	const footpath_flow_field *field = footpath_flow_get_field(key);
+	if (field == NULL)
+		return -1;
+
+	// Of overlaid paths at the height, follow the one nearest to the destination
+	sint32 tileIndex = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+	uint16 bestDistance = FOOTPATH_FLOW_DISTANCE_UNREACHABLE;
+	sint32 bestDirection = -1;
+	for (uint32 node = _flowTileFirstNode[tileIndex]; node < _flowTileFirstNode[tileIndex + 1]; node++) {
+		if (_flowNodes[node].z != z)
+			continue;
+		if (field->distances[node] < bestDistance) {
+			bestDistance = field->distances[node];
+			bestDirection = field->directions[node];
+		}
+	}
+
+	if (outDistance != NULL) {
+		*outDistance = bestDistance;
+	}
+	return bestDirection;
+}
@@ -0,0 +1,44 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _FOOTPATH_FLOW_H_
+#define _FOOTPATH_FLOW_H_
+
+#include "../common.h"
+#include "map.h"
+
+enum {
+	// Walk through 'no entry' signs as staff do
+	FOOTPATH_FLOW_FLAG_STAFF = (1 << 0),
+	// Do not walk along queues of other rides than queue_ride_index
+	FOOTPATH_FLOW_FLAG_IGNORE_FOREIGN_QUEUES = (1 << 1),
+};
+
+/**
+ * What a flow field leads to, the same destination and rules always give the same field.
+ */
+typedef struct footpath_flow_key {
+	// The tile and height of the destination, such as a ride entrance, ride exit or park entrance
+	rct_xyz8 goal;
+	uint8 flags;
+	uint8 queue_ride_index;
+} footpath_flow_key;
+
+#define FOOTPATH_FLOW_DISTANCE_UNREACHABLE 0xFFFF
+
+sint32 footpath_flow_get_direction(const footpath_flow_key *key, sint32 x, sint32 y, sint32 z, uint16 *outDistance);
+
+#endif
@@ -0,0 +1,326 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "footpath.h"
+#include "footpath_graph.h"
+#include "map.h"
+
+static footpath_graph_tile _footpathGraphTiles[MAX_TILE_MAP_ELEMENT_POINTERS];
+
+// Tiles built in an older generation are out of date, starts above the zeroed tiles
+static uint32 _footpathGraphGeneration = 1;
+
+// Changes whenever any part of the graph is marked out of date
+static uint32 _footpathGraphRevision;
+
+// Where a tile's nodes and links are gathered before they are copied into its own block
+static footpath_graph_node *_buildNodes;
+static footpath_graph_link *_buildLinks;
+static size_t _buildNodesCapacity;
+static size_t _buildLinksCapacity;
+
+/**
+ * Marks the whole footpath graph as out of date, for when the map is replaced or edited in a way that
+ * can not be pinned to a tile.
+ */
+void footpath_graph_invalidate()
+{
+	_footpathGraphGeneration++;
+	_footpathGraphRevision++;
+}
+
+/**
+ * Marks the graph of a tile as out of date, must be called whenever a path, banner, entrance or track element
+ * on the tile is added, removed or changed. The neighbouring tiles link to the tile, so they are marked too.
+ */
+void footpath_graph_invalidate_tile(sint32 x, sint32 y)
+{
+	_footpathGraphRevision++;
+
+	static const rct_xy8 Offsets[] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { (uint8)-1, 0 }, { 0, (uint8)-1 } };
+	for (sint32 i = 0; i < countof(Offsets); i++) {
+		sint32 tileX = x + (sint8)Offsets[i].x;
+		sint32 tileY = y + (sint8)Offsets[i].y;
+		if (tileX >= 0 && tileY >= 0 && tileX < MAXIMUM_MAP_SIZE_TECHNICAL && tileY < MAXIMUM_MAP_SIZE_TECHNICAL) {
+			_footpathGraphTiles[tileX + tileY * MAXIMUM_MAP_SIZE_TECHNICAL].generation = 0;
+		}
+	}
+}
+
+/**
+ * Marks the nodes of a tile as out of date without changing the graph, for when an element the graph leaves out
+ * is removed from below the tile's paths.
+ */
+void footpath_graph_invalidate_tile_nodes(sint32 x, sint32 y)
+{
+	if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL) {
+		_footpathGraphTiles[x + y * MAXIMUM_MAP_SIZE_TECHNICAL].generation = 0;
+	}
+}
+
+/**
+ * Marks what adding or removing the element on the tile at (x, y) changes of the graph. Only paths, banners,
+ * entrances and track are part of the graph, any other element just moves the elements above it.
+ */
+void footpath_graph_invalidate_element(sint32 x, sint32 y, const rct_map_element *mapElement)
+{
+	switch (map_element_get_type(mapElement)) {
+	case MAP_ELEMENT_TYPE_TRACK:
+	case MAP_ELEMENT_TYPE_ENTRANCE:
+		// Ghost track and entrances are not part of the graph, but the paths above them move
+		if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST) {
+			footpath_graph_invalidate_tile_nodes(x, y);
+		} else {
+			footpath_graph_invalidate_tile(x, y);
+		}
+		break;
+	case MAP_ELEMENT_TYPE_PATH:
+	case MAP_ELEMENT_TYPE_BANNER:
+		footpath_graph_invalidate_tile(x, y);
+		break;
+	default:
+		footpath_graph_invalidate_tile_nodes(x, y);
+		break;
+	}
+}
+
+/**
+ * Peeps path by the graph, so a tile that could not be built would send them elsewhere than on other machines.
+ */
+static void *footpath_graph_allocate(void *block, size_t size)
+{
+	void *newBlock = realloc(block, size);
+	if (newBlock == NULL) {
+		log_fatal("Unable to allocate memory for the footpath graph.");
+		exit(-1);
+	}
+	return newBlock;
+}
+
+static footpath_graph_link *footpath_graph_push_link(size_t numLinks)
+{
+	if (numLinks >= _buildLinksCapacity) {
+		_buildLinksCapacity = max(_buildLinksCapacity * 2, 64);
+		_buildLinks = footpath_graph_allocate(_buildLinks, _buildLinksCapacity * sizeof(footpath_graph_link));
+	}
+	return &_buildLinks[numLinks];
+}
+
+/**
+ * Returns whether a peep at height z walking in the given direction can step onto the map element, in which case
+ * the link is filled in (except for the node index of paths). Stepping onto a path moves z to the height of the path.
+ */
+bool footpath_graph_link_element(rct_map_element *mapElement, uint8 *z, sint32 direction, footpath_graph_link *link)
+{
+	if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST) return false;
+
+	switch (map_element_get_type(mapElement)) {
+	case MAP_ELEMENT_TYPE_TRACK:
+		if (*z != mapElement->base_height) return false;
+		link->type = FOOTPATH_GRAPH_LINK_TRACK;
+		link->ride_index = mapElement->properties.track.ride_index;
+		break;
+	case MAP_ELEMENT_TYPE_ENTRANCE:
+		if (*z != mapElement->base_height) return false;
+		switch (mapElement->properties.entrance.type) {
+		case ENTRANCE_TYPE_RIDE_ENTRANCE:
+			if ((mapElement->type & MAP_ELEMENT_DIRECTION_MASK) != direction) return false;
+			link->type = FOOTPATH_GRAPH_LINK_RIDE_ENTRANCE;
+			break;
+		case ENTRANCE_TYPE_RIDE_EXIT:
+			if ((mapElement->type & MAP_ELEMENT_DIRECTION_MASK) != direction) return false;
+			link->type = FOOTPATH_GRAPH_LINK_RIDE_EXIT;
+			break;
+		case ENTRANCE_TYPE_PARK_ENTRANCE:
+			link->type = FOOTPATH_GRAPH_LINK_PARK_ENTRANCE;
+			break;
+		default:
+			return false;
+		}
+		link->ride_index = mapElement->properties.entrance.ride_index;
+		break;
+	case MAP_ELEMENT_TYPE_PATH:
+		if (!footpath_element_is_valid_z_and_direction(mapElement, *z, direction)) return false;
+		// Path may be sloped, so the elements after it are checked at its base height
+		*z = mapElement->base_height;
+		link->type = FOOTPATH_GRAPH_LINK_PATH;
+		link->ride_index = 0xFF;
+		break;
+	default:
+		return false;
+	}
+
+	link->z = *z;
+	return true;
+}
+
+/**
+ * Gathers the elements a peep leaving the node in the given direction steps onto, in the order the peep
+ * pathfinding checks them.
+ */
+static size_t footpath_graph_build_links(sint32 x, sint32 y, footpath_graph_node *node, sint32 direction, size_t numLinks)
+{
+	node->first_link[direction] = (uint16)numLinks;
+	node->num_links[direction] = 0;
+
+	uint8 z = node->z;
+	if ((node->flags & FOOTPATH_GRAPH_NODE_FLAG_SLOPED) && node->slope_direction == direction) {
+		z += 2;
+	}
+
+	x += TileDirectionDelta[direction].x / 32;
+	y += TileDirectionDelta[direction].y / 32;
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
+		return numLinks;
+	}
+
+	uint8 nodeIndex = 0;
+	rct_map_element *mapElement = map_get_first_element_at(x, y);
+	do {
+		footpath_graph_link link = { 0 };
+		bool isPath = map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_PATH;
+		if (footpath_graph_link_element(mapElement, &z, direction, &link)) {
+			link.node_index = nodeIndex;
+			*footpath_graph_push_link(numLinks++) = link;
+			node->num_links[direction]++;
+		}
+		// Every path element is a node, including ghosts
+		if (isPath) {
+			nodeIndex++;
+		}
+	} while (!map_element_is_last_for_tile(mapElement++));
+
+	return numLinks;
+}
+
+static void footpath_graph_build_tile(footpath_graph_tile *tile, sint32 x, sint32 y)
+{
+	free(tile->nodes);
+	tile->generation = _footpathGraphGeneration;
+	tile->num_nodes = 0;
+	tile->num_links = 0;
+	tile->nodes = NULL;
+	tile->links = NULL;
+
+	size_t numNodes = 0;
+	sint32 lastElementIndex = -1;
+	rct_map_element *firstElement = map_get_first_element_at(x, y);
+	rct_map_element *mapElement = firstElement;
+	do {
+		switch (map_element_get_type(mapElement)) {
+		case MAP_ELEMENT_TYPE_TRACK:
+		case MAP_ELEMENT_TYPE_ENTRANCE:
+		case MAP_ELEMENT_TYPE_PATH:
+			if (!(mapElement->flags & MAP_ELEMENT_FLAG_GHOST)) {
+				lastElementIndex = (sint32)(mapElement - firstElement);
+			}
+			break;
+		}
+		if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_PATH)
+			continue;
+
+		if (numNodes >= _buildNodesCapacity) {
+			_buildNodesCapacity = max(_buildNodesCapacity * 2, 8);
+			_buildNodes = footpath_graph_allocate(_buildNodes, _buildNodesCapacity * sizeof(footpath_graph_node));
+		}
+
+		footpath_graph_node *node = &_buildNodes[numNodes++];
+		memset(node, 0, sizeof(footpath_graph_node));
+		node->z = mapElement->base_height;
+		node->element_index = (uint16)(mapElement - firstElement);
+		node->slope_direction = footpath_element_get_slope_direction(mapElement);
+		node->ride_index = mapElement->properties.path.ride_index;
+		node->edges = footpath_element_get_permitted_edges(mapElement, false);
+		node->staff_edges = footpath_element_get_permitted_edges(mapElement, true);
+		if (footpath_element_is_wide(mapElement)) node->flags |= FOOTPATH_GRAPH_NODE_FLAG_WIDE;
+		if (footpath_element_is_queue(mapElement)) node->flags |= FOOTPATH_GRAPH_NODE_FLAG_QUEUE;
+		if (footpath_element_is_sloped(mapElement)) node->flags |= FOOTPATH_GRAPH_NODE_FLAG_SLOPED;
+		if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST) node->flags |= FOOTPATH_GRAPH_NODE_FLAG_GHOST;
+		if (footpath_element_is_thin_junction(mapElement, x * 32, y * 32, node->z, false)) {
+			node->flags |= FOOTPATH_GRAPH_NODE_FLAG_THIN_JUNCTION;
+		}
+		if (footpath_element_is_thin_junction(mapElement, x * 32, y * 32, node->z, true)) {
+			node->flags |= FOOTPATH_GRAPH_NODE_FLAG_STAFF_THIN_JUNCTION;
+		}
+	} while (!map_element_is_last_for_tile(mapElement++));
+
+	if (numNodes == 0) {
+		return;
+	}
+
+	for (size_t i = 0; i < numNodes; i++) {
+		if (_buildNodes[i].element_index >= lastElementIndex) {
+			_buildNodes[i].flags |= FOOTPATH_GRAPH_NODE_FLAG_LAST_ON_TILE;
+		}
+	}
+
+	// Links are kept for every direction, as the search may leave a tile by an edge of an overlaid path
+	size_t numLinks = 0;
+	for (size_t i = 0; i < numNodes; i++) {
+		for (sint32 direction = 0; direction < 4; direction++) {
+			numLinks = footpath_graph_build_links(x, y, &_buildNodes[i], direction, numLinks);
+		}
+	}
+
+	size_t nodesSize = numNodes * sizeof(footpath_graph_node);
+	size_t linksSize = numLinks * sizeof(footpath_graph_link);
+	tile->nodes = footpath_graph_allocate(NULL, nodesSize + linksSize);
+	tile->links = (footpath_graph_link *)(tile->nodes + numNodes);
+	memcpy(tile->nodes, _buildNodes, nodesSize);
+	memcpy(tile->links, _buildLinks, linksSize);
+	tile->num_nodes = (uint16)numNodes;
+	tile->num_links = (uint16)numLinks;
+}
+
+/**
+ * Gets a number that changes whenever the footpath graph changes, for caches built from the whole graph.
+ */
+uint32 footpath_graph_get_revision()
+{
+	return _footpathGraphRevision;
+}
+
+/**
+ * Gets the footpath graph of the given tile, building it again if the tile has changed since.
+ */
+const footpath_graph_tile *footpath_graph_get_tile(sint32 x, sint32 y)
+{
+	footpath_graph_tile *tile = &_footpathGraphTiles[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+	if (tile->generation != _footpathGraphGeneration) {
+		footpath_graph_build_tile(tile, x, y);
+	}
+	return tile;
+}
+
+/**
+ * Gets the links a peep follows when leaving the node in the given direction.
+ */
+const footpath_graph_link *footpath_graph_get_links(const footpath_graph_tile *tile, const footpath_graph_node *node, sint32 direction, sint32 *numLinks)
+{
+	*numLinks = node->num_links[direction];
+	return &tile->links[node->first_link[direction]];
+}
+
+/**
+ * Gets the node a path link leads to.
+ * @param x The tile x of the node the link leaves from.
+ * @param y The tile y of the node the link leaves from.
+ */
+const footpath_graph_node *footpath_graph_get_link_node(sint32 x, sint32 y, sint32 direction, const footpath_graph_link *link)
+{
+	const footpath_graph_tile *tile = footpath_graph_get_tile(x + TileDirectionDelta[direction].x / 32, y + TileDirectionDelta[direction].y / 32);
+	return &tile->nodes[link->node_index];
+}
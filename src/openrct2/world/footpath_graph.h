@@ -0,0 +1,94 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _FOOTPATH_GRAPH_H_
+#define _FOOTPATH_GRAPH_H_
+
+#include "../common.h"
+#include "map.h"
+
+enum {
+	FOOTPATH_GRAPH_LINK_PATH,
+	FOOTPATH_GRAPH_LINK_TRACK,
+	FOOTPATH_GRAPH_LINK_RIDE_ENTRANCE,
+	FOOTPATH_GRAPH_LINK_RIDE_EXIT,
+	FOOTPATH_GRAPH_LINK_PARK_ENTRANCE,
+};
+
+/**
+ * An element a peep can step onto when leaving a path in one direction.
+ */
+typedef struct footpath_graph_link {
+	uint8 type;
+	// The height the element is reached at, which is the path's own height for paths
+	uint8 z;
+	// The ride of the track, ride entrance or ride exit
+	uint8 ride_index;
+	// For paths, the index of the node on the tile that is stepped onto
+	uint8 node_index;
+} footpath_graph_link;
+
+enum {
+	FOOTPATH_GRAPH_NODE_FLAG_WIDE = (1 << 0),
+	FOOTPATH_GRAPH_NODE_FLAG_QUEUE = (1 << 1),
+	FOOTPATH_GRAPH_NODE_FLAG_SLOPED = (1 << 2),
+	FOOTPATH_GRAPH_NODE_FLAG_GHOST = (1 << 3),
+	FOOTPATH_GRAPH_NODE_FLAG_THIN_JUNCTION = (1 << 4),
+	FOOTPATH_GRAPH_NODE_FLAG_STAFF_THIN_JUNCTION = (1 << 5),
+	// No track, entrance or path elements a peep could step onto follow the path on its tile
+	FOOTPATH_GRAPH_NODE_FLAG_LAST_ON_TILE = (1 << 6),
+};
+
+/**
+ * A path element of the footpath network along with what it connects to.
+ */
+typedef struct footpath_graph_node {
+	uint8 z;
+	uint8 flags;
+	uint8 slope_direction;
+	uint8 ride_index;
+	// The edges guests may leave by, without those blocked by 'no entry' signs
+	uint8 edges;
+	// The edges staff may leave by
+	uint8 staff_edges;
+	// The index of the path element on its tile
+	uint16 element_index;
+	uint8 num_links[4];
+	uint16 first_link[4];
+} footpath_graph_node;
+
+/**
+ * The nodes for the path elements of a tile, in element order, and the links leaving them.
+ */
+typedef struct footpath_graph_tile {
+	uint32 generation;
+	uint16 num_nodes;
+	uint16 num_links;
+	footpath_graph_node *nodes;
+	footpath_graph_link *links;
+} footpath_graph_tile;
+
+void footpath_graph_invalidate();
+void footpath_graph_invalidate_tile(sint32 x, sint32 y);
+void footpath_graph_invalidate_tile_nodes(sint32 x, sint32 y);
+void footpath_graph_invalidate_element(sint32 x, sint32 y, const rct_map_element *mapElement);
+uint32 footpath_graph_get_revision();
+bool footpath_graph_link_element(rct_map_element *mapElement, uint8 *z, sint32 direction, footpath_graph_link *link);
+const footpath_graph_tile *footpath_graph_get_tile(sint32 x, sint32 y);
+const footpath_graph_link *footpath_graph_get_links(const footpath_graph_tile *tile, const footpath_graph_node *node, sint32 direction, sint32 *numLinks);
+const footpath_graph_node *footpath_graph_get_link_node(sint32 x, sint32 y, sint32 direction, const footpath_graph_link *link);
+
+#endif
@@ -26,6 +26,7 @@
 #include "../management/finance.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../paint/paint.h"
 #include "../rct2.h"
 #include "../ride/ride_data.h"
 #include "../ride/track.h"
@@ -35,10 +36,12 @@
 #include "banner.h"
 #include "climate.h"
 #include "footpath.h"
+#include "footpath_graph.h"
 #include "map.h"
 #include "map_animation.h"
 #include "park.h"
 #include "scenery.h"
+#include "tile_summary.h"
 
 /**
  * Replaces 0x00993CCC, 0x00993CCE
@@ -83,7 +86,7 @@ uint8 gMapGroundFlags;
 
 uint16 gWidePathTileLoopX;
 uint16 gWidePathTileLoopY;
-uint16 gGrassSceneryTileLoopPosition;
+uint32 gGrassSceneryTileLoopPosition;
 
 sint16 gMapSizeUnits;
 sint16 gMapSizeMinus2;
@@ -92,7 +95,7 @@ sint16 gMapSizeMaxXY;
 sint16 gMapBaseZ;
 
 #if defined(NO_RCT2)
-rct_map_element gMapElements[0x30000];
+rct_map_element gMapElements[MAP_ELEMENT_BASE_POOL_SIZE];
 rct_map_element *gMapElementTilePointers[MAX_TILE_MAP_ELEMENT_POINTERS];
 #else
 rct_map_element *gMapElements = RCT2_ADDRESS(RCT2_ADDRESS_MAP_ELEMENTS, rct_map_element);
@@ -104,6 +107,27 @@ rct2_peep_spawn gPeepSpawns[2];
 rct_map_element *gNextFreeMapElement;
 uint32 gNextFreeMapElementPointerIndex;
 
+// Each tile's elements are kept in a block of the element pool that is a power of two in size, so
+// an element can usually be inserted in place. When a tile outgrows its block it is moved to a block
+// of the next size and the old block goes onto the free list for its size. The pool starts out as
+// gMapElements and grows by allocating further chunks, chunks are never moved or resized.
+#define MAP_ELEMENT_BLOCK_CLASSES	16
+#define MAP_ELEMENT_CHUNK_SIZE		0x10000
+#define MAX_MAP_ELEMENT_CHUNKS		256
+
+typedef struct map_element_free_list {
+	rct_map_element **blocks;
+	uint32 count;
+	uint32 capacity;
+} map_element_free_list;
+
+static rct_map_element *_mapElementChunks[MAX_MAP_ELEMENT_CHUNKS];
+static sint32 _mapElementNumChunks;
+static size_t _mapElementPoolCapacity;
+static rct_map_element *_mapElementChunkEnd;
+static map_element_free_list _mapElementFreeLists[MAP_ELEMENT_BLOCK_CLASSES];
+static uint32 _mapElementTileCapacity[MAX_TILE_MAP_ELEMENT_POINTERS];
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool LandRightsMode;
@@ -134,6 +158,9 @@ static void map_set_grass_length(sint32 x, sint32 y, rct_map_element *mapElement
 static void clear_elements_at(sint32 x, sint32 y);
 static void translate_3d_to_2d(sint32 rotation, sint32 *x, sint32 *y);
 static void map_obstruction_set_error_text(rct_map_element *mapElement);
+static void map_element_pool_reset();
+static bool map_element_pool_add_chunk(size_t minSize);
+static sint32 map_get_tile_loop_size();
 
 void rotate_map_coordinates(sint16 *x, sint16 *y, sint32 rotation)
 {
@@ -203,13 +230,13 @@ sint32 map_element_iterator_next(map_element_iterator *it)
 		return 1;
 	}
 
-	if (it->x < 255) {
+	if (it->x < MAXIMUM_MAP_SIZE_TECHNICAL - 1) {
 		it->x++;
 		it->element = map_get_first_element_at(it->x, it->y);
 		return 1;
 	}
 
-	if (it->y < 255) {
+	if (it->y < MAXIMUM_MAP_SIZE_TECHNICAL - 1) {
 		it->x = 0;
 		it->y++;
 		it->element = map_get_first_element_at(it->x, it->y);
@@ -226,20 +253,24 @@ void map_element_iterator_restart_for_tile(map_element_iterator *it)
 
 rct_map_element *map_get_first_element_at(sint32 x, sint32 y)
 {
-	if (x < 0 || y < 0 || x > 255 || y > 255) {
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
 		log_error("Trying to access element outside of range");
 		return NULL;
 	}
-	return gMapElementTilePointers[x + y * 256];
+	return gMapElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
 }
 
 void map_set_tile_elements(sint32 x, sint32 y, rct_map_element *elements)
 {
-	if (x < 0 || y < 0 || x > 255 || y > 255) {
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
 		log_error("Trying to access element outside of range");
 		return;
 	}
-	gMapElementTilePointers[x + y * 256] = elements;
+	gMapElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
+	tile_summary_invalidate_at(x, y);
+	tile_summary_invalidate_rides_at(x, y);
+	footpath_graph_invalidate_tile(x, y);
+	paint_cache_invalidate_tile(x, y);
 }
 
 sint32 map_element_is_last_for_tile(const rct_map_element *element)
@@ -372,8 +403,9 @@ void map_init(sint32 size)
 	gNumMapAnimations = 0;
 	gNextFreeMapElementPointerIndex = 0;
 
+	map_set_elements(NULL, 0);
 	for (sint32 i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
-		rct_map_element *map_element = &gMapElements[i];
+		rct_map_element *map_element = gMapElementTilePointers[i];
 		map_element->type = (MAP_ELEMENT_TYPE_SURFACE << 2);
 		map_element->flags = MAP_ELEMENT_FLAG_LAST_TILE;
 		map_element->base_height = 14;
@@ -395,7 +427,6 @@ void map_init(sint32 size)
 	gMapSize = size;
 	gMapSizeMaxXY = size * 32 - 33;
 	gMapBaseZ = 7;
-	map_update_tile_pointers();
 	map_remove_out_of_range_elements();
 	climate_reset(CLIMATE_WARM);
 }
@@ -410,8 +441,8 @@ void map_count_remaining_land_rights()
 	gLandRemainingOwnershipSales = 0;
 	gLandRemainingConstructionSales = 0;
 
-	for (sint32 x = 0; x <= 255; x++) {
-		for (sint32 y = 0; y <= 255; y++) {
+	for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+		for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
 			rct_map_element *element = map_get_surface_element_at(x, y);
 			// Surface elements are sometimes hacked out to save some space for other map elements
 			if (element == NULL) {
@@ -430,27 +461,92 @@ void map_count_remaining_land_rights()
 }
 
 /**
- *
- *  rct2: 0x0068AFFD
+ * Counts the elements on the tiles of the given size square in the corner of the map.
  */
-void map_update_tile_pointers()
+size_t map_get_num_elements(sint32 size)
 {
-	sint32 i, x, y;
-
-	for (i = 0; i < MAX_TILE_MAP_ELEMENT_POINTERS; i++) {
-		gMapElementTilePointers[i] = TILE_UNDEFINED_MAP_ELEMENT;
+	size_t numElements = 0;
+	for (sint32 y = 0; y < size; y++) {
+		for (sint32 x = 0; x < size; x++) {
+			rct_map_element *mapElement = gMapElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+			do {
+				numElements++;
+			} while (!map_element_is_last_for_tile(mapElement++));
+		}
 	}
+	return numElements;
+}
 
-	rct_map_element *mapElement = gMapElements;
-	rct_map_element **tile = gMapElementTilePointers;
-	for (y = 0; y < 256; y++) {
-		for (x = 0; x < 256; x++) {
-			*tile++ = mapElement;
+/**
+ * Copies the elements on the tiles of the given size square in the corner of the map to the given
+ * buffer as a single run in row order, which is the layout used by saved games. The buffer must hold
+ * at least map_get_num_elements(size) elements.
+ */
+void map_copy_elements(rct_map_element *dst, sint32 size)
+{
+	for (sint32 y = 0; y < size; y++) {
+		for (sint32 x = 0; x < size; x++) {
+			rct_map_element *firstElement = gMapElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+			rct_map_element *mapElement = firstElement;
 			while (!map_element_is_last_for_tile(mapElement++));
+
+			size_t numElements = (size_t)(mapElement - firstElement);
+			memcpy(dst, firstElement, numElements * sizeof(rct_map_element));
+			dst += numElements;
 		}
 	}
+}
+
+/**
+ * Replaces all elements of the map. The tiles of the given size square in the corner of the map are
+ * read from elements, laid out as by map_copy_elements, the remaining tiles get a blank surface.
+ */
+void map_set_elements(const rct_map_element *elements, sint32 size)
+{
+	static const rct_map_element BlankSurfaceElement = {
+		.type = MAP_ELEMENT_TYPE_SURFACE,
+		.flags = MAP_ELEMENT_FLAG_LAST_TILE,
+		.base_height = 2,
+		.clearance_height = 0,
+	};
+
+	map_element_pool_reset();
+	tile_summary_invalidate();
+	tile_summary_invalidate_rides();
+	footpath_graph_invalidate();
+	paint_cache_invalidate();
+
+	const rct_map_element *src = elements;
+	for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+		for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+			const rct_map_element *firstElement = &BlankSurfaceElement;
+			size_t numElements = 1;
+			if (x < size && y < size) {
+				firstElement = src;
+				while (!map_element_is_last_for_tile(src++));
+				numElements = (size_t)(src - firstElement);
+			}
 
-	gNextFreeMapElement = mapElement;
+			if ((size_t)(_mapElementChunkEnd - gNextFreeMapElement) < numElements && !map_element_pool_add_chunk(numElements)) {
+				log_fatal("Unable to allocate memory for map elements.");
+				return;
+			}
+
+			sint32 tileIndex = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+			memcpy(gNextFreeMapElement, firstElement, numElements * sizeof(rct_map_element));
+			gMapElementTilePointers[tileIndex] = gNextFreeMapElement;
+			_mapElementTileCapacity[tileIndex] = (uint32)numElements;
+			gNextFreeMapElement += numElements;
+		}
+	}
+}
+
+/**
+ * Gets the number of elements the element pool can currently hold without allocating.
+ */
+size_t map_get_element_pool_capacity()
+{
+	return _mapElementPoolCapacity;
 }
 
 /**
@@ -466,7 +562,7 @@ sint32 map_element_height(sint32 x, sint32 y)
 	rct_map_element *mapElement;
 
 	// Off the map
-	if ((unsigned)x >= 8192 || (unsigned)y >= 8192)
+	if ((unsigned)x >= MAXIMUM_MAP_SIZE_BIG || (unsigned)y >= MAXIMUM_MAP_SIZE_BIG)
 		return 16;
 
 	// Truncate subtile coordinates
@@ -596,55 +692,6 @@ sint32 map_element_height(sint32 x, sint32 y)
 	return height;
 }
 
-/**
- *
- *  rct2: 0x0068B089
- */
-void sub_68B089()
-{
-	sint32 i;
-	rct_map_element *mapElementFirst, *mapElement;
-
-	if (gTrackDesignSaveMode)
-		return;
-
-	i = gNextFreeMapElementPointerIndex;
-	do {
-		i++;
-		if (i >= MAX_TILE_MAP_ELEMENT_POINTERS)
-			i = 0;
-	} while (gMapElementTilePointers[i] == TILE_UNDEFINED_MAP_ELEMENT);
-	gNextFreeMapElementPointerIndex = i;
-
-	mapElementFirst = mapElement = gMapElementTilePointers[i];
-	do {
-		mapElement--;
-		if (mapElement < gMapElements)
-			break;
-	} while (mapElement->base_height == 255);
-	mapElement++;
-
-	if (mapElement == mapElementFirst)
-		return;
-
-	//
-	gMapElementTilePointers[i] = mapElement;
-	do {
-		*mapElement = *mapElementFirst;
-		mapElementFirst->base_height = 255;
-
-		mapElementFirst++;
-	} while (!map_element_is_last_for_tile(mapElement++));
-
-	mapElement = gNextFreeMapElement;
-	do {
-		mapElement--;
-	} while (mapElement->base_height == 255);
-	mapElement++;
-	gNextFreeMapElement = mapElement;
-}
-
-
 /**
  * Checks if the tile at coordinate at height counts as connected.
  * @return 1 if connected, 0 otherwise
@@ -689,18 +736,21 @@ void map_update_path_wide_flags()
 
 	// Presumably update_path_wide_flags is too computationally expensive to call for every
 	// tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
-	// progress. A maximum of 128 calls is done per update.
+	// progress. 128 calls are done per update for each 256x256 tiles of the loop.
+	sint32 loopSize = map_get_tile_loop_size();
+	sint32 loopSizeBig = loopSize * 32;
+	sint32 numTiles = 128 * (loopSize / RCT2_MAXIMUM_MAP_SIZE_TECHNICAL) * (loopSize / RCT2_MAXIMUM_MAP_SIZE_TECHNICAL);
 	uint16 x = gWidePathTileLoopX;
 	uint16 y = gWidePathTileLoopY;
-	for (sint32 i = 0; i < 128; i++) {
+	for (sint32 i = 0; i < numTiles; i++) {
 		footpath_update_path_wide_flags(x, y);
 
 		// Next x, y tile
 		x += 32;
-		if (x >= 8192) {
+		if (x >= loopSizeBig) {
 			x = 0;
 			y += 32;
-			if (y >= 8192) {
+			if (y >= loopSizeBig) {
 				y = 0;
 			}
 		}
@@ -709,6 +759,20 @@ void map_update_path_wide_flags()
 	gWidePathTileLoopY = y;
 }
 
+/**
+ * Gets the size of the square covered by the per tick tile loops. This is the smallest power of two
+ * that covers the map, but never less than the 256 tiles RCT2 loops over, so that each tile is
+ * visited as often as it would be in RCT2.
+ */
+static sint32 map_get_tile_loop_size()
+{
+	sint32 loopSize = RCT2_MAXIMUM_MAP_SIZE_TECHNICAL;
+	while (loopSize < gMapSize && loopSize < MAXIMUM_MAP_SIZE_TECHNICAL) {
+		loopSize *= 2;
+	}
+	return loopSize;
+}
+
 /**
  *
  *  rct2: 0x006A7B84
@@ -733,7 +797,7 @@ sint32 map_height_from_slope(sint32 x, sint32 y, sint32 slope)
 
 bool map_is_location_valid(sint32 x, sint32 y)
 {
-	if (x < (256 * 32) && x >= 0 && y < (256 * 32) && y >= 0) {
+	if (x < MAXIMUM_MAP_SIZE_BIG && x >= 0 && y < MAXIMUM_MAP_SIZE_BIG && y >= 0) {
 		return true;
 	}
 	return false;
@@ -879,7 +943,7 @@ void game_command_remove_scenery(sint32* eax, sint32* ebx, sint32* ecx, sint32*
 		}
 
 		map_invalidate_tile_full(x, y);
-		map_element_remove(map_element);
+		map_element_remove(x / 32, y / 32, map_element);
 	}
 	*ebx = (gParkFlags & PARK_FLAGS_NO_MONEY) ? 0 : cost;
 }
@@ -1011,7 +1075,7 @@ void game_command_remove_large_scenery(sint32* eax, sint32* ebx, sint32* ecx, si
 				continue;
 
 			map_invalidate_tile_full(currentTile.x, currentTile.y);
-			map_element_remove(sceneryElement);
+			map_element_remove(currentTile.x / 32, currentTile.y / 32, sceneryElement);
 			element_found = true;
 			break;
 		} while (!map_element_is_last_for_tile(sceneryElement++));
@@ -1087,7 +1151,7 @@ void game_command_remove_banner(sint32* eax, sint32* ebx, sint32* ecx, sint32* e
 
 		map_element_remove_banner_entry(map_element);
 		map_invalidate_tile_zoom1(x, y, z, z + 32);
-		map_element_remove(map_element);
+		map_element_remove(x / 32, y / 32, map_element);
 	}
 
 	*ebx = (scenery_entry->banner.price * -3) / 4;
@@ -1447,8 +1511,8 @@ restart_from_beginning:
 static void map_reset_clear_large_scenery_flag(){
 	rct_map_element* mapElement;
 	// TODO: Improve efficiency of this
-	for (sint32 y = 0; y <= 255; y++) {
-		for (sint32 x = 0; x <= 255; x++) {
+	for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+		for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
 			mapElement = map_get_first_element_at(x, y);
 			do {
 				if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_SCENERY_MULTIPLE) {
@@ -1567,8 +1631,8 @@ static money32 map_change_surface_style(sint32 x0, sint32 y0, sint32 x1, sint32
 	money32 edgeCost = 0;
 	for (sint32 x = x0; x <= x1; x += 32) {
 		for (sint32 y = y0; y <= y1; y += 32) {
-			if (x > 0x1FFF) continue;
-			if (y > 0x1FFF) continue;
+			if (x >= MAXIMUM_MAP_SIZE_BIG) continue;
+			if (y >= MAXIMUM_MAP_SIZE_BIG) continue;
 
 			if (!(gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) && !gCheatsSandboxMode) {
 				if (!map_is_location_in_park(x, y)) continue;
@@ -1773,7 +1837,7 @@ static money32 map_set_land_height(sint32 flags, sint32 x, sint32 y, sint32 heig
 			}
 			cost += MONEY(sceneryEntry->small_scenery.removal_price, 0);
 			if (flags & GAME_COMMAND_FLAG_APPLY)
-				map_element_remove(mapElement--);
+				map_element_remove(x / 32, y / 32, mapElement--);
 		} while (!map_element_is_last_for_tile(mapElement++));
 	}
 
@@ -2391,8 +2455,8 @@ static money32 smooth_land(sint32 flags, sint32 centreX, sint32 centreY, sint32
 	// Cap bounds to map
 	mapLeft = max(mapLeft, 32);
 	mapTop = max(mapTop, 32);
-	mapRight = clamp(0, mapRight, 255 * 32);
-	mapBottom = clamp(0, mapBottom, 255 * 32);
+	mapRight = clamp(0, mapRight, (MAXIMUM_MAP_SIZE_TECHNICAL - 1) * 32);
+	mapBottom = clamp(0, mapBottom, (MAXIMUM_MAP_SIZE_TECHNICAL - 1) * 32);
 
 	sint32 commandType;
 	sint32 centreZ = map_element_height(centreX, centreY);
@@ -2449,7 +2513,7 @@ static money32 smooth_land(sint32 flags, sint32 centreX, sint32 centreY, sint32
 
 	// Then do the smoothing
 	// The coords go in circles around the selected tile(s)
-	for (; size <= 256; size += 2) {
+	for (; size <= MAXIMUM_MAP_SIZE_TECHNICAL; size += 2) {
 		initialMinZ += 2;
 		sint32 minZ = initialMinZ * 2;
 		x -= 32;
@@ -2808,7 +2872,7 @@ void game_command_remove_fence(sint32* eax, sint32* ebx, sint32* ecx, sint32* ed
 
 	map_element_remove_banner_entry(map_element);
 	map_invalidate_tile_zoom1(x, y, map_element->base_height * 8, (map_element->base_height * 8) + 72);
-	map_element_remove(map_element);
+	map_element_remove(x / 32, y / 32, map_element);
 	*ebx = 0;
 }
 
@@ -2834,12 +2898,12 @@ void game_command_place_banner(sint32* eax, sint32* ebx, sint32* ecx, sint32* ed
 		return;
 	}
 
-	if (!map_check_free_elements_and_reorganise(1)) {
+	if (!map_check_free_elements(1)) {
 		*ebx = MONEY32_UNDEFINED;
 		return;
 	}
 
-	if (x >= 8192 || y >= 8192) {
+	if (x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG) {
 		*ebx = MONEY32_UNDEFINED;
 		return;
 	}
@@ -2922,6 +2986,7 @@ void game_command_place_banner(sint32* eax, sint32* ebx, sint32* ecx, sint32* ed
 		if(*ebx & GAME_COMMAND_FLAG_GHOST){
 			new_map_element->flags |= MAP_ELEMENT_FLAG_GHOST;
 		}
+		footpath_graph_invalidate_element(x / 32, y / 32, new_map_element);
 		map_invalidate_tile_full(x, y);
 		map_animation_create(0x0A, x, y, new_map_element->base_height);
 	}
@@ -2961,7 +3026,7 @@ static sint32 map_place_scenery_clear_func(rct_map_element** map_element, sint32
 
 	map_invalidate_tile(x, y, (*map_element)->base_height * 8, (*map_element)->clearance_height * 8);
 
-	map_element_remove(*map_element);
+	map_element_remove(x / 32, y / 32, *map_element);
 
 	(*map_element)--;
 	return 0;
@@ -2993,7 +3058,7 @@ sint32 map_place_non_scenery_clear_func(rct_map_element** map_element, sint32 x,
 
 	map_invalidate_tile(x, y, (*map_element)->base_height * 8, (*map_element)->clearance_height * 8);
 
-	map_element_remove(*map_element);
+	map_element_remove(x / 32, y / 32, *map_element);
 
 	(*map_element)--;
 	return 0;
@@ -3042,7 +3107,7 @@ void game_command_place_scenery(sint32* eax, sint32* ebx, sint32* ecx, sint32* e
 		return;
 	}
 
-	if (!map_check_free_elements_and_reorganise(1)) {
+	if (!map_check_free_elements(1)) {
 		*ebx = MONEY32_UNDEFINED;
 		return;
 	}
@@ -3232,7 +3297,7 @@ void game_command_place_scenery(sint32* eax, sint32* ebx, sint32* ecx, sint32* e
 
 static bool map_is_location_at_edge(sint32 x, sint32 y)
 {
-	return x < 32 || y < 32 || x >= ((256 - 1) * 32) || y >= ((256 - 1) * 32);
+	return x < 32 || y < 32 || x >= ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) * 32) || y >= ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) * 32);
 }
 
 /**
@@ -3641,7 +3706,7 @@ void game_command_place_fence(sint32* eax, sint32* ebx, sint32* ecx, sint32* edx
 		}
 	}
 
-	if (!map_check_free_elements_and_reorganise(1)){
+	if (!map_check_free_elements(1)){
 		*ebx = MONEY32_UNDEFINED;
 		return;
 	}
@@ -3795,7 +3860,7 @@ void game_command_place_large_scenery(sint32* eax, sint32* ebx, sint32* ecx, sin
 		curTile.x += x;
 		curTile.y += y;
 		
-		if(curTile.x >= 0x1FFF || curTile.y >= 0x1FFF || curTile.x < 0 || curTile.y < 0){
+		if(curTile.x >= MAXIMUM_MAP_SIZE_BIG - 1 || curTile.y >= MAXIMUM_MAP_SIZE_BIG - 1 || curTile.x < 0 || curTile.y < 0){
 			continue;
 		}
 
@@ -3820,7 +3885,7 @@ void game_command_place_large_scenery(sint32* eax, sint32* ebx, sint32* ecx, sin
 		maxHeight = z;
 	}
 	
-	if (!map_check_free_elements_and_reorganise(num_elements)) {
+	if (!map_check_free_elements(num_elements)) {
 		*ebx = MONEY32_UNDEFINED;
 		return;
 	}
@@ -3948,9 +4013,18 @@ sint32 map_get_station(rct_map_element *mapElement)
 /**
  *
  *  rct2: 0x0068B280
+ * @param x The tile x of the element.
+ * @param y The tile y of the element.
  */
-void map_element_remove(rct_map_element *mapElement)
+void map_element_remove(sint32 x, sint32 y, rct_map_element *mapElement)
 {
+	footpath_graph_invalidate_element(x, y, mapElement);
+
+	// Ghost track is left out of the ride cells, so only removing real track changes them
+	if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_TRACK && !(mapElement->flags & MAP_ELEMENT_FLAG_GHOST)) {
+		tile_summary_invalidate_rides_at(x, y);
+	}
+
 	// Replace Nth element by (N+1)th element.
 	// This loop will make mapElement point to the old last element position,
 	// after copy it to it's new position
@@ -3961,12 +4035,11 @@ void map_element_remove(rct_map_element *mapElement)
 	}
 
 	// Mark the latest element with the last element flag.
+	// The freed slot stays part of the tile's block for later inserts.
 	(mapElement - 1)->flags |= MAP_ELEMENT_FLAG_LAST_TILE;
 	mapElement->base_height = 0xFF;
-
-	if ((mapElement + 1) == gNextFreeMapElement){
-		gNextFreeMapElement--;
-	}
+	tile_summary_invalidate_at(x, y);
+	paint_cache_invalidate_tile(x, y);
 }
 
 /**
@@ -3994,7 +4067,7 @@ void map_remove_all_rides()
 		case MAP_ELEMENT_TYPE_TRACK:
 			footpath_queue_chain_reset();
 			footpath_remove_edges_at(it.x * 32, it.y * 32, it.element);
-			map_element_remove(it.element);
+			map_element_remove(it.x, it.y, it.element);
 			map_element_iterator_restart_for_tile(&it);
 			break;
 		}
@@ -4079,70 +4152,152 @@ void map_invalidate_selection_rect()
 	}
 }
 
+static void map_element_pool_reset()
+{
+	for (sint32 i = 0; i < _mapElementNumChunks; i++) {
+		free(_mapElementChunks[i]);
+		_mapElementChunks[i] = NULL;
+	}
+	_mapElementNumChunks = 0;
+
+	for (sint32 i = 0; i < MAP_ELEMENT_BLOCK_CLASSES; i++) {
+		_mapElementFreeLists[i].count = 0;
+	}
+
+	gNextFreeMapElement = gMapElements;
+	_mapElementChunkEnd = gMapElements + MAP_ELEMENT_BASE_POOL_SIZE;
+	_mapElementPoolCapacity = MAP_ELEMENT_BASE_POOL_SIZE;
+}
+
+static void map_element_free_list_push(sint32 blockClass, rct_map_element *block)
+{
+	map_element_free_list *freeList = &_mapElementFreeLists[blockClass];
+	if (freeList->count == freeList->capacity) {
+		uint32 newCapacity = max(64, freeList->capacity * 2);
+		rct_map_element **newBlocks = realloc(freeList->blocks, newCapacity * sizeof(rct_map_element*));
+		if (newBlocks == NULL) {
+			// The block is lost until the pool is next reset
+			log_error("Unable to allocate memory for map element free list.");
+			return;
+		}
+		freeList->blocks = newBlocks;
+		freeList->capacity = newCapacity;
+	}
+	freeList->blocks[freeList->count++] = block;
+}
+
 /**
- *
- *  rct2: 0x0068B111
+ * Returns a run of elements to the pool, split into blocks that are a power of two in size.
  */
-void map_reorganise_elements()
+static void map_element_pool_free(rct_map_element *elements, size_t numElements)
 {
-	platform_set_cursor(CURSOR_ZZZ);
+	for (size_t i = 0; i < numElements; i++) {
+		elements[i].base_height = 255;
+	}
 
-	rct_map_element* new_map_elements = malloc(0x30000 * sizeof(rct_map_element));
-	rct_map_element* new_elements_pointer = new_map_elements;
+	for (sint32 blockClass = MAP_ELEMENT_BLOCK_CLASSES - 1; blockClass >= 0; blockClass--) {
+		size_t blockSize = (size_t)1 << blockClass;
+		while (numElements >= blockSize) {
+			map_element_free_list_push(blockClass, elements);
+			elements += blockSize;
+			numElements -= blockSize;
+		}
+	}
+}
 
-	if (new_map_elements == NULL) {
-		log_fatal("Unable to allocate memory for map elements.");
-		return;
+/**
+ * Starts a new chunk of the pool, what is left of the current chunk is returned to the free lists.
+ */
+static bool map_element_pool_add_chunk(size_t minSize)
+{
+	if (_mapElementNumChunks >= MAX_MAP_ELEMENT_CHUNKS) {
+		return false;
 	}
 
-	uint32 num_elements;
+	size_t chunkSize = max((size_t)MAP_ELEMENT_CHUNK_SIZE, minSize);
+	rct_map_element *chunk = malloc(chunkSize * sizeof(rct_map_element));
+	if (chunk == NULL) {
+		log_error("Unable to allocate memory for map elements.");
+		return false;
+	}
+
+	map_element_pool_free(gNextFreeMapElement, (size_t)(_mapElementChunkEnd - gNextFreeMapElement));
+
+	_mapElementChunks[_mapElementNumChunks++] = chunk;
+	_mapElementPoolCapacity += chunkSize;
+	gNextFreeMapElement = chunk;
+	_mapElementChunkEnd = chunk + chunkSize;
+	return true;
+}
 
-	for (sint32 y = 0; y < 256; y++) {
-		for (sint32 x = 0; x < 256; x++) {
-			rct_map_element *startElement = map_get_first_element_at(x, y);
-			rct_map_element *endElement = startElement;
-			while (!map_element_is_last_for_tile(endElement++));
+/**
+ * Allocates a block of (1 << blockClass) elements, taking it from the free lists first, then the end of
+ * the current chunk, then by splitting a larger free block and lastly from a new chunk.
+ */
+static rct_map_element *map_element_pool_allocate(sint32 blockClass)
+{
+	size_t blockSize = (size_t)1 << blockClass;
+	map_element_free_list *freeList = &_mapElementFreeLists[blockClass];
+	if (freeList->count != 0) {
+		return freeList->blocks[--freeList->count];
+	}
+
+	if ((size_t)(_mapElementChunkEnd - gNextFreeMapElement) < blockSize) {
+		for (sint32 largerClass = blockClass + 1; largerClass < MAP_ELEMENT_BLOCK_CLASSES; largerClass++) {
+			freeList = &_mapElementFreeLists[largerClass];
+			if (freeList->count != 0) {
+				rct_map_element *block = freeList->blocks[--freeList->count];
+				map_element_pool_free(block + blockSize, ((size_t)1 << largerClass) - blockSize);
+				return block;
+			}
+		}
 
-			num_elements = (uint32)(endElement - startElement);
-			memcpy(new_elements_pointer, startElement, num_elements * sizeof(rct_map_element));
-			new_elements_pointer += num_elements;
+		if (!map_element_pool_add_chunk(blockSize)) {
+			return NULL;
 		}
 	}
 
-	num_elements = (uint32)(new_elements_pointer - new_map_elements);
-	memcpy(gMapElements, new_map_elements, num_elements * sizeof(rct_map_element));
-	memset(gMapElements + num_elements, 0, (0x30000 - num_elements) * sizeof(rct_map_element));
+	rct_map_element *block = gNextFreeMapElement;
+	gNextFreeMapElement += blockSize;
+	return block;
+}
 
-	free(new_map_elements);
+/**
+ * Packs the elements of all tiles into a single run in row order, releasing any chunks the pool has grown.
+ *  rct2: 0x0068B111
+ */
+void map_reorganise_elements()
+{
+	platform_set_cursor(CURSOR_ZZZ);
 
-	map_update_tile_pointers();
+	size_t numElements = map_get_num_elements(MAXIMUM_MAP_SIZE_TECHNICAL);
+	rct_map_element* new_map_elements = malloc(numElements * sizeof(rct_map_element));
+	if (new_map_elements == NULL) {
+		log_fatal("Unable to allocate memory for map elements.");
+		return;
+	}
+
+	map_copy_elements(new_map_elements, MAXIMUM_MAP_SIZE_TECHNICAL);
+	map_set_elements(new_map_elements, MAXIMUM_MAP_SIZE_TECHNICAL);
+	free(new_map_elements);
 }
 
 /**
  *
  *  rct2: 0x0068B044
  *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
  */
-bool map_check_free_elements_and_reorganise(sint32 num_elements)
+bool map_check_free_elements(sint32 num_elements)
 {
-	if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
-		return true;
-
-	for (sint32 i = 1000; i != 0; --i)
-		sub_68B089();
-
-	if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
+	size_t numFreeElements =
+		(size_t)(_mapElementChunkEnd - gNextFreeMapElement) +
+		(size_t)(MAX_MAP_ELEMENT_CHUNKS - _mapElementNumChunks) * MAP_ELEMENT_CHUNK_SIZE;
+	if ((size_t)num_elements <= numFreeElements) {
 		return true;
-
-	map_reorganise_elements();
-
-	if ((gNextFreeMapElement + num_elements) <= gMapElements + MAX_MAP_ELEMENTS)
-		return true;
-	else{
-		gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-		return false;
 	}
+
+	gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+	return false;
 }
 
 /**
@@ -4151,55 +4306,69 @@ bool map_check_free_elements_and_reorganise(sint32 num_elements)
  */
 rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
 {
-	rct_map_element *originalMapElement, *newMapElement, *insertedElement;
-
-	if (!map_check_free_elements_and_reorganise(1)) {
-		log_error("Cannot insert new element");
-		return NULL;
-	}
+	sint32 tileIndex = y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+	rct_map_element *firstElement = gMapElementTilePointers[tileIndex];
+	tile_summary_invalidate_at(x, y);
+	tile_summary_invalidate_rides_at(x, y);
+	// The element has no type yet, so only the indices of the elements above it change here. Callers adding
+	// elements that are part of the footpath graph mark it with footpath_graph_invalidate_element.
+	footpath_graph_invalidate_tile_nodes(x, y);
+	paint_cache_invalidate_tile(x, y);
+
+	// Find where the element goes, above all elements at or below the insert height
+	uint32 numElements = 0;
+	uint32 insertIndex = 0;
+	rct_map_element *mapElement = firstElement;
+	do {
+		numElements++;
+		if (z >= mapElement->base_height && insertIndex == numElements - 1) {
+			insertIndex = numElements;
+		}
+	} while (!map_element_is_last_for_tile(mapElement++));
 
-	newMapElement = gNextFreeMapElement;
-	originalMapElement = gMapElementTilePointers[y * 256 + x];
+	// Move the tile to a larger block if its current one is full
+	if (numElements >= _mapElementTileCapacity[tileIndex]) {
+		sint32 blockClass = 0;
+		while (((uint32)1 << blockClass) < numElements + 1) {
+			blockClass++;
+		}
 
-	// Set tile index pointer to point to new element block
-	gMapElementTilePointers[y * 256 + x] = newMapElement;
+		rct_map_element *block = NULL;
+		if (blockClass < MAP_ELEMENT_BLOCK_CLASSES) {
+			block = map_element_pool_allocate(blockClass);
+		}
+		if (block == NULL) {
+			log_error("Cannot insert new element");
+			gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+			return NULL;
+		}
 
-	// Copy all elements that are below the insert height
-	while (z >= originalMapElement->base_height) {
-		// Copy over map element
-		*newMapElement = *originalMapElement;
-		originalMapElement->base_height = 255;
-		originalMapElement++;
-		newMapElement++;
+		memcpy(block, firstElement, numElements * sizeof(rct_map_element));
+		map_element_pool_free(firstElement, _mapElementTileCapacity[tileIndex]);
 
-		if ((newMapElement - 1)->flags & MAP_ELEMENT_FLAG_LAST_TILE) {
-			// No more elements above the insert element
-			(newMapElement - 1)->flags &= ~MAP_ELEMENT_FLAG_LAST_TILE;
-			flags |= MAP_ELEMENT_FLAG_LAST_TILE;
-			break;
-		}
+		firstElement = block;
+		gMapElementTilePointers[tileIndex] = block;
+		_mapElementTileCapacity[tileIndex] = (uint32)1 << blockClass;
 	}
 
-	// Insert new map element
-	insertedElement = newMapElement;
-	newMapElement->base_height = z;
-	newMapElement->flags = flags;
-	newMapElement->clearance_height = z;
-	memset(&newMapElement->properties, 0, sizeof(newMapElement->properties));
-	newMapElement++;
-
-	// Insert rest of map elements above insert height
-	if (!(flags & MAP_ELEMENT_FLAG_LAST_TILE)) {
-		do {
-			// Copy over map element
-			*newMapElement = *originalMapElement;
-			originalMapElement->base_height = 255;
-			originalMapElement++;
-			newMapElement++;
-		} while (!((newMapElement - 1)->flags & MAP_ELEMENT_FLAG_LAST_TILE));
+	// Make room for the new element
+	memmove(
+		firstElement + insertIndex + 1,
+		firstElement + insertIndex,
+		(numElements - insertIndex) * sizeof(rct_map_element)
+	);
+	if (insertIndex == numElements) {
+		// No more elements above the insert element
+		firstElement[insertIndex - 1].flags &= ~MAP_ELEMENT_FLAG_LAST_TILE;
+		flags |= MAP_ELEMENT_FLAG_LAST_TILE;
 	}
 
-	gNextFreeMapElement = newMapElement;
+	// Insert new map element
+	rct_map_element *insertedElement = &firstElement[insertIndex];
+	insertedElement->base_height = z;
+	insertedElement->flags = flags;
+	insertedElement->clearance_height = z;
+	memset(&insertedElement->properties, 0, sizeof(insertedElement->properties));
 	return insertedElement;
 }
 
@@ -4398,7 +4567,7 @@ void map_remove_intersecting_walls(sint32 x, sint32 y, sint32 z0, sint32 z1, sin
 
 		map_element_remove_banner_entry(mapElement);
 		map_invalidate_tile_zoom1(x, y, mapElement->base_height * 8, mapElement->base_height * 8 + 72);
-		map_element_remove(mapElement);
+		map_element_remove(x >> 5, y >> 5, mapElement);
 		mapElement--;
 	} while (!map_element_is_last_for_tile(mapElement++));
 }
@@ -4414,13 +4583,20 @@ void map_update_tiles()
 	if (gScreenFlags & ignoreScreenFlags)
 		return;
 
-	// Update 43 more tiles
-	for (sint32 j = 0; j < 43; j++) {
+	// The tiles are visited in an interleaved (Morton) order, 43 more tiles for each 256x256 tiles of the loop
+	sint32 loopSize = map_get_tile_loop_size();
+	sint32 numBits = 0;
+	while ((1 << numBits) < loopSize) {
+		numBits++;
+	}
+	sint32 numTiles = 43 * (loopSize / RCT2_MAXIMUM_MAP_SIZE_TECHNICAL) * (loopSize / RCT2_MAXIMUM_MAP_SIZE_TECHNICAL);
+
+	for (sint32 j = 0; j < numTiles; j++) {
 		sint32 x = 0;
 		sint32 y = 0;
 
-		uint16 interleaved_xy = gGrassSceneryTileLoopPosition;
-		for (sint32 i = 0; i < 8; i++) {
+		uint32 interleaved_xy = gGrassSceneryTileLoopPosition;
+		for (sint32 i = 0; i < numBits; i++) {
 			x = (x << 1) | (interleaved_xy & 1);
 			interleaved_xy >>= 1;
 			y = (y << 1) | (interleaved_xy & 1);
@@ -4434,7 +4610,7 @@ void map_update_tiles()
 		}
 
 		gGrassSceneryTileLoopPosition++;
-		gGrassSceneryTileLoopPosition &= 0xFFFF;
+		gGrassSceneryTileLoopPosition &= ((uint32)1 << (numBits * 2)) - 1;
 	}
 }
 
@@ -4597,8 +4773,8 @@ void map_remove_out_of_range_elements()
 {
 	sint32 mapMaxXY = gMapSizeMaxXY;
 
-	for (sint32 y = 0; y < (256 * 32); y += 32) {
-		for (sint32 x = 0; x < (256 * 32); x += 32) {
+	for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_BIG; y += 32) {
+		for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_BIG; x += 32) {
 			if (x == 0 || y == 0 || x >= mapMaxXY || y >= mapMaxXY) {
 				map_buy_land_rights(x, y, x, y, 1, GAME_COMMAND_FLAG_APPLY);
 				clear_elements_at(x, y);
@@ -4617,7 +4793,7 @@ void map_extend_boundary_surface()
 	sint32 x, y, z, slope;
 
 	y = gMapSize - 2;
-	for (x = 0; x < 256; x++) {
+	for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
 		existingMapElement = map_get_surface_element_at(x, y - 1);
 		newMapElement = map_get_surface_element_at(x, y);
 
@@ -4653,7 +4829,7 @@ void map_extend_boundary_surface()
 	}
 
 	x = gMapSize - 2;
-	for (y = 0; y < 256; y++) {
+	for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
 		existingMapElement = map_get_surface_element_at(x - 1, y);
 		newMapElement = map_get_surface_element_at(x, y);
 
@@ -4748,7 +4924,7 @@ static void clear_element_at(sint32 x, sint32 y, rct_map_element **elementPtr)
 		);
 		break;
 	default:
-		map_element_remove(element);
+		map_element_remove(x >> 5, y >> 5, element);
 		break;
 	}
 }
@@ -4978,7 +5154,7 @@ repeat:
 
 		map_element_remove_banner_entry(mapElement);
 		map_invalidate_tile_zoom1(x, y, mapElement->base_height * 8, mapElement->base_height * 8 + 72);
-		map_element_remove(mapElement);
+		map_element_remove(x >> 5, y >> 5, mapElement);
 		goto repeat;
 	} while (!map_element_is_last_for_tile(mapElement++));
 }
@@ -5048,6 +5224,9 @@ rct_xy32 translate_3d_to_2d_with_z(sint32 rotation, rct_xyz32 pos)
 
 static void map_invalidate_tile_under_zoom(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 maxZoom)
 {
+	// Anything that changes how a tile looks invalidates it
+	paint_cache_invalidate_tile(x >> 5, y >> 5);
+
 	if (gOpenRCT2Headless) return;
 
 	sint32 x1, y1, x2, y2;
@@ -5134,7 +5313,7 @@ sint32 map_get_tile_quadrant(sint32 mapX, sint32 mapY)
  */
 bool map_surface_is_blocked(sint16 x, sint16 y){
 	rct_map_element *mapElement;
-	if (x >= 8192 || y >= 8192)
+	if (x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG)
 		return true;
 
 	mapElement = map_get_surface_element_at(x / 32, y / 32);
@@ -5177,8 +5356,8 @@ bool map_surface_is_blocked(sint16 x, sint16 y){
 /* Clears all map elements, to be used before generating a new map */
 void map_clear_all_elements()
 {
-	for (sint32 y = 0; y < (256 * 32); y += 32) {
-		for (sint32 x = 0; x < (256 * 32); x += 32) {
+	for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_BIG; y += 32) {
+		for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_BIG; x += 32) {
 			clear_elements_at(x, y);
 		}
 	}
@@ -5196,7 +5375,7 @@ static money32 place_park_entrance(sint32 flags, sint16 x, sint16 y, sint16 z, u
 	// ??
 	gCommandPosition.z = (z & 0xFF) << 4;
 
-	if (!map_check_free_elements_and_reorganise(3)) {
+	if (!map_check_free_elements(3)) {
 		return MONEY32_UNDEFINED;
 	}
 
@@ -5270,6 +5449,7 @@ static money32 place_park_entrance(sint32 flags, sint16 x, sint16 y, sint16 z, u
 		newElement->properties.entrance.index = index;
 		newElement->properties.entrance.type = ENTRANCE_TYPE_PARK_ENTRANCE;
 		newElement->properties.entrance.path_type = gFootpathSelectedId & 0xFF;
+		footpath_graph_invalidate_element(x / 32, y / 32, newElement);
 
 		if (!(flags & GAME_COMMAND_FLAG_GHOST)) {
 			footpath_connect_edges(x, y, newElement, 1);
@@ -5474,6 +5654,7 @@ void game_command_set_banner_style(sint32* eax, sint32* ebx, sint32* ecx, sint32
 	if (banner->flags & BANNER_FLAG_NO_ENTRY){
 		map_element->properties.banner.flags &= ~(1 << map_element->properties.banner.position);
 	}
+	footpath_graph_invalidate_tile(x / 32, y / 32);
 
 	sint32 colourCodepoint = FORMAT_COLOUR_CODE_START + banner->text_colour;
 
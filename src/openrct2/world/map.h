@@ -236,8 +236,26 @@ enum {
 #define MAP_MINIMUM_X_Y -256
 #define MAP_LOCATION_NULL ((sint16)(uint16)0x8000)
 
+// The size in tiles of the largest map the map storage can hold, the element pool and
+// tile loops follow this but saved games are always RCT2 sized.
+#ifndef MAXIMUM_MAP_SIZE_TECHNICAL
+#define MAXIMUM_MAP_SIZE_TECHNICAL 256
+#endif
+#define MINIMUM_MAP_SIZE_TECHNICAL 15
+#define MINIMUM_MAP_SIZE_PRACTICAL (MINIMUM_MAP_SIZE_TECHNICAL - 2)
+#define MAXIMUM_MAP_SIZE_PRACTICAL (MAXIMUM_MAP_SIZE_TECHNICAL - 2)
+#define MAXIMUM_MAP_SIZE_BIG (MAXIMUM_MAP_SIZE_TECHNICAL * 32)
+#define RCT2_MAXIMUM_MAP_SIZE_TECHNICAL 256
+
+#if !defined(NO_RCT2) && MAXIMUM_MAP_SIZE_TECHNICAL != RCT2_MAXIMUM_MAP_SIZE_TECHNICAL
+#error "The map size can only be changed when building without RCT2."
+#endif
+
+// The most elements that can be saved in an SV6 / SC6, the map itself is not limited to this
 #define MAX_MAP_ELEMENTS 196096
-#define MAX_TILE_MAP_ELEMENT_POINTERS (256 * 256)
+// Size of gMapElements, the first chunk of the element pool
+#define MAP_ELEMENT_BASE_POOL_SIZE 0x30000
+#define MAX_TILE_MAP_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 
 #define MAP_ELEMENT_LARGE_TYPE_MASK 0x3FF
 
@@ -334,7 +352,7 @@ extern const money32 TerrainPricing[];
 
 extern uint16 gWidePathTileLoopX;
 extern uint16 gWidePathTileLoopY;
-extern uint16 gGrassSceneryTileLoopPosition;
+extern uint32 gGrassSceneryTileLoopPosition;
 
 extern sint16 gMapSizeUnits;
 extern sint16 gMapSizeMinus2;
@@ -394,7 +412,10 @@ extern uint8 gUnk9E2E28;
 
 void map_init(sint32 size);
 void map_count_remaining_land_rights();
-void map_update_tile_pointers();
+size_t map_get_num_elements(sint32 size);
+void map_copy_elements(rct_map_element *dst, sint32 size);
+void map_set_elements(const rct_map_element *elements, sint32 size);
+size_t map_get_element_pool_capacity();
 rct_map_element *map_get_first_element_at(sint32 x, sint32 y);
 void map_set_tile_elements(sint32 x, sint32 y, rct_map_element *elements);
 sint32 map_element_is_last_for_tile(const rct_map_element *element);
@@ -413,7 +434,6 @@ rct_map_element *map_get_fence_element_at(sint32 x, sint32 y, sint32 z, sint32 d
 rct_map_element *map_get_small_scenery_element_at(sint32 x, sint32 y, sint32 z, sint32 type, uint8 quadrant);
 rct_map_element *map_get_park_entrance_element_at(sint32 x, sint32 y, sint32 z, bool ghost);
 sint32 map_element_height(sint32 x, sint32 y);
-void sub_68B089();
 sint32 map_coord_is_connected(sint32 x, sint32 y, sint32 z, uint8 faceDirection);
 void map_remove_provisional_elements();
 void map_restore_provisional_elements();
@@ -424,12 +444,12 @@ bool map_is_location_in_park(sint32 x, sint32 y);
 bool map_is_location_owned_or_has_rights(sint32 x, sint32 y);
 bool map_surface_is_blocked(sint16 x, sint16 y);
 sint32 map_get_station(rct_map_element *mapElement);
-void map_element_remove(rct_map_element *mapElement);
+void map_element_remove(sint32 x, sint32 y, rct_map_element *mapElement);
 void map_remove_all_rides();
 void map_invalidate_map_selection_tiles();
 void map_invalidate_selection_rect();
 void map_reorganise_elements();
-bool map_check_free_elements_and_reorganise(sint32 num_elements);
+bool map_check_free_elements(sint32 num_elements);
 rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags);
 
 typedef sint32 (CLEAR_FUNC)(rct_map_element** map_element, sint32 x, sint32 y, uint8 flags, money32* price);
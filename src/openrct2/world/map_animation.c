@@ -196,12 +196,9 @@ static bool map_animation_invalidate_small_scenery(sint32 x, sint32 y, sint32 ba
 				sint32 x2 = x - TileDirectionDelta[direction].x;
 				sint32 y2 = y - TileDirectionDelta[direction].y;
 
-				uint16 spriteIdx = sprite_get_first_in_quadrant(x2, y2);
-				for (; spriteIdx != SPRITE_INDEX_NULL; spriteIdx = sprite->unknown.next_in_quadrant) {
-					sprite = get_sprite(spriteIdx);
-					if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_PEEP * 2)
-						continue;
-
+				sprite_query query;
+				sprite_query_tile(&query, x2 >> 5, y2 >> 5, SPRITE_LIST_MASK(SPRITE_LIST_PEEP));
+				while ((sprite = sprite_query_next(&query)) != NULL) {
 					peep = &sprite->peep;
 					if (peep->state != PEEP_STATE_WALKING)
 						continue;
@@ -26,6 +26,7 @@
 #include "../management/news_item.h"
 #include "../management/research.h"
 #include "../peep/peep.h"
+#include "../peep/peep_needs.h"
 #include "../peep/staff.h"
 #include "../rct2.h"
 #include "../ride/ride.h"
@@ -221,7 +222,7 @@ sint32 calculate_park_rating()
 		FOR_ALL_GUESTS(spriteIndex, peep) {
 			if (peep->outside_of_park != 0)
 				continue;
-			if (peep->happiness > 128)
+			if (PEEP_NEED(peep, happiness) > 128)
 				num_happy_peeps++;
 			if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
 				num_lost_guests++;
@@ -815,7 +816,7 @@ static void park_remove_entrance_segment(sint32 x, sint32 y, sint32 z)
 		return;
 
 	map_invalidate_tile(x, y, mapElement->base_height * 8, mapElement->clearance_height * 8);
-	map_element_remove(mapElement);
+	map_element_remove(x / 32, y / 32, mapElement);
 	update_park_fences(x, y);
 }
 
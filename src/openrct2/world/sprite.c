@@ -22,9 +22,11 @@
 #include "../localisation/date.h"
 #include "../localisation/localisation.h"
 #include "../OpenRCT2.h"
+#include "../peep/peep_needs.h"
 #include "../scenario/scenario.h"
 #include "fountain.h"
 #include "sprite.h"
+#include "tile_summary.h"
 
 #ifdef NO_RCT2
 uint16 gSpriteListHead[6];
@@ -36,7 +38,24 @@ uint16 *gSpriteListCount = RCT2_ADDRESS(RCT2_ADDRESS_SPRITE_LISTS_COUNT, uint16)
 static rct_sprite *_spriteList = RCT2_ADDRESS(RCT2_ADDRESS_SPRITE_LIST, rct_sprite);
 #endif
 
-uint16 gSpriteSpatialIndex[0x10001];
+/**
+ * The sprites on a tile, kept densely so they can be walked without going through the sprites themselves. The
+ * order is kept when sprites are added, but removing a sprite moves the last sprite into its slot.
+ */
+typedef struct sprite_grid_cell {
+	uint16 *sprites;
+	uint16 count;
+	uint16 capacity;
+} sprite_grid_cell;
+
+// A cell for each tile in the order of the original spatial index, with one more for sprites without a location
+static sprite_grid_cell _spriteGrid[SPRITE_SPATIAL_INDEX_SIZE];
+// The cell and slot each sprite is in, so it can be removed without a search
+static uint32 _spriteGridCell[MAX_SPRITES];
+static uint16 _spriteGridSlot[MAX_SPRITES];
+
+#define SPRITE_GRID_CELL_NULL_LOCATION	(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
+#define SPRITE_GRID_CELL_NONE			0xFFFFFFFF
 
 static rct_xyz16 _spritelocations1[MAX_SPRITES];
 static rct_xyz16 _spritelocations2[MAX_SPRITES];
@@ -47,10 +66,197 @@ rct_sprite *get_sprite(size_t sprite_idx)
 	return &_spriteList[sprite_idx];
 }
 
-uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y)
+/**
+ * Gets the cell of the tile at the given position, the cells go along y first. Positions off the map wrap around
+ * onto it, which relies on MAXIMUM_MAP_SIZE_TECHNICAL being a power of two.
+ */
+static uint32 sprite_grid_get_cell_index(sint32 x, sint32 y)
+{
+	if (x == SPRITE_LOCATION_NULL) {
+		return SPRITE_GRID_CELL_NULL_LOCATION;
+	}
+	uint32 tileX = (x >> 5) & (MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+	uint32 tileY = (y >> 5) & (MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+	return tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY;
+}
+
+static void sprite_grid_insert(uint16 spriteIndex, uint32 cellIndex)
+{
+	sprite_grid_cell *cell = &_spriteGrid[cellIndex];
+	if (cell->count >= cell->capacity) {
+		uint16 newCapacity = max(cell->capacity * 2, 4);
+		uint16 *newSprites = realloc(cell->sprites, newCapacity * sizeof(uint16));
+		if (newSprites == NULL) {
+			// A sprite missing from the grid would never be found on its tile again
+			log_fatal("Unable to allocate memory for sprite spatial index.");
+			exit(-1);
+		}
+		cell->sprites = newSprites;
+		cell->capacity = newCapacity;
+	}
+	_spriteGridCell[spriteIndex] = cellIndex;
+	_spriteGridSlot[spriteIndex] = cell->count;
+	cell->sprites[cell->count++] = spriteIndex;
+}
+
+static void sprite_grid_remove(uint16 spriteIndex)
+{
+	uint32 cellIndex = _spriteGridCell[spriteIndex];
+	if (cellIndex == SPRITE_GRID_CELL_NONE) {
+		return;
+	}
+
+	sprite_grid_cell *cell = &_spriteGrid[cellIndex];
+	uint16 slot = _spriteGridSlot[spriteIndex];
+	uint16 lastSpriteIndex = cell->sprites[--cell->count];
+	cell->sprites[slot] = lastSpriteIndex;
+	_spriteGridSlot[lastSpriteIndex] = slot;
+	_spriteGridCell[spriteIndex] = SPRITE_GRID_CELL_NONE;
+}
+
+static void sprite_grid_clear()
+{
+	for (size_t i = 0; i < SPRITE_SPATIAL_INDEX_SIZE; i++) {
+		_spriteGrid[i].count = 0;
+	}
+	for (size_t i = 0; i < MAX_SPRITES; i++) {
+		_spriteGridCell[i] = SPRITE_GRID_CELL_NONE;
+	}
+}
+
+/**
+ * Gets the sprites on the tile, valid until a sprite is next moved, added or removed. Sprites added to the tile
+ * since it was last emptied come last, so walk it backwards to see the newest first.
+ *
+ * No sprite may be moved, added or removed while the array is walked. Removing a sprite moves the last sprite of
+ * its tile into the freed slot, so the walk could visit a sprite twice or miss one. Use sprite_query_tile to change
+ * the sprites that are visited.
+ */
+const uint16 *sprite_get_tile_sprites(sint32 tileX, sint32 tileY, size_t *outCount)
+{
+	if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL) {
+		*outCount = 0;
+		return NULL;
+	}
+	const sprite_grid_cell *cell = &_spriteGrid[sprite_grid_get_cell_index(tileX * 32, tileY * 32)];
+	*outCount = cell->count;
+	return cell->sprites;
+}
+
+static bool sprite_query_is_litter_only(const sprite_query *query)
 {
-	sint32 offset = ((x & 0x1FE0) << 3) | (y >> 5);
-	return gSpriteSpatialIndex[offset];
+	return query->list_mask == SPRITE_LIST_MASK(SPRITE_LIST_LITTER);
+}
+
+static void sprite_query_start_tile(sprite_query *query)
+{
+	// Litter has its own lists per tile, so other sprites on the tile need not be skipped
+	if (sprite_query_is_litter_only(query)) {
+		query->next_sprite_index = tile_summary_get_first_litter(query->tile_x, query->tile_y);
+		return;
+	}
+	query->cell_index = sprite_grid_get_cell_index(query->tile_x * 32, query->tile_y * 32);
+	query->cell_position = _spriteGrid[query->cell_index].count;
+}
+
+static bool sprite_query_tile_is_done(const sprite_query *query)
+{
+	if (sprite_query_is_litter_only(query)) {
+		return query->next_sprite_index == SPRITE_INDEX_NULL;
+	}
+	return query->cell_position <= 0;
+}
+
+/**
+ * Starts a query for the sprites in the given sprite lists that are within the rectangle, including its edges.
+ * @param listMask The lists to include, built from SPRITE_LIST_MASK.
+ */
+void sprite_query_rect(sprite_query *query, sint32 left, sint32 top, sint32 right, sint32 bottom, uint32 listMask)
+{
+	query->left = left;
+	query->top = top;
+	query->right = right;
+	query->bottom = bottom;
+	query->list_mask = listMask;
+	query->tile_left = max(left, 0) >> 5;
+	query->tile_top = max(top, 0) >> 5;
+	query->tile_right = min(right, MAXIMUM_MAP_SIZE_BIG - 1) >> 5;
+	query->tile_bottom = min(bottom, MAXIMUM_MAP_SIZE_BIG - 1) >> 5;
+	query->tile_x = query->tile_left;
+	query->tile_y = query->tile_top;
+	query->next_sprite_index = SPRITE_INDEX_NULL;
+	query->cell_index = 0;
+	query->cell_position = 0;
+
+	if (query->tile_left > query->tile_right || query->tile_top > query->tile_bottom) {
+		// Nothing on the map is covered
+		query->tile_x = query->tile_right + 1;
+		return;
+	}
+	sprite_query_start_tile(query);
+}
+
+/**
+ * Starts a query for the sprites in the given sprite lists that are no further than radius away from (x, y) on
+ * either axis.
+ */
+void sprite_query_radius(sprite_query *query, sint32 x, sint32 y, sint32 radius, uint32 listMask)
+{
+	sprite_query_rect(query, x - radius, y - radius, x + radius, y + radius, listMask);
+}
+
+/**
+ * Starts a query for the sprites in the given sprite lists that are on a single tile.
+ */
+void sprite_query_tile(sprite_query *query, sint32 tileX, sint32 tileY, uint32 listMask)
+{
+	sprite_query_rect(query, tileX * 32, tileY * 32, tileX * 32 + 31, tileY * 32 + 31, listMask);
+}
+
+/**
+ * Gets the next sprite of the query, or NULL once all the sprites have been visited. Only the returned sprite may
+ * be moved or removed while the query is in progress.
+ */
+rct_sprite *sprite_query_next(sprite_query *query)
+{
+	bool litterOnly = sprite_query_is_litter_only(query);
+	for (;;) {
+		while (sprite_query_tile_is_done(query)) {
+			if (query->tile_x > query->tile_right) {
+				return NULL;
+			}
+
+			// Tiles with the same x are next to each other in the spatial index
+			if (query->tile_y < query->tile_bottom) {
+				query->tile_y++;
+			} else {
+				query->tile_y = query->tile_top;
+				query->tile_x++;
+				if (query->tile_x > query->tile_right) {
+					return NULL;
+				}
+			}
+			sprite_query_start_tile(query);
+		}
+
+		rct_sprite *sprite;
+		if (litterOnly) {
+			uint16 spriteIndex = query->next_sprite_index;
+			sprite = get_sprite(spriteIndex);
+			query->next_sprite_index = tile_summary_get_next_litter(spriteIndex);
+		} else {
+			// Walked backwards, so removing the last returned sprite only moves a sprite that has been visited
+			const sprite_grid_cell *cell = &_spriteGrid[query->cell_index];
+			query->cell_position = min(query->cell_position - 1, (sint32)cell->count - 1);
+			if (query->cell_position < 0) continue;
+			sprite = get_sprite(cell->sprites[query->cell_position]);
+		}
+
+		if (!(query->list_mask & SPRITE_LIST_MASK(sprite->unknown.linked_list_type_offset >> 1))) continue;
+		if (sprite->unknown.x < query->left || sprite->unknown.x > query->right) continue;
+		if (sprite->unknown.y < query->top || sprite->unknown.y > query->bottom) continue;
+		return sprite;
+	}
 }
 
 static void invalidate_sprite_max_zoom(rct_sprite *sprite, sint32 maxZoom)
@@ -108,6 +314,7 @@ void reset_sprite_list()
 {
 	gSavedAge = 0;
 	memset(_spriteList, 0, sizeof(rct_sprite) * MAX_SPRITES);
+	peep_needs_reset_all();
 
 	for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++) {
 		gSpriteListHead[i] = SPRITE_INDEX_NULL;
@@ -148,25 +355,123 @@ void reset_sprite_list()
  */
 void reset_sprite_spatial_index()
 {
-	memset(gSpriteSpatialIndex, -1, 0x10001 * sizeof(uint16));
+	sprite_grid_clear();
 	for (size_t i = 0; i < MAX_SPRITES; i++) {
 		rct_sprite *spr = get_sprite(i);
 		if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL) {
-			uint32 index;
-			if (spr->unknown.x == SPRITE_LOCATION_NULL) {
-				index = 0x10000;
-			} else {
-				sint16 x = floor2(spr->unknown.x, 32);
-				uint8 tileY = spr->unknown.y >> 5;
-				index = (x << 3) | tileY;
+			sprite_grid_insert((uint16)i, sprite_grid_get_cell_index(spr->unknown.x, spr->unknown.y));
+		}
+	}
+
+	tile_summary_reset_litter();
+}
+
+/**
+ * Writes the spatial index in the layout of the original game, the first sprite of each tile with the others
+ * linked through next_in_quadrant. Loading it again with sprite_spatial_index_load keeps the order of the sprites.
+ * @param heads Receives the first sprite of each tile, SPRITE_SPATIAL_INDEX_SIZE entries. Can be NULL.
+ * @param sprites The copy of the sprite list to link, such as the one being saved. Can be NULL.
+ */
+void sprite_spatial_index_store(uint16 *heads, rct_sprite *sprites)
+{
+	for (size_t i = 0; i < SPRITE_SPATIAL_INDEX_SIZE; i++) {
+		const sprite_grid_cell *cell = &_spriteGrid[i];
+		uint16 nextSpriteIndex = SPRITE_INDEX_NULL;
+		for (uint16 j = 0; j < cell->count; j++) {
+			uint16 spriteIndex = cell->sprites[j];
+			if (sprites != NULL) {
+				sprites[spriteIndex].unknown.next_in_quadrant = nextSpriteIndex;
 			}
-			uint16 nextSpriteId = gSpriteSpatialIndex[index];
-			gSpriteSpatialIndex[index] = spr->unknown.sprite_index;
-			spr->unknown.next_in_quadrant = nextSpriteId;
+			nextSpriteIndex = spriteIndex;
+		}
+		if (heads != NULL) {
+			heads[i] = nextSpriteIndex;
 		}
 	}
 }
 
+/**
+ * Builds the spatial index from one written by sprite_spatial_index_store, for the sprites that have been loaded
+ * along with it. Sprites missing from the links are added after the others.
+ */
+void sprite_spatial_index_load(const uint16 *heads)
+{
+	static uint16 tileSprites[MAX_SPRITES];
+
+	sprite_grid_clear();
+	for (size_t i = 0; i < SPRITE_SPATIAL_INDEX_SIZE; i++) {
+		size_t numSprites = 0;
+		for (uint16 spriteIndex = heads[i]; spriteIndex < MAX_SPRITES && numSprites < MAX_SPRITES;) {
+			rct_sprite *spr = get_sprite(spriteIndex);
+			if (spr->unknown.sprite_identifier == SPRITE_IDENTIFIER_NULL || _spriteGridCell[spriteIndex] != SPRITE_GRID_CELL_NONE) {
+				break;
+			}
+			// Marked so that a looping list is noticed, the sprites are added once the tile is complete
+			_spriteGridCell[spriteIndex] = (uint32)i;
+			tileSprites[numSprites++] = spriteIndex;
+			spriteIndex = spr->unknown.next_in_quadrant;
+		}
+
+		// The first sprite of a tile is its newest, so it goes last
+		while (numSprites > 0) {
+			sprite_grid_insert(tileSprites[--numSprites], (uint32)i);
+		}
+	}
+
+	for (size_t i = 0; i < MAX_SPRITES; i++) {
+		rct_sprite *spr = get_sprite(i);
+		if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && _spriteGridCell[i] == SPRITE_GRID_CELL_NONE) {
+			sprite_grid_insert((uint16)i, sprite_grid_get_cell_index(spr->unknown.x, spr->unknown.y));
+		}
+	}
+
+	tile_summary_reset_litter();
+}
+
+/**
+ * Hashes the contents of a sprite, ignoring the viewport dependent screen bounds.
+ */
+static uint32 sprite_hash(const rct_sprite *sprite)
+{
+	rct_sprite copy = *sprite;
+	copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
+	// Only written when saving, the spatial index is kept apart from the sprites
+	copy.unknown.next_in_quadrant = 0;
+	if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+		peep_needs_store(copy.unknown.sprite_index, &copy.peep);
+	}
+
+	// FNV-1a over 32-bit words
+	const uint8 *data = (const uint8 *)&copy;
+	uint32 hash = 2166136261u;
+	for (size_t i = 0; i < sizeof(rct_sprite); i += sizeof(uint32)) {
+		uint32 word;
+		memcpy(&word, data + i, sizeof(uint32));
+		hash = (hash ^ word) * 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * Calculates a checksum for each sprite list by walking only the sprites in use, which is cheap enough to
+ * be done every tick. The order of the sprites in each list is part of the checksum. The null and misc lists
+ * are not checksummed as they contain free slots and client-side effects.
+ */
+void sprite_list_checksums(uint32 *checksums)
+{
+	for (sint32 list = 0; list < NUM_SPRITE_LISTS; list++) {
+		uint32 checksum = 0;
+		if (list != SPRITE_LIST_NULL && list != SPRITE_LIST_MISC) {
+			for (uint16 spriteIndex = gSpriteListHead[list]; spriteIndex != SPRITE_INDEX_NULL;) {
+				rct_sprite *sprite = get_sprite(spriteIndex);
+				checksum = rol32(checksum, 5) ^ sprite_hash(sprite);
+				spriteIndex = sprite->unknown.next;
+			}
+		}
+		checksums[list] = checksum;
+	}
+}
+
 #ifndef DISABLE_NETWORK
 
 static uint8 _spriteChecksum[EVP_MAX_MD_SIZE + 1];
@@ -184,6 +489,11 @@ const char * sprite_checksum()
 		{
 			rct_sprite copy = *sprite;
 			copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
+			copy.unknown.next_in_quadrant = 0;
+			if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+			{
+				peep_needs_store(copy.unknown.sprite_index, &copy.peep);
+			}
 			if (EVP_DigestUpdate(gHashCTX, &copy, sizeof(rct_sprite)) <= 0)
 			{
 				openrct2_assert(false, "Failed to update digest");
@@ -278,6 +588,7 @@ rct_sprite *create_sprite(uint8 bl)
 	// Need to reset all sprite data, as the uninitialised values
 	// may contain garbage and cause a desync later on.
 	sprite_reset(sprite);
+	peep_needs_reset(sprite->sprite_index);
 
 	sprite->x = SPRITE_LOCATION_NULL;
 	sprite->y = SPRITE_LOCATION_NULL;
@@ -289,8 +600,8 @@ rct_sprite *create_sprite(uint8 bl)
 	sprite->flags = 0;
 	sprite->sprite_left = SPRITE_LOCATION_NULL;
 
-	sprite->next_in_quadrant = gSpriteSpatialIndex[0x10000];
-	gSpriteSpatialIndex[0x10000] = sprite->sprite_index;
+	sprite_grid_remove(sprite->sprite_index);
+	sprite_grid_insert(sprite->sprite_index, SPRITE_GRID_CELL_NULL_LOCATION);
 
 	return (rct_sprite*)sprite;
 }
@@ -499,32 +810,16 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite* sprite){
 	if (x < 0 || y < 0 || x > 0x1FFF || y > 0x1FFF)
 		x = SPRITE_LOCATION_NULL;
 
-	sint32 new_position = x;
-	if (x == SPRITE_LOCATION_NULL)new_position = 0x10000;
-	else{
-		new_position &= 0x1FE0;
-		new_position = (y >> 5) | (new_position << 3);
-	}
-
-	sint32 current_position = sprite->unknown.x;
-	if (sprite->unknown.x == SPRITE_LOCATION_NULL)current_position = 0x10000;
-	else{
-		current_position &= 0x1FE0;
-		current_position = (sprite->unknown.y >> 5) | (current_position << 3);
+	bool isLitter = sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2;
+	if (isLitter) {
+		tile_summary_remove_litter(&sprite->litter);
 	}
 
-	if (new_position != current_position){
-		uint16* sprite_idx = &gSpriteSpatialIndex[current_position];
-		rct_sprite* sprite2 = get_sprite(*sprite_idx);
-		while (sprite != sprite2){
-			sprite_idx = &sprite2->unknown.next_in_quadrant;
-			sprite2 = get_sprite(*sprite_idx);
-		}
-		*sprite_idx = sprite->unknown.next_in_quadrant;
-
-		sint32 temp_sprite_idx = gSpriteSpatialIndex[new_position];
-		gSpriteSpatialIndex[new_position] = sprite->unknown.sprite_index;
-		sprite->unknown.next_in_quadrant = temp_sprite_idx;
+	uint16 spriteIndex = sprite->unknown.sprite_index;
+	uint32 cellIndex = sprite_grid_get_cell_index(x, y);
+	if (cellIndex != _spriteGridCell[spriteIndex]) {
+		sprite_grid_remove(spriteIndex);
+		sprite_grid_insert(spriteIndex, cellIndex);
 	}
 
 	if (x == SPRITE_LOCATION_NULL){
@@ -535,6 +830,10 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite* sprite){
 		return;
 	}
 	sprite_set_coordinates(x, y, z, sprite);
+
+	if (isLitter) {
+		tile_summary_add_litter(&sprite->litter);
+	}
 }
 
 void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
@@ -573,23 +872,14 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+	if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
+		tile_summary_remove_litter(&sprite->litter);
+	}
+
 	move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
 	user_string_free(sprite->unknown.name_string_idx);
 	sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
-
-	uint32 quadrantIndex = sprite->unknown.x;
-	if (sprite->unknown.x == SPRITE_LOCATION_NULL) {
-		quadrantIndex = 0x10000;
-	} else {
-		quadrantIndex = (floor2(sprite->unknown.x, 32) << 3) | (sprite->unknown.y >> 5);
-	}
-
-	uint16 *spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
-	rct_sprite *quadrantSprite;
-	while ((quadrantSprite = get_sprite(*spriteIndex)) != sprite) {
-		spriteIndex = &quadrantSprite->unknown.next_in_quadrant;
-	}
-	*spriteIndex = sprite->unknown.next_in_quadrant;
+	sprite_grid_remove(sprite->unknown.sprite_index);
 }
 
 static bool litter_can_be_at(sint32 x, sint32 y, sint32 z)
@@ -671,21 +961,25 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
  */
 void litter_remove_at(sint32 x, sint32 y, sint32 z)
 {
-	uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-	while (spriteIndex != SPRITE_INDEX_NULL) {
-		rct_sprite *sprite = get_sprite(spriteIndex);
-		uint16 nextSpriteIndex = sprite->unknown.next_in_quadrant;
-		if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
-			rct_litter *litter = &sprite->litter;
-
-			if (abs(litter->z - z) <= 16) {
-				if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8) {
-					invalidate_sprite_0(sprite);
-					sprite_remove(sprite);
-				}
-			}
+	// Only the litter on the tile containing (x, y) is removed
+	sint32 tileLeft = x & ~31;
+	sint32 tileTop = y & ~31;
+
+	sprite_query query;
+	sprite_query_rect(&query,
+		max(x - 8, tileLeft),
+		max(y - 8, tileTop),
+		min(x + 8, tileLeft + 31),
+		min(y + 8, tileTop + 31),
+		SPRITE_LIST_MASK(SPRITE_LIST_LITTER)
+	);
+
+	rct_sprite *sprite;
+	while ((sprite = sprite_query_next(&query)) != NULL) {
+		if (abs(sprite->litter.z - z) <= 16) {
+			invalidate_sprite_0(sprite);
+			sprite_remove(sprite);
 		}
-		spriteIndex = nextSpriteIndex;
 	}
 }
 
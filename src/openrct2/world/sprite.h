@@ -412,7 +412,35 @@ extern uint16 *gSpriteListHead;
 extern uint16 *gSpriteListCount;
 #endif
 
-extern uint16 gSpriteSpatialIndex[0x10001];
+// The number of entries in the spatial index of the original game, a tile per entry plus one for sprites without a location
+#define SPRITE_SPATIAL_INDEX_SIZE	(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL + 1)
+
+#define SPRITE_LIST_MASK(list)	(1 << (list))
+#define SPRITE_LIST_MASK_ALL	((1 << NUM_SPRITE_LISTS) - 1)
+// The first car of each train is in the train list, the cars behind it are in the unknown list
+#define VEHICLE_SPRITE_LIST_MASK	(SPRITE_LIST_MASK(SPRITE_LIST_TRAIN) | SPRITE_LIST_MASK(SPRITE_LIST_UNKNOWN))
+
+/**
+ * Iterates the sprites within an area of the map, visiting only the tiles of the spatial index that
+ * the area covers. Sprites are returned tile by tile in quadrant order. The returned sprite may be
+ * moved or removed before the next sprite is requested.
+ */
+typedef struct sprite_query {
+	sint32 left;
+	sint32 top;
+	sint32 right;
+	sint32 bottom;
+	uint32 list_mask;
+	sint32 tile_left;
+	sint32 tile_top;
+	sint32 tile_right;
+	sint32 tile_bottom;
+	sint32 tile_x;
+	sint32 tile_y;
+	uint32 cell_index;
+	sint32 cell_position;
+	uint16 next_sprite_index;
+} sprite_query;
 
 rct_sprite *create_sprite(uint8 bl);
 void reset_sprite_list();
@@ -430,7 +458,13 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type);
 void litter_remove_at(sint32 x, sint32 y, sint32 z);
 void sprite_misc_explosion_cloud_create(sint32 x, sint32 y, sint32 z);
 void sprite_misc_explosion_flare_create(sint32 x, sint32 y, sint32 z);
-uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y);
+void sprite_spatial_index_store(uint16 *heads, rct_sprite *sprites);
+void sprite_spatial_index_load(const uint16 *heads);
+const uint16 *sprite_get_tile_sprites(sint32 tileX, sint32 tileY, size_t *outCount);
+void sprite_query_rect(sprite_query *query, sint32 left, sint32 top, sint32 right, sint32 bottom, uint32 listMask);
+void sprite_query_radius(sprite_query *query, sint32 x, sint32 y, sint32 radius, uint32 listMask);
+void sprite_query_tile(sprite_query *query, sint32 tileX, sint32 tileY, uint32 listMask);
+rct_sprite *sprite_query_next(sprite_query *query);
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
@@ -467,5 +501,6 @@ void crash_splash_create(sint32 x, sint32 y, sint32 z);
 void crash_splash_update(rct_crash_splash *splash);
 
 const char *sprite_checksum();
+void sprite_list_checksums(uint32 *checksums);
 
 #endif
@@ -0,0 +1,389 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../ride/ride.h"
+#include "footpath.h"
+#include "map.h"
+#include "scenery.h"
+#include "sprite.h"
+#include "tile_summary.h"
+
+/**
+ * Litter on a tile, split by whether it lies on the tile's west (x) or north (y) edge so that
+ * ranges which end exactly on a tile edge can be counted without visiting the litter.
+ */
+typedef struct tile_litter_count {
+	uint16 total;
+	uint16 on_x_edge;
+	uint16 on_y_edge;
+	uint16 on_corner;
+} tile_litter_count;
+
+static tile_summary _tileSummaries[MAX_TILE_MAP_ELEMENT_POINTERS];
+static tile_litter_count _tileLitterCounts[MAX_TILE_MAP_ELEMENT_POINTERS];
+
+// The litter on each tile, linked through _litterNextOnTile by sprite index
+static uint16 _tileLitterHeads[MAX_TILE_MAP_ELEMENT_POINTERS];
+static uint16 _litterNextOnTile[MAX_SPRITES];
+
+// Tiles whose summary was taken in an older generation are out of date, starts above the zeroed summaries
+static uint32 _tileSummaryGeneration = 1;
+
+#define TILE_RIDE_CELL_SHIFT	3
+#define TILE_RIDE_CELL_SIZE		(1 << TILE_RIDE_CELL_SHIFT)
+#define TILE_RIDE_CELLS_PER_ROW	(MAXIMUM_MAP_SIZE_TECHNICAL >> TILE_RIDE_CELL_SHIFT)
+
+/**
+ * The rides that have track in a square of tiles, so that the rides around a tile can be found without
+ * going through the elements of every tile.
+ */
+typedef struct tile_ride_cell {
+	uint32 generation;
+	uint32 rides[(MAX_RIDES + 31) / 32];
+} tile_ride_cell;
+
+static tile_ride_cell _tileRideCells[TILE_RIDE_CELLS_PER_ROW * TILE_RIDE_CELLS_PER_ROW];
+
+// Cells built in an older generation are out of date, starts above the zeroed cells
+static uint32 _tileRideCellGeneration = 1;
+
+/**
+ * Marks all tile summaries as out of date, for when elements change somewhere that can not be pinned to a tile.
+ */
+void tile_summary_invalidate()
+{
+	_tileSummaryGeneration++;
+}
+
+/**
+ * Marks the summaries of a tile and the tiles around it as out of date, must be called whenever an element
+ * is added to or removed from the tile or a counted property of one of its elements changes.
+ */
+void tile_summary_invalidate_at(sint32 x, sint32 y)
+{
+	for (sint32 tileY = max(y - 1, 0); tileY <= min(y + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1); tileY++) {
+		for (sint32 tileX = max(x - 1, 0); tileX <= min(x + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1); tileX++) {
+			// Generation 0 is never current, the generations start at 1
+			_tileSummaries[tileX + tileY * MAXIMUM_MAP_SIZE_TECHNICAL].generation = 0;
+		}
+	}
+}
+
+static void tile_summary_update(tile_summary *summary, sint32 x, sint32 y)
+{
+	summary->generation = _tileSummaryGeneration;
+	summary->scenery = 0;
+	summary->fountains = 0;
+	summary->broken_path_additions = 0;
+	summary->missing_path_additions = 0;
+	summary->track = 0;
+
+	rct_map_element *mapElement = map_get_first_element_at(x, y);
+	do {
+		switch (map_element_get_type(mapElement)) {
+		case MAP_ELEMENT_TYPE_PATH:
+		{
+			if (!footpath_element_has_path_scenery(mapElement))
+				break;
+
+			rct_scenery_entry *scenery = get_footpath_item_entry(footpath_element_get_path_scenery_index(mapElement));
+			if (scenery == NULL) {
+				summary->missing_path_additions++;
+				break;
+			}
+			if (footpath_element_path_scenery_is_ghost(mapElement))
+				break;
+
+			if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW)) {
+				summary->fountains++;
+				break;
+			}
+			if (mapElement->flags & MAP_ELEMENT_FLAG_BROKEN) {
+				summary->broken_path_additions++;
+			}
+			break;
+		}
+		case MAP_ELEMENT_TYPE_SCENERY_MULTIPLE:
+		case MAP_ELEMENT_TYPE_SCENERY:
+			summary->scenery++;
+			break;
+		case MAP_ELEMENT_TYPE_TRACK:
+			summary->track++;
+			break;
+		}
+	} while (!map_element_is_last_for_tile(mapElement++));
+}
+
+/**
+ * Gets the summary of the given tile, taking it again if the map has changed since.
+ */
+const tile_summary *tile_summary_get(sint32 x, sint32 y)
+{
+	tile_summary *summary = &_tileSummaries[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+	if (summary->generation != _tileSummaryGeneration) {
+		tile_summary_update(summary, x, y);
+	}
+	return summary;
+}
+
+/**
+ * Sums the summaries of the tiles from (left, top) up to but not including (right, bottom).
+ */
+void tile_summary_sum(sint32 left, sint32 top, sint32 right, sint32 bottom, tile_summary_totals *totals)
+{
+	memset(totals, 0, sizeof(tile_summary_totals));
+
+	left = max(left, 0);
+	top = max(top, 0);
+	right = min(right, MAXIMUM_MAP_SIZE_TECHNICAL);
+	bottom = min(bottom, MAXIMUM_MAP_SIZE_TECHNICAL);
+	for (sint32 y = top; y < bottom; y++) {
+		for (sint32 x = left; x < right; x++) {
+			const tile_summary *summary = tile_summary_get(x, y);
+			totals->scenery += summary->scenery;
+			totals->fountains += summary->fountains;
+			totals->broken_path_additions += summary->broken_path_additions;
+			totals->missing_path_additions += summary->missing_path_additions;
+			totals->track += summary->track;
+		}
+	}
+}
+
+/**
+ * Marks the rides of every tile as out of date, for when track is removed or changed somewhere that can not be
+ * pinned to a tile.
+ */
+void tile_summary_invalidate_rides()
+{
+	_tileRideCellGeneration++;
+}
+
+/**
+ * Marks the rides of a tile as out of date, must be called whenever an element is added to the tile.
+ */
+void tile_summary_invalidate_rides_at(sint32 x, sint32 y)
+{
+	if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL) {
+		_tileRideCells[(x >> TILE_RIDE_CELL_SHIFT) + (y >> TILE_RIDE_CELL_SHIFT) * TILE_RIDE_CELLS_PER_ROW].generation = 0;
+	}
+}
+
+static void tile_summary_add_rides_on_tile(sint32 x, sint32 y, uint32 *rides)
+{
+	rct_map_element *mapElement = map_get_first_element_at(x, y);
+	do {
+		if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK)
+			continue;
+		if (mapElement->flags & MAP_ELEMENT_FLAG_GHOST)
+			continue;
+
+		sint32 rideIndex = mapElement->properties.track.ride_index;
+		rides[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
+	} while (!map_element_is_last_for_tile(mapElement++));
+}
+
+static const tile_ride_cell *tile_summary_get_ride_cell(sint32 cellX, sint32 cellY)
+{
+	tile_ride_cell *cell = &_tileRideCells[cellX + cellY * TILE_RIDE_CELLS_PER_ROW];
+	if (cell->generation != _tileRideCellGeneration) {
+		cell->generation = _tileRideCellGeneration;
+		memset(cell->rides, 0, sizeof(cell->rides));
+		for (sint32 y = 0; y < TILE_RIDE_CELL_SIZE; y++) {
+			for (sint32 x = 0; x < TILE_RIDE_CELL_SIZE; x++) {
+				tile_summary_add_rides_on_tile((cellX << TILE_RIDE_CELL_SHIFT) + x, (cellY << TILE_RIDE_CELL_SHIFT) + y, cell->rides);
+			}
+		}
+	}
+	return cell;
+}
+
+/**
+ * Marks the rides that have track, other than ghosts, on the tiles from (left, top) up to but not including
+ * (right, bottom), as bits of (MAX_RIDES + 31) / 32 words. Rides already marked are kept.
+ */
+void tile_summary_get_rides(sint32 left, sint32 top, sint32 right, sint32 bottom, uint32 *rides)
+{
+	left = max(left, 0);
+	top = max(top, 0);
+	right = min(right, MAXIMUM_MAP_SIZE_TECHNICAL);
+	bottom = min(bottom, MAXIMUM_MAP_SIZE_TECHNICAL);
+	if (left >= right || top >= bottom)
+		return;
+
+	for (sint32 cellY = top >> TILE_RIDE_CELL_SHIFT; cellY <= (bottom - 1) >> TILE_RIDE_CELL_SHIFT; cellY++) {
+		for (sint32 cellX = left >> TILE_RIDE_CELL_SHIFT; cellX <= (right - 1) >> TILE_RIDE_CELL_SHIFT; cellX++) {
+			const tile_ride_cell *cell = tile_summary_get_ride_cell(cellX, cellY);
+			sint32 cellLeft = cellX << TILE_RIDE_CELL_SHIFT;
+			sint32 cellTop = cellY << TILE_RIDE_CELL_SHIFT;
+			sint32 cellRight = cellLeft + TILE_RIDE_CELL_SIZE;
+			sint32 cellBottom = cellTop + TILE_RIDE_CELL_SIZE;
+			if (cellLeft >= left && cellTop >= top && cellRight <= right && cellBottom <= bottom) {
+				for (sint32 i = 0; i < countof(cell->rides); i++) {
+					rides[i] |= cell->rides[i];
+				}
+				continue;
+			}
+
+			// Only part of the cell is covered, so its tiles are only looked at if it could add a ride
+			bool hasNewRides = false;
+			for (sint32 i = 0; i < countof(cell->rides); i++) {
+				if (cell->rides[i] & ~rides[i]) {
+					hasNewRides = true;
+					break;
+				}
+			}
+			if (!hasNewRides)
+				continue;
+
+			for (sint32 y = max(top, cellTop); y < min(bottom, cellBottom); y++) {
+				for (sint32 x = max(left, cellLeft); x < min(right, cellRight); x++) {
+					tile_summary_add_rides_on_tile(x, y, rides);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Recounts the litter on every tile, for when the sprites have been replaced.
+ */
+void tile_summary_reset_litter()
+{
+	memset(_tileLitterCounts, 0, sizeof(_tileLitterCounts));
+	memset(_tileLitterHeads, 0xFF, sizeof(_tileLitterHeads));
+
+	uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER];
+	while (spriteIndex != SPRITE_INDEX_NULL) {
+		rct_litter *litter = &get_sprite(spriteIndex)->litter;
+		tile_summary_add_litter(litter);
+		spriteIndex = litter->next;
+	}
+}
+
+static sint32 tile_summary_get_litter_tile_index(const rct_litter *litter)
+{
+	if (litter->x < 0 || litter->y < 0 || litter->x >= MAXIMUM_MAP_SIZE_BIG || litter->y >= MAXIMUM_MAP_SIZE_BIG) {
+		return -1;
+	}
+	return (litter->x >> 5) + (litter->y >> 5) * MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+/**
+ * Adds the litter to the tile at its current position, litter that is not on the map is ignored.
+ */
+void tile_summary_add_litter(rct_litter *litter)
+{
+	sint32 tileIndex = tile_summary_get_litter_tile_index(litter);
+	if (tileIndex == -1)
+		return;
+
+	_litterNextOnTile[litter->sprite_index] = _tileLitterHeads[tileIndex];
+	_tileLitterHeads[tileIndex] = litter->sprite_index;
+
+	tile_litter_count *count = &_tileLitterCounts[tileIndex];
+	count->total++;
+	if ((litter->x & 31) == 0) count->on_x_edge++;
+	if ((litter->y & 31) == 0) count->on_y_edge++;
+	if ((litter->x & 31) == 0 && (litter->y & 31) == 0) count->on_corner++;
+}
+
+/**
+ * Removes the litter from the tile at its current position, must be called before it moves.
+ */
+void tile_summary_remove_litter(rct_litter *litter)
+{
+	sint32 tileIndex = tile_summary_get_litter_tile_index(litter);
+	if (tileIndex == -1)
+		return;
+
+	uint16 *spriteIndex = &_tileLitterHeads[tileIndex];
+	while (*spriteIndex != litter->sprite_index) {
+		if (*spriteIndex == SPRITE_INDEX_NULL) {
+			log_error("Litter %u missing from its tile", litter->sprite_index);
+			return;
+		}
+		spriteIndex = &_litterNextOnTile[*spriteIndex];
+	}
+	*spriteIndex = _litterNextOnTile[litter->sprite_index];
+
+	tile_litter_count *count = &_tileLitterCounts[tileIndex];
+	count->total--;
+	if ((litter->x & 31) == 0) count->on_x_edge--;
+	if ((litter->y & 31) == 0) count->on_y_edge--;
+	if ((litter->x & 31) == 0 && (litter->y & 31) == 0) count->on_corner--;
+}
+
+/**
+ * Gets the sprite index of the first litter on the given tile, or SPRITE_INDEX_NULL if there is none.
+ */
+uint16 tile_summary_get_first_litter(sint32 x, sint32 y)
+{
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
+		return SPRITE_INDEX_NULL;
+	}
+	return _tileLitterHeads[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+}
+
+/**
+ * Gets the sprite index of the litter after the given one on the same tile.
+ */
+uint16 tile_summary_get_next_litter(uint16 spriteIndex)
+{
+	return _litterNextOnTile[spriteIndex];
+}
+
+/**
+ * Counts the litter no further than range away from (x, y) on either axis. The position and
+ * range must be whole tiles.
+ */
+uint32 tile_summary_count_litter(sint32 x, sint32 y, sint32 range)
+{
+	assert((x & 31) == 0 && (y & 31) == 0 && (range & 31) == 0);
+
+	// Litter in [x - range, x + range) covers whole tiles, litter at x + range lies on the
+	// west edge of the tile after them
+	sint32 left = (x - range) >> 5;
+	sint32 top = (y - range) >> 5;
+	sint32 right = (x + range) >> 5;
+	sint32 bottom = (y + range) >> 5;
+	sint32 clippedLeft = max(left, 0);
+	sint32 clippedTop = max(top, 0);
+	sint32 clippedRight = min(right, MAXIMUM_MAP_SIZE_TECHNICAL);
+	sint32 clippedBottom = min(bottom, MAXIMUM_MAP_SIZE_TECHNICAL);
+	bool hasRightEdge = right >= 0 && right < MAXIMUM_MAP_SIZE_TECHNICAL;
+	bool hasBottomEdge = bottom >= 0 && bottom < MAXIMUM_MAP_SIZE_TECHNICAL;
+
+	uint32 numLitter = 0;
+	for (sint32 tileY = clippedTop; tileY < clippedBottom; tileY++) {
+		const tile_litter_count *row = &_tileLitterCounts[tileY * MAXIMUM_MAP_SIZE_TECHNICAL];
+		for (sint32 tileX = clippedLeft; tileX < clippedRight; tileX++) {
+			numLitter += row[tileX].total;
+		}
+		if (hasRightEdge) {
+			numLitter += row[right].on_x_edge;
+		}
+	}
+	if (hasBottomEdge) {
+		const tile_litter_count *row = &_tileLitterCounts[bottom * MAXIMUM_MAP_SIZE_TECHNICAL];
+		for (sint32 tileX = clippedLeft; tileX < clippedRight; tileX++) {
+			numLitter += row[tileX].on_y_edge;
+		}
+		if (hasRightEdge) {
+			numLitter += row[right].on_corner;
+		}
+	}
+	return numLitter;
+}
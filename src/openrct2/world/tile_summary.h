@@ -0,0 +1,63 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef _TILE_SUMMARY_H_
+#define _TILE_SUMMARY_H_
+
+#include "../common.h"
+#include "sprite.h"
+
+/**
+ * Counts of the elements on a tile that guests look at when assessing their surroundings.
+ * The counts are taken from the tile when first needed after the tile last changed.
+ */
+typedef struct tile_summary {
+	uint32 generation;
+	uint16 scenery;						// small and large scenery
+	uint16 fountains;					// jumping fountain path additions
+	uint16 broken_path_additions;		// vandalised path additions
+	uint16 missing_path_additions;		// path additions whose object is not loaded
+	uint16 track;						// track elements of any ride
+} tile_summary;
+
+/**
+ * Sums of tile_summary over a range of tiles.
+ */
+typedef struct tile_summary_totals {
+	uint32 scenery;
+	uint32 fountains;
+	uint32 broken_path_additions;
+	uint32 missing_path_additions;
+	uint32 track;
+} tile_summary_totals;
+
+void tile_summary_invalidate();
+void tile_summary_invalidate_at(sint32 x, sint32 y);
+const tile_summary *tile_summary_get(sint32 x, sint32 y);
+void tile_summary_sum(sint32 left, sint32 top, sint32 right, sint32 bottom, tile_summary_totals *totals);
+
+void tile_summary_invalidate_rides();
+void tile_summary_invalidate_rides_at(sint32 x, sint32 y);
+void tile_summary_get_rides(sint32 left, sint32 top, sint32 right, sint32 bottom, uint32 *rides);
+
+void tile_summary_reset_litter();
+void tile_summary_add_litter(rct_litter *litter);
+void tile_summary_remove_litter(rct_litter *litter);
+uint16 tile_summary_get_first_litter(sint32 x, sint32 y);
+uint16 tile_summary_get_next_litter(uint16 spriteIndex);
+uint32 tile_summary_count_litter(sint32 x, sint32 y, sint32 range);
+
+#endif
@@ -21,6 +21,7 @@
 #include <openrct2/ride/ride.h>
 #include <openrct2/ride/track.h>
 #include <openrct2/world/sprite.h>
+#include <openrct2/paint/paint.h>
 #include <openrct2/paint/map_element/map_element.h>
 
 #define RCT2_ADDRESS_SPRITE_LIST					0x010E63BC
@@ -73,6 +74,7 @@ int object_entry_group_counts[] = {
 
 
 general_configuration gConfigGeneral;
+paint_session * gPaintSession;
 uint16 gMapSelectFlags;
 uint16 gMapSelectType;
 rct_xy16 gMapSelectPositionA;
@@ -88,6 +90,12 @@ void scenery_paint(uint8 direction, int height, rct_map_element *mapElement) { }
 void fence_paint(uint8 direction, int height, rct_map_element *mapElement) { }
 void scenery_multiple_paint(uint8 direction, uint16 height, rct_map_element *mapElement) { }
 
+void paint_session_store_rct2(paint_session * session) { }
+void paint_session_load_rct2(paint_session * session) { }
+bool paint_cache_begin_tile(sint32 x, sint32 y) { return false; }
+void paint_cache_end_tile() { }
+void paint_cache_disallow() { }
+
 rct_ride *get_ride(int index) {
 	if (index < 0 || index >= MAX_RIDES) {
 		log_error("invalid index %d for ride", index);
@@ -0,0 +1,137 @@
+extern "C"
+{
+    #include "openrct2/ride/ride.h"
+    #include "openrct2/world/footpath.h"
+    #include "openrct2/world/map.h"
+    #include "openrct2/world/scenery.h"
+    #include "openrct2/world/sprite.h"
+    #include "openrct2/world/tile_summary.h"
+}
+
+#include <gtest/gtest.h>
+
+// A map of one element per tile, in place of the real map
+static rct_map_element _elements[MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL];
+
+extern "C"
+{
+#ifdef NO_RCT2
+    uint16 gSpriteListHead[6];
+#else
+    uint16 * gSpriteListHead;
+#endif
+
+    rct_map_element * map_get_first_element_at(sint32 x, sint32 y)
+    {
+        return &_elements[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+    }
+
+    sint32 map_element_is_last_for_tile(const rct_map_element * element)
+    {
+        return element->flags & MAP_ELEMENT_FLAG_LAST_TILE;
+    }
+
+    sint32 map_element_get_type(const rct_map_element * element)
+    {
+        return element->type & MAP_ELEMENT_TYPE_MASK;
+    }
+
+    bool footpath_element_has_path_scenery(rct_map_element * mapElement) { return false; }
+    uint8 footpath_element_get_path_scenery_index(rct_map_element * mapElement) { return 0; }
+    bool footpath_element_path_scenery_is_ghost(rct_map_element * mapElement) { return false; }
+    rct_scenery_entry * get_footpath_item_entry(sint32 entryIndex) { return nullptr; }
+    rct_sprite * get_sprite(size_t sprite_idx) { return nullptr; }
+}
+
+class TileSummaryTest : public testing::Test
+{
+protected:
+    static constexpr sint32 NUM_RIDE_WORDS = (MAX_RIDES + 31) / 32;
+
+    void SetUp() override
+    {
+        for (rct_map_element &element : _elements)
+        {
+            element = { 0 };
+            element.type = MAP_ELEMENT_TYPE_SURFACE;
+            element.flags = MAP_ELEMENT_FLAG_LAST_TILE;
+        }
+        tile_summary_invalidate();
+        tile_summary_invalidate_rides();
+    }
+
+    static void PlaceTrack(sint32 x, sint32 y, uint8 rideIndex, uint8 flags = 0)
+    {
+        rct_map_element * element = map_get_first_element_at(x, y);
+        element->type = MAP_ELEMENT_TYPE_TRACK;
+        element->flags |= flags;
+        element->properties.track.ride_index = rideIndex;
+    }
+
+    static bool HasRide(const uint32 * rides, sint32 rideIndex)
+    {
+        return (rides[rideIndex >> 5] & (1u << (rideIndex & 0x1F))) != 0;
+    }
+};
+
+TEST_F(TileSummaryTest, last_ride_in_whole_cell)
+{
+    PlaceTrack(100, 100, MAX_RIDES - 1);
+    PlaceTrack(108, 100, 3);
+
+    uint32 rides[NUM_RIDE_WORDS] = { 0 };
+    tile_summary_get_rides(96, 96, 112, 104, rides);
+    ASSERT_TRUE(HasRide(rides, MAX_RIDES - 1));
+    ASSERT_TRUE(HasRide(rides, 3));
+
+    // The cell next to the one with the last ride must not have picked it up
+    uint32 nextCellRides[NUM_RIDE_WORDS] = { 0 };
+    tile_summary_get_rides(104, 96, 112, 104, nextCellRides);
+    ASSERT_FALSE(HasRide(nextCellRides, MAX_RIDES - 1));
+    ASSERT_TRUE(HasRide(nextCellRides, 3));
+}
+
+TEST_F(TileSummaryTest, last_ride_in_part_of_cell)
+{
+    PlaceTrack(100, 100, MAX_RIDES - 1);
+
+    uint32 rides[NUM_RIDE_WORDS] = { 0 };
+    tile_summary_get_rides(99, 99, 102, 102, rides);
+    ASSERT_TRUE(HasRide(rides, MAX_RIDES - 1));
+
+    uint32 outsideRides[NUM_RIDE_WORDS] = { 0 };
+    tile_summary_get_rides(101, 101, 104, 104, outsideRides);
+    ASSERT_FALSE(HasRide(outsideRides, MAX_RIDES - 1));
+}
+
+TEST_F(TileSummaryTest, ghost_track_ignored)
+{
+    PlaceTrack(100, 100, 5, MAP_ELEMENT_FLAG_GHOST);
+    PlaceTrack(101, 100, 6);
+
+    uint32 rides[NUM_RIDE_WORDS] = { 0 };
+    tile_summary_get_rides(96, 96, 104, 104, rides);
+    ASSERT_FALSE(HasRide(rides, 5));
+    ASSERT_TRUE(HasRide(rides, 6));
+}
+
+TEST_F(TileSummaryTest, invalidate_at_retakes_tile_and_neighbours)
+{
+    ASSERT_EQ(0, tile_summary_get(100, 100)->track);
+    ASSERT_EQ(0, tile_summary_get(101, 101)->track);
+    ASSERT_EQ(0, tile_summary_get(102, 100)->track);
+
+    PlaceTrack(100, 100, 1);
+    PlaceTrack(101, 101, 1);
+    PlaceTrack(102, 100, 1);
+    tile_summary_invalidate_at(100, 100);
+
+    ASSERT_EQ(1, tile_summary_get(100, 100)->track);
+    ASSERT_EQ(1, tile_summary_get(101, 101)->track);
+    // Tiles further away keep their summary until they are invalidated themselves
+    ASSERT_EQ(0, tile_summary_get(102, 100)->track);
+
+    tile_summary_invalidate_at(0, 0);
+    tile_summary_invalidate_at(MAXIMUM_MAP_SIZE_TECHNICAL - 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    ASSERT_EQ(0, tile_summary_get(0, 0)->track);
+}